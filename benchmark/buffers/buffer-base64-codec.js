@@ -0,0 +1,29 @@
+'use strict';
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  op: ['encode', 'decode'],
+  encoding: ['base64', 'base64url'],
+  size: [64, 4096, 1024 * 1024],
+  n: [1e4],
+}, {
+  test: { size: 64 },
+});
+
+function main({ n, op, encoding, size }) {
+  const buf = Buffer.allocUnsafe(size);
+  for (let i = 0; i < size; i++) buf[i] = (i * 7 + 3) & 0xff;
+  const str = buf.toString(encoding);
+  // Keep the run time of the larger sizes bounded.
+  const iterations = Math.max(1, Math.floor(n * 4096 / Math.max(size, 4096)));
+
+  if (op === 'encode') {
+    bench.start();
+    for (let i = 0; i < iterations; i++) buf.toString(encoding);
+    bench.end(iterations);
+  } else {
+    bench.start();
+    for (let i = 0; i < iterations; i++) Buffer.from(str, encoding);
+    bench.end(iterations);
+  }
+}
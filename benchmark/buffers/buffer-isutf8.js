@@ -0,0 +1,30 @@
+'use strict';
+const common = require('../common.js');
+const { isAscii, isUtf8 } = require('buffer');
+
+const bench = common.createBenchmark(main, {
+  method: ['isUtf8', 'isAscii'],
+  input: ['ascii', 'latin1', 'cjk', 'emoji'],
+  size: [16, 1024, 64 * 1024],
+  n: [1e5],
+}, {
+  test: { size: 16 },
+});
+
+const samples = {
+  ascii: 'hello world, ',
+  latin1: 'café crème ',
+  cjk: '日本語のテキスト',
+  emoji: '\u{1f600}\u{1f680}\u{1f308} ',
+};
+
+function main({ n, method, input, size }) {
+  const buf = Buffer.from(samples[input].repeat(size));
+  const fn = method === 'isUtf8' ? isUtf8 : isAscii;
+  // Keep the run time of the larger sizes bounded.
+  const iterations = Math.max(1, Math.floor(n * 1024 / Math.max(buf.length, 1024)));
+
+  bench.start();
+  for (let i = 0; i < iterations; i++) fn(buf);
+  bench.end(iterations);
+}
@@ -0,0 +1,78 @@
+'use strict';
+const common = require('../common.js');
+
+// Exercises the Buffer binding methods that have V8 fast API call paths
+// with small inputs, where the cost of the call itself dominates.
+const bench = common.createBenchmark(main, {
+  type: [
+    'byteLength',
+    'compare',
+    'compareOffset',
+    'concat',
+    'copy',
+    'fill',
+    'indexOfBuffer',
+    'indexOfNumber',
+    'swap16',
+  ],
+  size: [16, 256],
+  n: [1e6],
+});
+
+function main({ n, size, type }) {
+  const a = Buffer.alloc(size, 'a');
+  const b = Buffer.alloc(size, 'a');
+  b[size - 1] = 0x62;
+  const needle = Buffer.from('ab');
+  const pattern = Buffer.from('xyz');
+  const str = 'a'.repeat(size);
+  const list = [a.subarray(0, size / 2), b.subarray(0, size / 2)];
+
+  switch (type) {
+    case 'byteLength':
+      bench.start();
+      for (let i = 0; i < n; i++) Buffer.byteLength(str, 'utf8');
+      bench.end(n);
+      break;
+    case 'compare':
+      bench.start();
+      for (let i = 0; i < n; i++) Buffer.compare(a, b);
+      bench.end(n);
+      break;
+    case 'compareOffset':
+      bench.start();
+      for (let i = 0; i < n; i++) a.compare(b, 1, size - 1, 1, size - 1);
+      bench.end(n);
+      break;
+    case 'concat':
+      bench.start();
+      for (let i = 0; i < n; i++) Buffer.concat(list, size);
+      bench.end(n);
+      break;
+    case 'copy':
+      bench.start();
+      for (let i = 0; i < n; i++) a.copy(b, 1, 0, size - 1);
+      bench.end(n);
+      break;
+    case 'fill':
+      bench.start();
+      for (let i = 0; i < n; i++) b.fill(pattern);
+      bench.end(n);
+      break;
+    case 'indexOfBuffer':
+      bench.start();
+      for (let i = 0; i < n; i++) b.indexOf(needle);
+      bench.end(n);
+      break;
+    case 'indexOfNumber':
+      bench.start();
+      for (let i = 0; i < n; i++) b.indexOf(0x62);
+      bench.end(n);
+      break;
+    case 'swap16':
+      bench.start();
+      for (let i = 0; i < n; i++) b.swap16();
+      bench.end(n);
+      break;
+  }
+}
@@ -0,0 +1,75 @@
+// Compares hashing many small chunks with one crypto.hashBatch() job against
+// one webcrypto job per chunk.
+'use strict';
+
+const common = require('../common.js');
+const {
+  hashBatch,
+  webcrypto,
+} = require('crypto');
+const { subtle } = webcrypto;
+
+const bench = common.createBenchmark(main, {
+  api: ['hashBatch', 'hashBatchOffsets', 'subtle'],
+  len: [64, 1024, 16384],
+  method: ['SHA-1', 'SHA-256'],
+  chunks: [1000],
+  n: [10],
+});
+
+const kMethods = {
+  'SHA-1': 'sha1',
+  'SHA-256': 'sha256',
+};
+
+function measureBatch(n, chunks, method) {
+  let remaining = n;
+  bench.start();
+  (function next() {
+    hashBatch(kMethods[method], chunks, (err) => {
+      if (err) throw err;
+      if (--remaining === 0) return bench.end(n * chunks.length);
+      next();
+    });
+  })();
+}
+
+function measureBatchOffsets(n, chunks, method) {
+  const data = Buffer.concat(chunks);
+  const offsets = chunks.map((_, i) => i * chunks[0].length);
+  let remaining = n;
+  bench.start();
+  (function next() {
+    hashBatch(kMethods[method], data, offsets, (err) => {
+      if (err) throw err;
+      if (--remaining === 0) return bench.end(n * chunks.length);
+      next();
+    });
+  })();
+}
+
+function measureSubtle(n, chunks, method) {
+  let remaining = n;
+  bench.start();
+  (function next() {
+    Promise.all(chunks.map((chunk) => subtle.digest(method, chunk)))
+      .then(() => {
+        if (--remaining === 0) return bench.end(n * chunks.length);
+        next();
+      })
+      .catch((err) => {
+        process.nextTick(() => { throw err; });
+      });
+  })();
+}
+
+function main({ api, len, method, chunks, n }) {
+  const data = [];
+  for (let i = 0; i < chunks; i++)
+    data.push(webcrypto.getRandomValues(Buffer.alloc(len)));
+  switch (api) {
+    case 'hashBatch': return measureBatch(n, data, method);
+    case 'hashBatchOffsets': return measureBatchOffsets(n, data, method);
+    case 'subtle': return measureSubtle(n, data, method);
+  }
+}
@@ -0,0 +1,28 @@
+// Compares crypto.hash() with crypto.createHash() for small inputs.
+'use strict';
+const common = require('../common.js');
+const crypto = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  n: [1e5],
+  algo: ['sha1', 'sha256', 'md5'],
+  type: ['string', 'buffer'],
+  len: [32, 256, 4096],
+  out: ['hex', 'base64', 'buffer'],
+  api: ['oneshot', 'stateful'],
+});
+
+function main({ n, algo, type, len, out, api }) {
+  const data = type === 'string' ? 'a'.repeat(len) : Buffer.alloc(len, 'a');
+  if (api === 'stateful') {
+    bench.start();
+    for (let i = 0; i < n; i++)
+      crypto.createHash(algo).update(data).digest(out);
+    bench.end(n);
+  } else {
+    bench.start();
+    for (let i = 0; i < n; i++)
+      crypto.hash(algo, data, out);
+    bench.end(n);
+  }
+}
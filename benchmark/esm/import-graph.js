@@ -0,0 +1,71 @@
+'use strict';
+
+// Measures how long it takes a new process to load a large synthetic graph of
+// ES modules. `wide` graphs have a root that imports every other module,
+// `deep` graphs are trees in which each module imports up to 8 others.
+
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  modules: [1000, 3000],
+  shape: ['wide', 'deep'],
+  compileCache: [0, 1],
+  n: [10],
+});
+
+function writeGraph(dir, modules, shape) {
+  const children = [];
+  for (let i = 0; i < modules; i++)
+    children.push([]);
+  for (let i = 1; i < modules; i++) {
+    const parent = shape === 'wide' ? 0 : Math.floor((i - 1) / 8);
+    children[parent].push(i);
+  }
+  for (let i = 0; i < modules; i++) {
+    let source = '';
+    let sum = '1';
+    for (const child of children[i]) {
+      source += `import { count as c${child} } from './m${child}.mjs';\n`;
+      sum += ` + c${child}`;
+    }
+    source += `export const count = ${sum};\n`;
+    source += 'export function f() { return count * 2; }\n';
+    fs.writeFileSync(path.join(dir, `m${i}.mjs`), source);
+  }
+  fs.writeFileSync(path.join(dir, 'main.mjs'), `
+    import { count } from './m0.mjs';
+    if (count !== ${modules}) throw new Error('unexpected count ' + count);
+  `);
+}
+
+function main({ modules, shape, compileCache, n }) {
+  tmpdir.refresh();
+  const dir = path.join(tmpdir.path, 'benchmark-esm-import-graph');
+  fs.mkdirSync(dir);
+  writeGraph(dir, modules, shape);
+
+  const args = [];
+  if (compileCache)
+    args.push(`--experimental-compile-cache=${path.join(dir, 'cache')}`);
+  args.push(path.join(dir, 'main.mjs'));
+
+  const run = () => {
+    const child = spawnSync(process.execPath, args, { stdio: 'inherit' });
+    if (child.status !== 0)
+      throw new Error(`Child process exited with ${child.status}`);
+  };
+
+  // Warm up the file system cache, and fill the compile cache if it is used.
+  run();
+
+  bench.start();
+  for (let i = 0; i < n; i++)
+    run();
+  bench.end(n);
+
+  tmpdir.refresh();
+}
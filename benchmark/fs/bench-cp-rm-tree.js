@@ -0,0 +1,48 @@
+// Copy and remove a directory tree. Passing a filter makes fs.cp() walk the
+// tree entry by entry instead of copying it with a single binding call.
+'use strict';
+
+const common = require('../common');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+tmpdir.refresh();
+
+const bench = common.createBenchmark(main, {
+  n: [20],
+  files: [1000],
+  depth: [1, 5],
+  api: ['sync', 'promises'],
+  filter: ['true', 'false'],
+});
+
+function makeTree(root, files, depth) {
+  let dir = root;
+  for (let i = 0; i < depth; i++) {
+    dir = path.join(dir, `d${i}`);
+    fs.mkdirSync(dir, { recursive: true });
+    for (let j = 0; j < files / depth; j++)
+      fs.writeFileSync(path.join(dir, `f${j}`), 'x'.repeat(j));
+  }
+}
+
+async function main({ n, files, depth, api, filter }) {
+  const src = path.join(tmpdir.path, 'src');
+  makeTree(src, files, depth);
+  const options = { recursive: true };
+  if (filter === 'true')
+    options.filter = () => true;
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    const dest = path.join(tmpdir.path, `dest${i}`);
+    if (api === 'sync') {
+      fs.cpSync(src, dest, options);
+      fs.rmSync(dest, { recursive: true });
+    } else {
+      await fs.promises.cp(src, dest, options);
+      await fs.promises.rm(dest, { recursive: true });
+    }
+  }
+  bench.end(n);
+}
@@ -0,0 +1,73 @@
+// Walk a directory tree and lstat() every entry, either with a single
+// recursive fs.Dir that returns the stats in batches or with readdir() and
+// one lstat() call per entry.
+'use strict';
+
+const common = require('../common');
+const fs = require('fs');
+const path = require('path');
+
+const bench = common.createBenchmark(main, {
+  n: [10],
+  dir: [ 'lib', 'test/parallel' ],
+  method: [ 'opendir', 'readdir' ],
+  mode: [ 'async', 'sync' ],
+});
+
+async function walkReaddir(root) {
+  let counter = 0;
+  const pending = [root];
+  while (pending.length > 0) {
+    const dir = pending.pop();
+    const names = await fs.promises.readdir(dir);
+    const stats = await Promise.all(
+      names.map((name) => fs.promises.lstat(path.join(dir, name))));
+    for (let i = 0; i < names.length; i++) {
+      if (stats[i].isDirectory())
+        pending.push(path.join(dir, names[i]));
+      counter++;
+    }
+  }
+  return counter;
+}
+
+function walkReaddirSync(root) {
+  let counter = 0;
+  const pending = [root];
+  while (pending.length > 0) {
+    const dir = pending.pop();
+    for (const name of fs.readdirSync(dir)) {
+      const full = path.join(dir, name);
+      if (fs.lstatSync(full).isDirectory())
+        pending.push(full);
+      counter++;
+    }
+  }
+  return counter;
+}
+
+async function main({ n, dir, method, mode }) {
+  const fullPath = path.resolve(__dirname, '../../', dir);
+  const options = { recursive: true, withStats: true };
+
+  bench.start();
+
+  let counter = 0;
+  for (let i = 0; i < n; i++) {
+    if (method === 'readdir') {
+      counter += mode === 'async' ?
+        await walkReaddir(fullPath) : walkReaddirSync(fullPath);
+    } else if (mode === 'async') {
+      for await (const entry of await fs.promises.opendir(fullPath, options))
+        if (entry.stats !== undefined) counter++;
+    } else {
+      const dir = fs.opendirSync(fullPath, options);
+      let entry;
+      while ((entry = dir.readSync()) !== null)
+        if (entry.stats !== undefined) counter++;
+      dir.closeSync();
+    }
+  }
+
+  bench.end(counter);
+}
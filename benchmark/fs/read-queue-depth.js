@@ -0,0 +1,75 @@
+// Keep `queueDepth` positional fs.read() calls in flight against one file
+// and count how many of them complete. Compare the threadpool with io_uring
+// by running the benchmark a second time with
+// NODE_BENCHMARK_FLAGS=--experimental-fs-io-uring.
+'use strict';
+
+const path = require('path');
+const common = require('../common.js');
+const fs = require('fs');
+
+const tmpdir = require('../../test/common/tmpdir');
+tmpdir.refresh();
+const filename = path.resolve(tmpdir.path,
+                              `.removeme-benchmark-garbage-${process.pid}`);
+
+const bench = common.createBenchmark(main, {
+  duration: [5],
+  size: [4096, 64 * 1024],
+  queueDepth: [1, 4, 16, 64, 256],
+  api: ['callback', 'promises'],
+});
+
+const fileSize = 64 * 1024 * 1024;
+
+function main({ duration, size, queueDepth, api }) {
+  fs.writeFileSync(filename, Buffer.alloc(fileSize, 'x'));
+  const fd = fs.openSync(filename, 'r');
+  const blocks = fileSize / size;
+
+  let reads = 0;
+  let benchEnded = false;
+  bench.start();
+  setTimeout(() => {
+    benchEnded = true;
+    bench.end(reads);
+    fs.closeSync(fd);
+    fs.unlinkSync(filename);
+    process.exit(0);
+  }, duration * 1000);
+
+  function position() {
+    return Math.floor(Math.random() * blocks) * size;
+  }
+
+  function read(buffer) {
+    fs.read(fd, buffer, 0, size, position(), (err, bytesRead) => {
+      if (err) throw err;
+      if (bytesRead !== size)
+        throw new Error('wrong number of bytes returned');
+      reads++;
+      if (!benchEnded)
+        read(buffer);
+    });
+  }
+
+  async function readPromises(filehandle, buffer) {
+    while (!benchEnded) {
+      const { bytesRead } =
+        await filehandle.read(buffer, 0, size, position());
+      if (bytesRead !== size)
+        throw new Error('wrong number of bytes returned');
+      reads++;
+    }
+  }
+
+  if (api === 'callback') {
+    for (let i = 0; i < queueDepth; i++)
+      read(Buffer.allocUnsafe(size));
+  } else {
+    fs.promises.open(filename, 'r').then((filehandle) => {
+      for (let i = 0; i < queueDepth; i++)
+        readPromises(filehandle, Buffer.allocUnsafe(size));
+    });
+  }
+}
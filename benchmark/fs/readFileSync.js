@@ -4,12 +4,14 @@ const common = require('../common.js');
 const fs = require('fs');
 
 const bench = common.createBenchmark(main, {
+  encoding: ['undefined', 'utf8'],
   n: [60e4]
 });
 
-function main({ n }) {
+function main({ n, encoding }) {
+  if (encoding === 'undefined') encoding = undefined;
   bench.start();
   for (let i = 0; i < n; ++i)
-    fs.readFileSync(__filename);
+    fs.readFileSync(__filename, encoding);
   bench.end(n);
 }
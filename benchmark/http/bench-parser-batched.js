@@ -0,0 +1,43 @@
+'use strict';
+
+// Compares request parsers that call into JS land for every event with
+// parsers that batch all events of one execute() call, for single and for
+// pipelined requests.
+
+const common = require('../common');
+
+const bench = common.createBenchmark(main, {
+  batched: ['true', 'false'],
+  pipeline: [1, 16],
+  body: [0, 1024],
+  n: [1e5],
+});
+
+function main({ batched, pipeline, body, n }) {
+  const { parsers, HTTPParser } = require('_http_common');
+
+  let request = 'POST /hello HTTP/1.1\r\nHost: example.com\r\n' +
+                'Content-Type: text/plain\r\n';
+  for (let i = 0; i < 8; i++)
+    request += `X-Filler-${i}: ${'x'.repeat(16)}\r\n`;
+  request += `Content-Length: ${body}\r\n\r\n${'b'.repeat(body)}`;
+  const chunk = Buffer.from(request.repeat(pipeline));
+
+  // Pooled parsers use the same callbacks as the HTTP server.
+  const parser = parsers.alloc();
+  parser.initialize(HTTPParser.REQUEST, {}, 0, 0, undefined,
+                    batched === 'true');
+  let requests = 0;
+  parser.onIncoming = () => {
+    requests++;
+    return 0;
+  };
+
+  const iterations = Math.ceil(n / pipeline);
+  bench.start();
+  for (let i = 0; i < iterations; i++)
+    parser.execute(chunk);
+  bench.end(requests);
+
+  parser.close();
+}
@@ -0,0 +1,33 @@
+'use strict';
+
+const common = require('../common.js');
+const http = require('http');
+
+const bench = common.createBenchmark(main, {
+  type: ['object', 'array', 'frozen'],
+  headers: [2, 10],
+  n: [1e5],
+});
+
+function main({ n, type, headers: count }) {
+  const headers = {
+    'Content-Type': 'text/plain; charset=utf-8',
+    'Content-Length': '11',
+  };
+  for (let i = 2; i < count; i++)
+    headers[`X-Header-${i}`] = `some header value ${i}`;
+
+  let argument = headers;
+  if (type === 'array')
+    argument = Object.entries(headers).flat();
+  else if (type === 'frozen')
+    argument = new http.FrozenHeaders(headers);
+
+  const req = { method: 'GET', httpVersionMajor: 1, httpVersionMinor: 1 };
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    const res = new http.ServerResponse(req);
+    res.writeHead(200, argument);
+  }
+  bench.end(n);
+}
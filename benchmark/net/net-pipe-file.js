@@ -0,0 +1,60 @@
+// Send a file to a client with stream.pipeline() over and over again and
+// measure the throughput. `method=pipe` forces the regular path that reads
+// the file into Buffers; `method=pipeline` lets the kernel copy it where
+// sendfile(2) is available.
+'use strict';
+
+const common = require('../common.js');
+const fs = require('fs');
+const net = require('net');
+const path = require('path');
+const { pipeline } = require('stream');
+
+const bench = common.createBenchmark(main, {
+  size: [64 * 1024, 1024 * 1024, 64 * 1024 * 1024],
+  method: ['pipe', 'pipeline'],
+  dur: [5],
+});
+
+const tmpdir = require('../../test/common/tmpdir');
+tmpdir.refresh();
+const filename = path.resolve(tmpdir.path,
+                              `.removeme-benchmark-garbage-${process.pid}`);
+
+function main({ size, method, dur }) {
+  fs.writeFileSync(filename, Buffer.alloc(size, 'x'));
+
+  const server = net.createServer((socket) => {
+    const src = fs.createReadStream(filename);
+    if (method === 'pipe')
+      src.pipe(socket);
+    else
+      pipeline(src, socket, () => {});
+  });
+
+  let received = 0;
+  let ended = false;
+  function connect() {
+    const socket = net.connect(server.address().port);
+    socket.on('data', (chunk) => {
+      received += chunk.length;
+    });
+    socket.on('end', () => {
+      if (!ended)
+        connect();
+    });
+  }
+
+  server.listen(0, () => {
+    bench.start();
+    connect();
+    setTimeout(() => {
+      ended = true;
+      const bytes = received;
+      const gbits = (bytes * 8) / (1024 * 1024 * 1024);
+      bench.end(gbits);
+      fs.unlinkSync(filename);
+      process.exit(0);
+    }, dur * 1000);
+  });
+}
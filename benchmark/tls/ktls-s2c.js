@@ -0,0 +1,60 @@
+'use strict';
+const common = require('../common.js');
+const bench = common.createBenchmark(main, {
+  dur: [5],
+  ktls: ['true', 'false'],
+  protocol: ['TLSv1.2', 'TLSv1.3'],
+  sendchunklen: [16 * 1024, 256 * 1024],
+});
+
+const fixtures = require('../../test/common/fixtures');
+const tls = require('tls');
+
+function main({ dur, ktls, protocol, sendchunklen }) {
+  const chunk = Buffer.alloc(sendchunklen, 'b');
+  let received = 0;
+
+  const options = {
+    key: fixtures.readKey('rsa_private.pem'),
+    cert: fixtures.readKey('rsa_cert.crt'),
+    ca: fixtures.readKey('rsa_ca.crt'),
+    ciphers: 'AES128-GCM-SHA256',
+    minVersion: protocol,
+    maxVersion: protocol,
+    enableKTLS: ktls === 'true',
+  };
+
+  const server = tls.createServer(options, (socket) => {
+    socket.on('data', (buf) => {
+      socket.on('drain', write);
+      write();
+    });
+
+    function write() {
+      while (false !== socket.write(chunk));
+    }
+  });
+
+  server.listen(common.PORT, () => {
+    const conn = tls.connect({
+      port: common.PORT,
+      rejectUnauthorized: false,
+      minVersion: protocol,
+      maxVersion: protocol,
+    }, () => {
+      setTimeout(done, dur * 1000);
+      bench.start();
+      conn.write('hello');
+    });
+
+    conn.on('data', (chunk) => {
+      received += chunk.length;
+    });
+  });
+
+  function done() {
+    const mbits = (received * 8) / (1024 * 1024);
+    bench.end(mbits);
+    process.exit(0);
+  }
+}
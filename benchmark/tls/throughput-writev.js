@@ -0,0 +1,62 @@
+'use strict';
+const common = require('../common.js');
+const bench = common.createBenchmark(main, {
+  dur: [5],
+  chunks: [2, 16],
+  chunklen: [64, 1024, 64 * 1024],
+});
+
+const fixtures = require('../../test/common/fixtures');
+const tls = require('tls');
+
+function main({ dur, chunks, chunklen }) {
+  const chunk = Buffer.alloc(chunklen, 'b');
+  let received = 0;
+
+  const options = {
+    key: fixtures.readKey('rsa_private.pem'),
+    cert: fixtures.readKey('rsa_cert.crt'),
+    ca: fixtures.readKey('rsa_ca.crt'),
+    ciphers: 'AES256-GCM-SHA384',
+    maxVersion: 'TLSv1.2',
+  };
+
+  const server = tls.createServer(options, (socket) => {
+    socket.on('data', (buf) => {
+      socket.on('drain', write);
+      write();
+    });
+
+    // Each batch of corked writes is passed to TLSWrap as one writev().
+    function write() {
+      let more;
+      do {
+        socket.cork();
+        for (let i = 0; i < chunks; i++)
+          more = socket.write(chunk);
+        socket.uncork();
+      } while (more);
+    }
+  });
+
+  server.listen(common.PORT, () => {
+    const conn = tls.connect({
+      port: common.PORT,
+      rejectUnauthorized: false,
+    }, () => {
+      setTimeout(done, dur * 1000);
+      bench.start();
+      conn.write('hello');
+    });
+
+    conn.on('data', (chunk) => {
+      received += chunk.length;
+    });
+  });
+
+  function done() {
+    const mbits = (received * 8) / (1024 * 1024);
+    bench.end(mbits);
+    process.exit(0);
+  }
+}
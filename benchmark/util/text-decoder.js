@@ -0,0 +1,43 @@
+'use strict';
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  encoding: ['utf-8', 'utf-16le'],
+  input: ['ascii', 'latin1', 'unicode'],
+  ignoreBOM: [0, 1],
+  fatal: [0, 1],
+  len: [256, 1024 * 16, 1024 * 512],
+  n: [1e3],
+  type: ['Buffer', 'ArrayBuffer', 'SharedArrayBuffer'],
+});
+
+function main({ encoding, input, len, n, ignoreBOM, fatal, type }) {
+  const decoder = new TextDecoder(encoding, { ignoreBOM, fatal });
+  const chars = { ascii: 'ab', latin1: 'aé', unicode: 'é日' }[input];
+  const source = Buffer.from(chars.repeat(len / 2));
+  let buf;
+
+  switch (type) {
+    case 'SharedArrayBuffer': {
+      buf = new SharedArrayBuffer(source.length);
+      new Uint8Array(buf).set(source);
+      break;
+    }
+    case 'ArrayBuffer': {
+      buf = new ArrayBuffer(source.length);
+      new Uint8Array(buf).set(source);
+      break;
+    }
+    case 'Buffer': {
+      buf = source;
+      break;
+    }
+  }
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    decoder.decode(buf);
+  }
+  bench.end(n);
+}
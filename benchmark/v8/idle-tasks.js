@@ -0,0 +1,54 @@
+'use strict';
+
+// Runs bursts of allocation-heavy work with short pauses in between, like a
+// server under bursty load, and measures how late the bursts finish. Garbage
+// collection pauses that hit a burst delay it, so with --experimental-idle-tasks
+// more of the collection work should happen between the bursts instead.
+//
+// The reported rate is the inverse of the 99th percentile of that latency in
+// seconds, so higher is better.
+
+if (process.argv[2] === 'child') {
+  const { performance } = require('perf_hooks');
+  const bursts = +process.argv[3];
+  const interval = +process.argv[4];
+  const retained = new Array(1e5);
+  const latencies = [];
+  let due = performance.now();
+
+  function burst() {
+    for (let i = 0; i < 5e3; i++) {
+      const obj = { i, payload: new Array(8).fill(i) };
+      // Keeps some of the objects alive long enough to reach the old space.
+      retained[(i * 7919 + latencies.length) % retained.length] = obj;
+    }
+    latencies.push(performance.now() - due);
+    if (latencies.length === bursts) {
+      latencies.sort((a, b) => a - b);
+      process.send(latencies[Math.floor(bursts * 0.99)]);
+      process.disconnect();
+      return;
+    }
+    due = performance.now() + interval;
+    setTimeout(burst, interval);
+  }
+  burst();
+} else {
+  const common = require('../common.js');
+  const { fork } = require('child_process');
+
+  const bench = common.createBenchmark(main, {
+    idleTasks: ['true', 'false'],
+    interval: [10],
+    bursts: [500],
+  });
+
+  function main({ idleTasks, interval, bursts }) {
+    const execArgv = idleTasks === 'true' ? ['--experimental-idle-tasks'] : [];
+    const start = process.hrtime.bigint();
+    const child = fork(__filename, ['child', bursts, interval], { execArgv });
+    child.on('message', (p99) => {
+      bench.report(1e3 / p99, process.hrtime.bigint() - start);
+    });
+  }
+}
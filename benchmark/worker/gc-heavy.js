@@ -0,0 +1,37 @@
+'use strict';
+
+// Runs allocation-heavy code on several threads at once. Concurrent marking,
+// sweeping and compilation tasks of all isolates share the platform worker
+// pool, so this measures how well the pool copes with many busy isolates.
+
+const common = require('../common.js');
+const { Worker } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  workers: [1, 4, 16],
+  n: [2e6],
+});
+
+const churn = `
+const { parentPort, workerData } = require('worker_threads');
+const live = [];
+for (let i = 0; i < workerData; i++) {
+  const obj = { i, payload: new Array(16).fill(i), name: 'item' + i };
+  live[i % 4096] = obj;
+}
+parentPort.postMessage(live.length);
+`;
+
+function main({ workers, n }) {
+  const perWorker = Math.ceil(n / workers);
+  let pending = workers;
+
+  bench.start();
+  for (let i = 0; i < workers; i++) {
+    const worker = new Worker(churn, { eval: true, workerData: perWorker });
+    worker.on('message', () => {
+      if (--pending === 0)
+        bench.end(perWorker * workers);
+    });
+  }
+}
@@ -0,0 +1,70 @@
+'use strict';
+
+// Many workers post small messages to the main thread as fast as they can.
+// With `channel=broadcast` they all post into one BroadcastChannel, so that
+// the incoming queue of a single port is filled by many threads at once. Like
+// every BroadcastChannel, the producers' own channels receive those messages
+// as well.
+
+const common = require('../common.js');
+const { BroadcastChannel, Worker } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  channel: ['port', 'broadcast'],
+  producers: [1, 4, 16],
+  n: [1e6],
+});
+
+const producer = `
+const { BroadcastChannel, parentPort, workerData } = require('worker_threads');
+const { channel, count } = workerData;
+const port = channel === 'broadcast' ?
+  new BroadcastChannel('bench-fanin') : parentPort;
+parentPort.once('message', () => {
+  for (let i = 0; i < count; i++)
+    port.postMessage(i);
+  if (port !== parentPort)
+    port.close();
+});
+`;
+
+function main({ channel, producers, n }) {
+  const count = Math.ceil(n / producers);
+  const total = count * producers;
+  const workers = [];
+  let online = 0;
+  let received = 0;
+
+  function onMessage() {
+    if (++received === total) {
+      bench.end(total);
+      if (broadcast)
+        broadcast.close();
+      for (const worker of workers)
+        worker.terminate();
+    }
+  }
+
+  let broadcast;
+  if (channel === 'broadcast') {
+    broadcast = new BroadcastChannel('bench-fanin');
+    broadcast.onmessage = onMessage;
+  }
+
+  for (let i = 0; i < producers; i++) {
+    const worker = new Worker(producer, {
+      eval: true,
+      workerData: { channel, count },
+    });
+    workers.push(worker);
+    if (!broadcast)
+      worker.on('message', onMessage);
+    worker.on('online', () => {
+      if (++online < producers)
+        return;
+      bench.start();
+      for (const worker of workers)
+        worker.postMessage('go');
+    });
+  }
+}
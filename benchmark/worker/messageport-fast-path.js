@@ -0,0 +1,47 @@
+'use strict';
+
+// Sends small messages of the shapes that skip v8::ValueSerializer through a
+// MessageChannel and receives them synchronously, so only the cost of cloning
+// the message is measured.
+
+const common = require('../common.js');
+const { MessageChannel, receiveMessageOnPort } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  payload: ['number', 'string', 'object', 'array', 'typedarray', 'nested'],
+  n: [1e6],
+});
+
+function main({ payload, n }) {
+  let message;
+  switch (payload) {
+    case 'number':
+      message = 42;
+      break;
+    case 'string':
+      message = 'the quick brown fox';
+      break;
+    case 'object':
+      message = { id: 1, op: 'update', key: 'counter', value: 3.5 };
+      break;
+    case 'array':
+      message = [1, 2, 3, 'four', 'five', true, null];
+      break;
+    case 'typedarray':
+      message = new Float64Array(16);
+      break;
+    case 'nested':
+      // Still goes through v8::ValueSerializer.
+      message = { id: 1, op: 'update', meta: { key: 'counter' } };
+      break;
+  }
+
+  const { port1, port2 } = new MessageChannel();
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    port1.postMessage(message);
+    receiveMessageOnPort(port2);
+  }
+  bench.end(n);
+  port1.close();
+}
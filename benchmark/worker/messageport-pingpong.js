@@ -0,0 +1,39 @@
+'use strict';
+
+// Bounces small messages between the main thread and a worker. `inflight`
+// messages are on their way at any time, so with more than one of them both
+// sides keep posting while the other one is still receiving.
+
+const common = require('../common.js');
+const { Worker } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  inflight: [1, 64],
+  n: [5e5],
+});
+
+const echo = `
+const { parentPort } = require('worker_threads');
+parentPort.on('message', (msg) => parentPort.postMessage(msg));
+`;
+
+function main({ inflight, n }) {
+  const worker = new Worker(echo, { eval: true });
+  let sent = 0;
+  let received = 0;
+
+  worker.on('message', () => {
+    if (++received === n) {
+      bench.end(n);
+      worker.terminate();
+    } else if (sent < n) {
+      worker.postMessage(sent++);
+    }
+  });
+
+  worker.on('online', () => {
+    bench.start();
+    for (; sent < inflight; sent++)
+      worker.postMessage(sent);
+  });
+}
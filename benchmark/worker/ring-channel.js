@@ -0,0 +1,70 @@
+'use strict';
+
+// Streams records of `size` bytes from a worker to the main thread, either
+// through a RingChannel or by posting them to a MessagePort.
+
+const common = require('../common.js');
+const { MessageChannel, RingChannel, Worker } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  channel: ['ring', 'port'],
+  size: [64, 4096, 65536],
+  bytes: [64 * 1024 * 1024],
+});
+
+const producer = `
+const { workerData } = require('worker_threads');
+const { channel, port, writer, size, count } = workerData;
+const record = Buffer.alloc(size, 'x');
+if (channel === 'port') {
+  for (let i = 0; i < count; i++)
+    port.postMessage(record);
+  port.close();
+} else {
+  let i = 0;
+  (function writeMore() {
+    for (; i < count; i++) {
+      if (!writer.write(record))
+        return writer.once('drain', writeMore);
+    }
+    writer.close();
+  })();
+}
+`;
+
+function main({ channel, size, bytes }) {
+  const count = Math.floor(bytes / size);
+  let received = 0;
+
+  if (channel === 'port') {
+    const { port1, port2 } = new MessageChannel();
+    port1.on('message', () => {
+      if (++received === count) {
+        bench.end(bytes / (1024 * 1024));
+        port1.close();
+      }
+    });
+    bench.start();
+    new Worker(producer, {
+      eval: true,
+      workerData: { channel, port: port2, size, count },
+      transferList: [port2],
+    });
+  } else {
+    const { reader, writer } = new RingChannel({ capacity: 4 * 1024 * 1024 });
+    reader.on('readable', () => {
+      while (reader.read() !== null)
+        received++;
+    });
+    reader.on('end', () => {
+      bench.end(bytes / (1024 * 1024));
+      reader.close();
+    });
+    bench.start();
+    new Worker(producer, {
+      eval: true,
+      workerData: { channel, writer, size, count },
+    });
+    writer.close();
+  }
+}
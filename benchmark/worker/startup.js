@@ -0,0 +1,34 @@
+'use strict';
+
+// Starts a pool of workers at once and measures how long it takes until all of
+// them are online. Concurrently starting workers compile the same built-in
+// modules, so this also measures how well they share the code cache.
+
+const common = require('../common.js');
+const { Worker } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  workers: [1, 8, 32],
+  n: [4],
+});
+
+function startPool(workers, callback) {
+  let pending = workers;
+  for (let i = 0; i < workers; i++) {
+    const worker = new Worker('', { eval: true });
+    worker.on('exit', () => {
+      if (--pending === 0)
+        callback();
+    });
+  }
+}
+
+function main({ workers, n }) {
+  let round = 0;
+  bench.start();
+  (function next() {
+    if (round++ === n)
+      return bench.end(workers * n);
+    startPool(workers, next);
+  })();
+}
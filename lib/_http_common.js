@@ -29,6 +29,7 @@ const {
 const { setImmediate } = require('timers');
 
 const { methods, HTTPParser } = internalBinding('http_parser');
+const { FastBuffer } = require('internal/buffer');
 const { getOptionValue } = require('internal/options');
 const insecureHTTPParser = getOptionValue('--insecure-http-parser');
 
@@ -48,6 +49,9 @@ const kOnBody = HTTPParser.kOnBody | 0;
 const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
 const kOnExecute = HTTPParser.kOnExecute | 0;
 const kOnTimeout = HTTPParser.kOnTimeout | 0;
+const kOnEvents = HTTPParser.kOnEvents | 0;
+const kEventShouldKeepAlive = HTTPParser.kEventShouldKeepAlive | 0;
+const kEventHasHeaders = HTTPParser.kEventHasHeaders | 0;
 
 const MAX_HEADER_PAIRS = 2000;
 
@@ -154,6 +158,63 @@ function parserOnMessageComplete() {
   readStart(parser.socket);
 }
 
+// Parsers that were initialized with `batchEvents` record everything that
+// happened during one execute() call and hand it over in one go. `events` is
+// the event log, `values` holds the headers and URLs it refers to, and the
+// body chunks are slices of `body`. For data read from a consumed stream,
+// `ret` is the result of the execute() call, which is passed on to
+// parser[kOnExecute] once the events have been handled.
+function parserOnEvents(events, values, body, ret) {
+  const parser = this;
+  let v = 0;
+
+  for (let i = 0; i < events.length;) {
+    switch (events[i++]) {
+      case kOnMessageBegin: {
+        const onMessageBegin = parser[kOnMessageBegin];
+        if (typeof onMessageBegin === 'function')
+          onMessageBegin.call(parser);
+        break;
+      }
+      case kOnHeaders:
+        parser[kOnHeaders](values[v++], values[v++]);
+        break;
+      case kOnHeadersComplete: {
+        const versionMajor = events[i++];
+        const versionMinor = events[i++];
+        const method = events[i++];
+        const flags = events[i++];
+        let headers;
+        let url;
+        if ((flags & kEventHasHeaders) !== 0) {
+          headers = values[v++];
+          url = values[v++];
+        }
+        // Upgrade requests are never batched.
+        parser[kOnHeadersComplete](versionMajor, versionMinor, headers, method,
+                                   url, undefined, undefined, false,
+                                   (flags & kEventShouldKeepAlive) !== 0);
+        break;
+      }
+      case kOnBody: {
+        const offset = events[i++];
+        const length = events[i++];
+        parser[kOnBody](new FastBuffer(body, offset, length));
+        break;
+      }
+      case kOnMessageComplete:
+        parser[kOnMessageComplete]();
+        break;
+    }
+  }
+
+  if (ret !== undefined) {
+    const onExecute = parser[kOnExecute];
+    if (typeof onExecute === 'function')
+      onExecute.call(parser, ret);
+  }
+}
+
 
 const parsers = new FreeList('parsers', 1000, function parsersCb() {
   const parser = new HTTPParser();
@@ -164,6 +225,7 @@ const parsers = new FreeList('parsers', 1000, function parsersCb() {
   parser[kOnHeadersComplete] = parserOnHeadersComplete;
   parser[kOnBody] = parserOnBody;
   parser[kOnMessageComplete] = parserOnMessageComplete;
+  parser[kOnEvents] = parserOnEvents;
 
   return parser;
 });
@@ -29,16 +29,19 @@ const {
   NumberPrototypeToString,
   ObjectCreate,
   ObjectDefineProperty,
+  ObjectFreeze,
   ObjectKeys,
   ObjectValues,
   ObjectPrototypeHasOwnProperty,
   ObjectSetPrototypeOf,
+  ArrayPrototypePush,
   RegExpPrototypeExec,
   SafeSet,
   StringPrototypeToLowerCase,
   Symbol,
 } = primordials;
 
+const { serializeHeaders } = internalBinding('http_parser');
 const { getDefaultHighWaterMark } = require('internal/streams/state');
 const assert = require('internal/assert');
 const EE = require('events');
@@ -84,6 +87,9 @@ const HIGH_WATER_MARK = getDefaultHighWaterMark();
 
 const kCorked = Symbol('corked');
 const kUniqueHeaders = Symbol('kUniqueHeaders');
+const kFrozenFields = Symbol('kFrozenFields');
+const kFrozenHeader = Symbol('kFrozenHeader');
+const kFrozenMatches = Symbol('kFrozenMatches');
 
 const nop = () => {};
 
@@ -380,6 +386,26 @@ function _writeRaw(data, encoding, callback) {
 }
 
 
+// Header fields that are validated and serialized once, so that they can be
+// passed to response.writeHead() over and over again.
+class FrozenHeaders {
+  constructor(headers) {
+    if (headers === null || typeof headers !== 'object') {
+      throw new ERR_INVALID_ARG_TYPE('headers', ['Object', 'Array'], headers);
+    }
+    const fields = flattenHeaders(null, headers);
+    const matches = [];
+    for (let i = 0; i < fields.length; i += 2) {
+      if (fields[i].length >= 4 && fields[i].length <= 17)
+        ArrayPrototypePush(matches, fields[i], fields[i + 1]);
+    }
+    this[kFrozenHeader] = serializeFields(fields);
+    this[kFrozenFields] = ObjectFreeze(fields);
+    this[kFrozenMatches] = matches;
+    ObjectFreeze(this);
+  }
+}
+
 OutgoingMessage.prototype._storeHeader = _storeHeader;
 function _storeHeader(firstLine, headers) {
   // firstLine in the case of request is: 'GET /index.html HTTP/1.1\r\n'
@@ -398,29 +424,18 @@ function _storeHeader(firstLine, headers) {
     if (headers === this[kOutHeaders]) {
       for (const key in headers) {
         const entry = headers[key];
-        processHeader(this, state, entry[0], entry[1], false);
-      }
-    } else if (ArrayIsArray(headers)) {
-      if (headers.length && ArrayIsArray(headers[0])) {
-        for (let i = 0; i < headers.length; i++) {
-          const entry = headers[i];
-          processHeader(this, state, entry[0], entry[1], true);
-        }
-      } else {
-        if (headers.length % 2 !== 0) {
-          throw new ERR_INVALID_ARG_VALUE('headers', headers);
-        }
-
-        for (let n = 0; n < headers.length; n += 2) {
-          processHeader(this, state, headers[n + 0], headers[n + 1], true);
-        }
+        processHeader(this, state, entry[0], entry[1]);
       }
+    } else if (headers instanceof FrozenHeaders) {
+      state.header += headers[kFrozenHeader];
+      const matches = headers[kFrozenMatches];
+      for (let i = 0; i < matches.length; i += 2)
+        matchHeader(this, state, matches[i], matches[i + 1]);
     } else {
-      for (const key in headers) {
-        if (ObjectPrototypeHasOwnProperty(headers, key)) {
-          processHeader(this, state, key, headers[key], true);
-        }
-      }
+      const fields = flattenHeaders(this, headers);
+      state.header += serializeFields(fields);
+      for (let i = 0; i < fields.length; i += 2)
+        matchHeader(this, state, fields[i], fields[i + 1]);
     }
   }
 
@@ -508,9 +523,9 @@ function _storeHeader(firstLine, headers) {
   if (state.expect) this._send('');
 }
 
-function processHeader(self, state, key, value, validate) {
-  if (validate)
-    validateHeaderName(key);
+// Stores headers that have already been validated by setHeader() and
+// friends.
+function processHeader(self, state, key, value) {
   if (ArrayIsArray(value)) {
     if (
       (value.length < 2 || !isCookieField(key)) &&
@@ -519,21 +534,89 @@ function processHeader(self, state, key, value, validate) {
       // Retain for(;;) loop for performance reasons
       // Refs: https://github.com/nodejs/node/pull/30958
       for (let i = 0; i < value.length; i++)
-        storeHeader(self, state, key, value[i], validate);
+        storeHeader(self, state, key, value[i]);
       return;
     }
     value = ArrayPrototypeJoin(value, '; ');
   }
-  storeHeader(self, state, key, value, validate);
+  storeHeader(self, state, key, value);
 }
 
-function storeHeader(self, state, key, value, validate) {
-  if (validate)
-    validateHeaderValue(key, value);
+function storeHeader(self, state, key, value) {
   state.header += key + ': ' + value + '\r\n';
   matchHeader(self, state, key, value);
 }
 
+// Turns the `headers` argument of writeHead() and friends (an object, an
+// array of [name, value] pairs or a flat array) into a flat
+// [name, value, ...] array with one entry per header line.
+function flattenHeaders(self, headers) {
+  const fields = [];
+  if (ArrayIsArray(headers)) {
+    if (headers.length && ArrayIsArray(headers[0])) {
+      for (let i = 0; i < headers.length; i++) {
+        const entry = headers[i];
+        flattenHeader(self, fields, entry[0], entry[1]);
+      }
+    } else {
+      if (headers.length % 2 !== 0) {
+        throw new ERR_INVALID_ARG_VALUE('headers', headers);
+      }
+
+      for (let n = 0; n < headers.length; n += 2) {
+        flattenHeader(self, fields, headers[n + 0], headers[n + 1]);
+      }
+    }
+  } else {
+    for (const key in headers) {
+      if (ObjectPrototypeHasOwnProperty(headers, key)) {
+        flattenHeader(self, fields, key, headers[key]);
+      }
+    }
+  }
+  return fields;
+}
+
+function flattenHeader(self, fields, key, value) {
+  if (typeof key !== 'string')
+    validateHeaderName(key);
+  if (ArrayIsArray(value)) {
+    if (
+      (value.length < 2 || !isCookieField(key)) &&
+      (!self?.[kUniqueHeaders] || !self[kUniqueHeaders].has(StringPrototypeToLowerCase(key)))
+    ) {
+      // Retain for(;;) loop for performance reasons
+      // Refs: https://github.com/nodejs/node/pull/30958
+      for (let i = 0; i < value.length; i++)
+        pushField(fields, key, value[i]);
+      return;
+    }
+    value = ArrayPrototypeJoin(value, '; ');
+  }
+  pushField(fields, key, value);
+}
+
+function pushField(fields, key, value) {
+  // Values are written the same way string concatenation would write them.
+  // `undefined` is kept so that validation can reject it.
+  if (typeof value !== 'string' && value !== undefined)
+    value = '' + value;
+  ArrayPrototypePush(fields, key, value);
+}
+
+// Validates a flat [name, value, ...] array and returns the header lines for
+// it. The serialization happens in C++; when it rejects an entry, the JS
+// validators run on that entry to throw the appropriate error.
+function serializeFields(fields) {
+  const result = serializeHeaders(fields);
+  if (typeof result === 'string')
+    return result;
+  validateHeaderName(fields[result]);
+  validateHeaderValue(fields[result], fields[result + 1]);
+  // Unreachable as long as both sides agree on what is valid.
+  throw new ERR_INVALID_CHAR('header content', fields[result]);
+}
+
 function matchHeader(self, state, field, value) {
   if (field.length < 4 || field.length > 17)
     return;
@@ -1078,6 +1161,8 @@ function(err, event) {
 };
 
 module.exports = {
+  FrozenHeaders,
+  kFrozenFields,
   kUniqueHeaders,
   parseUniqueHeadersOption,
   validateHeaderName,
@@ -48,6 +48,8 @@ const {
 } = require('_http_common');
 const { ConnectionsList } = internalBinding('http_parser');
 const {
+  FrozenHeaders,
+  kFrozenFields,
   kUniqueHeaders,
   parseUniqueHeadersOption,
   OutgoingMessage
@@ -333,6 +335,14 @@ function writeHead(statusCode, reason, obj) {
         k = obj[n + 0];
         if (k) this.setHeader(k, obj[n + 1]);
       }
+    } else if (obj instanceof FrozenHeaders) {
+      const fields = obj[kFrozenFields];
+      for (let n = 0; n < fields.length; n += 2)
+        this.removeHeader(fields[n]);
+      for (let n = 0; n < fields.length; n += 2) {
+        k = fields[n];
+        this.appendHeader(k, fields[n + 1]);
+      }
     } else if (obj) {
       const keys = ObjectKeys(obj);
       // Retain for(;;) loop for performance reasons
@@ -595,6 +605,7 @@ function connectionListenerInternal(server, socket) {
     server.maxHeaderSize || 0,
     lenient ? kLenientAll : kLenientNone,
     server[kConnections],
+    true,  // Batch the parser events of each read into one callback.
   );
   parser.socket = socket;
   socket.parser = parser;
@@ -108,6 +108,7 @@ const kHandshakeTimeout = Symbol('handshake-timeout');
 const kRes = Symbol('res');
 const kSNICallback = Symbol('snicallback');
 const kEnableTrace = Symbol('enableTrace');
+const kEnableKTLS = Symbol('enableKTLS');
 const kPskCallback = Symbol('pskcallback');
 const kPskIdentityHint = Symbol('pskidentityhint');
 const kPendingSession = Symbol('pendingSession');
@@ -482,6 +483,9 @@ function TLSSocket(socket, opts) {
     validateBoolean(enableTrace, 'options.enableTrace');
   }
 
+  if (tlsOptions.enableKTLS != null)
+    validateBoolean(tlsOptions.enableKTLS, 'options.enableKTLS');
+
   if (tlsOptions.ALPNProtocols)
     tls.convertALPNProtocols(tlsOptions.ALPNProtocols, tlsOptions);
 
@@ -807,6 +811,9 @@ TLSSocket.prototype._init = function(socket, wrap) {
     }
   }
 
+  // Has no effect where kernel TLS is not supported.
+  if (options.enableKTLS)
+    ssl.enableKTLS();
 
   if (options.handshakeTimeout > 0)
     this.setTimeout(options.handshakeTimeout, this._handleTimeout);
@@ -1102,6 +1109,7 @@ function tlsConnectionListener(rawSocket) {
     ALPNProtocols: this.ALPNProtocols,
     SNICallback: this[kSNICallback] || SNICallback,
     enableTrace: this[kEnableTrace],
+    enableKTLS: this[kEnableKTLS],
     pauseOnConnect: this.pauseOnConnect,
     pskCallback: this[kPskCallback],
     pskIdentityHint: this[kPskIdentityHint],
@@ -1242,6 +1250,7 @@ function Server(options, listener) {
   }
 
   this[kEnableTrace] = options.enableTrace;
+  this[kEnableKTLS] = options.enableKTLS;
 }
 
 ObjectSetPrototypeOf(Server.prototype, net.Server.prototype);
@@ -1331,8 +1340,13 @@ Server.prototype.setSecureContext = function(options) {
   else
     this.secureOptions = undefined;
 
+  this.sessionStore = options.sessionStore;
+
   if (options.sessionIdContext) {
     this.sessionIdContext = options.sessionIdContext;
+  } else if (this.sessionStore) {
+    // Use the session ID context of the store.
+    this.sessionIdContext = undefined;
   } else {
     this.sessionIdContext = StringPrototypeSlice(
       crypto.createHash('sha1')
@@ -1367,6 +1381,7 @@ Server.prototype.setSecureContext = function(options) {
     honorCipherOrder: this.honorCipherOrder,
     crl: this.crl,
     sessionIdContext: this.sessionIdContext,
+    sessionStore: this.sessionStore,
     ticketKeys: this.ticketKeys,
     sessionTimeout: this.sessionTimeout,
     privateKeyIdentifier: this.privateKeyIdentifier,
@@ -1639,6 +1654,7 @@ exports.connect = function connect(...args) {
     ALPNProtocols: options.ALPNProtocols,
     requestOCSP: options.requestOCSP,
     enableTrace: options.enableTrace,
+    enableKTLS: options.enableKTLS,
     pskCallback: options.pskCallback,
     highWaterMark: options.highWaterMark,
     onread: options.onread,
@@ -55,11 +55,14 @@ const {
   byteLengthUtf8,
   compare: _compare,
   compareOffset,
+  copy: bindingCopy,
   createFromString,
   fill: bindingFill,
   indexOfBuffer,
   indexOfNumber,
   indexOfString,
+  isAscii: bindingIsAscii,
+  isUtf8: bindingIsUtf8,
   swap16: _swap16,
   swap32: _swap32,
   swap64: _swap64,
@@ -83,6 +86,7 @@ const {
 const {
   isAnyArrayBuffer,
   isArrayBufferView,
+  isTypedArray,
   isUint8Array
 } = require('internal/util/types');
 const {
@@ -253,12 +257,11 @@ function _copyActual(source, target, targetStart, sourceStart, sourceEnd) {
   if (nb > sourceLen)
     nb = sourceLen;
 
-  if (sourceStart !== 0 || sourceEnd < source.length)
-    source = new Uint8Array(source.buffer, source.byteOffset + sourceStart, nb);
-
-  TypedArrayPrototypeSet(target, source, targetStart);
+  if (nb <= 0)
+    return 0;
 
-  return nb;
+  return bindingCopy(source, target, targetStart, sourceStart,
+                     sourceStart + nb);
 }
 
 /**
@@ -1149,7 +1152,8 @@ Buffer.prototype.swap16 = function swap16() {
       swap(this, i, i + 1);
     return this;
   }
-  return _swap16(this);
+  _swap16(this);
+  return this;
 };
 
 Buffer.prototype.swap32 = function swap32() {
@@ -1166,7 +1170,8 @@ Buffer.prototype.swap32 = function swap32() {
     }
     return this;
   }
-  return _swap32(this);
+  _swap32(this);
+  return this;
 };
 
 Buffer.prototype.swap64 = function swap64() {
@@ -1185,7 +1190,8 @@ Buffer.prototype.swap64 = function swap64() {
     }
     return this;
   }
-  return _swap64(this);
+  _swap64(this);
+  return this;
 };
 
 Buffer.prototype.toLocaleString = Buffer.prototype.toString;
@@ -1292,12 +1298,30 @@ function atob(input) {
   return Buffer.from(input, 'base64').toString('latin1');
 }
 
+function isUtf8(input) {
+  if (isTypedArray(input) || isAnyArrayBuffer(input)) {
+    return bindingIsUtf8(input);
+  }
+
+  throw new ERR_INVALID_ARG_TYPE('input', ['ArrayBuffer', 'Buffer', 'TypedArray'], input);
+}
+
+function isAscii(input) {
+  if (isTypedArray(input) || isAnyArrayBuffer(input)) {
+    return bindingIsAscii(input);
+  }
+
+  throw new ERR_INVALID_ARG_TYPE('input', ['ArrayBuffer', 'Buffer', 'TypedArray'], input);
+}
+
 module.exports = {
   Blob,
   resolveObjectURL,
   Buffer,
   SlowBuffer,
   transcode,
+  isUtf8,
+  isAscii,
   // Legacy
   kMaxLength,
   kStringMaxLength,
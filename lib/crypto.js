@@ -106,7 +106,10 @@ const {
 } = require('internal/crypto/sig');
 const {
   Hash,
-  Hmac
+  Hmac,
+  hash,
+  hashBatch,
+  hashBatchSync,
 } = require('internal/crypto/hash');
 const {
   X509Certificate
@@ -204,6 +207,9 @@ module.exports = {
   getCurves,
   getDiffieHellman: createDiffieHellmanGroup,
   getHashes,
+  hash,
+  hashBatch,
+  hashBatchSync,
   hkdf,
   hkdfSync,
   pbkdf2,
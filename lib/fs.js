@@ -387,6 +387,21 @@ function checkAborted(signal, callback) {
 function readFile(path, options, callback) {
   callback = maybeCallback(callback || options);
   options = getOptions(options, { flag: 'r' });
+
+  if (!isFd(path) && !options.signal) {
+    // Open, read, close and decode in a single request on the threadpool.
+    const flagsNumber = stringToFlags(options.flag, 'options.flag');
+    path = getValidatedPath(path);
+
+    const req = new FSReqCallback();
+    req.oncomplete = callback;
+    binding.readFile(pathModule.toNamespacedPath(path),
+                     flagsNumber,
+                     options.encoding,
+                     req);
+    return;
+  }
+
   const context = new ReadFileContext(callback, options.encoding);
   context.isUserFd = isFd(path); // File descriptor ownership
 
@@ -464,7 +479,20 @@ function tryReadSync(fd, isUserFd, buffer, pos, len) {
 function readFileSync(path, options) {
   options = getOptions(options, { flag: 'r' });
   const isUserFd = isFd(path); // File descriptor ownership
-  const fd = isUserFd ? path : fs.openSync(path, options.flag, 0o666);
+
+  if (!isUserFd) {
+    path = getValidatedPath(path);
+    const ctx = { path };
+    const result = binding.readFile(pathModule.toNamespacedPath(path),
+                                    stringToFlags(options.flag),
+                                    options.encoding,
+                                    undefined,
+                                    ctx);
+    handleErrorFromBinding(ctx);
+    return result;
+  }
+
+  const fd = path;
 
   const stats = tryStatSync(fd, isUserFd);
   const size = isFileType(stats, S_IFREG) ? stats[8] : 0;
@@ -498,9 +526,6 @@ function readFileSync(path, options) {
     } while (bytesRead !== 0);
   }
 
-  if (!isUserFd)
-    fs.closeSync(fd);
-
   if (size === 0) {
     // Data was collected into the buffers list.
     buffer = Buffer.concat(buffers, pos);
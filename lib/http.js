@@ -33,6 +33,7 @@ const { ClientRequest } = require('_http_client');
 const { methods, parsers } = require('_http_common');
 const { IncomingMessage } = require('_http_incoming');
 const {
+  FrozenHeaders,
   validateHeaderName,
   validateHeaderValue,
   OutgoingMessage
@@ -116,6 +117,7 @@ module.exports = {
   STATUS_CODES,
   Agent: httpAgent.Agent,
   ClientRequest,
+  FrozenHeaders,
   IncomingMessage,
   OutgoingMessage,
   Server,
@@ -1,16 +1,25 @@
 'use strict';
 
 const {
+  Array,
+  ArrayIsArray,
+  FunctionPrototypeCall,
   ObjectSetPrototypeOf,
   ReflectApply,
+  StringPrototypeToLowerCase,
   Symbol,
+  Uint32Array,
+  Uint8Array,
 } = primordials;
 
 const {
   Hash: _Hash,
+  HashBatchJob,
   HashJob,
   Hmac: _Hmac,
   kCryptoJobAsync,
+  kCryptoJobSync,
+  oneShotDigest,
 } = internalBinding('crypto');
 
 const {
@@ -30,6 +39,7 @@ const {
 
 const {
   lazyDOMException,
+  normalizeEncoding,
 } = require('internal/util');
 
 const {
@@ -41,16 +51,21 @@ const {
     ERR_CRYPTO_HASH_FINALIZED,
     ERR_CRYPTO_HASH_UPDATE_FAILED,
     ERR_INVALID_ARG_TYPE,
-  }
+    ERR_INVALID_ARG_VALUE,
+  },
+  hideStackFrames,
 } = require('internal/errors');
 
 const {
   validateEncoding,
+  validateFunction,
+  validateInteger,
   validateString,
   validateUint32,
 } = require('internal/validators');
 
 const {
+  isAnyArrayBuffer,
   isArrayBufferView,
 } = require('internal/util/types');
 
@@ -165,6 +180,90 @@ Hmac.prototype.digest = function digest(outputEncoding) {
 Hmac.prototype._flush = Hash.prototype._flush;
 Hmac.prototype._transform = Hash.prototype._transform;
 
+function hash(algorithm, data, outputEncoding = 'hex') {
+  validateString(algorithm, 'algorithm');
+  if (typeof data !== 'string' && !isArrayBufferView(data)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'data', ['string', 'Buffer', 'TypedArray', 'DataView'], data);
+  }
+  let normalized = outputEncoding;
+  // 'hex' is by far the most common case, and does not need to be normalized.
+  if (outputEncoding !== 'hex') {
+    validateString(outputEncoding, 'outputEncoding');
+    normalized = normalizeEncoding(outputEncoding);
+    if (normalized === undefined) {
+      // normalizeEncoding() does not know about 'buffer'.
+      if (StringPrototypeToLowerCase(outputEncoding) !== 'buffer')
+        throw new ERR_INVALID_ARG_VALUE('outputEncoding', outputEncoding);
+      normalized = 'buffer';
+    }
+  }
+  return oneShotDigest(algorithm, data, normalized);
+}
+
+// Returns the arguments for a HashBatchJob after the algorithm: either an array
+// of ArrayBufferViews, or a buffer and the offsets at which the inputs start.
+const validateBatchParameters = hideStackFrames((algorithm, data, offsets) => {
+  validateString(algorithm, 'algorithm');
+
+  if (ArrayIsArray(data)) {
+    if (offsets !== undefined) {
+      throw new ERR_INVALID_ARG_VALUE(
+        'offsets', offsets, 'must be undefined when data is an array');
+    }
+    const inputs = new Array(data.length);
+    for (let i = 0; i < data.length; i++) {
+      const input = getArrayBufferOrView(data[i], `data[${i}]`);
+      inputs[i] = isAnyArrayBuffer(input) ? new Uint8Array(input) : input;
+    }
+    return [inputs, undefined];
+  }
+
+  data = getArrayBufferOrView(data, 'data');
+  const { byteLength } = data;
+  if (offsets === undefined) {
+    // A single input.
+    offsets = [0];
+  } else if (!ArrayIsArray(offsets) && !isArrayBufferView(offsets)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'offsets', ['Array', 'TypedArray'], offsets);
+  }
+  const starts = new Uint32Array(offsets.length);
+  let previous = 0;
+  for (let i = 0; i < offsets.length; i++) {
+    validateInteger(offsets[i], `offsets[${i}]`, previous, byteLength);
+    starts[i] = previous = offsets[i];
+  }
+  return [data, starts];
+});
+
+function hashBatch(algorithm, data, offsets, callback) {
+  if (typeof offsets === 'function') {
+    callback = offsets;
+    offsets = undefined;
+  }
+  const { 0: inputs, 1: starts } =
+    validateBatchParameters(algorithm, data, offsets);
+  validateFunction(callback, 'callback');
+
+  const job = new HashBatchJob(kCryptoJobAsync, algorithm, inputs, starts);
+  job.ondone = (error, digests) => {
+    if (error) return FunctionPrototypeCall(callback, job, error);
+    FunctionPrototypeCall(callback, job, null, Buffer.from(digests));
+  };
+  job.run();
+}
+
+function hashBatchSync(algorithm, data, offsets) {
+  const { 0: inputs, 1: starts } =
+    validateBatchParameters(algorithm, data, offsets);
+  const job = new HashBatchJob(kCryptoJobSync, algorithm, inputs, starts);
+  const { 0: err, 1: digests } = job.run();
+  if (err !== undefined)
+    throw err;
+  return Buffer.from(digests);
+}
+
 // Implementation for WebCrypto subtle.digest()
 
 async function asyncDigest(algorithm, data) {
@@ -197,4 +296,7 @@ module.exports = {
   Hash,
   Hmac,
   asyncDigest,
+  hash,
+  hashBatch,
+  hashBatchSync,
 };
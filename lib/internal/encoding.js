@@ -29,6 +29,7 @@ const kFlags = Symbol('flags');
 const kEncoding = Symbol('encoding');
 const kDecoder = Symbol('decoder');
 const kEncoder = Symbol('encoder');
+const kUTF8FastPath = Symbol('kUTF8FastPath');
 
 const {
   getConstructorOf,
@@ -50,7 +51,8 @@ const {
 
 const {
   encodeInto,
-  encodeUtf8String
+  encodeUtf8String,
+  decodeUTF8,
 } = internalBinding('buffer');
 
 let Buffer;
@@ -406,6 +408,10 @@ function makeTextDecoderICU() {
       this[kHandle] = handle;
       this[kFlags] = flags;
       this[kEncoding] = enc;
+      // Whole UTF-8 inputs are decoded without the ICU converter until the
+      // decoder is used for streaming, after which the converter owns the
+      // state.
+      this[kUTF8FastPath] = enc === 'utf-8';
     }
 
 
@@ -424,6 +430,18 @@ function makeTextDecoderICU() {
         allowFunction: true,
       });
 
+      this[kUTF8FastPath] &&= !(options?.stream);
+
+      if (this[kUTF8FastPath]) {
+        const ret = decodeUTF8(input,
+                               (this[kFlags] & CONVERTER_FLAGS_IGNORE_BOM) !== 0,
+                               (this[kFlags] & CONVERTER_FLAGS_FATAL) !== 0);
+        if (ret !== undefined)
+          return ret;
+        // The input is malformed. Let the converter decode it again, so that
+        // the error carries the same errno as it does without the fast path.
+      }
+
       let flags = 0;
       if (options !== null)
         flags |= options.stream ? 0 : CONVERTER_FLAGS_FLUSH;
@@ -2,7 +2,11 @@
 
 // This file is a modified version of the fs-extra's copySync method.
 
-const { areIdentical, isSrcSubdir } = require('internal/fs/cp/cp');
+const {
+  areIdentical,
+  isSrcSubdir,
+  throwUnsupportedFileType,
+} = require('internal/fs/cp/cp');
 const { codes } = require('internal/errors');
 const {
   os: {
@@ -12,17 +16,21 @@ const {
       EINVAL,
       ENOTDIR,
     }
-  }
+  },
+  fs: {
+    UV_DIRENT_FIFO,
+    UV_DIRENT_SOCKET,
+    UV_DIRENT_UNKNOWN,
+  },
 } = internalBinding('constants');
+const binding = internalBinding('fs');
+const { handleErrorFromBinding } = require('internal/fs/utils');
 const {
   ERR_FS_CP_DIR_TO_NON_DIR,
   ERR_FS_CP_EEXIST,
   ERR_FS_CP_EINVAL,
-  ERR_FS_CP_FIFO_PIPE,
   ERR_FS_CP_NON_DIR_TO_DIR,
-  ERR_FS_CP_SOCKET,
   ERR_FS_CP_SYMLINK_TO_SUBDIRECTORY,
-  ERR_FS_CP_UNKNOWN,
   ERR_FS_EISDIR,
   ERR_INVALID_RETURN_VALUE,
 } = codes;
@@ -48,6 +56,8 @@ const {
 } = require('path');
 const { isPromise } = require('util/types');
 
+const isWindows = process.platform === 'win32';
+
 function cpSyncFn(src, dest, opts) {
   // Warn about using preserveTimestamps on 32-bit node
   if (opts.preserveTimestamps && process.arch === 'ia32') {
@@ -184,29 +194,11 @@ function getStats(destStat, src, dest, opts) {
   } else if (srcStat.isSymbolicLink()) {
     return onLink(destStat, src, dest, opts);
   } else if (srcStat.isSocket()) {
-    throw new ERR_FS_CP_SOCKET({
-      message: `cannot copy a socket file: ${dest}`,
-      path: dest,
-      syscall: 'cp',
-      errno: EINVAL,
-      code: 'EINVAL',
-    });
+    throwUnsupportedFileType(UV_DIRENT_SOCKET, dest);
   } else if (srcStat.isFIFO()) {
-    throw new ERR_FS_CP_FIFO_PIPE({
-      message: `cannot copy a FIFO pipe: ${dest}`,
-      path: dest,
-      syscall: 'cp',
-      errno: EINVAL,
-      code: 'EINVAL',
-    });
+    throwUnsupportedFileType(UV_DIRENT_FIFO, dest);
   }
-  throw new ERR_FS_CP_UNKNOWN({
-    message: `cannot copy an unknown file type: ${dest}`,
-    path: dest,
-    syscall: 'cp',
-    errno: EINVAL,
-    code: 'EINVAL',
-  });
+  throwUnsupportedFileType(UV_DIRENT_UNKNOWN, dest);
 }
 
 function onFile(srcStat, destStat, src, dest, opts) {
@@ -270,7 +262,19 @@ function onDir(srcStat, destStat, src, dest, opts) {
 
 function mkDirAndCopy(srcMode, src, dest, opts) {
   mkdirSync(dest);
-  copyDir(src, dest, opts);
+  if (opts.filter === undefined && !isWindows) {
+    // Nothing exists below `dest` yet, so the whole tree can be copied
+    // without the checks that copyDir() makes for every entry.
+    const ctx = { path: src, dest };
+    const unsupported = binding.cpTree(src, dest, opts.dereference,
+                                       opts.preserveTimestamps,
+                                       opts.verbatimSymlinks, undefined, ctx);
+    handleErrorFromBinding(ctx);
+    if (unsupported !== undefined)
+      throwUnsupportedFileType(unsupported[0], unsupported[1]);
+  } else {
+    copyDir(src, dest, opts);
+  }
   return setDestMode(dest, srcMode);
 }
 
@@ -34,8 +34,15 @@ const {
       EINVAL,
       ENOTDIR,
     }
-  }
+  },
+  fs: {
+    UV_DIRENT_FIFO,
+    UV_DIRENT_SOCKET,
+    UV_DIRENT_UNKNOWN,
+  },
 } = internalBinding('constants');
+const binding = internalBinding('fs');
+const { kUsePromises } = binding;
 const {
   chmod,
   copyFile,
@@ -57,6 +64,8 @@ const {
   sep,
 } = require('path');
 
+const isWindows = process.platform === 'win32';
+
 async function cpFn(src, dest, opts) {
   // Warn about using preserveTimestamps on 32-bit node
   if (opts.preserveTimestamps && process.arch === 'ia32') {
@@ -224,6 +233,17 @@ async function getStatsForCopy(destStat, src, dest, opts) {
   } else if (srcStat.isSymbolicLink()) {
     return onLink(destStat, src, dest, opts);
   } else if (srcStat.isSocket()) {
+    throwUnsupportedFileType(UV_DIRENT_SOCKET, dest);
+  } else if (srcStat.isFIFO()) {
+    throwUnsupportedFileType(UV_DIRENT_FIFO, dest);
+  }
+  throwUnsupportedFileType(UV_DIRENT_UNKNOWN, dest);
+}
+
+// Throws the error for a source file of the given UV_DIRENT_* type that
+// cannot be copied to `dest`.
+function throwUnsupportedFileType(type, dest) {
+  if (type === UV_DIRENT_SOCKET) {
     throw new ERR_FS_CP_SOCKET({
       message: `cannot copy a socket file: ${dest}`,
       path: dest,
@@ -231,7 +251,7 @@ async function getStatsForCopy(destStat, src, dest, opts) {
       errno: EINVAL,
       code: 'EINVAL',
     });
-  } else if (srcStat.isFIFO()) {
+  } else if (type === UV_DIRENT_FIFO) {
     throw new ERR_FS_CP_FIFO_PIPE({
       message: `cannot copy a FIFO pipe: ${dest}`,
       path: dest,
@@ -320,7 +340,18 @@ function onDir(srcStat, destStat, src, dest, opts) {
 
 async function mkDirAndCopy(srcMode, src, dest, opts) {
   await mkdir(dest);
-  await copyDir(src, dest, opts);
+  if (opts.filter === undefined && !isWindows) {
+    // Nothing exists below `dest` yet, so the whole tree can be copied
+    // without the checks that copyDir() makes for every entry.
+    const unsupported = await binding.cpTree(src, dest, opts.dereference,
+                                             opts.preserveTimestamps,
+                                             opts.verbatimSymlinks,
+                                             kUsePromises);
+    if (unsupported !== undefined)
+      throwUnsupportedFileType(unsupported[0], unsupported[1]);
+  } else {
+    await copyDir(src, dest, opts);
+  }
   return setDestMode(dest, srcMode);
 }
 
@@ -393,4 +424,5 @@ module.exports = {
   areIdentical,
   cpFn,
   isSrcSubdir,
+  throwUnsupportedFileType,
 };
@@ -2,6 +2,7 @@
 
 const {
   ArrayPrototypePush,
+  ArrayPrototypeShift,
   ArrayPrototypeSlice,
   ArrayPrototypeSplice,
   FunctionPrototypeBind,
@@ -22,15 +23,19 @@ const {
   }
 } = require('internal/errors');
 
-const { FSReqCallback } = binding;
+const { FSReqCallback, kFsStatsFieldsNumber } = binding;
 const internalUtil = require('internal/util');
 const {
+  Dirent,
+  DirentWithStats,
   getDirent,
   getOptions,
   getValidatedPath,
-  handleErrorFromBinding
+  handleErrorFromBinding,
+  join,
 } = require('internal/fs/utils');
 const {
+  validateBoolean,
   validateFunction,
   validateUint32
 } = require('internal/validators');
@@ -44,6 +49,8 @@ const kDirReadImpl = Symbol('kDirReadImpl');
 const kDirReadPromisified = Symbol('kDirReadPromisified');
 const kDirClosePromisified = Symbol('kDirClosePromisified');
 const kDirOperationQueue = Symbol('kDirOperationQueue');
+const kDirWalk = Symbol('kDirWalk');
+const kDirGetDirents = Symbol('kDirGetDirents');
 
 class Dir {
   constructor(handle, path, options) {
@@ -57,14 +64,22 @@ class Dir {
     // once the current operation is done).
     this[kDirOperationQueue] = null;
 
+    options = getOptions(options, {
+      encoding: 'utf8'
+    });
+    // Entries that come with their stats are read in larger batches, so that
+    // walking a large tree takes few round trips to the threadpool.
+    this[kDirWalk] = options.recursive === true || options.withStats === true;
     this[kDirOptions] = {
-      bufferSize: 32,
-      ...getOptions(options, {
-        encoding: 'utf8'
-      })
+      bufferSize: this[kDirWalk] ? 1000 : 32,
+      recursive: false,
+      withStats: false,
+      ...options,
     };
 
     validateUint32(this[kDirOptions].bufferSize, 'options.bufferSize', true);
+    validateBoolean(this[kDirOptions].recursive, 'options.recursive');
+    validateBoolean(this[kDirOptions].withStats, 'options.withStats');
 
     this[kDirReadPromisified] = FunctionPrototypeBind(
       internalUtil.promisify(this[kDirReadImpl]), this, false);
@@ -98,6 +113,15 @@ class Dir {
       return;
     }
 
+    if (this[kDirWalk] && this[kDirBufferedEntries].length > 0) {
+      const dirent = ArrayPrototypeShift(this[kDirBufferedEntries]);
+      if (maybeSync)
+        process.nextTick(callback, null, dirent);
+      else
+        callback(null, dirent);
+      return;
+    }
+
     if (this[kDirBufferedEntries].length > 0) {
       const { 0: name, 1: type } =
         ArrayPrototypeSplice(this[kDirBufferedEntries], 0, 2);
@@ -120,16 +144,60 @@ class Dir {
         return callback(err, result);
       }
 
+      if (this[kDirWalk]) {
+        this[kDirBufferedEntries] = this[kDirGetDirents](result);
+        return callback(
+          null, ArrayPrototypeShift(this[kDirBufferedEntries]));
+      }
+
       this[kDirBufferedEntries] = ArrayPrototypeSlice(result, 2);
       getDirent(this[kDirPath], result[0], result[1], callback);
     };
 
     this[kDirOperationQueue] = [];
-    this[kDirHandle].read(
-      this[kDirOptions].encoding,
-      this[kDirOptions].bufferSize,
-      req
-    );
+    if (this[kDirWalk]) {
+      this[kDirHandle].readStats(
+        pathModule.toNamespacedPath(this[kDirPath]),
+        this[kDirOptions].encoding,
+        this[kDirOptions].bufferSize,
+        this[kDirOptions].recursive,
+        req
+      );
+    } else {
+      this[kDirHandle].read(
+        this[kDirOptions].encoding,
+        this[kDirOptions].bufferSize,
+        req
+      );
+    }
+  }
+
+  // Turns a batch returned by DirHandle.readStats() into Dirent objects.
+  [kDirGetDirents](result) {
+    const {
+      0: names, 1: types, 2: parents, 3: directories, 4: stats,
+    } = result;
+    const path = this[kDirPath];
+    for (let i = 0; i < directories.length; i++) {
+      directories[i] =
+        directories[i].length === 0 ? path : join(path, directories[i]);
+    }
+
+    const { withStats } = this[kDirOptions];
+    const dirents = [];
+    for (let i = 0; i < names.length; i++) {
+      let dirent;
+      if (withStats) {
+        dirent = new DirentWithStats(names[i], types[i],
+                                     directories[parents[i]],
+                                     stats, i * kFsStatsFieldsNumber);
+      } else {
+        dirent = new Dirent(names[i], types[i]);
+        dirent.path = directories[parents[i]];
+      }
+      ArrayPrototypePush(dirents, dirent);
+    }
+    return dirents;
   }
 
   readSync() {
@@ -141,6 +209,10 @@ class Dir {
       throw new ERR_DIR_CONCURRENT_OPERATION();
     }
 
+    if (this[kDirWalk] && this[kDirBufferedEntries].length > 0) {
+      return ArrayPrototypeShift(this[kDirBufferedEntries]);
+    }
+
     if (this[kDirBufferedEntries].length > 0) {
       const { 0: name, 1: type } =
           ArrayPrototypeSplice(this[kDirBufferedEntries], 0, 2);
@@ -148,18 +220,35 @@ class Dir {
     }
 
     const ctx = { path: this[kDirPath] };
-    const result = this[kDirHandle].read(
-      this[kDirOptions].encoding,
-      this[kDirOptions].bufferSize,
-      undefined,
-      ctx
-    );
+    let result;
+    if (this[kDirWalk]) {
+      result = this[kDirHandle].readStats(
+        pathModule.toNamespacedPath(this[kDirPath]),
+        this[kDirOptions].encoding,
+        this[kDirOptions].bufferSize,
+        this[kDirOptions].recursive,
+        undefined,
+        ctx
+      );
+    } else {
+      result = this[kDirHandle].read(
+        this[kDirOptions].encoding,
+        this[kDirOptions].bufferSize,
+        undefined,
+        ctx
+      );
+    }
     handleErrorFromBinding(ctx);
 
     if (result === null) {
       return result;
     }
 
+    if (this[kDirWalk]) {
+      this[kDirBufferedEntries] = this[kDirGetDirents](result);
+      return ArrayPrototypeShift(this[kDirBufferedEntries]);
+    }
+
     this[kDirBufferedEntries] = ArrayPrototypeSlice(result, 2);
     return getDirent(this[kDirPath], result[0], result[1]);
   }
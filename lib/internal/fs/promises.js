@@ -869,6 +869,15 @@ async function readFile(path, options) {
 
   checkAborted(options.signal);
 
+  if (options.signal == null) {
+    // Open, read, close and decode in a single request on the threadpool.
+    path = getValidatedPath(path);
+    return binding.readFile(pathModule.toNamespacedPath(path),
+                            stringToFlags(flag),
+                            options.encoding,
+                            kUsePromises);
+  }
+
   const fd = await open(path, flag, 0o666);
   return handleFdClose(readFileHandle(fd, options), fd.close);
 }
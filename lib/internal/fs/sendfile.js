@@ -0,0 +1,166 @@
+'use strict';
+
+// Moves the contents of an fs.ReadStream into a TCP or pipe socket with
+// sendfile(2) instead of reading it into Buffers first. Used by
+// stream.pipeline() when a file is piped into a socket or into an
+// http.ServerResponse.
+
+const { SendFilePipe } = internalBinding('stream_pipe');
+const { TCP } = internalBinding('tcp_wrap');
+const { Pipe } = internalBinding('pipe_wrap');
+const { UV_ECANCELED } = internalBinding('uv');
+const { errnoException } = require('internal/errors');
+const fs = require('fs');
+const {
+  ReadStream,
+  kFs,
+  kIoCancel,
+  kIoDone,
+  kIsPerformingIO,
+} = require('internal/fs/streams');
+
+let net;
+let ServerResponse;
+
+function isUntouchedReadStream(src) {
+  if (!(src instanceof ReadStream) || src[kFs] !== fs)
+    return false;
+  const state = src._readableState;
+  return (src.fd === null || typeof src.fd === 'number') &&
+         !src.destroyed &&
+         !src[kIsPerformingIO] &&
+         src.bytesRead === 0 &&
+         state.flowing === null &&
+         state.length === 0 &&
+         !state.ended &&
+         state.encoding === null;
+}
+
+function isSendFileSocket(socket) {
+  net ??= require('net');
+  if (!(socket instanceof net.Socket))
+    return false;
+  const handle = socket._handle;
+  return (handle instanceof TCP || handle instanceof Pipe) &&
+         !socket.connecting &&
+         !socket.destroyed &&
+         socket.writable;
+}
+
+function getSendFileSocket(dst) {
+  ServerResponse ??= require('_http_server').ServerResponse;
+  if (!(dst instanceof ServerResponse))
+    return isSendFileSocket(dst) ? dst : null;
+
+  const socket = dst.socket;
+  if (socket?._httpMessage !== dst || dst.finished || !isSendFileSocket(socket))
+    return null;
+  // The body has to go out verbatim, so chunked responses (and responses
+  // without a body) take the regular path.
+  return hasVerbatimBody(dst) ? socket : null;
+}
+
+// Tells whether the body of `res` is sent as it is, without committing the
+// headers, which can still change if the regular path is taken.
+function hasVerbatimBody(res) {
+  if (res._header)
+    return res._hasBody && !res.chunkedEncoding;
+  const { statusCode } = res;
+  if (!res._hasBody || statusCode === 204 || statusCode === 304 ||
+      (statusCode >= 100 && statusCode <= 199)) {
+    return false;
+  }
+  if (res.hasHeader('transfer-encoding') || res.hasHeader('trailer'))
+    return false;
+  return res.hasHeader('content-length') || !res.useChunkedEncodingByDefault;
+}
+
+// Returns false if `src` has to be piped into `dst` the regular way.
+// Otherwise the file is sent in the background and `src` ends (or is
+// destroyed) once it is done, just like after a regular pipe().
+function trySendFile(src, dst) {
+  if (SendFilePipe === undefined || !isUntouchedReadStream(src))
+    return false;
+  const socket = getSendFileSocket(dst);
+  if (socket === null)
+    return false;
+
+  // Everything that was written before has to hit the socket before the file
+  // does, so wait until the write queue is flushed. Headers of a response
+  // go out with this write as well.
+  if (socket !== dst) {
+    if (!dst._header)
+      dst._implicitHeader();
+    dst._send('', 'latin1', onFlushed);
+  } else {
+    socket.write('', 'latin1', onFlushed);
+  }
+
+  function onFlushed(err) {
+    if (err || src.destroyed || !isSendFileSocket(socket))
+      return finish(err);
+    if (src.fd === null)
+      src.once('ready', start);
+    else
+      start();
+  }
+
+  function start() {
+    if (src.destroyed || !isSendFileSocket(socket))
+      return finish(null);
+
+    const position = src.pos === undefined ? -1 : src.pos;
+    const length = src.end === Infinity ? -1 :
+      src.end - (src.pos === undefined ? 0 : src.pos) + 1;
+    const pipe = new SendFilePipe(src.fd, position, length, socket._handle);
+    const cancel = () => pipe.unpipe();
+    pipe.oncomplete = (status, bytesSent) => {
+      src[kIsPerformingIO] = false;
+      src.removeListener(kIoCancel, cancel);
+      socket.removeListener('close', cancel);
+      socket.uncork();
+
+      src.bytesRead += bytesSent;
+      if (src.pos !== undefined)
+        src.pos += bytesSent;
+
+      const err = status < 0 && status !== UV_ECANCELED ?
+        errnoException(status, 'sendfile') : null;
+      // Tell ._destroy() that it's safe to close the fd now.
+      if (src.destroyed)
+        src.emit(kIoDone, err);
+      else
+        finish(err);
+    };
+
+    // The fd must stay open, and nothing else may be written to the socket,
+    // while the file is being sent.
+    src[kIsPerformingIO] = true;
+    socket.cork();
+    src.once(kIoCancel, cancel);
+    socket.once('close', cancel);
+    const err = pipe.start();
+    if (err !== 0)
+      pipe.oncomplete(err, 0);
+  }
+
+  function finish(err) {
+    if (src.destroyed)
+      return;
+    if (err) {
+      src.destroy(err);
+    } else if (!isSendFileSocket(socket)) {
+      // The socket went away before everything was sent.
+      src.destroy();
+    } else {
+      src.push(null);
+      src.resume();
+    }
+  }
+
+  return true;
+}
+
+module.exports = {
+  trySendFile,
+};
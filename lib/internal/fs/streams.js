@@ -36,6 +36,7 @@ const {
 } = require('internal/fs/utils');
 const { Readable, Writable, finished } = require('stream');
 const { toPathIfFileURL } = require('internal/url');
+const kIoCancel = Symbol('kIoCancel');
 const kIoDone = Symbol('kIoDone');
 const kIsPerformingIO = Symbol('kIsPerformingIO');
 
@@ -288,6 +289,8 @@ ReadStream.prototype._destroy = function(err, cb) {
   // any pending IO (kIsPerformingIO) to complete (kIoDone).
   if (this[kIsPerformingIO]) {
     this.once(kIoDone, (er) => close(this, err || er, cb));
+    // Lets long-running operations such as a sendfile() pipe stop early.
+    this.emit(kIoCancel);
   } else {
     close(this, err, cb);
   }
@@ -492,5 +495,9 @@ ObjectDefineProperty(WriteStream.prototype, 'pending', {
 
 module.exports = {
   ReadStream,
-  WriteStream
+  WriteStream,
+  kFs,
+  kIoCancel,
+  kIoDone,
+  kIsPerformingIO,
 };
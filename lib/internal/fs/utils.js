@@ -211,6 +211,31 @@ for (const name of ReflectOwnKeys(Dirent.prototype)) {
   };
 }
 
+const kStatsArray = Symbol('kStatsArray');
+const kStatsOffset = Symbol('kStatsOffset');
+
+// A Dirent that was read together with its lstat() information. The fields
+// stay in the Float64Array shared by all entries of a batch until the
+// `stats` property is first accessed.
+class DirentWithStats extends Dirent {
+  constructor(name, type, path, statsArray, offset) {
+    super(name, type);
+    this.path = path;
+    this[kStatsArray] = statsArray;
+    this[kStatsOffset] = offset;
+    this[kStats] = undefined;
+  }
+
+  get stats() {
+    if (this[kStats] === undefined) {
+      this[kStats] =
+        getStatsFromBinding(this[kStatsArray], this[kStatsOffset]);
+      this[kStatsArray] = undefined;
+    }
+    return this[kStats];
+  }
+}
+
 function copyObject(source) {
   const target = {};
   for (const key in source)
@@ -932,6 +957,7 @@ module.exports = {
   BigIntStats,  // for testing
   copyObject,
   Dirent,
+  DirentWithStats,
   emitRecursiveRmdirWarning,
   getDirent,
   getDirents,
@@ -940,6 +966,7 @@ module.exports = {
   getValidatedPath,
   getValidMode,
   handleErrorFromBinding,
+  join,
   nullCheck,
   preprocessSymlinkDestination,
   realpathCacheKey: Symbol('realpathCacheKey'),
@@ -22,6 +22,7 @@
 'use strict';
 
 const {
+  ArrayFrom,
   ArrayIsArray,
   ArrayPrototypeConcat,
   ArrayPrototypeFilter,
@@ -81,12 +82,17 @@ const {
 const { pathToFileURL, fileURLToPath, isURLInstance } = require('internal/url');
 const { deprecate, kEmptyObject, filterOwnProperties, setOwnProperty } = require('internal/util');
 const vm = require('vm');
+const { internalCompileFunction } = require('internal/vm');
 const assert = require('internal/assert');
 const fs = require('fs');
 const internalFS = require('internal/fs/utils');
 const path = require('path');
 const { sep } = path;
-const { internalModuleStat } = internalBinding('fs');
+const {
+  internalModuleStat,
+  internalModuleGetCachedResolution,
+  internalModuleCacheResolution,
+} = internalBinding('fs');
 const packageJsonReader = require('internal/modules/package_json_reader');
 const { safeGetenv } = internalBinding('credentials');
 const {
@@ -100,6 +106,8 @@ const {
 const { getOptionValue } = require('internal/options');
 const preserveSymlinks = getOptionValue('--preserve-symlinks');
 const preserveSymlinksMain = getOptionValue('--preserve-symlinks-main');
+const useResolutionCache =
+  getOptionValue('--experimental-resolution-cache') !== '';
 // Do not eagerly grab .manifest, it may be in TDZ
 const policy = getOptionValue('--experimental-policy') ?
   require('internal/process/policy') :
@@ -147,16 +155,22 @@ const relativeResolveCache = ObjectCreate(null);
 let requireDepth = 0;
 let statCache = null;
 let isPreloading = false;
+// The directories and package.json files that the result of the resolution in
+// progress depends on, when it is going to be stored in the resolution cache.
+let resolutionDependencies = null;
 
 function stat(filename) {
   filename = path.toNamespacedPath(filename);
+  if (resolutionDependencies !== null)
+    resolutionDependencies.add(path.dirname(filename));
   if (statCache !== null) {
     const result = statCache.get(filename);
     if (result !== undefined) return result;
   }
   const result = internalModuleStat(filename);
-  if (statCache !== null && result >= 0) {
-    // Only set cache when `internalModuleStat(filename)` succeeds.
+  if (statCache !== null && (result >= 0 || useResolutionCache)) {
+    // Only cache misses with --experimental-resolution-cache. Otherwise, a
+    // module could not create a file and require it while it is being loaded.
     statCache.set(filename, result);
   }
   return result;
@@ -300,25 +314,31 @@ const packageJsonCache = new SafeMap();
 
 function readPackage(requestPath) {
   const jsonPath = path.resolve(requestPath, 'package.json');
+  if (resolutionDependencies !== null)
+    resolutionDependencies.add(path.toNamespacedPath(jsonPath));
 
   const existing = packageJsonCache.get(jsonPath);
   if (existing !== undefined) return existing;
 
-  const result = packageJsonReader.read(jsonPath);
-  const json = result.containsKeys === false ? '{}' : result.string;
-  if (json === undefined) {
+  const result = packageJsonReader.readFields(jsonPath);
+  if (result === undefined) {
     packageJsonCache.set(jsonPath, false);
     return false;
   }
 
   try {
-    const filtered = filterOwnProperties(JSONParse(json), [
-      'name',
-      'main',
-      'exports',
-      'imports',
-      'type',
-    ]);
+    let filtered = result.fields;
+    if (filtered === undefined) {
+      filtered = result.containsKeys ?
+        filterOwnProperties(JSONParse(result.string), [
+          'name',
+          'main',
+          'exports',
+          'imports',
+          'type',
+        ]) :
+        ObjectCreate(null);
+    }
     packageJsonCache.set(jsonPath, filtered);
     return filtered;
   } catch (e) {
@@ -510,7 +530,10 @@ Module._findPath = function(request, paths, isMain) {
   }
 
   const cacheKey = request + '\x00' + ArrayPrototypeJoin(paths, '\x00');
-  const entry = Module._pathCache[cacheKey];
+  // A result that is going to be stored in the resolution cache has to come
+  // from the file system, so that the directories it depends on are known.
+  const entry = resolutionDependencies === null ?
+    Module._pathCache[cacheKey] : undefined;
   if (entry)
     return entry;
 
@@ -861,6 +884,32 @@ Module._load = function(request, parent, isMain) {
   return module.exports;
 };
 
+// Resolves `request` with the help of the cache enabled with
+// --experimental-resolution-cache. The cache is keyed by everything that
+// the result depends on besides the file system: the directory of the parent
+// module, its lookup paths and the known extensions.
+function resolveFilenameCached(request, parent, isMain) {
+  const context = (isMain ? '1' : '0') +
+    ArrayPrototypeJoin(ObjectKeys(Module._extensions), ',') + '\x00' +
+    path.dirname(parent.filename) + '\x00' +
+    ArrayPrototypeJoin(parent.paths, '\x00') + '\x00\x00' +
+    ArrayPrototypeJoin(modulePaths, '\x00');
+  const cached = internalModuleGetCachedResolution(context, request);
+  if (cached !== undefined)
+    return cached;
+
+  const dependencies = resolutionDependencies = new SafeSet();
+  let filename;
+  try {
+    filename = resolveFilename(request, parent, isMain);
+  } finally {
+    resolutionDependencies = null;
+  }
+  internalModuleCacheResolution(context, request, filename,
+                                ArrayFrom(dependencies));
+  return filename;
+}
+
 Module._resolveFilename = function(request, parent, isMain, options) {
   if (
     (
@@ -874,6 +923,12 @@ Module._resolveFilename = function(request, parent, isMain, options) {
     return request;
   }
 
+  if (useResolutionCache && resolutionDependencies === null &&
+      options === undefined && typeof parent?.filename === 'string' &&
+      path.isAbsolute(parent.filename) && ArrayIsArray(parent.paths)) {
+    return resolveFilenameCached(request, parent, isMain);
+  }
+
   let paths;
 
   if (typeof options === 'object' && options !== null) {
@@ -958,6 +1013,9 @@ Module._resolveFilename = function(request, parent, isMain, options) {
   throw err;
 };
 
+// Used by resolveFilenameCached(), even if Module._resolveFilename is patched.
+const resolveFilename = Module._resolveFilename;
+
 function finalizeEsmResolution(resolved, parentPath, pkgPath) {
   if (RegExpPrototypeExec(encodedSepRegEx, resolved) !== null)
     throw new ERR_INVALID_MODULE_SPECIFIER(
@@ -1044,21 +1102,33 @@ function wrapSafe(filename, content, cjsModuleInstance) {
       },
     });
   }
+  validateString(content, 'code');
+  validateString(filename, 'options.filename');
   try {
-    return vm.compileFunction(content, [
-      'exports',
-      'require',
-      'module',
-      '__filename',
-      '__dirname',
-    ], {
+    return internalCompileFunction(
+      content,
       filename,
-      importModuleDynamically(specifier, _, importAssertions) {
+      0,
+      0,
+      undefined,
+      false,
+      undefined,
+      [],
+      [
+        'exports',
+        'require',
+        'module',
+        '__filename',
+        '__dirname',
+      ],
+      (specifier, _, importAssertions) => {
         const loader = asyncESM.esmLoader;
         return loader.import(specifier, normalizeReferrerURL(filename),
                              importAssertions);
       },
-    });
+      // Only files can be looked up in the compile cache.
+      path.isAbsolute(filename),
+    );
   } catch (err) {
     if (process.mainModule === cjsModuleInstance)
       enrichCJSError(err, content);
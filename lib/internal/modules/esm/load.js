@@ -1,7 +1,12 @@
 'use strict';
 
 const {
+  ArrayPrototypeMap,
   ArrayPrototypePush,
+  ArrayPrototypeSlice,
+  MathCeil,
+  MathMin,
+  PromisePrototypeThen,
   RegExpPrototypeExec,
   decodeURIComponent,
 } = primordials;
@@ -20,8 +25,12 @@ const experimentalNetworkImports =
 
 const { Buffer: { from: BufferFrom } } = require('buffer');
 
-const { readFile: readFileAsync } = require('internal/fs/promises').exports;
-const { URL } = require('internal/url');
+const { readFiles, kUsePromises } = internalBinding('fs');
+const { O_RDONLY } = internalBinding('constants').fs;
+const { toNamespacedPath } = require('path');
+const { createDeferredPromise } = require('internal/util');
+const { isUint8Array } = require('internal/util/types');
+const { URL, fileURLToPath } = require('internal/url');
 const {
   ERR_INVALID_URL,
   ERR_UNSUPPORTED_ESM_URL_SCHEME,
@@ -29,12 +38,57 @@ const {
 
 const DATA_URL_PATTERN = /^[^/]+\/[^,;]+(?:[^,]*?)(;base64)?,([\s\S]*)$/;
 
+// Modules of a graph are loaded level by level (see ModuleJob): once the
+// sources of a set of modules have been read, they are all compiled, and the
+// files they import are requested together. The reads started during one tick
+// are therefore collected and handed to the threadpool together, instead of
+// one request per file. Each job reads its files one after another, so the
+// reads are spread over at least kReadJobs jobs to keep the threads of the
+// default libuv threadpool busy, and over jobs of at most kReadBatchSize files
+// when there are more of them.
+const kReadBatchSize = 32;
+const kReadJobs = 4;
+let pendingReads = [];
+
+function flushPendingReads() {
+  const reads = pendingReads;
+  pendingReads = [];
+  const batchSize =
+    MathMin(kReadBatchSize, MathCeil(reads.length / kReadJobs));
+  for (let i = 0; i < reads.length; i += batchSize) {
+    const batch = ArrayPrototypeSlice(reads, i, i + batchSize);
+    const paths = ArrayPrototypeMap(batch, (read) => read.path);
+    PromisePrototypeThen(
+      readFiles(paths, O_RDONLY, undefined, kUsePromises),
+      (results) => {
+        for (let j = 0; j < batch.length; j++) {
+          if (isUint8Array(results[j]))
+            batch[j].resolve(results[j]);
+          else
+            batch[j].reject(results[j]);
+        }
+      },
+      (err) => {
+        for (let j = 0; j < batch.length; j++)
+          batch[j].reject(err);
+      });
+  }
+}
+
+function readSourceFile(url) {
+  const { promise, resolve, reject } = createDeferredPromise();
+  const path = toNamespacedPath(fileURLToPath(url));
+  if (ArrayPrototypePush(pendingReads, { path, resolve, reject }) === 1)
+    process.nextTick(flushPendingReads);
+  return promise;
+}
+
 async function getSource(url, context) {
   const parsed = new URL(url);
   let responseURL = url;
   let source;
   if (parsed.protocol === 'file:') {
-    source = await readFileAsync(parsed);
+    source = await readSourceFile(parsed);
   } else if (parsed.protocol === 'data:') {
     const match = RegExpPrototypeExec(DATA_URL_PATTERN, parsed.pathname);
     if (!match) {
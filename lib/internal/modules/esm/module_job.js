@@ -13,6 +13,7 @@ const {
   RegExpPrototypeExec,
   RegExpPrototypeSymbolReplace,
   SafePromiseAll,
+  SafePromiseAllSettled,
   SafeSet,
   StringPrototypeIncludes,
   StringPrototypeSplit,
@@ -21,7 +22,10 @@ const {
 
 const { ModuleWrap } = internalBinding('module_wrap');
 
-const { decorateErrorStack } = require('internal/util');
+const {
+  createDeferredPromise,
+  decorateErrorStack,
+} = require('internal/util');
 const {
   getSourceMapsEnabled,
 } = require('internal/source_map/source_map_cache');
@@ -48,6 +52,9 @@ const isCommonJSGlobalLikeNotDefinedError = (errorMessage) =>
 /* A ModuleJob tracks the loading of a single Module, and the ModuleJobs of
  * its dependencies, over time. */
 class ModuleJob {
+  #linked;
+  #linkStarted = false;
+
   // `loader` is the Loader instance used for loading dependencies.
   // `moduleProvider` is a function
   constructor(loader, url, importAssertions = ObjectCreate(null),
@@ -57,14 +64,67 @@ class ModuleJob {
     this.isMain = isMain;
     this.inspectBrk = inspectBrk;
 
+    this.url = url;
     this.module = undefined;
     // Expose the promise to the ModuleWrap directly for linking below.
     // `this.module` is also filled in below.
     this.modulePromise = ReflectApply(moduleProvider, loader, [url, isMain]);
 
-    // Wait for the ModuleWrap instance being linked with all dependencies.
-    const link = async () => {
-      this.module = await this.modulePromise;
+    // Promise for the list of all dependencyJobs, see `linked`.
+    this.#linked = createDeferredPromise();
+    // This promise is awaited later anyway, so silence
+    // 'unhandled rejection' warnings.
+    PromisePrototypeThen(this.#linked.promise, undefined, noop);
+
+    // instantiated == deep dependency jobs wrappers are instantiated,
+    // and module wrapper is instantiated.
+    this.instantiated = undefined;
+  }
+
+  // Resolves with the jobs of the modules that this module imports, once the
+  // ModuleWrap instance has been linked with all of them.
+  get linked() {
+    if (!this.#linkStarted) {
+      this.#linkStarted = true;
+      ModuleJob.#linkGraph([this]);
+    }
+    return this.#linked.promise;
+  }
+
+  // Links the modules of `jobs` and everything they import breadth-first:
+  // the dependencies of all modules on one level of the graph are requested
+  // together, so that their sources are read in the same batches, and the
+  // next level is only started once all of them have been fetched.
+  static async #linkGraph(jobs) {
+    while (jobs.length > 0) {
+      const modules = await SafePromiseAllSettled(
+        jobs, (job) => job.modulePromise);
+      const requested = [];
+      for (let i = 0; i < jobs.length; i++) {
+        if (modules[i].status === 'fulfilled')
+          jobs[i].#link(modules[i].value, requested);
+        else
+          jobs[i].#linked.reject(modules[i].reason);
+      }
+
+      const dependencies = await SafePromiseAllSettled(requested);
+      jobs = [];
+      for (let i = 0; i < dependencies.length; i++) {
+        // A job that could not be created fails the link() of its importer.
+        if (dependencies[i].status !== 'fulfilled') continue;
+        const job = dependencies[i].value;
+        if (job.#linkStarted) continue;
+        job.#linkStarted = true;
+        ArrayPrototypePush(jobs, job);
+      }
+    }
+  }
+
+  // Links the ModuleWrap instance, and adds the promises for the jobs of its
+  // dependencies to `requested`.
+  #link(module, requested) {
+    try {
+      this.module = module;
       assert(this.module instanceof ModuleWrap);
 
       // Explicitly keeping track of dependency jobs is needed in order
@@ -73,26 +133,23 @@ class ModuleJob {
       // these `link` callbacks depending on each other.
       const dependencyJobs = [];
       const promises = this.module.link(async (specifier, assertions) => {
-        const jobPromise = this.loader.getModuleJob(specifier, url, assertions);
+        const jobPromise =
+          this.loader.getModuleJob(specifier, this.url, assertions);
         ArrayPrototypePush(dependencyJobs, jobPromise);
+        ArrayPrototypePush(requested, jobPromise);
         const job = await jobPromise;
         return job.modulePromise;
       });
 
-      if (promises !== undefined)
-        await SafePromiseAll(promises);
-
-      return SafePromiseAll(dependencyJobs);
-    };
-    // Promise for the list of all dependencyJobs.
-    this.linked = link();
-    // This promise is awaited later anyway, so silence
-    // 'unhandled rejection' warnings.
-    PromisePrototypeThen(this.linked, undefined, noop);
+      this.#linked.resolve((async () => {
+        if (promises !== undefined)
+          await SafePromiseAll(promises);
 
-    // instantiated == deep dependency jobs wrappers are instantiated,
-    // and module wrapper is instantiated.
-    this.instantiated = undefined;
+        return SafePromiseAll(dependencyJobs);
+      })());
+    } catch (error) {
+      this.#linked.reject(error);
+    }
   }
 
   instantiate() {
@@ -2,7 +2,6 @@
 
 const {
   JSONParse,
-  ObjectPrototypeHasOwnProperty,
   SafeMap,
   StringPrototypeEndsWith,
 } = primordials;
@@ -42,8 +41,8 @@ function getPackageConfig(path, specifier, base) {
   if (existing !== undefined) {
     return existing;
   }
-  const source = packageJsonReader.read(path).string;
-  if (source === undefined) {
+  const pkgJson = packageJsonReader.readFields(path);
+  if (pkgJson === undefined) {
     const packageConfig = {
       pjsonPath: path,
       exists: false,
@@ -57,19 +56,23 @@ function getPackageConfig(path, specifier, base) {
     return packageConfig;
   }
 
-  let packageJSON;
-  try {
-    packageJSON = JSONParse(source);
-  } catch (error) {
-    throw new ERR_INVALID_PACKAGE_CONFIG(
-      path,
-      (base ? `"${specifier}" from ` : '') + fileURLToPath(base || specifier),
-      error.message
-    );
+  let packageJSON = pkgJson.fields;
+  if (packageJSON === undefined) {
+    try {
+      packageJSON = filterOwnProperties(JSONParse(pkgJson.string), [
+        'exports', 'imports', 'main', 'name', 'type',
+      ]);
+    } catch (error) {
+      throw new ERR_INVALID_PACKAGE_CONFIG(
+        path,
+        (base ? `"${specifier}" from ` : '') + fileURLToPath(base || specifier),
+        error.message
+      );
+    }
   }
 
-  let { imports, main, name, type } = filterOwnProperties(packageJSON, ['imports', 'main', 'name', 'type']);
-  const exports = ObjectPrototypeHasOwnProperty(packageJSON, 'exports') ? packageJSON.exports : undefined;
+  let { imports, main, name, type } = packageJSON;
+  const { exports } = packageJSON;
   if (typeof imports !== 'object' || imports === null) {
     imports = undefined;
   }
@@ -250,9 +250,9 @@ function resolveDirectoryEntry(search) {
   const dirPath = fileURLToPath(search);
   const pkgJsonPath = resolve(dirPath, 'package.json');
   if (fileExists(pkgJsonPath)) {
-    const pkgJson = packageJsonReader.read(pkgJsonPath);
-    if (pkgJson.containsKeys) {
-      const { main } = JSONParse(pkgJson.string);
+    const pkgJson = packageJsonReader.readFields(pkgJsonPath);
+    if (pkgJson?.containsKeys) {
+      const { main } = pkgJson.fields ?? JSONParse(pkgJson.string);
       if (main != null) {
         const mainUrl = pathToFileURL(resolve(dirPath, main));
         return resolveExtensionsWithTryExactName(mainUrl);
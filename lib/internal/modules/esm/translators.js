@@ -116,7 +116,9 @@ translators.set('module', async function moduleStrategy(url, source, isMain) {
   source = stringify(source);
   maybeCacheSourceMap(url, source);
   debug(`Translating StandardModule ${url}`);
-  const module = new ModuleWrap(url, undefined, source, 0, 0);
+  // Only files can be looked up in the compile cache.
+  const module = new ModuleWrap(url, undefined, source, 0, 0, undefined,
+                                StringPrototypeStartsWith(url, 'file:'));
   moduleWrap.callbackMap.set(module, {
     initializeImportMeta: (meta, wrap) => this.importMetaInitialize(meta, { url }),
     importModuleDynamically,
@@ -1,14 +1,37 @@
 'use strict';
 
-const { SafeMap } = primordials;
-const { internalModuleReadJSON } = internalBinding('fs');
+const {
+  JSONParse,
+  ObjectCreate,
+  SafeMap,
+} = primordials;
+const {
+  internalModuleReadJSON,
+  internalModuleReadPackageJSON,
+} = internalBinding('fs');
 const { pathToFileURL } = require('url');
 const { toNamespacedPath } = require('path');
+const { filterOwnProperties } = require('internal/util');
 
 const cache = new SafeMap();
+const fieldsCache = new SafeMap();
+
+// The fields that module resolution uses, in the order in which
+// internalModuleReadPackageJSON() returns them.
+const kFieldNames = ['name', 'main', 'type', 'exports', 'imports'];
 
 let manifest;
 
+function getManifest() {
+  if (manifest === undefined) {
+    const { getOptionValue } = require('internal/options');
+    manifest = getOptionValue('--experimental-policy') ?
+      require('internal/process/policy').manifest :
+      null;
+  }
+  return manifest;
+}
+
 /**
  *
  * @param {string} jsonPath
@@ -22,20 +45,71 @@ function read(jsonPath) {
     toNamespacedPath(jsonPath)
   );
   const result = { string, containsKeys };
-  const { getOptionValue } = require('internal/options');
-  if (string !== undefined) {
-    if (manifest === undefined) {
-      manifest = getOptionValue('--experimental-policy') ?
-        require('internal/process/policy').manifest :
-        null;
+  if (string !== undefined && getManifest() !== null) {
+    const jsonURL = pathToFileURL(jsonPath);
+    manifest.assertIntegrity(jsonURL, string);
+  }
+  cache.set(jsonPath, result);
+  return result;
+}
+
+/**
+ * Reads the fields of a package.json file that module resolution uses. The
+ * file is parsed in C++, and only the values of these fields are parsed in JS.
+ * `fields` is a null-prototype object with the fields that are present. If the
+ * file cannot be parsed, `fields` is undefined and `string` holds its contents,
+ * so that the caller can report the error.
+ * @param {string} jsonPath
+ * @returns {{
+ *   fields: Record<string, unknown> | undefined,
+ *   string: string | undefined,
+ *   containsKeys: boolean,
+ * } | undefined} undefined if the file does not exist
+ */
+function readFields(jsonPath) {
+  const existing = fieldsCache.get(jsonPath);
+  if (existing !== undefined || fieldsCache.has(jsonPath)) {
+    return existing;
+  }
+
+  let result;
+  if (getManifest() !== null) {
+    // The integrity of the whole file has to be checked.
+    const { string, containsKeys } = read(jsonPath);
+    if (string !== undefined) {
+      result = { fields: undefined, string, containsKeys };
     }
-    if (manifest !== null) {
-      const jsonURL = pathToFileURL(jsonPath);
-      manifest.assertIntegrity(jsonURL, string);
+  } else {
+    const values = internalModuleReadPackageJSON(toNamespacedPath(jsonPath));
+    if (values === undefined) {
+      result = undefined;
+    } else if (values.length === 2) {
+      result = { fields: undefined, string: values[0], containsKeys: values[1] };
+    } else {
+      const fields = ObjectCreate(null);
+      const jsonFields = values[kFieldNames.length];
+      for (let i = 0; i < kFieldNames.length; i++) {
+        const value = values[i];
+        if (value === undefined) continue;
+        fields[kFieldNames[i]] =
+          (jsonFields & (1 << i)) !== 0 ? JSONParse(value) : value;
+      }
+      result = { fields, string: undefined, containsKeys: true };
     }
   }
-  cache.set(jsonPath, result);
+
+  if (result !== undefined && result.fields === undefined) {
+    // JSON.parse() may still accept what the native parser does not handle,
+    // e.g. keys with escape sequences. Errors are left to the caller.
+    try {
+      result.fields = filterOwnProperties(JSONParse(result.string),
+                                          kFieldNames);
+    } catch {
+      // Ignore.
+    }
+  }
+  fieldsCache.set(jsonPath, result);
   return result;
 }
 
-module.exports = { read };
+module.exports = { read, readFields };
@@ -40,6 +40,7 @@ const { AbortController } = require('internal/abort_controller');
 
 let PassThrough;
 let Readable;
+let trySendFile;
 
 function destroyer(stream, reading, writing) {
   let finished = false;
@@ -353,7 +354,10 @@ function pipe(src, dst, finish, { end }) {
     }
   });
 
-  src.pipe(dst, { end });
+  // Files that go into a socket are sent by the kernel directly.
+  trySendFile ??= require('internal/fs/sendfile').trySendFile;
+  if (!trySendFile(src, dst))
+    src.pipe(dst, { end });
 
   if (end) {
     // Compat. Before node v10.12.0 stdio used to throw an error so
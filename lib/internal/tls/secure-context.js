@@ -35,6 +35,10 @@ const {
   toBuf,
 } = require('internal/crypto/util');
 
+const {
+  setSessionStore,
+} = require('internal/tls/session-store');
+
 const {
   crypto: {
     TLS1_2_VERSION,
@@ -138,6 +142,7 @@ function configSecureContext(context, options = kEmptyObject, name = 'options')
     privateKeyIdentifier,
     privateKeyEngine,
     sessionIdContext,
+    sessionStore,
     sessionTimeout,
     sigalgs,
     ticketKeys,
@@ -257,6 +262,11 @@ function configSecureContext(context, options = kEmptyObject, name = 'options')
     }
   }
 
+  // The store provides a session ID context and ticket keys, but explicitly
+  // passed ones take precedence.
+  if (sessionStore !== undefined && sessionStore !== null)
+    setSessionStore(context, sessionStore, `${name}.sessionStore`);
+
   if (sessionIdContext !== undefined && sessionIdContext !== null) {
     validateString(sessionIdContext, `${name}.sessionIdContext`);
     context.setSessionIdContext(sessionIdContext);
@@ -0,0 +1,110 @@
+'use strict';
+
+const {
+  ObjectSetPrototypeOf,
+} = primordials;
+
+const {
+  createSessionStore,
+} = internalBinding('crypto');
+
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+  },
+} = require('internal/errors');
+
+const {
+  kEmptyObject,
+} = require('internal/util');
+
+const {
+  validateObject,
+  validateString,
+  validateUint32,
+} = require('internal/validators');
+
+const {
+  JSTransferable,
+  kClone,
+  kDeserialize,
+} = require('internal/worker/js_transferable');
+
+const {
+  kHandle,
+} = require('internal/crypto/util');
+
+class InternalSessionStore extends JSTransferable {
+  constructor(handle) {
+    super();
+    this[kHandle] = handle;
+  }
+}
+
+class SessionStore extends JSTransferable {
+  constructor(options = kEmptyObject) {
+    validateObject(options, 'options');
+    const {
+      maxSessions = 20480,
+      shards = 16,
+      directory,
+    } = options;
+    validateUint32(maxSessions, 'options.maxSessions', true);
+    validateUint32(shards, 'options.shards', true);
+    if (directory !== undefined)
+      validateString(directory, 'options.directory');
+    super();
+    this[kHandle] = createSessionStore(maxSessions, shards, directory);
+  }
+
+  getStats() {
+    const {
+      0: hits,
+      1: misses,
+      2: stores,
+      3: evictions,
+      4: ticketHits,
+      5: ticketMisses,
+      6: size,
+    } = this[kHandle].getStats();
+    return {
+      hits,
+      misses,
+      stores,
+      evictions,
+      ticketHits,
+      ticketMisses,
+      size,
+    };
+  }
+
+  [kClone]() {
+    const handle = this[kHandle];
+    return {
+      data: { handle },
+      deserializeInfo: 'internal/tls/session-store:InternalSessionStore'
+    };
+  }
+
+  [kDeserialize]({ handle }) {
+    this[kHandle] = handle;
+  }
+}
+
+InternalSessionStore.prototype.constructor = SessionStore;
+ObjectSetPrototypeOf(
+  InternalSessionStore.prototype,
+  SessionStore.prototype);
+
+function setSessionStore(context, sessionStore, name) {
+  if (!(sessionStore instanceof SessionStore)) {
+    throw new ERR_INVALID_ARG_TYPE(name, 'tls.SessionStore', sessionStore);
+  }
+  context.setSessionStore(sessionStore[kHandle]);
+}
+
+module.exports = {
+  InternalSessionStore,
+  SessionStore,
+  setSessionStore,
+};
@@ -0,0 +1,57 @@
+'use strict';
+
+const {
+  compileFunction,
+} = internalBinding('contextify');
+const {
+  validateFunction,
+} = require('internal/validators');
+
+// Compiles a function like vm.compileFunction(), after its arguments have been
+// validated. `useCompileCache` lets the CommonJS loader look up and store the
+// compiled code in the cache enabled with --experimental-compile-cache.
+function internalCompileFunction(code, filename, lineOffset, columnOffset,
+                                 cachedData, produceCachedData, parsingContext,
+                                 contextExtensions, params,
+                                 importModuleDynamically,
+                                 useCompileCache = false) {
+  const result = compileFunction(
+    code,
+    filename,
+    lineOffset,
+    columnOffset,
+    cachedData,
+    produceCachedData,
+    parsingContext,
+    contextExtensions,
+    params,
+    useCompileCache,
+  );
+
+  if (produceCachedData) {
+    result.function.cachedDataProduced = result.cachedDataProduced;
+  }
+
+  if (result.cachedData) {
+    result.function.cachedData = result.cachedData;
+  }
+
+  if (importModuleDynamically !== undefined) {
+    validateFunction(importModuleDynamically,
+                     'options.importModuleDynamically');
+    const { importModuleDynamicallyWrap } =
+      require('internal/vm/module');
+    const { callbackMap } = internalBinding('module_wrap');
+    const wrapped = importModuleDynamicallyWrap(importModuleDynamically);
+    const func = result.function;
+    callbackMap.set(result.cacheKey, {
+      importModuleDynamically: (s, _k, i) => wrapped(s, func, i),
+    });
+  }
+
+  return result.function;
+}
+
+module.exports = {
+  internalCompileFunction,
+};
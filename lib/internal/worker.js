@@ -30,6 +30,7 @@ const path = require('path');
 const {
   internalEventLoopUtilization
 } = require('internal/perf/event_loop_utilization');
+const { now } = require('internal/perf/utils');
 
 const errorCodes = require('internal/errors').codes;
 const {
@@ -70,7 +71,12 @@ const {
   kMaxOldGenerationSizeMb,
   kCodeRangeSizeMb,
   kStackSizeMb,
-  kTotalResourceLimitCount
+  kTotalResourceLimitCount,
+  kStartupSpawnStart,
+  kStartupThreadStart,
+  kStartupIsolateCreated,
+  kStartupEnvironmentCreated,
+  kStartupBootstrapComplete,
 } = internalBinding('worker');
 
 const kHandle = Symbol('kHandle');
@@ -83,6 +89,8 @@ const kOnErrorMessage = Symbol('kOnErrorMessage');
 const kParentSideStdio = Symbol('kParentSideStdio');
 const kLoopStartTime = Symbol('kLoopStartTime');
 const kIsOnline = Symbol('kIsOnline');
+const kOnlineTime = Symbol('kOnlineTime');
+const kStartupMilestones = Symbol('kStartupMilestones');
 
 const SHARE_ENV = SymbolFor('nodejs.worker_threads.SHARE_ENV');
 let debug = require('internal/util/debuglog').debuglog('worker', (fn) => {
@@ -255,8 +263,11 @@ class Worker extends EventEmitter {
     // Use this to cache the Worker's loopStart value once available.
     this[kLoopStartTime] = -1;
     this[kIsOnline] = false;
+    this[kOnlineTime] = -1;
+    this[kStartupMilestones] = null;
     this.performance = {
       eventLoopUtilization: FunctionPrototypeBind(eventLoopUtilization, this),
+      startupTiming: FunctionPrototypeBind(startupTiming, this),
     };
     // Actually start the new thread now that everything is in place.
     this[kHandle].startThread();
@@ -296,6 +307,7 @@ class Worker extends EventEmitter {
     switch (message.type) {
       case messageTypes.UP_AND_RUNNING:
         this[kIsOnline] = true;
+        this[kOnlineTime] = now();
         return this.emit('online');
       case messageTypes.COULD_NOT_SERIALIZE_ERROR:
         return this[kOnCouldNotSerializeErr]();
@@ -321,6 +333,8 @@ class Worker extends EventEmitter {
   }
 
   [kDispose]() {
+    // Keep the startup timing around once the native handle is gone.
+    this[kStartupMilestones] = this[kHandle].getStartupMilestones();
     this[kHandle].onexit = null;
     this[kHandle] = null;
     this[kPort] = null;
@@ -482,6 +496,20 @@ function eventLoopUtilization(util1, util2) {
   );
 }
 
+function startupTiming() {
+  const milestones = this[kHandle] !== null ?
+    this[kHandle].getStartupMilestones() :
+    this[kStartupMilestones];
+  return {
+    spawnStart: milestones[kStartupSpawnStart],
+    threadStart: milestones[kStartupThreadStart],
+    isolateCreated: milestones[kStartupIsolateCreated],
+    environmentCreated: milestones[kStartupEnvironmentCreated],
+    bootstrapComplete: milestones[kStartupBootstrapComplete],
+    online: this[kOnlineTime],
+  };
+}
+
 module.exports = {
   ownsProcessState,
   isMainThread,
@@ -0,0 +1,268 @@
+'use strict';
+
+const {
+  ArrayIsArray,
+  ArrayPrototypePush,
+  MathCeil,
+  MathLog2,
+  Symbol,
+  Uint8Array,
+} = primordials;
+
+const {
+  RingReader: RingReaderHandle,
+  kMinCapacity,
+  kMaxCapacity,
+} = internalBinding('ring_channel');
+const { owner_symbol } = internalBinding('symbols');
+
+const EventEmitter = require('events');
+const { Buffer } = require('buffer');
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_STATE,
+    ERR_OUT_OF_RANGE,
+  },
+} = require('internal/errors');
+const {
+  isAnyArrayBuffer,
+  isArrayBufferView,
+} = require('internal/util/types');
+const {
+  kEmptyObject,
+  lazyDOMException,
+} = require('internal/util');
+const {
+  validateInteger,
+  validateObject,
+} = require('internal/validators');
+const {
+  makeTransferable,
+  kClone,
+  kDeserialize,
+  kTransfer,
+  kTransferList,
+} = require('internal/worker/js_transferable');
+
+const kHandle = Symbol('kHandle');
+const kMaxRecordSize = Symbol('kMaxRecordSize');
+const kEnded = Symbol('kEnded');
+
+const kDefaultCapacity = 1024 * 1024;
+
+function toChunk(data, name) {
+  if (typeof data === 'string')
+    return Buffer.from(data);
+  if (isArrayBufferView(data))
+    return data;
+  if (isAnyArrayBuffer(data))
+    return new Uint8Array(data);
+  throw new ERR_INVALID_ARG_TYPE(
+    name, ['string', 'ArrayBuffer', 'Buffer', 'TypedArray', 'DataView'], data);
+}
+
+function onReadable() {
+  const reader = this[owner_symbol];
+  if (reader !== undefined)
+    reader.emit('readable');
+}
+
+function onDrain() {
+  this.unref();
+  const writer = this[owner_symbol];
+  if (writer !== undefined)
+    writer.emit('drain');
+}
+
+// The reader keeps the event loop alive while someone listens for 'readable'.
+function onNewListener(name) {
+  if (name === 'readable' &&
+      this.listenerCount('readable') === 0 &&
+      this[kHandle] !== null &&
+      !this[kEnded]) {
+    this[kHandle].ref();
+  }
+}
+
+function onRemoveListener(name) {
+  if (name === 'readable' &&
+      this.listenerCount('readable') === 0 &&
+      this[kHandle] !== null) {
+    this[kHandle].unref();
+  }
+}
+
+function setupReader(reader, handle) {
+  reader[kHandle] = handle;
+  reader[kMaxRecordSize] = handle.getMaxRecordSize();
+  handle[owner_symbol] = reader;
+  handle.onreadable = onReadable;
+  handle.unref();
+}
+
+function setupWriter(writer, handle) {
+  writer[kHandle] = handle;
+  writer[kMaxRecordSize] = handle.getMaxRecordSize();
+  handle[owner_symbol] = writer;
+  handle.ondrain = onDrain;
+  handle.unref();
+}
+
+function emitEnd(reader) {
+  reader[kEnded] = true;
+  reader[kHandle].unref();
+  process.nextTick(() => reader.emit('end'));
+}
+
+class RingReader extends EventEmitter {
+  constructor(handle) {
+    super();
+    const reader = makeTransferable(this);
+    reader[kHandle] = null;
+    reader[kMaxRecordSize] = 0;
+    reader[kEnded] = false;
+    reader.on('newListener', onNewListener);
+    reader.on('removeListener', onRemoveListener);
+    if (handle !== undefined)
+      setupReader(reader, handle);
+    // eslint-disable-next-line no-constructor-return
+    return reader;
+  }
+
+  get maxRecordSize() {
+    return this[kMaxRecordSize];
+  }
+
+  get ended() {
+    return this[kEnded];
+  }
+
+  read() {
+    const handle = this[kHandle];
+    if (handle === null || this[kEnded])
+      return null;
+    const record = handle.read();
+    if (record === undefined)
+      return null;
+    if (record === null) {
+      emitEnd(this);
+      return null;
+    }
+    return record;
+  }
+
+  close() {
+    const handle = this[kHandle];
+    if (handle === null)
+      return;
+    this[kHandle] = null;
+    handle.close();
+  }
+
+  [kTransfer]() {
+    const handle = this[kHandle];
+    if (handle === null || this[kEnded])
+      throw lazyDOMException('RingReader is closed', 'DataCloneError');
+    this[kHandle] = null;
+    handle[owner_symbol] = undefined;
+    return {
+      data: { handle },
+      deserializeInfo: 'internal/worker/ring_channel:RingReader',
+    };
+  }
+
+  [kTransferList]() {
+    return this[kHandle] === null ? [] : [this[kHandle]];
+  }
+
+  [kDeserialize]({ handle }) {
+    setupReader(this, handle);
+  }
+}
+
+class RingWriter extends EventEmitter {
+  constructor(handle) {
+    super();
+    const writer = makeTransferable(this);
+    writer[kHandle] = null;
+    writer[kMaxRecordSize] = 0;
+    if (handle !== undefined)
+      setupWriter(writer, handle);
+    // eslint-disable-next-line no-constructor-return
+    return writer;
+  }
+
+  get maxRecordSize() {
+    return this[kMaxRecordSize];
+  }
+
+  write(data) {
+    const handle = this[kHandle];
+    if (handle === null)
+      throw new ERR_INVALID_STATE('RingWriter is closed');
+
+    let size = 0;
+    if (ArrayIsArray(data)) {
+      const chunks = [];
+      for (let i = 0; i < data.length; i++) {
+        const chunk = toChunk(data[i], `data[${i}]`);
+        ArrayPrototypePush(chunks, chunk);
+        size += chunk.byteLength;
+      }
+      data = chunks;
+    } else {
+      data = toChunk(data, 'data');
+      size = data.byteLength;
+    }
+    if (size > this[kMaxRecordSize]) {
+      throw new ERR_OUT_OF_RANGE(
+        'data.byteLength', `<= ${this[kMaxRecordSize]}`, size);
+    }
+
+    if (handle.write(data))
+      return true;
+    // Keep the event loop alive until 'drain' is emitted.
+    handle.ref();
+    return false;
+  }
+
+  close() {
+    const handle = this[kHandle];
+    if (handle === null)
+      return;
+    this[kHandle] = null;
+    handle.close();
+  }
+
+  [kClone]() {
+    if (this[kHandle] === null)
+      throw lazyDOMException('RingWriter is closed', 'DataCloneError');
+    return {
+      data: { handle: this[kHandle] },
+      deserializeInfo: 'internal/worker/ring_channel:RingWriter',
+    };
+  }
+
+  [kDeserialize]({ handle }) {
+    setupWriter(this, handle);
+  }
+}
+
+class RingChannel {
+  constructor(options = kEmptyObject) {
+    validateObject(options, 'options');
+    const { capacity = kDefaultCapacity } = options;
+    validateInteger(capacity, 'options.capacity', kMinCapacity, kMaxCapacity);
+
+    const handle = new RingReaderHandle(2 ** MathCeil(MathLog2(capacity)));
+    this.writer = new RingWriter(handle.createWriter());
+    this.reader = new RingReader(handle);
+  }
+}
+
+module.exports = {
+  RingChannel,
+  RingReader,
+  RingWriter,
+};
@@ -34,7 +34,6 @@ const {
   makeContext,
   isContext: _isContext,
   constants,
-  compileFunction: _compileFunction,
   measureMemory: _measureMemory,
 } = internalBinding('contextify');
 const {
@@ -60,6 +59,7 @@ const {
   kEmptyObject,
   kVmBreakFirstLineSymbol,
 } = require('internal/util');
+const { internalCompileFunction } = require('internal/vm');
 const kParsingContext = Symbol('script parsing context');
 
 class Script extends ContextifyScript {
@@ -357,7 +357,7 @@ function compileFunction(code, params, options = kEmptyObject) {
     validateObject(extension, name, { nullable: true });
   });
 
-  const result = _compileFunction(
+  return internalCompileFunction(
     code,
     filename,
     lineOffset,
@@ -366,31 +366,9 @@ function compileFunction(code, params, options = kEmptyObject) {
     produceCachedData,
     parsingContext,
     contextExtensions,
-    params
+    params,
+    importModuleDynamically
   );
-
-  if (produceCachedData) {
-    result.function.cachedDataProduced = result.cachedDataProduced;
-  }
-
-  if (result.cachedData) {
-    result.function.cachedData = result.cachedData;
-  }
-
-  if (importModuleDynamically !== undefined) {
-    validateFunction(importModuleDynamically,
-                     'options.importModuleDynamically');
-    const { importModuleDynamicallyWrap } =
-      require('internal/vm/module');
-    const { callbackMap } = internalBinding('module_wrap');
-    const wrapped = importModuleDynamicallyWrap(importModuleDynamically);
-    const func = result.function;
-    callbackMap.set(result.cacheKey, {
-      importModuleDynamically: (s, _k, i) => wrapped(s, func, i),
-    });
-  }
-
-  return result.function;
 }
 
 const measureMemoryModes = {
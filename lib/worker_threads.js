@@ -1,5 +1,9 @@
 'use strict';
 
+const {
+  ObjectDefineProperty,
+} = primordials;
+
 const {
   isMainThread,
   SHARE_ENV,
@@ -39,3 +43,13 @@ module.exports = {
   setEnvironmentData,
   getEnvironmentData,
 };
+
+// Loaded lazily, so that workers do not pay for it during startup.
+ObjectDefineProperty(module.exports, 'RingChannel', {
+  __proto__: null,
+  configurable: true,
+  enumerable: true,
+  get() {
+    return require('internal/worker/ring_channel').RingChannel;
+  },
+});
@@ -478,6 +478,7 @@
         'src/node_blob.cc',
         'src/node_buffer.cc',
         'src/node_builtins.cc',
+        'src/node_compile_cache.cc',
         'src/node_config.cc',
         'src/node_constants.cc',
         'src/node_contextify.cc',
@@ -487,6 +488,7 @@
         'src/node_errors.cc',
         'src/node_external_reference.cc',
         'src/node_file.cc',
+        'src/node_file_uring.cc',
         'src/node_http_parser.cc',
         'src/node_http2.cc',
         'src/node_i18n.cc',
@@ -495,6 +497,7 @@
         'src/node_metadata.cc',
         'src/node_options.cc',
         'src/node_os.cc',
+        'src/node_package_json.cc',
         'src/node_perf.cc',
         'src/node_platform.cc',
         'src/node_postmortem_metadata.cc',
@@ -504,6 +507,8 @@
         'src/node_report.cc',
         'src/node_report_module.cc',
         'src/node_report_utils.cc',
+        'src/node_resolution_cache.cc',
+        'src/node_ring_channel.cc',
         'src/node_serdes.cc',
         'src/node_shadow_realm.cc',
         'src/node_snapshotable.cc',
@@ -541,6 +546,7 @@
         'src/tracing/traced_value.cc',
         'src/tty_wrap.cc',
         'src/udp_wrap.cc',
+        'src/utf8_utils.cc',
         'src/util.cc',
         'src/uv.cc',
         # headers to make for a more pleasant IDE experience
@@ -578,6 +584,7 @@
         'src/node_blob.h',
         'src/node_buffer.h',
         'src/node_builtins.h',
+        'src/node_compile_cache.h',
         'src/node_constants.h',
         'src/node_context_data.h',
         'src/node_contextify.h',
@@ -586,6 +593,7 @@
         'src/node_external_reference.h',
         'src/node_file.h',
         'src/node_file-inl.h',
+        'src/node_file_uring.h',
         'src/node_http_common.h',
         'src/node_http_common-inl.h',
         'src/node_http2.h',
@@ -601,13 +609,16 @@
         'src/node_object_wrap.h',
         'src/node_options.h',
         'src/node_options-inl.h',
+        'src/node_package_json.h',
         'src/node_perf.h',
         'src/node_perf_common.h',
         'src/node_platform.h',
         'src/node_process.h',
         'src/node_process-inl.h',
         'src/node_report.h',
+        'src/node_resolution_cache.h',
         'src/node_revert.h',
+        'src/node_ring_channel.h',
         'src/node_root_certs.h',
         'src/node_shadow_realm.h',
         'src/node_snapshotable.h',
@@ -646,6 +657,7 @@
         'src/timer_wrap-inl.h',
         'src/tty_wrap.h',
         'src/udp_wrap.h',
+        'src/utf8_utils.h',
         'src/util.h',
         'src/util-inl.h',
         # Dependency headers
@@ -754,6 +766,7 @@
             'src/crypto/crypto_keys.cc',
             'src/crypto/crypto_keygen.cc',
             'src/crypto/crypto_scrypt.cc',
+            'src/crypto/crypto_session_store.cc',
             'src/crypto/crypto_tls.cc',
             'src/crypto/crypto_aes.cc',
             'src/crypto/crypto_x509.cc',
@@ -772,6 +785,7 @@
             'src/crypto/crypto_keys.h',
             'src/crypto/crypto_keygen.h',
             'src/crypto/crypto_scrypt.h',
+            'src/crypto/crypto_session_store.h',
             'src/crypto/crypto_tls.h',
             'src/crypto/crypto_clienthello.h',
             'src/crypto/crypto_context.h',
@@ -984,6 +998,7 @@
         'test/cctest/test_json_utils.cc',
         'test/cctest/test_sockaddr.cc',
         'test/cctest/test_traced_value.cc',
+        'test/cctest/test_utf8_utils.cc',
         'test/cctest/test_util.cc',
         'test/cctest/test_url.cc',
       ],
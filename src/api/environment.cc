@@ -1,4 +1,7 @@
 #include "node.h"
+#if HAVE_OPENSSL
+#include "crypto/crypto_util.h"
+#endif  // HAVE_OPENSSL
 #include "node_builtins.h"
 #include "node_context_data.h"
 #include "node_errors.h"
@@ -6,6 +9,7 @@
 #include "node_options-inl.h"
 #include "node_platform.h"
 #include "node_shadow_realm.h"
+#include "node_snapshotable.h"
 #include "node_v8_platform-inl.h"
 #include "node_wasm_web_api.h"
 #include "uv.h"
@@ -387,6 +391,62 @@ Environment* CreateEnvironment(
   return env;
 }
 
+Environment* CreateWorkerEnvironmentFromSnapshot(
+    IsolateData* isolate_data,
+    const SnapshotData* snapshot_data,
+    const std::vector<std::string>& args,
+    const std::vector<std::string>& exec_args,
+    EnvironmentFlags::Flags flags,
+    ThreadId thread_id,
+    std::unique_ptr<InspectorParentHandle> inspector_parent_handle) {
+  Isolate* isolate = isolate_data->isolate();
+  HandleScope handle_scope(isolate);
+  Environment* env = new Environment(isolate_data,
+                                     isolate,
+                                     args,
+                                     exec_args,
+                                     &(snapshot_data->worker_env_info),
+                                     flags,
+                                     thread_id);
+  Local<Context> context =
+      Context::FromSnapshot(isolate,
+                            SnapshotData::kNodeWorkerContextIndex,
+                            {DeserializeNodeInternalFields, env})
+          .ToLocalChecked();
+  Context::Scope context_scope(context);
+  // Attach the context first, so that the Environment can be freed if the
+  // rest fails because the worker is being terminated.
+  env->InitializeMainContext(context, &(snapshot_data->worker_env_info));
+  if (InitializeContextRuntime(context).IsNothing()) {
+    FreeEnvironment(env);
+    return nullptr;
+  }
+#if HAVE_INSPECTOR
+  if (env->should_create_inspector()) {
+    if (inspector_parent_handle) {
+      env->InitializeInspector(
+          std::move(static_cast<InspectorParentHandleImpl*>(
+              inspector_parent_handle.get())->impl));
+    } else {
+      env->InitializeInspector({});
+    }
+  }
+#endif
+
+#if HAVE_OPENSSL
+  // The crypto binding may have been loaded while the worker context was
+  // bootstrapped, in which case it is not initialized again.
+  crypto::InitCryptoOnce(isolate);
+#endif  // HAVE_OPENSSL
+
+  if (env->RunWorkerSnapshotBootstrapping().IsEmpty()) {
+    FreeEnvironment(env);
+    return nullptr;
+  }
+
+  return env;
+}
+
 void FreeEnvironment(Environment* env) {
   Isolate* isolate = env->isolate();
   Isolate::DisallowJavascriptExecutionScope disallow_js(isolate,
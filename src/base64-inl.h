@@ -7,6 +7,8 @@
 #include "libbase64.h"
 #include "util.h"
 
+#include <cstring>
+
 namespace node {
 
 extern const int8_t unbase64_table[256];
@@ -113,9 +115,70 @@ size_t base64_decoded_size(const TypeName* src, size_t size) {
 }
 
 
+// Decodes canonical base64 with the SIMD codecs from deps/base64, which
+// pick the fastest implementation for the host CPU at runtime. Returns false
+// when the input needs the lenient decoder above, for example because it
+// contains whitespace or characters from the URL-safe alphabet; the caller
+// must then decode it again.
+inline bool base64_decode_simd(char* const dst, const size_t dstlen,
+                               const char* const src, size_t srclen,
+                               size_t* const written) {
+  // The vectorized loops store whole registers and may leave up to 8 junk
+  // bytes after the last decoded byte when they hit invalid input. Only use
+  // them when the output could hold every input character as payload...
+  if (dstlen < base64_decoded_size_fast(srclen))
+    return false;
+
+  // Trailing line breaks are common in files and would otherwise make us
+  // decode everything twice.
+  while (srclen > 0 && (src[srclen - 1] == '\n' || src[srclen - 1] == '\r' ||
+                        src[srclen - 1] == ' ' || src[srclen - 1] == '\t')) {
+    srclen--;
+  }
+
+  // ...and when the lenient decoder would overwrite that junk if it has to
+  // take over: it stops at the first '=', so that may only start the padding,
+  // and at least 16 valid characters must follow any invalid one.
+  size_t padding = 0;
+  const void* eq = memchr(src, '=', srclen);
+  if (eq != nullptr) {
+    padding = src + srclen - static_cast<const char*>(eq);
+    if (padding > 2 || (padding == 2 && src[srclen - 1] != '='))
+      return false;
+  }
+  const size_t payload = srclen - padding;
+  for (size_t i = payload > 16 ? payload - 16 : 0; i < payload; i++) {
+    const uint8_t c = static_cast<uint8_t>(src[i]);
+    if (unbase64(c) < 0 || c == '-' || c == '_')
+      return false;
+  }
+
+  struct base64_state state;
+  base64_stream_decode_init(&state, 0);
+  size_t outlen = 0;
+  // Unlike ::base64_decode(), accept unpadded input. A dangling sixth bit
+  // group (state.bytes == 1) produces no output, like the scalar decoder.
+  if (base64_stream_decode(&state, src, srclen, dst, &outlen) != 1)
+    return false;
+
+  *written = outlen;
+  return true;
+}
+
+
 template <typename TypeName>
 size_t base64_decode(char* const dst, const size_t dstlen,
                      const TypeName* const src, const size_t srclen) {
+  if constexpr (sizeof(TypeName) == 1) {
+    size_t written;
+    if (base64_decode_simd(dst,
+                           dstlen,
+                           reinterpret_cast<const char*>(src),
+                           srclen,
+                           &written)) {
+      return written;
+    }
+  }
   const size_t decoded_size = base64_decoded_size(src, srclen);
   return base64_decode_fast(dst, dstlen, src, srclen, decoded_size);
 }
@@ -139,30 +202,26 @@ inline size_t base64_encode(const char* src,
 
   unsigned a;
   unsigned b;
-  unsigned c;
-  unsigned i;
-  unsigned k;
-  unsigned n;
+  size_t i;
+  size_t k;
+  size_t n;
 
   const char* table = base64_select_table(mode);
 
-  i = 0;
-  k = 0;
+  // Encode all complete groups with the SIMD codec, which never pads them,
+  // and translate the result to the URL-safe alphabet.
   n = slen / 3 * 3;
-
-  while (i < n) {
-    a = src[i + 0] & 0xff;
-    b = src[i + 1] & 0xff;
-    c = src[i + 2] & 0xff;
-
-    dst[k + 0] = table[a >> 2];
-    dst[k + 1] = table[((a & 3) << 4) | (b >> 4)];
-    dst[k + 2] = table[((b & 0x0f) << 2) | (c >> 6)];
-    dst[k + 3] = table[c & 0x3f];
-
-    i += 3;
-    k += 4;
+  k = 0;
+  if (n > 0) {
+    ::base64_encode(src, n, dst, &k, 0);
+    for (size_t j = 0; j < k; j++) {
+      if (dst[j] == '+')
+        dst[j] = '-';
+      else if (dst[j] == '/')
+        dst[j] = '_';
+    }
   }
+  i = n;
 
   switch (slen - n) {
     case 1:
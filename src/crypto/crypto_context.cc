@@ -1,6 +1,7 @@
 #include "crypto/crypto_context.h"
 #include "crypto/crypto_bio.h"
 #include "crypto/crypto_common.h"
+#include "crypto/crypto_session_store.h"
 #include "crypto/crypto_util.h"
 #include "base_object-inl.h"
 #include "env-inl.h"
@@ -282,6 +283,7 @@ Local<FunctionTemplate> SecureContext::GetConstructorTemplate(
     SetProtoMethod(isolate, tmpl, "setOptions", SetOptions);
     SetProtoMethod(isolate, tmpl, "setSessionIdContext", SetSessionIdContext);
     SetProtoMethod(isolate, tmpl, "setSessionTimeout", SetSessionTimeout);
+    SetProtoMethod(isolate, tmpl, "setSessionStore", SetSessionStore);
     SetProtoMethod(isolate, tmpl, "close", Close);
     SetProtoMethod(isolate, tmpl, "loadPKCS12", LoadPKCS12);
     SetProtoMethod(isolate, tmpl, "setTicketKeys", SetTicketKeys);
@@ -362,6 +364,7 @@ void SecureContext::RegisterExternalReferences(
   registry->Register(SetOptions);
   registry->Register(SetSessionIdContext);
   registry->Register(SetSessionTimeout);
+  registry->Register(SetSessionStore);
   registry->Register(Close);
   registry->Register(LoadPKCS12);
   registry->Register(SetTicketKeys);
@@ -959,6 +962,31 @@ void SecureContext::SetSessionTimeout(const FunctionCallbackInfo<Value>& args) {
   SSL_CTX_set_timeout(sc->ctx_.get(), sessionTimeout);
 }
 
+// Makes servers using this context look up and store sessions in the given
+// SessionStore, and use its ticket keys and session ID context, so that all
+// contexts sharing the store can resume each other's sessions.
+void SecureContext::SetSessionStore(const FunctionCallbackInfo<Value>& args) {
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
+  Environment* env = sc->env();
+
+  CHECK_GE(args.Length(), 1);
+  CHECK(SessionStoreHandle::HasInstance(env, args[0]));
+  SessionStoreHandle* handle;
+  ASSIGN_OR_RETURN_UNWRAP(&handle, args[0]);
+  const std::shared_ptr<SessionStore>& store = handle->store();
+
+  const unsigned char* keys = store->ticket_keys();
+  memcpy(sc->ticket_key_name_, keys, 16);
+  memcpy(sc->ticket_key_hmac_, keys + 16, 16);
+  memcpy(sc->ticket_key_aes_, keys + 32, 16);
+  CHECK_EQ(SSL_CTX_set_session_id_context(sc->ctx_.get(),
+                                          store->session_id_context(),
+                                          SessionStore::kSessionIdContextSize),
+           1);
+  sc->session_store_ = store;
+}
+
 void SecureContext::Close(const FunctionCallbackInfo<Value>& args) {
   SecureContext* sc;
   ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
@@ -1256,7 +1284,11 @@ int SecureContext::TicketCompatibilityCallback(SSL* ssl,
     return 1;
   }
 
-  if (memcmp(name, sc->ticket_key_name_, sizeof(sc->ticket_key_name_)) != 0) {
+  const bool known =
+      memcmp(name, sc->ticket_key_name_, sizeof(sc->ticket_key_name_)) == 0;
+  if (sc->session_store_)
+    sc->session_store_->RecordTicket(known);
+  if (!known) {
     // The ticket key name does not match. Discard the ticket.
     return 0;
   }
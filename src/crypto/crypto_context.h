@@ -9,8 +9,12 @@
 #include "memory_tracker.h"
 #include "v8.h"
 
+#include <memory>
+
 namespace node {
 namespace crypto {
+class SessionStore;
+
 // A maxVersion of 0 means "any", but OpenSSL may support TLS versions that
 // Node.js doesn't, so pin the max to what we do support.
 constexpr int kMaxSupportedVersion = TLS1_3_VERSION;
@@ -50,6 +54,11 @@ class SecureContext final : public BaseObject {
   void SetNewSessionCallback(NewSessionCb cb);
   void SetSelectSNIContextCallback(SelectSNIContextCb cb);
 
+  // The store that servers using this context look sessions up in, if any.
+  const std::shared_ptr<SessionStore>& session_store() const {
+    return session_store_;
+  }
+
   // TODO(joyeecheung): track the memory used by OpenSSL types
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(SecureContext)
@@ -88,6 +97,7 @@ class SecureContext final : public BaseObject {
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetSessionTimeout(
       const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetSessionStore(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetMinProto(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetMaxProto(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetMinProto(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -138,6 +148,8 @@ class SecureContext final : public BaseObject {
   unsigned char ticket_key_name_[16];
   unsigned char ticket_key_aes_[16];
   unsigned char ticket_key_hmac_[16];
+
+  std::shared_ptr<SessionStore> session_store_;
 };
 
 }  // namespace crypto
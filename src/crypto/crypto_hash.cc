@@ -3,14 +3,19 @@
 #include "base_object-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
+#include "node_mutex.h"
 #include "string_bytes.h"
 #include "threadpoolwork-inl.h"
 #include "v8.h"
 
 #include <cstdio>
+#include <string>
+#include <unordered_map>
 
 namespace node {
 
+using v8::Array;
+using v8::ArrayBufferView;
 using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -22,9 +27,61 @@ using v8::MaybeLocal;
 using v8::Nothing;
 using v8::Object;
 using v8::Uint32;
+using v8::Uint32Array;
 using v8::Value;
 
 namespace crypto {
+#if OPENSSL_VERSION_MAJOR >= 3
+namespace {
+struct DigestCache {
+  Mutex mutex;
+  std::unordered_map<std::string, const EVP_MD*> digests;
+};
+
+// Intentionally leaked, so that the implementations outlive all threads that
+// may still use them while the process exits. They are not freed when the
+// cache is reset either, because jobs on the thread pool may refer to them.
+DigestCache* GetDigestCache() {
+  static DigestCache* const cache = new DigestCache();
+  return cache;
+}
+}  // anonymous namespace
+#endif
+
+const EVP_MD* GetDigestImplementation(const char* name) {
+#if OPENSSL_VERSION_MAJOR >= 3
+  DigestCache* const cache = GetDigestCache();
+  Mutex::ScopedLock lock(cache->mutex);
+  auto it = cache->digests.find(name);
+  if (it != cache->digests.end()) return it->second;
+
+  MarkPopErrorOnReturn mark_pop_error_on_return;
+  const EVP_MD* md = EVP_MD_fetch(nullptr, name, nullptr);
+  if (md == nullptr) {
+    // Names like "RSA-SHA256" are only known to the legacy lookup. Use it to
+    // find the canonical name, and fetch the implementation by that name.
+    const EVP_MD* legacy_md = EVP_get_digestbyname(name);
+    if (legacy_md == nullptr) return nullptr;
+    md = EVP_MD_fetch(nullptr, EVP_MD_get0_name(legacy_md), nullptr);
+    if (md == nullptr) md = legacy_md;
+  }
+  // Unknown names are not cached, so that the table stays bounded by the
+  // number of supported algorithms and their aliases.
+  cache->digests.emplace(name, md);
+  return md;
+#else
+  return EVP_get_digestbyname(name);
+#endif
+}
+
+void ResetDigestImplementations() {
+#if OPENSSL_VERSION_MAJOR >= 3
+  DigestCache* const cache = GetDigestCache();
+  Mutex::ScopedLock lock(cache->mutex);
+  cache->digests.clear();
+#endif
+}
+
 Hash::Hash(Environment* env, Local<Object> wrap) : BaseObject(env, wrap) {
   MakeWeak();
 }
@@ -67,8 +124,10 @@ void Hash::Initialize(Environment* env, Local<Object> target) {
   SetConstructorFunction(context, target, "Hash", t);
 
   SetMethodNoSideEffect(context, target, "getHashes", GetHashes);
+  SetMethodNoSideEffect(context, target, "oneShotDigest", OneShotDigest);
 
   HashJob::Initialize(env, target);
+  HashBatchJob::Initialize(env, target);
 }
 
 void Hash::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
@@ -76,8 +135,10 @@ void Hash::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(HashUpdate);
   registry->Register(HashDigest);
   registry->Register(GetHashes);
+  registry->Register(OneShotDigest);
 
   HashJob::RegisterExternalReferences(registry);
+  HashBatchJob::RegisterExternalReferences(registry);
 }
 
 void Hash::New(const FunctionCallbackInfo<Value>& args) {
@@ -91,7 +152,7 @@ void Hash::New(const FunctionCallbackInfo<Value>& args) {
     md = EVP_MD_CTX_md(orig->mdctx_.get());
   } else {
     const Utf8Value hash_type(env->isolate(), args[0]);
-    md = EVP_get_digestbyname(*hash_type);
+    md = GetDigestImplementation(*hash_type);
   }
 
   Maybe<unsigned int> xof_md_len = Nothing<unsigned int>();
@@ -112,6 +173,50 @@ void Hash::New(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// crypto.hash(algorithm, data, outputEncoding): computes the digest of a string
+// or buffer in a single call, without creating a Hash object.
+void Hash::OneShotDigest(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  CHECK_EQ(args.Length(), 3);
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsString() || IsAnyByteSource(args[1]));
+
+  const Utf8Value algorithm(isolate, args[0]);
+  const EVP_MD* md = GetDigestImplementation(*algorithm);
+  if (md == nullptr) {
+    return ThrowCryptoError(env, ERR_get_error(),
+                            "Digest method not supported");
+  }
+
+  const enum encoding output_encoding = ParseEncoding(isolate, args[2], BUFFER);
+
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_len;
+  int ret;
+  if (args[1]->IsString()) {
+    const Utf8Value data(isolate, args[1]);
+    ret = EVP_Digest(*data, data.length(), digest, &digest_len, md, nullptr);
+  } else {
+    ArrayBufferOrViewContents<unsigned char> data(args[1]);
+    ret = EVP_Digest(
+        data.data(), data.size(), digest, &digest_len, md, nullptr);
+  }
+  if (ret != 1)
+    return ThrowCryptoError(env, ERR_get_error());
+
+  Local<Value> error;
+  MaybeLocal<Value> rc = StringBytes::Encode(
+      isolate, reinterpret_cast<char*>(digest), digest_len, output_encoding,
+      &error);
+  if (rc.IsEmpty()) {
+    CHECK(!error.IsEmpty());
+    isolate->ThrowException(error);
+    return;
+  }
+  args.GetReturnValue().Set(rc.FromMaybe(Local<Value>()));
+}
+
 bool Hash::HashInit(const EVP_MD* md, Maybe<unsigned int> xof_md_len) {
   mdctx_.reset(EVP_MD_CTX_new());
   if (!mdctx_ || EVP_DigestInit_ex(mdctx_.get(), md, nullptr) <= 0) {
@@ -244,7 +349,7 @@ Maybe<bool> HashTraits::AdditionalConfig(
 
   CHECK(args[offset]->IsString());  // Hash algorithm
   Utf8Value digest(env->isolate(), args[offset]);
-  params->digest = EVP_get_digestbyname(*digest);
+  params->digest = GetDigestImplementation(*digest);
   if (UNLIKELY(params->digest == nullptr)) {
     THROW_ERR_CRYPTO_INVALID_DIGEST(env, "Invalid digest: %s", *digest);
     return Nothing<bool>();
@@ -310,5 +415,144 @@ bool HashTraits::DeriveBits(
   return true;
 }
 
+HashBatchConfig::HashBatchConfig(HashBatchConfig&& other) noexcept
+    : mode(other.mode),
+      in(std::move(other.in)),
+      boundaries(std::move(other.boundaries)),
+      digest(other.digest) {}
+
+HashBatchConfig& HashBatchConfig::operator=(HashBatchConfig&& other) noexcept {
+  if (&other == this) return *this;
+  this->~HashBatchConfig();
+  return *new (this) HashBatchConfig(std::move(other));
+}
+
+void HashBatchConfig::MemoryInfo(MemoryTracker* tracker) const {
+  // If the Job is sync and the input was a single buffer, then the
+  // HashBatchConfig does not own the data.
+  if (mode == kCryptoJobAsync)
+    tracker->TrackFieldWithSize("in", in.size());
+  tracker->TrackFieldWithSize("boundaries",
+                              boundaries.size() * sizeof(boundaries[0]));
+}
+
+Maybe<bool> HashBatchTraits::EncodeOutput(
+    Environment* env,
+    const HashBatchConfig& params,
+    ByteSource* out,
+    v8::Local<v8::Value>* result) {
+  *result = out->ToArrayBuffer(env);
+  return Just(!result->IsEmpty());
+}
+
+// Arguments are the algorithm, and either an array of buffers, or a single
+// buffer together with a Uint32Array of the offsets at which the inputs start.
+Maybe<bool> HashBatchTraits::AdditionalConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    HashBatchConfig* params) {
+  Environment* env = Environment::GetCurrent(args);
+
+  params->mode = mode;
+
+  CHECK(args[offset]->IsString());  // Hash algorithm
+  Utf8Value digest(env->isolate(), args[offset]);
+  params->digest = GetDigestImplementation(*digest);
+  if (UNLIKELY(params->digest == nullptr)) {
+    THROW_ERR_CRYPTO_INVALID_DIGEST(env, "Invalid digest: %s", *digest);
+    return Nothing<bool>();
+  }
+
+  if (args[offset + 1]->IsArray()) {
+    // Concatenate the inputs, so that the job owns a copy of them no matter
+    // how many there are, with a single allocation.
+    Local<Array> inputs = args[offset + 1].As<Array>();
+    const uint32_t count = inputs->Length();
+    std::vector<Local<Value>> values(count);
+    size_t total = 0;
+    for (uint32_t i = 0; i < count; i++) {
+      if (!inputs->Get(env->context(), i).ToLocal(&values[i]))
+        return Nothing<bool>();
+      CHECK(values[i]->IsArrayBufferView());
+      total += values[i].As<ArrayBufferView>()->ByteLength();
+      if (UNLIKELY(total > INT_MAX)) {
+        THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+        return Nothing<bool>();
+      }
+    }
+
+    params->boundaries.reserve(count + 1);
+    ByteSource::Builder buf(total);
+    size_t position = 0;
+    for (uint32_t i = 0; i < count; i++) {
+      params->boundaries.push_back(static_cast<uint32_t>(position));
+      position += values[i].As<ArrayBufferView>()->CopyContents(
+          buf.data<char>() + position, total - position);
+    }
+    params->boundaries.push_back(static_cast<uint32_t>(position));
+    params->in = std::move(buf).release();
+    return Just(true);
+  }
+
+  ArrayBufferOrViewContents<char> data(args[offset + 1]);
+  if (UNLIKELY(!data.CheckSizeInt32())) {
+    THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+    return Nothing<bool>();
+  }
+  params->in = mode == kCryptoJobAsync
+      ? data.ToCopy()
+      : data.ToByteSource();
+
+  CHECK(args[offset + 2]->IsUint32Array());
+  Local<Uint32Array> offsets = args[offset + 2].As<Uint32Array>();
+  params->boundaries.resize(offsets->Length() + 1);
+  offsets->CopyContents(params->boundaries.data(),
+                        offsets->ByteLength());
+  params->boundaries.back() = static_cast<uint32_t>(data.size());
+  // The offsets have been validated in JS, but against a byteLength that
+  // user code could have overridden.
+  for (size_t i = 1; i < params->boundaries.size(); i++) {
+    if (UNLIKELY(params->boundaries[i - 1] > params->boundaries[i])) {
+      THROW_ERR_OUT_OF_RANGE(env, "offsets are out of range");
+      return Nothing<bool>();
+    }
+  }
+  return Just(true);
+}
+
+bool HashBatchTraits::DeriveBits(
+    Environment* env,
+    const HashBatchConfig& params,
+    ByteSource* out) {
+  const size_t count = params.boundaries.size() - 1;
+  if (count == 0) return true;
+
+  // The context is reused for all inputs, which only resets its state.
+  EVPMDPointer ctx(EVP_MD_CTX_new());
+  const unsigned int digest_size = EVP_MD_size(params.digest);
+  if (UNLIKELY(!ctx || digest_size == 0)) return false;
+
+  ByteSource::Builder buf(count * digest_size);
+  const char* data = params.in.data<char>();
+  unsigned char* result = buf.data<unsigned char>();
+  for (size_t i = 0; i < count; i++) {
+    const uint32_t start = params.boundaries[i];
+    const uint32_t end = params.boundaries[i + 1];
+    unsigned int length;
+    if (UNLIKELY(
+            EVP_DigestInit_ex(ctx.get(), params.digest, nullptr) <= 0 ||
+            EVP_DigestUpdate(ctx.get(), data + start, end - start) <= 0 ||
+            EVP_DigestFinal_ex(ctx.get(), result, &length) <= 0)) {
+      return false;
+    }
+    CHECK_EQ(length, digest_size);
+    result += digest_size;
+  }
+
+  *out = std::move(buf).release();
+  return true;
+}
+
 }  // namespace crypto
 }  // namespace node
@@ -10,8 +10,21 @@
 #include "memory_tracker.h"
 #include "v8.h"
 
+#include <vector>
+
 namespace node {
 namespace crypto {
+// Returns the implementation of the digest algorithm `name`, or nullptr if it
+// is not supported. With OpenSSL 3, implementations are fetched explicitly
+// from the providers once and then cached for the lifetime of the process,
+// instead of being looked up again by every EVP_DigestInit_ex() call. The
+// result can be used on any thread.
+const EVP_MD* GetDigestImplementation(const char* name);
+
+// Drops the cached implementations, e.g. because FIPS mode was toggled and
+// digests need to be fetched from another provider.
+void ResetDigestImplementations();
+
 class Hash final : public BaseObject {
  public:
   static void Initialize(Environment* env, v8::Local<v8::Object> target);
@@ -25,6 +38,7 @@ class Hash final : public BaseObject {
   bool HashUpdate(const char* data, size_t len);
 
   static void GetHashes(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void OneShotDigest(const v8::FunctionCallbackInfo<v8::Value>& args);
 
  protected:
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -82,6 +96,52 @@ struct HashTraits final {
 
 using HashJob = DeriveBitsJob<HashTraits>;
 
+// Computes the digests of many inputs in a single job. The inputs are stored
+// back to back in `in`, and input i spans the bytes from boundaries[i] to
+// boundaries[i + 1]. The result contains the digests in the same order.
+struct HashBatchConfig final : public MemoryRetainer {
+  CryptoJobMode mode;
+  ByteSource in;
+  std::vector<uint32_t> boundaries;
+  const EVP_MD* digest;
+
+  HashBatchConfig() = default;
+
+  explicit HashBatchConfig(HashBatchConfig&& other) noexcept;
+
+  HashBatchConfig& operator=(HashBatchConfig&& other) noexcept;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(HashBatchConfig)
+  SET_SELF_SIZE(HashBatchConfig)
+};
+
+struct HashBatchTraits final {
+  using AdditionalParameters = HashBatchConfig;
+  static constexpr const char* JobName = "HashBatchJob";
+  static constexpr AsyncWrap::ProviderType Provider =
+      AsyncWrap::PROVIDER_HASHREQUEST;
+
+  static v8::Maybe<bool> AdditionalConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      HashBatchConfig* params);
+
+  static bool DeriveBits(
+      Environment* env,
+      const HashBatchConfig& params,
+      ByteSource* out);
+
+  static v8::Maybe<bool> EncodeOutput(
+      Environment* env,
+      const HashBatchConfig& params,
+      ByteSource* out,
+      v8::Local<v8::Value>* result);
+};
+
+using HashBatchJob = DeriveBitsJob<HashBatchTraits>;
+
 }  // namespace crypto
 }  // namespace node
 
@@ -0,0 +1,431 @@
+#include "crypto/crypto_session_store.h"
+#include "base_object-inl.h"
+#include "crypto/crypto_context.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_errors.h"
+#include "node_external_reference.h"
+#include "node_internals.h"
+#include "util-inl.h"
+#include "uv.h"
+#include "v8.h"
+
+#include <openssl/rand.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <functional>
+
+namespace node {
+
+using v8::Array;
+using v8::Context;
+using v8::EscapableHandleScope;
+using v8::Function;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::Isolate;
+using v8::Local;
+using v8::MaybeLocal;
+using v8::Number;
+using v8::Object;
+using v8::Uint32;
+using v8::Value;
+
+namespace crypto {
+
+namespace {
+
+constexpr char kSessionFileSuffix[] = ".session";
+
+time_t GetExpiryTime(const SSL_SESSION* session) {
+  return SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session);
+}
+
+void Unlink(const std::string& path) {
+  uv_fs_t req;
+  uv_fs_unlink(nullptr, &req, path.c_str(), nullptr);
+  uv_fs_req_cleanup(&req);
+}
+
+}  // anonymous namespace
+
+MemorySessionStoreBackend::MemorySessionStoreBackend(size_t capacity,
+                                                     size_t shard_count) {
+  CHECK_GT(capacity, 0);
+  CHECK_GT(shard_count, 0);
+  // Every shard holds at least one session, and the first ones hold one more
+  // than the others if the capacity cannot be split evenly.
+  shard_count = std::min(shard_count, capacity);
+  shards_.reserve(shard_count);
+  for (size_t i = 0; i < shard_count; i++) {
+    shards_.push_back(std::make_unique<Shard>(
+        capacity / shard_count + (i < capacity % shard_count ? 1 : 0)));
+  }
+}
+
+MemorySessionStoreBackend::Shard* MemorySessionStoreBackend::GetShard(
+    const std::string& id) {
+  return shards_[std::hash<std::string>()(id) % shards_.size()].get();
+}
+
+bool MemorySessionStoreBackend::Get(const std::string& id,
+                                    std::string* session) {
+  Shard* shard = GetShard(id);
+  Mutex::ScopedLock lock(shard->mutex);
+  auto it = shard->index.find(id);
+  if (it == shard->index.end()) return false;
+  shard->entries.splice(shard->entries.begin(), shard->entries, it->second);
+  *session = it->second->second;
+  return true;
+}
+
+void MemorySessionStoreBackend::Put(const std::string& id,
+                                    const std::string& session,
+                                    time_t expires) {
+  Shard* shard = GetShard(id);
+  Mutex::ScopedLock lock(shard->mutex);
+  auto it = shard->index.find(id);
+  if (it != shard->index.end()) {
+    it->second->second = session;
+    shard->entries.splice(shard->entries.begin(), shard->entries, it->second);
+    return;
+  }
+  if (shard->entries.size() >= shard->capacity) {
+    shard->index.erase(shard->entries.back().first);
+    shard->entries.pop_back();
+    evictions_++;
+  }
+  shard->entries.emplace_front(id, session);
+  shard->index.emplace(id, shard->entries.begin());
+}
+
+void MemorySessionStoreBackend::Remove(const std::string& id) {
+  Shard* shard = GetShard(id);
+  Mutex::ScopedLock lock(shard->mutex);
+  auto it = shard->index.find(id);
+  if (it == shard->index.end()) return;
+  shard->entries.erase(it->second);
+  shard->index.erase(it);
+}
+
+size_t MemorySessionStoreBackend::Size() const {
+  size_t size = 0;
+  for (const auto& shard : shards_) {
+    Mutex::ScopedLock lock(shard->mutex);
+    size += shard->entries.size();
+  }
+  return size;
+}
+
+FileSessionStoreBackend::FileSessionStoreBackend(const std::string& directory,
+                                                 size_t capacity)
+    : directory_(directory),
+      capacity_(capacity),
+      sweep_interval_(std::max<size_t>(1, capacity / 8)) {}
+
+std::string FileSessionStoreBackend::GetPath(const std::string& id) const {
+  static constexpr char kHex[] = "0123456789abcdef";
+  std::string path = directory_ + kPathSeparator;
+  for (unsigned char c : id) {
+    path += kHex[c >> 4];
+    path += kHex[c & 15];
+  }
+  return path + kSessionFileSuffix;
+}
+
+bool FileSessionStoreBackend::Get(const std::string& id,
+                                  std::string* session) {
+  return ReadFileSync(session, GetPath(id).c_str()) == 0;
+}
+
+void FileSessionStoreBackend::Put(const std::string& id,
+                                  const std::string& session,
+                                  time_t expires) {
+  const uint64_t write = writes_++;
+  const std::string path = GetPath(id);
+  // Unique per process and call, so that concurrent writers do not share a
+  // temporary file.
+  const std::string temp_path = SPrintF(
+      "%s.%d.%d.tmp", path, uv_os_getpid(), write);
+  uv_buf_t buf = uv_buf_init(const_cast<char*>(session.data()),
+                             session.size());
+  if (WriteFileAtomically(path.c_str(), temp_path.c_str(), &buf, 1) == 0) {
+    uv_fs_t req;
+    uv_fs_utime(nullptr,
+                &req,
+                path.c_str(),
+                static_cast<double>(expires),
+                static_cast<double>(expires),
+                nullptr);
+    uv_fs_req_cleanup(&req);
+  }
+
+  if ((write + 1) % sweep_interval_ == 0)
+    Sweep();
+}
+
+void FileSessionStoreBackend::Remove(const std::string& id) {
+  Unlink(GetPath(id));
+}
+
+void FileSessionStoreBackend::Sweep() {
+  // Another thread is already at it.
+  if (sweeping_.exchange(true)) return;
+
+  const time_t now = time(nullptr);
+  // Expiry time and path of the sessions that are still valid.
+  std::vector<std::pair<time_t, std::string>> sessions;
+  uv_fs_t req;
+  if (uv_fs_scandir(nullptr, &req, directory_.c_str(), 0, nullptr) >= 0) {
+    uv_dirent_t ent;
+    while (uv_fs_scandir_next(&req, &ent) != UV_EOF) {
+      const size_t length = strlen(ent.name);
+      const size_t suffix_length = sizeof(kSessionFileSuffix) - 1;
+      if (length <= suffix_length ||
+          strcmp(ent.name + length - suffix_length, kSessionFileSuffix) != 0) {
+        continue;
+      }
+      std::string path = directory_ + kPathSeparator + ent.name;
+      uv_fs_t stat_req;
+      if (uv_fs_stat(nullptr, &stat_req, path.c_str(), nullptr) == 0) {
+        const time_t expires = static_cast<time_t>(
+            static_cast<const uv_stat_t*>(stat_req.ptr)->st_mtim.tv_sec);
+        if (expires < now)
+          Unlink(path);
+        else
+          sessions.emplace_back(expires, std::move(path));
+      }
+      uv_fs_req_cleanup(&stat_req);
+    }
+  }
+  uv_fs_req_cleanup(&req);
+
+  if (sessions.size() > capacity_) {
+    const auto end = sessions.begin() + (sessions.size() - capacity_);
+    std::nth_element(sessions.begin(), end, sessions.end());
+    for (auto it = sessions.begin(); it != end; ++it)
+      Unlink(it->second);
+  }
+
+  sweeping_ = false;
+}
+
+SessionStore::SessionStore(
+    std::vector<std::unique_ptr<SessionStoreBackend>>&& backends,
+    const unsigned char* ticket_keys,
+    const unsigned char* session_id_context)
+    : backends_(std::move(backends)) {
+  CHECK(!backends_.empty());
+  memcpy(ticket_keys_, ticket_keys, sizeof(ticket_keys_));
+  memcpy(session_id_context_, session_id_context,
+         sizeof(session_id_context_));
+}
+
+SSLSessionPointer SessionStore::Get(const unsigned char* id, size_t length) {
+  const std::string key(reinterpret_cast<const char*>(id), length);
+  std::string serialized;
+  size_t found = 0;
+  while (found < backends_.size() && !backends_[found]->Get(key, &serialized))
+    found++;
+  if (found == backends_.size()) {
+    misses_++;
+    return SSLSessionPointer();
+  }
+
+  const unsigned char* p =
+      reinterpret_cast<const unsigned char*>(serialized.data());
+  SSLSessionPointer session(d2i_SSL_SESSION(nullptr, &p, serialized.size()));
+  if (!session || GetExpiryTime(session.get()) < time(nullptr)) {
+    for (const auto& backend : backends_)
+      backend->Remove(key);
+    misses_++;
+    return SSLSessionPointer();
+  }
+
+  for (size_t i = 0; i < found; i++)
+    backends_[i]->Put(key, serialized, GetExpiryTime(session.get()));
+  hits_++;
+  return session;
+}
+
+void SessionStore::Put(SSL_SESSION* session) {
+  const int size = i2d_SSL_SESSION(session, nullptr);
+  if (size <= 0 || size > SecureContext::kMaxSessionSize)
+    return;
+  std::string serialized(size, '\0');
+  unsigned char* p = reinterpret_cast<unsigned char*>(&serialized[0]);
+  CHECK_EQ(i2d_SSL_SESSION(session, &p), size);
+
+  unsigned int id_length;
+  const unsigned char* id = SSL_SESSION_get_id(session, &id_length);
+  if (id_length == 0)
+    return;
+  const std::string key(reinterpret_cast<const char*>(id), id_length);
+  const time_t expires = GetExpiryTime(session);
+  for (const auto& backend : backends_)
+    backend->Put(key, serialized, expires);
+  stores_++;
+}
+
+void SessionStore::RecordTicket(bool hit) {
+  if (hit)
+    ticket_hits_++;
+  else
+    ticket_misses_++;
+}
+
+SessionStore::Stats SessionStore::GetStats() const {
+  Stats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.stores = stores_;
+  stats.ticket_hits = ticket_hits_;
+  stats.ticket_misses = ticket_misses_;
+  stats.evictions = backends_[0]->Evictions();
+  stats.size = backends_[0]->Size();
+  return stats;
+}
+
+SessionStoreHandle::SessionStoreHandle(Environment* env,
+                                       Local<Object> object,
+                                       std::shared_ptr<SessionStore> store)
+    : BaseObject(env, object), store_(std::move(store)) {
+  MakeWeak();
+}
+
+void SessionStoreHandle::MemoryInfo(MemoryTracker* tracker) const {
+  // The store is shared with other threads, and is not accounted for here.
+}
+
+Local<FunctionTemplate> SessionStoreHandle::GetConstructorTemplate(
+    Environment* env) {
+  Local<FunctionTemplate> tmpl = env->session_store_constructor_template();
+  if (tmpl.IsEmpty()) {
+    Isolate* isolate = env->isolate();
+    tmpl = NewFunctionTemplate(isolate, nullptr);
+    tmpl->InstanceTemplate()->SetInternalFieldCount(
+        BaseObject::kInternalFieldCount);
+    tmpl->Inherit(BaseObject::GetConstructorTemplate(env));
+    tmpl->SetClassName(
+        FIXED_ONE_BYTE_STRING(env->isolate(), "SessionStoreHandle"));
+    SetProtoMethodNoSideEffect(isolate, tmpl, "getStats", GetStats);
+    env->set_session_store_constructor_template(tmpl);
+  }
+  return tmpl;
+}
+
+bool SessionStoreHandle::HasInstance(Environment* env, Local<Value> value) {
+  return GetConstructorTemplate(env)->HasInstance(value);
+}
+
+MaybeLocal<Object> SessionStoreHandle::New(
+    Environment* env, std::shared_ptr<SessionStore> store) {
+  EscapableHandleScope scope(env->isolate());
+  Local<Function> ctor;
+  if (!GetConstructorTemplate(env)->GetFunction(env->context()).ToLocal(&ctor))
+    return MaybeLocal<Object>();
+
+  Local<Object> obj;
+  if (!ctor->NewInstance(env->context()).ToLocal(&obj))
+    return MaybeLocal<Object>();
+
+  new SessionStoreHandle(env, obj, std::move(store));
+  return scope.Escape(obj);
+}
+
+// createSessionStore(capacity, shardCount, directory)
+void SessionStoreHandle::CreateSessionStore(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint32());
+  CHECK(args[1]->IsUint32());
+  const uint32_t capacity = args[0].As<Uint32>()->Value();
+  const uint32_t shard_count = args[1].As<Uint32>()->Value();
+
+  std::vector<std::unique_ptr<SessionStoreBackend>> backends;
+  backends.push_back(
+      std::make_unique<MemorySessionStoreBackend>(capacity, shard_count));
+  if (!args[2]->IsUndefined()) {
+    CHECK(args[2]->IsString());
+    Utf8Value directory(env->isolate(), args[2]);
+    backends.push_back(std::make_unique<FileSessionStoreBackend>(
+        directory.ToString(), capacity));
+  }
+
+  unsigned char ticket_keys[SessionStore::kTicketKeysSize];
+  unsigned char session_id_context[SessionStore::kSessionIdContextSize];
+  if (RAND_bytes(ticket_keys, sizeof(ticket_keys)) <= 0 ||
+      RAND_bytes(session_id_context, sizeof(session_id_context)) <= 0) {
+    return THROW_ERR_CRYPTO_OPERATION_FAILED(
+        env, "Error generating ticket keys");
+  }
+
+  Local<Object> handle;
+  if (New(env,
+          std::make_shared<SessionStore>(
+              std::move(backends), ticket_keys, session_id_context))
+          .ToLocal(&handle)) {
+    args.GetReturnValue().Set(handle);
+  }
+}
+
+void SessionStoreHandle::GetStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  SessionStoreHandle* handle;
+  ASSIGN_OR_RETURN_UNWRAP(&handle, args.Holder());
+
+  const SessionStore::Stats stats = handle->store_->GetStats();
+  Isolate* isolate = env->isolate();
+  Local<Value> values[] = {
+    Number::New(isolate, static_cast<double>(stats.hits)),
+    Number::New(isolate, static_cast<double>(stats.misses)),
+    Number::New(isolate, static_cast<double>(stats.stores)),
+    Number::New(isolate, static_cast<double>(stats.evictions)),
+    Number::New(isolate, static_cast<double>(stats.ticket_hits)),
+    Number::New(isolate, static_cast<double>(stats.ticket_misses)),
+    Number::New(isolate, static_cast<double>(stats.size)),
+  };
+  args.GetReturnValue().Set(Array::New(isolate, values, arraysize(values)));
+}
+
+BaseObjectPtr<BaseObject>
+SessionStoreHandle::SessionStoreTransferData::Deserialize(
+    Environment* env,
+    Local<Context> context,
+    std::unique_ptr<worker::TransferData> self) {
+  if (context != env->context()) {
+    THROW_ERR_MESSAGE_TARGET_CONTEXT_UNAVAILABLE(env);
+    return {};
+  }
+
+  Local<Object> handle;
+  if (!SessionStoreHandle::New(env, store_).ToLocal(&handle))
+    return {};
+
+  return BaseObjectPtr<BaseObject>(Unwrap<SessionStoreHandle>(handle));
+}
+
+BaseObject::TransferMode SessionStoreHandle::GetTransferMode() const {
+  return BaseObject::TransferMode::kCloneable;
+}
+
+std::unique_ptr<worker::TransferData> SessionStoreHandle::CloneForMessaging()
+    const {
+  return std::make_unique<SessionStoreTransferData>(store_);
+}
+
+void SessionStoreHandle::Initialize(Environment* env, Local<Object> target) {
+  SetMethod(env->context(), target, "createSessionStore", CreateSessionStore);
+}
+
+void SessionStoreHandle::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(CreateSessionStore);
+  registry->Register(GetStats);
+}
+
+}  // namespace crypto
+}  // namespace node
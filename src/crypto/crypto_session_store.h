@@ -0,0 +1,217 @@
+#ifndef SRC_CRYPTO_CRYPTO_SESSION_STORE_H_
+#define SRC_CRYPTO_CRYPTO_SESSION_STORE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "base_object.h"
+#include "crypto/crypto_util.h"
+#include "env.h"
+#include "memory_tracker.h"
+#include "node_mutex.h"
+#include "node_worker.h"
+#include "v8.h"
+
+#include <atomic>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace node {
+namespace crypto {
+
+// Storage for serialized TLS sessions, keyed by session ID. Implementations
+// must be safe to use from multiple threads at the same time.
+class SessionStoreBackend {
+ public:
+  virtual ~SessionStoreBackend() = default;
+
+  // Returns false if no session is stored for `id`.
+  virtual bool Get(const std::string& id, std::string* session) = 0;
+  // `expires` is the time at which the session expires, in seconds since the
+  // epoch.
+  virtual void Put(const std::string& id,
+                   const std::string& session,
+                   time_t expires) = 0;
+  virtual void Remove(const std::string& id) = 0;
+
+  // Number of stored sessions, if known.
+  virtual size_t Size() const { return 0; }
+  // Number of sessions that were dropped to make room for new ones.
+  virtual uint64_t Evictions() const { return 0; }
+};
+
+// Keeps up to `capacity` sessions in memory. The sessions are distributed over
+// independently locked shards by session ID, and each shard evicts its least
+// recently used session when it is full, so that threads storing and looking
+// up sessions at the same time rarely wait for each other. There are never
+// more shards than `capacity`, and the capacity is split between them.
+class MemorySessionStoreBackend final : public SessionStoreBackend {
+ public:
+  MemorySessionStoreBackend(size_t capacity, size_t shard_count);
+
+  bool Get(const std::string& id, std::string* session) override;
+  void Put(const std::string& id,
+           const std::string& session,
+           time_t expires) override;
+  void Remove(const std::string& id) override;
+  size_t Size() const override;
+  uint64_t Evictions() const override { return evictions_; }
+
+ private:
+  struct Shard {
+    explicit Shard(size_t capacity) : capacity(capacity) {}
+
+    const size_t capacity;
+    mutable Mutex mutex;
+    // Most recently used first.
+    std::list<std::pair<std::string, std::string>> entries;
+    std::unordered_map<std::string, decltype(entries)::iterator> index;
+  };
+
+  Shard* GetShard(const std::string& id);
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<uint64_t> evictions_{0};
+};
+
+// Stores each session in a file in `directory`, so that sessions survive
+// restarts and can be shared with other processes on the same machine. Files
+// are replaced atomically, and their modification time is set to the time
+// at which the session expires. Every `capacity / 8` writes, the directory is
+// swept: expired sessions are deleted, and then the ones that expire first
+// until no more than `capacity` are left.
+//
+// All file system access is synchronous and happens on the thread that runs
+// the handshake. A sweep stat()s every file in the directory.
+class FileSessionStoreBackend final : public SessionStoreBackend {
+ public:
+  FileSessionStoreBackend(const std::string& directory, size_t capacity);
+
+  bool Get(const std::string& id, std::string* session) override;
+  void Put(const std::string& id,
+           const std::string& session,
+           time_t expires) override;
+  void Remove(const std::string& id) override;
+
+ private:
+  std::string GetPath(const std::string& id) const;
+  void Sweep();
+
+  const std::string directory_;
+  const size_t capacity_;
+  const uint64_t sweep_interval_;
+  // Also makes the names of temporary files unique.
+  std::atomic<uint64_t> writes_{0};
+  std::atomic<bool> sweeping_{false};
+};
+
+// A TLS session cache that servers look up without calling into JS, and that
+// can be shared by all threads of the process through SessionStoreHandle.
+// Lookups go through the backends in order, and sessions found in a later
+// backend are copied into the earlier ones. The store also holds the ticket
+// keys and the session ID context of the SecureContexts that use it, so that
+// sessions and tickets issued by one of them can be resumed by all others.
+class SessionStore final {
+ public:
+  static constexpr size_t kTicketKeysSize = 48;
+  static constexpr size_t kSessionIdContextSize = 16;
+
+  SessionStore(std::vector<std::unique_ptr<SessionStoreBackend>>&& backends,
+               const unsigned char* ticket_keys,
+               const unsigned char* session_id_context);
+
+  // Returns nullptr if the session is unknown or expired.
+  SSLSessionPointer Get(const unsigned char* id, size_t length);
+  void Put(SSL_SESSION* session);
+
+  void RecordTicket(bool hit);
+
+  const unsigned char* ticket_keys() const { return ticket_keys_; }
+  const unsigned char* session_id_context() const {
+    return session_id_context_;
+  }
+
+  struct Stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t stores;
+    uint64_t evictions;
+    uint64_t ticket_hits;
+    uint64_t ticket_misses;
+    uint64_t size;
+  };
+  Stats GetStats() const;
+
+ private:
+  std::vector<std::unique_ptr<SessionStoreBackend>> backends_;
+  unsigned char ticket_keys_[kTicketKeysSize];
+  unsigned char session_id_context_[kSessionIdContextSize];
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> stores_{0};
+  std::atomic<uint64_t> ticket_hits_{0};
+  std::atomic<uint64_t> ticket_misses_{0};
+};
+
+// The JS handle of a SessionStore. It can be cloned to other threads with
+// postMessage(), and all clones refer to the same store.
+class SessionStoreHandle final : public BaseObject {
+ public:
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+  static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
+      Environment* env);
+  static bool HasInstance(Environment* env, v8::Local<v8::Value> value);
+
+  static v8::MaybeLocal<v8::Object> New(
+      Environment* env, std::shared_ptr<SessionStore> store);
+
+  const std::shared_ptr<SessionStore>& store() const { return store_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(SessionStoreHandle)
+  SET_SELF_SIZE(SessionStoreHandle)
+
+  class SessionStoreTransferData : public worker::TransferData {
+   public:
+    explicit SessionStoreTransferData(
+        const std::shared_ptr<SessionStore>& store)
+        : store_(store) {}
+
+    BaseObjectPtr<BaseObject> Deserialize(
+        Environment* env,
+        v8::Local<v8::Context> context,
+        std::unique_ptr<worker::TransferData> self) override;
+
+    SET_MEMORY_INFO_NAME(SessionStoreTransferData)
+    SET_SELF_SIZE(SessionStoreTransferData)
+    SET_NO_MEMORY_INFO()
+
+   private:
+    std::shared_ptr<SessionStore> store_;
+  };
+
+  BaseObject::TransferMode GetTransferMode() const override;
+  std::unique_ptr<worker::TransferData> CloneForMessaging() const override;
+
+ private:
+  static void CreateSessionStore(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetStats(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  SessionStoreHandle(Environment* env,
+                     v8::Local<v8::Object> object,
+                     std::shared_ptr<SessionStore> store);
+
+  std::shared_ptr<SessionStore> store_;
+};
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+#endif  // SRC_CRYPTO_CRYPTO_SESSION_STORE_H_
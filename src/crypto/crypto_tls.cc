@@ -24,6 +24,7 @@
 #include "crypto/crypto_common.h"
 #include "crypto/crypto_util.h"
 #include "crypto/crypto_bio.h"
+#include "crypto/crypto_session_store.h"
 #include "crypto/crypto_clienthello-inl.h"
 #include "async_wrap-inl.h"
 #include "debug_utils-inl.h"
@@ -33,6 +34,14 @@
 #include "stream_base-inl.h"
 #include "util-inl.h"
 
+#include <algorithm>
+
+#ifdef NODE_OPENSSL_HAS_KTLS
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif  // NODE_OPENSSL_HAS_KTLS
+
 namespace node {
 
 using v8::Array;
@@ -71,7 +80,14 @@ SSL_SESSION* GetSessionCallback(
     int* copy) {
   TLSWrap* w = static_cast<TLSWrap*>(SSL_get_app_data(s));
   *copy = 0;
-  return w->ReleaseSession();
+  if (SSL_SESSION* session = w->ReleaseSession())
+    return session;
+
+  SecureContext* sc = static_cast<SecureContext*>(
+      SSL_CTX_get_app_data(SSL_get_SSL_CTX(s)));
+  if (!sc->session_store())
+    return nullptr;
+  return sc->session_store()->Get(key, len).release();
 }
 
 void OnClientHello(
@@ -135,6 +151,13 @@ int NewSessionCallback(SSL* s, SSL_SESSION* sess) {
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
+  if (w->is_server()) {
+    SecureContext* sc = static_cast<SecureContext*>(
+        SSL_CTX_get_app_data(SSL_get_SSL_CTX(s)));
+    if (sc->session_store())
+      sc->session_store()->Put(sess);
+  }
+
   if (!w->has_session_callbacks())
     return 0;
 
@@ -324,6 +347,7 @@ std::string GetBIOError() {
       static_cast<void*>(&ret));
   return ret;
 }
+
 }  // namespace
 
 TLSWrap::TLSWrap(Environment* env,
@@ -499,6 +523,10 @@ void TLSWrap::Start(const FunctionCallbackInfo<Value>& args) {
 
   // Send ClientHello handshake
   CHECK(wrap->is_client());
+#ifdef NODE_OPENSSL_HAS_KTLS
+  if (wrap->ktls_requested_)
+    wrap->WriteToSocket();
+#endif  // NODE_OPENSSL_HAS_KTLS
   // Seems odd to read when when we want to send, but SSL_read() triggers a
   // handshake if a session isn't established, and handshake will cause
   // encrypted data to become available for output.
@@ -580,6 +608,16 @@ void TLSWrap::EncOut() {
     return;
   }
 
+#ifdef NODE_OPENSSL_HAS_KTLS
+  // OpenSSL keeps what it could not write to the socket, and has to be called
+  // again to write it.
+  if (writes_to_socket_ && BIO_should_write(SSL_get_wbio(ssl_.get()))) {
+    Debug(this, "Returning from EncOut(), waiting for the socket");
+    WaitForWritableSocket();
+    return;
+  }
+#endif  // NODE_OPENSSL_HAS_KTLS
+
   // No encrypted output ready to write to the underlying stream.
   if (BIO_pending(enc_out_) == 0) {
     Debug(this, "No pending encrypted output");
@@ -677,6 +715,88 @@ void TLSWrap::OnStreamAfterWrite(WriteWrap* req_wrap, int status) {
   EncOut();
 }
 
+#ifdef NODE_OPENSSL_HAS_KTLS
+void TLSWrap::WriteToSocket() {
+  ktls_requested_ = false;
+  // Waiting for the `newSession` callback relies on holding back the output
+  // in enc_out_.
+  if (is_server() && session_callbacks_) {
+    Debug(this, "Not using kernel TLS, session callbacks are enabled");
+    return;
+  }
+
+  const int fd = GetFD();
+  int protocol = 0;
+  socklen_t protocol_length = sizeof(protocol);
+  if (fd < 0 ||
+      getsockopt(fd, SOL_SOCKET, SO_PROTOCOL, &protocol, &protocol_length) ||
+      protocol != IPPROTO_TCP) {
+    Debug(this, "Not using kernel TLS, not a TCP socket");
+    return;
+  }
+
+  BIO* bio = BIO_new_socket(fd, BIO_NOCLOSE);
+  if (bio == nullptr)
+    return;
+  // enc_out_ stays empty from now on, but the code that checks it for output
+  // keeps working with it.
+  BIO_up_ref(enc_out_);
+  SSL_set0_wbio(ssl_.get(), bio);
+  // Data that OpenSSL could not write is passed again from
+  // pending_cleartext_input_, which is a copy.
+  SSL_set_mode(ssl_.get(), SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+  // Whether the kernel actually encrypts depends on the negotiated cipher and
+  // on the `tls` kernel module, OpenSSL falls back to encrypting itself.
+  SSL_set_options(ssl_.get(), SSL_OP_ENABLE_KTLS);
+  writes_to_socket_ = true;
+  Debug(this, "Writing to the socket directly");
+}
+
+void TLSWrap::WaitForWritableSocket() {
+  if (writable_poll_ != nullptr)
+    return;
+
+  const int fd = dup(GetFD());
+  if (fd < 0) {
+    InvokeQueued(uv_translate_sys_error(errno));
+    return;
+  }
+  writable_poll_ = new WritablePoll();
+  writable_poll_->fd = fd;
+  writable_poll_->handle.data = this;
+  int err = uv_poll_init(env()->event_loop(), &writable_poll_->handle, fd);
+  if (err == 0) {
+    err = uv_poll_start(&writable_poll_->handle, UV_WRITABLE,
+                        OnWritableSocket);
+  }
+  if (err != 0) {
+    close(fd);
+    delete writable_poll_;
+    writable_poll_ = nullptr;
+    InvokeQueued(err);
+  }
+}
+
+void TLSWrap::OnWritableSocket(uv_poll_t* handle, int status, int events) {
+  TLSWrap* wrap = static_cast<TLSWrap*>(handle->data);
+  // Also closes the duplicate, so that it does not keep the socket open.
+  wrap->env()->CloseHandle(handle, [](uv_poll_t* handle) {
+    WritablePoll* poll = ContainerOf(&WritablePoll::handle, handle);
+    close(poll->fd);
+    delete poll;
+  });
+  wrap->writable_poll_ = nullptr;
+
+  HandleScope handle_scope(wrap->env()->isolate());
+  Context::Scope context_scope(wrap->env()->context());
+  if (status != 0) {
+    wrap->InvokeQueued(status);
+    return;
+  }
+  wrap->Cycle();
+}
+#endif  // NODE_OPENSSL_HAS_KTLS
+
 int TLSWrap::GetSSLError(int status) const {
   // ssl_ might already be destroyed for reading EOF from a close notify alert.
   return ssl_ != nullptr ? SSL_get_error(ssl_.get(), status) : 0;
@@ -854,6 +974,61 @@ void TLSWrap::ClearIn() {
   pending_cleartext_input_ = std::move(bs);
 }
 
+// Passes `bufs` to SSL_write() without flattening them. Full records are
+// encrypted from where they are, and whatever does not fill a record is
+// coalesced with the data that follows it, so that many small buffers, such as
+// headers that are written together with a body, do not each end up in a
+// record of their own. Returns -1 if an SSL_write() call failed, and the total
+// length otherwise. `*written` is set to the number of bytes that OpenSSL
+// accepted.
+int TLSWrap::WriteCoalesced(const uv_buf_t* bufs,
+                            size_t count,
+                            size_t* written) {
+  NodeBIO* enc_out = NodeBIO::FromBIO(enc_out_);
+  char record[kMaxPlaintextRecordSize];
+  size_t staged = 0;
+  *written = 0;
+
+  auto write = [&](const char* data, size_t length) {
+    enc_out->set_allocate_tls_hint(length);
+    const int ret = SSL_write(ssl_.get(), data, length);
+    CHECK(ret == -1 || ret == static_cast<int>(length));
+    if (ret == -1)
+      return false;
+    *written += length;
+    return true;
+  };
+
+  for (size_t i = 0; i < count; i++) {
+    const char* data = bufs[i].base;
+    size_t length = bufs[i].len;
+
+    if (staged > 0) {
+      const size_t n = std::min(length, sizeof(record) - staged);
+      memcpy(record + staged, data, n);
+      staged += n;
+      data += n;
+      length -= n;
+      if (staged < sizeof(record))
+        continue;
+      if (!write(record, staged))
+        return -1;
+      staged = 0;
+    }
+
+    const size_t tail = length % sizeof(record);
+    if (length > tail && !write(data, length - tail))
+      return -1;
+    if (tail > 0)
+      memcpy(record, data + length - tail, tail);
+    staged = tail;
+  }
+
+  if (staged > 0 && !write(record, staged))
+    return -1;
+  return static_cast<int>(*written);
+}
+
 std::string TLSWrap::diagnostic_name() const {
   std::string name = "TLSWrap ";
   name += is_server() ? "server (" : "client (";
@@ -983,19 +1158,27 @@ int TLSWrap::DoWrite(WriteWrap* w,
   // and copying it when it could just be used.
 
   if (nonempty_count != 1) {
-    {
-      NoArrayBufferZeroFillScope no_zero_fill_scope(env()->isolate_data());
-      bs = ArrayBuffer::NewBackingStore(env()->isolate(), length);
-    }
-    size_t offset = 0;
-    for (i = 0; i < count; i++) {
-      memcpy(static_cast<char*>(bs->Data()) + offset,
-             bufs[i].base, bufs[i].len);
-      offset += bufs[i].len;
-    }
+    size_t accepted;
+    written = WriteCoalesced(bufs, count, &accepted);
 
-    NodeBIO::FromBIO(enc_out_)->set_allocate_tls_hint(length);
-    written = SSL_write(ssl_.get(), bs->Data(), length);
+    // Only copy what OpenSSL did not accept, for ClearIn() to retry.
+    if (written == -1) {
+      {
+        NoArrayBufferZeroFillScope no_zero_fill_scope(env()->isolate_data());
+        bs = ArrayBuffer::NewBackingStore(env()->isolate(), length - accepted);
+      }
+      size_t offset = 0;
+      for (i = 0; i < count; i++) {
+        if (bufs[i].len <= accepted) {
+          accepted -= bufs[i].len;
+          continue;
+        }
+        memcpy(static_cast<char*>(bs->Data()) + offset,
+               bufs[i].base + accepted, bufs[i].len - accepted);
+        offset += bufs[i].len - accepted;
+        accepted = 0;
+      }
+    }
   } else {
     // Only one buffer: try to write directly, only store if it fails
     uv_buf_t* buf = &bufs[nonempty_i];
@@ -1071,6 +1254,12 @@ void TLSWrap::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
   // calls anymore.
   CHECK(ssl_);
 
+#ifdef NODE_OPENSSL_HAS_KTLS
+  // This is the first data of a server connection, nothing was sent yet.
+  if (ktls_requested_)
+    WriteToSocket();
+#endif  // NODE_OPENSSL_HAS_KTLS
+
   // Commit the amount of data actually read into the peeked/allocated buffer
   // from the underlying stream.
   NodeBIO* enc_in = NodeBIO::FromBIO(enc_in_);
@@ -1173,6 +1362,39 @@ void TLSWrap::EnableKeylogCallback(const FunctionCallbackInfo<Value>& args) {
 # define HAVE_SSL_TRACE 1
 #endif
 
+#ifdef NODE_OPENSSL_HAS_KTLS
+# define HAVE_KTLS 1
+#else
+# define HAVE_KTLS 0
+#endif
+
+// Returns whether kernel TLS can be used for sending, which still depends on
+// the socket, the negotiated cipher and the kernel. The switch to the socket
+// happens when the handshake starts, clients are not connected before.
+void TLSWrap::EnableKTLS(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK_NOT_NULL(wrap->ssl_);
+
+#ifdef NODE_OPENSSL_HAS_KTLS
+  wrap->ktls_requested_ = true;
+#endif  // NODE_OPENSSL_HAS_KTLS
+  args.GetReturnValue().Set(HAVE_KTLS == 1);
+}
+
+// Returns whether the kernel encrypts the data that is sent.
+void TLSWrap::IsKTLSSending(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  bool sending = false;
+#ifdef NODE_OPENSSL_HAS_KTLS
+  sending = wrap->ssl_ && wrap->writes_to_socket_ &&
+            BIO_get_ktls_send(SSL_get_wbio(wrap->ssl_.get()));
+#endif  // NODE_OPENSSL_HAS_KTLS
+  args.GetReturnValue().Set(sending);
+}
+
 void TLSWrap::EnableTrace(const FunctionCallbackInfo<Value>& args) {
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -1216,6 +1438,20 @@ void TLSWrap::Destroy() {
   env()->isolate()->AdjustAmountOfExternalAllocatedMemory(-kExternalSize);
   ssl_.reset();
 
+#ifdef NODE_OPENSSL_HAS_KTLS
+  // The reference that was taken when OpenSSL was given the socket BIO.
+  if (writes_to_socket_)
+    BIO_free(enc_out_);
+  if (writable_poll_ != nullptr) {
+    env()->CloseHandle(&writable_poll_->handle, [](uv_poll_t* handle) {
+      WritablePoll* poll = ContainerOf(&WritablePoll::handle, handle);
+      close(poll->fd);
+      delete poll;
+    });
+    writable_poll_ = nullptr;
+  }
+#endif  // NODE_OPENSSL_HAS_KTLS
+
   enc_in_ = nullptr;
   enc_out_ = nullptr;
 
@@ -2035,6 +2271,7 @@ void TLSWrap::Initialize(
   SetMethod(context, target, "wrap", TLSWrap::Wrap);
 
   NODE_DEFINE_CONSTANT(target, HAVE_SSL_TRACE);
+  NODE_DEFINE_CONSTANT(target, HAVE_KTLS);
 
   Local<FunctionTemplate> t = BaseObject::MakeLazilyInitializedJSTemplate(env);
   Local<String> tlsWrapString =
@@ -2060,6 +2297,7 @@ void TLSWrap::Initialize(
   SetProtoMethod(isolate, t, "enableCertCb", EnableCertCb);
   SetProtoMethod(isolate, t, "endParser", EndParser);
   SetProtoMethod(isolate, t, "enableKeylogCallback", EnableKeylogCallback);
+  SetProtoMethod(isolate, t, "enableKTLS", EnableKTLS);
   SetProtoMethod(isolate, t, "enableSessionCallbacks", EnableSessionCallbacks);
   SetProtoMethod(isolate, t, "enableTrace", EnableTrace);
   SetProtoMethod(isolate, t, "getServername", GetServername);
@@ -2077,6 +2315,7 @@ void TLSWrap::Initialize(
 
   SetProtoMethodNoSideEffect(
       isolate, t, "exportKeyingMaterial", ExportKeyingMaterial);
+  SetProtoMethodNoSideEffect(isolate, t, "isKTLSSending", IsKTLSSending);
   SetProtoMethodNoSideEffect(isolate, t, "isSessionReused", IsSessionReused);
   SetProtoMethodNoSideEffect(
       isolate, t, "getALPNNegotiatedProtocol", GetALPNNegotiatedProto);
@@ -2125,6 +2364,7 @@ void TLSWrap::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(EnableCertCb);
   registry->Register(EndParser);
   registry->Register(EnableKeylogCallback);
+  registry->Register(EnableKTLS);
   registry->Register(EnableSessionCallbacks);
   registry->Register(EnableTrace);
   registry->Register(GetServername);
@@ -2140,6 +2380,7 @@ void TLSWrap::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(SetVerifyMode);
   registry->Register(Start);
   registry->Register(ExportKeyingMaterial);
+  registry->Register(IsKTLSSending);
   registry->Register(IsSessionReused);
   registry->Register(GetALPNNegotiatedProto);
   registry->Register(GetCertificate);
@@ -35,6 +35,13 @@
 
 #include <string>
 
+// Kernel TLS is only available on Linux, and only when OpenSSL was built with
+// support for it. The OpenSSL that is bundled with Node.js is not.
+#if defined(__linux__) && !defined(OPENSSL_NO_KTLS) && \
+    defined(SSL_OP_ENABLE_KTLS)
+#define NODE_OPENSSL_HAS_KTLS 1
+#endif
+
 namespace node {
 namespace crypto {
 
@@ -112,6 +119,9 @@ class TLSWrap : public AsyncWrap,
 
   static constexpr int kClearOutChunkSize = 16384;
 
+  // Maximum amount of cleartext in a single TLS record
+  static constexpr size_t kMaxPlaintextRecordSize = 16384;
+
   // Maximum number of bytes for hello parser
   static constexpr int kMaxHelloLength = 16384;
 
@@ -148,6 +158,8 @@ class TLSWrap : public AsyncWrap,
   void EncOut();  // Write encrypted data from enc_out_ to underlying stream.
   void ClearIn();  // SSL_write() clear data "in" to SSL.
   void ClearOut();  // SSL_read() clear text "out" from SSL.
+  // SSL_write() multiple buffers, see the definition.
+  int WriteCoalesced(const uv_buf_t* bufs, size_t count, size_t* written);
   void Destroy();
 
   // Call Done() on outstanding WriteWrap request.
@@ -168,6 +180,16 @@ class TLSWrap : public AsyncWrap,
 
   int GetSSLError(int status) const;
 
+#ifdef NODE_OPENSSL_HAS_KTLS
+  // OpenSSL only hands the keys for sending to the kernel when it writes to
+  // the socket itself, so with enableKTLS, it is given a socket BIO instead
+  // of enc_out_ before the handshake starts.
+  void WriteToSocket();
+  // Cycles once the socket accepts the data that OpenSSL could not write.
+  void WaitForWritableSocket();
+  static void OnWritableSocket(uv_poll_t* handle, int status, int events);
+#endif  // NODE_OPENSSL_HAS_KTLS
+
   static int SelectSNIContextCallback(SSL* s, int* ad, void* arg);
 
   static void CertCbDone(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -175,6 +197,7 @@ class TLSWrap : public AsyncWrap,
   static void EnableCertCb(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableKeylogCallback(
       const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableKTLS(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableSessionCallbacks(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableTrace(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -202,6 +225,7 @@ class TLSWrap : public AsyncWrap,
   static void GetTLSTicket(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetWriteQueueSize(
       const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void IsKTLSSending(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void IsSessionReused(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void LoadSession(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void NewSessionDone(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -283,6 +307,19 @@ class TLSWrap : public AsyncWrap,
   void* cert_cb_arg_ = nullptr;
 
   BIOPointer bio_trace_;
+
+#ifdef NODE_OPENSSL_HAS_KTLS
+  bool ktls_requested_ = false;
+  // Whether OpenSSL writes to the socket rather than to enc_out_.
+  bool writes_to_socket_ = false;
+  // Watches a duplicate of the socket, because libuv only allows one handle
+  // per file descriptor. Only exists while waiting for the socket.
+  struct WritablePoll {
+    uv_poll_t handle;
+    uv_os_fd_t fd;
+  };
+  WritablePoll* writable_poll_ = nullptr;
+#endif  // NODE_OPENSSL_HAS_KTLS
 };
 
 }  // namespace crypto
@@ -1,6 +1,7 @@
 #include "crypto/crypto_util.h"
 #include "async_wrap-inl.h"
 #include "crypto/crypto_bio.h"
+#include "crypto/crypto_hash.h"
 #include "crypto/crypto_keys.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
@@ -236,6 +237,9 @@ void SetFipsCrypto(const FunctionCallbackInfo<Value>& args) {
     unsigned long err = ERR_get_error();  // NOLINT(runtime/int)
     return ThrowCryptoError(env, err);
   }
+  // Digests that were fetched before are not necessarily provided by the FIPS
+  // provider, or the other way around.
+  ResetDigestImplementations();
 }
 
 void TestFipsCrypto(const v8::FunctionCallbackInfo<v8::Value>& args) {
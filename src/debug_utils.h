@@ -44,9 +44,12 @@ void NODE_EXTERN_PRIVATE FWrite(FILE* file, const std::string& str);
   NODE_ASYNC_PROVIDER_TYPES(V)                                                 \
   V(DIAGNOSTICS)                                                               \
   V(HUGEPAGES)                                                                 \
+  V(IDLE_TASKS)                                                                \
   V(INSPECTOR_SERVER)                                                          \
   V(INSPECTOR_PROFILER)                                                        \
   V(CODE_CACHE)                                                                \
+  V(COMPILE_CACHE)                                                             \
+  V(RESOLUTION_CACHE)                                                          \
   V(NGTCP2_DEBUG)                                                              \
   V(WASI)                                                                      \
   V(MKSNAPSHOT)
@@ -77,6 +77,14 @@ inline worker::Worker* IsolateData::worker_context() const {
   return worker_context_;
 }
 
+inline const SnapshotData* IsolateData::snapshot_data() const {
+  return snapshot_data_;
+}
+
+inline void IsolateData::set_snapshot_data(const SnapshotData* snapshot_data) {
+  snapshot_data_ = snapshot_data;
+}
+
 inline v8::Local<v8::String> IsolateData::async_wrap_provider(int index) const {
   return async_wrap_providers_[index].Get(isolate_);
 }
@@ -5,11 +5,13 @@
 #include "diagnosticfilename-inl.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
+#include "node_compile_cache.h"
 #include "node_context_data.h"
 #include "node_errors.h"
 #include "node_internals.h"
 #include "node_options-inl.h"
 #include "node_process-inl.h"
+#include "node_resolution_cache.h"
 #include "node_v8_platform-inl.h"
 #include "node_worker.h"
 #include "req_wrap-inl.h"
@@ -1080,6 +1082,29 @@ void Environment::AtExit(void (*cb)(void* arg), void* arg) {
   at_exit_functions_.push_front(ExitCallback{cb, arg});
 }
 
+CompileCache* Environment::compile_cache() {
+  if (!compile_cache_initialized_) {
+    compile_cache_initialized_ = true;
+    const std::string& path = options()->experimental_compile_cache;
+#if HAVE_OPENSSL
+    // The code compiled while building a snapshot ends up in the snapshot.
+    if (!path.empty() && !per_process::cli_options->build_snapshot)
+      compile_cache_ = std::make_unique<CompileCache>(this, path);
+#endif  // HAVE_OPENSSL
+  }
+  return compile_cache_.get();
+}
+
+ResolutionCache* Environment::resolution_cache() {
+  if (!resolution_cache_initialized_) {
+    resolution_cache_initialized_ = true;
+    const std::string& path = options()->experimental_resolution_cache;
+    if (!path.empty())
+      resolution_cache_ = std::make_unique<ResolutionCache>(this, path);
+  }
+  return resolution_cache_.get();
+}
+
 void Environment::RunAndClearInterrupts() {
   while (native_immediates_interrupts_.size() > 0) {
     NativeImmediateQueue queue;
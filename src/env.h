@@ -59,6 +59,10 @@
 
 namespace node {
 
+class CompileCache;
+class ResolutionCache;
+struct SnapshotData;
+
 namespace contextify {
 class ContextifyScript;
 class CompiledFnEntry;
@@ -349,6 +353,7 @@ class NoArrayBufferZeroFillScope {
   V(nistcurve_string, "nistCurve")                                             \
   V(node_string, "node")                                                       \
   V(nsname_string, "nsname")                                                   \
+  V(object_string, "Object")                                                   \
   V(ocsp_request_string, "OCSPRequest")                                        \
   V(oncertcb_string, "oncertcb")                                               \
   V(onchange_string, "onchange")                                               \
@@ -356,6 +361,7 @@ class NoArrayBufferZeroFillScope {
   V(oncomplete_string, "oncomplete")                                           \
   V(onconnection_string, "onconnection")                                       \
   V(ondone_string, "ondone")                                                   \
+  V(ondrain_string, "ondrain")                                                 \
   V(onerror_string, "onerror")                                                 \
   V(onexit_string, "onexit")                                                   \
   V(onhandshakedone_string, "onhandshakedone")                                 \
@@ -364,6 +370,7 @@ class NoArrayBufferZeroFillScope {
   V(onmessage_string, "onmessage")                                             \
   V(onnewsession_string, "onnewsession")                                       \
   V(onocspresponse_string, "onocspresponse")                                   \
+  V(onreadable_string, "onreadable")                                           \
   V(onreadstart_string, "onreadstart")                                         \
   V(onreadstop_string, "onreadstop")                                           \
   V(onshutdown_string, "onshutdown")                                           \
@@ -495,9 +502,12 @@ class NoArrayBufferZeroFillScope {
   V(microtask_queue_ctor_template, v8::FunctionTemplate)                       \
   V(pipe_constructor_template, v8::FunctionTemplate)                           \
   V(promise_wrap_template, v8::ObjectTemplate)                                 \
+  V(ring_reader_constructor_template, v8::FunctionTemplate)                    \
+  V(ring_writer_constructor_template, v8::FunctionTemplate)                    \
   V(sab_lifetimepartner_constructor_template, v8::FunctionTemplate)            \
   V(script_context_constructor_template, v8::FunctionTemplate)                 \
   V(secure_context_constructor_template, v8::FunctionTemplate)                 \
+  V(session_store_constructor_template, v8::FunctionTemplate)                  \
   V(shutdown_wrap_template, v8::ObjectTemplate)                                \
   V(socketaddress_constructor_template, v8::FunctionTemplate)                  \
   V(streambaseoutputstream_constructor_template, v8::ObjectTemplate)           \
@@ -614,6 +624,11 @@ class NODE_EXTERN_PRIVATE IsolateData : public MemoryRetainer {
   inline worker::Worker* worker_context() const;
   inline void set_worker_context(worker::Worker* context);
 
+  // The snapshot that the isolate was created from, if any. Workers started
+  // from this isolate use the same snapshot.
+  inline const SnapshotData* snapshot_data() const;
+  inline void set_snapshot_data(const SnapshotData* snapshot_data);
+
 #define VP(PropertyName, StringValue) V(v8::Private, PropertyName)
 #define VY(PropertyName, StringValue) V(v8::Symbol, PropertyName)
 #define VS(PropertyName, StringValue) V(v8::String, PropertyName)
@@ -674,6 +689,7 @@ class NODE_EXTERN_PRIVATE IsolateData : public MemoryRetainer {
   MultiIsolatePlatform* platform_;
   std::shared_ptr<PerIsolateOptions> options_;
   worker::Worker* worker_context_ = nullptr;
+  const SnapshotData* snapshot_data_ = nullptr;
 };
 
 struct ContextInfo {
@@ -1003,6 +1019,8 @@ struct SnapshotData {
   static const uint32_t kMagic = 0x143da19;
   static const SnapshotIndex kNodeBaseContextIndex = 0;
   static const SnapshotIndex kNodeMainContextIndex = kNodeBaseContextIndex + 1;
+  static const SnapshotIndex kNodeWorkerContextIndex =
+      kNodeMainContextIndex + 1;
 
   DataOwnership data_ownership = DataOwnership::kOwned;
 
@@ -1013,9 +1031,10 @@ struct SnapshotData {
   v8::StartupData v8_snapshot_blob_data{nullptr, 0};
 
   IsolateDataSerializeInfo isolate_data_info;
-  // TODO(joyeecheung): there should be a vector of env_info once we snapshot
-  // the worker environments.
   EnvSerializeInfo env_info;
+  // The Environment of the worker context, which is bootstrapped up to
+  // Environment::BootstrapThreadState().
+  EnvSerializeInfo worker_env_info;
 
   // A vector of built-in ids and v8::ScriptCompiler::CachedData, this can be
   // shared across Node.js instances because they are supposed to share the
@@ -1078,7 +1097,15 @@ class Environment : public MemoryRetainer {
 
   v8::MaybeLocal<v8::Value> BootstrapInternalLoaders();
   v8::MaybeLocal<v8::Value> BootstrapNode();
+  // Runs the parts of the bootstrap that depend on the kind of thread and on
+  // whether the Environment owns the process state. The worker context in the
+  // snapshot is bootstrapped without them, so they run after it is
+  // deserialized.
+  v8::MaybeLocal<v8::Value> BootstrapThreadState();
   v8::MaybeLocal<v8::Value> RunBootstrapping();
+  // Completes the bootstrap of an Environment that was deserialized from the
+  // worker context of the snapshot.
+  v8::MaybeLocal<v8::Value> RunWorkerSnapshotBootstrapping();
 
   inline size_t async_callback_scope_depth() const;
   inline void PushAsyncCallbackScope();
@@ -1240,6 +1267,13 @@ class Environment : public MemoryRetainer {
   inline uint32_t get_next_script_id();
   inline uint32_t get_next_function_id();
 
+  // Returns the on-disk cache for compiled user code, or nullptr if it is not
+  // enabled with --experimental-compile-cache.
+  CompileCache* compile_cache();
+  // Returns the on-disk cache for require() resolutions, or nullptr if it is
+  // not enabled with --experimental-resolution-cache.
+  ResolutionCache* resolution_cache();
+
   EnabledDebugList* enabled_debug_list() { return &enabled_debug_list_; }
 
   inline performance::PerformanceState* performance_state();
@@ -1565,6 +1599,11 @@ class Environment : public MemoryRetainer {
   double time_origin_timestamp_;
   std::unique_ptr<performance::PerformanceState> performance_state_;
 
+  std::unique_ptr<CompileCache> compile_cache_;
+  bool compile_cache_initialized_ = false;
+  std::unique_ptr<ResolutionCache> resolution_cache_;
+  bool resolution_cache_initialized_ = false;
+
   bool has_run_bootstrapping_code_ = false;
   bool has_serialized_options_ = false;
 
@@ -2,6 +2,7 @@
 
 #include "env.h"
 #include "memory_tracker-inl.h"
+#include "node_compile_cache.h"
 #include "node_contextify.h"
 #include "node_errors.h"
 #include "node_internals.h"
@@ -138,7 +139,8 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
     // new ModuleWrap(url, context, exportNames, syntheticExecutionFunction)
     CHECK(args[3]->IsFunction());
   } else {
-    // new ModuleWrap(url, context, source, lineOffset, columOffset, cachedData)
+    // new ModuleWrap(url, context, source, lineOffset, columOffset, cachedData,
+    //                useCompileCache)
     CHECK(args[2]->IsString());
     CHECK(args[3]->IsNumber());
     line_offset = args[3].As<Int32>()->Value();
@@ -174,7 +176,10 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
       module = Module::CreateSyntheticModule(isolate, url, export_names,
         SyntheticModuleEvaluationStepsCallback);
     } else {
+      Local<String> source_text = args[2].As<String>();
       ScriptCompiler::CachedData* cached_data = nullptr;
+      CompileCache* compile_cache = nullptr;
+      CompileCacheKey compile_cache_key;
       if (!args[5]->IsUndefined()) {
         CHECK(args[5]->IsArrayBufferView());
         Local<ArrayBufferView> cached_data_buf = args[5].As<ArrayBufferView>();
@@ -183,9 +188,14 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
         cached_data =
             new ScriptCompiler::CachedData(data + cached_data_buf->ByteOffset(),
                                            cached_data_buf->ByteLength());
+      } else if (args[6]->IsTrue()) {
+        compile_cache = env->compile_cache();
+        if (compile_cache != nullptr) {
+          cached_data = compile_cache->Get(
+              CachedCodeType::kESM, url, source_text, &compile_cache_key);
+        }
       }
 
-      Local<String> source_text = args[2].As<String>();
       ScriptOrigin origin(isolate,
                           url,
                           line_offset,
@@ -215,8 +225,18 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
         }
         return;
       }
-      if (options == ScriptCompiler::kConsumeCodeCache &&
-          source.GetCachedData()->rejected) {
+      if (compile_cache != nullptr) {
+        // Unlike cached data passed in by the user, a rejected entry from the
+        // compile cache is not an error, it is simply replaced.
+        if (options != ScriptCompiler::kConsumeCodeCache ||
+            source.GetCachedData()->rejected) {
+          compile_cache->Put(std::move(compile_cache_key),
+                             std::unique_ptr<ScriptCompiler::CachedData>(
+                                 ScriptCompiler::CreateCodeCache(
+                                     module->GetUnboundModuleScript())));
+        }
+      } else if (options == ScriptCompiler::kConsumeCodeCache &&
+                 source.GetCachedData()->rejected) {
         THROW_ERR_VM_MODULE_CACHED_DATA_REJECTED(
             env, "cachedData buffer was rejected");
         try_catch.ReThrow();
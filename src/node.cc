@@ -353,11 +353,22 @@ MaybeLocal<Value> Environment::BootstrapNode() {
     }
   }
 
-  // TODO(joyeecheung): skip these in the snapshot building for workers.
+  return scope.EscapeMaybe(result);
+}
+
+MaybeLocal<Value> Environment::BootstrapThreadState() {
+  EscapableHandleScope scope(isolate_);
+
+  std::vector<Local<Value>> node_args = {process_object(),
+                                         builtin_module_require(),
+                                         internal_binding_loader(),
+                                         primordials()};
+
   auto thread_switch_id =
       is_main_thread() ? "internal/bootstrap/switches/is_main_thread"
                        : "internal/bootstrap/switches/is_not_main_thread";
-  result = ExecuteBootstrapper(this, thread_switch_id, &node_args);
+  MaybeLocal<Value> result =
+      ExecuteBootstrapper(this, thread_switch_id, &node_args);
 
   if (result.IsEmpty()) {
     return MaybeLocal<Value>();
@@ -392,8 +403,12 @@ MaybeLocal<Value> Environment::RunBootstrapping() {
     return MaybeLocal<Value>();
   }
 
+  if (BootstrapNode().IsEmpty()) {
+    return MaybeLocal<Value>();
+  }
+
   Local<Value> result;
-  if (!BootstrapNode().ToLocal(&result)) {
+  if (!BootstrapThreadState().ToLocal(&result)) {
     return MaybeLocal<Value>();
   }
 
@@ -409,6 +424,24 @@ MaybeLocal<Value> Environment::RunBootstrapping() {
   return scope.Escape(result);
 }
 
+MaybeLocal<Value> Environment::RunWorkerSnapshotBootstrapping() {
+  EscapableHandleScope scope(isolate_);
+
+  CHECK(!has_run_bootstrapping_code());
+
+  Local<Value> result;
+  if (!BootstrapThreadState().ToLocal(&result)) {
+    return MaybeLocal<Value>();
+  }
+
+  CHECK(req_wrap_queue()->IsEmpty());
+  CHECK(handle_wrap_queue()->IsEmpty());
+
+  DoneBootstrapping();
+
+  return scope.Escape(result);
+}
+
 static
 MaybeLocal<Value> StartExecution(Environment* env, const char* main_script_id) {
   EscapableHandleScope scope(env->isolate());
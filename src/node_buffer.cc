@@ -29,7 +29,9 @@
 #include "env-inl.h"
 #include "string_bytes.h"
 #include "string_search.h"
+#include "utf8_utils.h"
 #include "util-inl.h"
+#include "v8-fast-api-calls.h"
 #include "v8.h"
 
 #include <cstring>
@@ -52,8 +54,12 @@ namespace Buffer {
 using v8::ArrayBuffer;
 using v8::ArrayBufferView;
 using v8::BackingStore;
+using v8::CFunction;
 using v8::Context;
 using v8::EscapableHandleScope;
+using v8::FastApiCallbackOptions;
+using v8::FastApiTypedArray;
+using v8::FastOneByteString;
 using v8::FunctionCallbackInfo;
 using v8::Global;
 using v8::HandleScope;
@@ -604,6 +610,58 @@ void Copy(const FunctionCallbackInfo<Value> &args) {
   args.GetReturnValue().Set(to_copy);
 }
 
+uint32_t FastCopy(Local<Value> receiver,
+                  const FastApiTypedArray<uint8_t>& source,
+                  const FastApiTypedArray<uint8_t>& target,
+                  uint32_t target_start,
+                  uint32_t source_start,
+                  uint32_t source_end,
+                  // NOLINTNEXTLINE(runtime/references) This is V8 api.
+                  FastApiCallbackOptions& options) {
+  uint8_t* source_data;
+  CHECK(source.getStorageIfAligned(&source_data));
+  uint8_t* target_data;
+  CHECK(target.getStorageIfAligned(&target_data));
+  const size_t source_length = source.length();
+  const size_t target_length = target.length();
+
+  if (target_start >= target_length || source_start >= source_end)
+    return 0;
+
+  // Let the slow path throw the out-of-range error.
+  if (source_start > source_length) {
+    options.fallback = true;
+    return 0;
+  }
+
+  size_t to_copy = std::min(
+      std::min(static_cast<size_t>(source_end - source_start),
+               target_length - target_start),
+      source_length - source_start);
+
+  memmove(target_data + target_start, source_data + source_start, to_copy);
+  return static_cast<uint32_t>(to_copy);
+}
+
+CFunction fast_copy(CFunction::Make(FastCopy));
+
+// Repeats the first `written` bytes at `data` until `fill_length` bytes
+// are filled, doubling the copied chunk size on each iteration.
+inline void RepeatFill(char* data, size_t written, size_t fill_length) {
+  size_t in_there = written;
+  char* ptr = data + written;
+
+  while (in_there < fill_length - in_there) {
+    memcpy(ptr, data, in_there);
+    ptr += in_there;
+    in_there *= 2;
+  }
+
+  if (in_there < fill_length) {
+    memcpy(ptr, data, fill_length - in_there);
+  }
+}
+
 
 void Fill(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -683,20 +741,43 @@ start_fill:
   if (str_length == 0)
     return args.GetReturnValue().Set(-1);
 
-  size_t in_there = str_length;
-  char* ptr = ts_obj_data + start + str_length;
+  RepeatFill(ts_obj_data + start, str_length, fill_length);
+}
 
-  while (in_there < fill_length - in_there) {
-    memcpy(ptr, ts_obj_data + start, in_there);
-    ptr += in_there;
-    in_there *= 2;
-  }
+// Only Uint8Array fill values take the fast path; strings and other values
+// fail the type check and are handled by Fill() above. `encoding` is only
+// meaningful for string values and is ignored here.
+int32_t FastFill(Local<Value> receiver,
+                 const FastApiTypedArray<uint8_t>& target,
+                 const FastApiTypedArray<uint8_t>& value,
+                 uint32_t start,
+                 uint32_t end,
+                 Local<Value> encoding) {
+  uint8_t* target_data;
+  CHECK(target.getStorageIfAligned(&target_data));
+  uint8_t* value_data;
+  CHECK(value.getStorageIfAligned(&value_data));
+
+  const size_t fill_length = end - start;
+  // OOB Check. Throw the error in JS.
+  if (start > end || fill_length + start > target.length())
+    return -2;
 
-  if (in_there < fill_length) {
-    memcpy(ptr, ts_obj_data + start, fill_length - in_there);
-  }
+  const size_t value_length = value.length();
+  char* data = reinterpret_cast<char*>(target_data) + start;
+  memcpy(data, value_data, std::min(value_length, fill_length));
+
+  if (value_length >= fill_length)
+    return 0;
+  if (value_length == 0)
+    return -1;
+
+  RepeatFill(data, value_length, fill_length);
+  return 0;
 }
 
+CFunction fast_fill(CFunction::Make(FastFill));
+
 
 template <encoding encoding>
 void StringWrite(const FunctionCallbackInfo<Value>& args) {
@@ -739,6 +820,22 @@ void ByteLengthUtf8(const FunctionCallbackInfo<Value> &args) {
   args.GetReturnValue().Set(args[0].As<String>()->Utf8Length(env->isolate()));
 }
 
+// Only sequential one-byte strings reach the fast path. Every Latin-1
+// character above 0x7f takes two bytes in UTF-8, all others take one.
+uint32_t FastByteLengthUtf8(Local<Value> receiver,
+                            const FastOneByteString& source) {
+  uint32_t result = 0;
+  uint32_t length = source.length;
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(source.data);
+  for (uint32_t i = FindNonAscii(source.data, length); i < length; ++i) {
+    result += (data[i] >> 7);
+  }
+  result += length;
+  return result;
+}
+
+CFunction fast_byte_length_utf8(CFunction::Make(FastByteLengthUtf8));
+
 // Normalize val to be an integer in the range of [1, -1] since
 // implementations of memcmp() can vary by platform.
 static int normalizeCompareVal(int val, size_t a_length, size_t b_length) {
@@ -800,6 +897,45 @@ void CompareOffset(const FunctionCallbackInfo<Value> &args) {
   args.GetReturnValue().Set(val);
 }
 
+int32_t FastCompareOffset(Local<Value> receiver,
+                          const FastApiTypedArray<uint8_t>& source,
+                          const FastApiTypedArray<uint8_t>& target,
+                          uint32_t target_start,
+                          uint32_t source_start,
+                          uint32_t target_end,
+                          uint32_t source_end,
+                          // NOLINTNEXTLINE(runtime/references) This is V8 api.
+                          FastApiCallbackOptions& options) {
+  uint8_t* source_data;
+  CHECK(source.getStorageIfAligned(&source_data));
+  uint8_t* target_data;
+  CHECK(target.getStorageIfAligned(&target_data));
+  const size_t source_length = source.length();
+
+  // Let the slow path throw the out-of-range errors.
+  if (source_start > source_length || target_start > target.length()) {
+    options.fallback = true;
+    return 0;
+  }
+
+  CHECK_LE(source_start, source_end);
+  CHECK_LE(target_start, target_end);
+
+  size_t to_cmp =
+      std::min(std::min(static_cast<size_t>(source_end - source_start),
+                        static_cast<size_t>(target_end - target_start)),
+               source_length - source_start);
+
+  return normalizeCompareVal(to_cmp > 0 ?
+                               memcmp(source_data + source_start,
+                                      target_data + target_start,
+                                      to_cmp) : 0,
+                             source_end - source_start,
+                             target_end - target_start);
+}
+
+CFunction fast_compare_offset(CFunction::Make(FastCompareOffset));
+
 void Compare(const FunctionCallbackInfo<Value> &args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -816,6 +952,23 @@ void Compare(const FunctionCallbackInfo<Value> &args) {
   args.GetReturnValue().Set(val);
 }
 
+int32_t FastCompare(Local<Value> receiver,
+                    const FastApiTypedArray<uint8_t>& a,
+                    const FastApiTypedArray<uint8_t>& b) {
+  uint8_t* data_a;
+  CHECK(a.getStorageIfAligned(&data_a));
+  uint8_t* data_b;
+  CHECK(b.getStorageIfAligned(&data_b));
+
+  size_t cmp_length = std::min(a.length(), b.length());
+
+  return normalizeCompareVal(cmp_length > 0 ?
+                             memcmp(data_a, data_b, cmp_length) : 0,
+                             a.length(), b.length());
+}
+
+CFunction fast_compare(CFunction::Make(FastCompare));
+
 
 // Computes the offset for starting an indexOf or lastIndexOf search.
 // Returns either a valid offset in [0...<length - 1>], ie inside the Buffer,
@@ -968,29 +1121,19 @@ void IndexOfString(const FunctionCallbackInfo<Value>& args) {
   }
 
   args.GetReturnValue().Set(
-      result == haystack_length ? -1 : static_cast<int>(result));
+      result == haystack_length ? -1 : static_cast<double>(result));
 }
 
-void IndexOfBuffer(const FunctionCallbackInfo<Value>& args) {
-  CHECK(args[1]->IsObject());
-  CHECK(args[2]->IsNumber());
-  CHECK(args[3]->IsInt32());
-  CHECK(args[4]->IsBoolean());
-
-  enum encoding enc = static_cast<enum encoding>(args[3].As<Int32>()->Value());
-
-  THROW_AND_RETURN_UNLESS_BUFFER(Environment::GetCurrent(args), args[0]);
-  THROW_AND_RETURN_UNLESS_BUFFER(Environment::GetCurrent(args), args[1]);
-  ArrayBufferViewContents<char> haystack_contents(args[0]);
-  ArrayBufferViewContents<char> needle_contents(args[1]);
-  int64_t offset_i64 = args[2].As<Integer>()->Value();
-  bool is_forward = args[4]->IsTrue();
-
-  const char* haystack = haystack_contents.data();
-  const size_t haystack_length = haystack_contents.length();
-  const char* needle = needle_contents.data();
-  const size_t needle_length = needle_contents.length();
-
+// Shared by IndexOfBuffer() and FastIndexOfBuffer(). Returns the index of
+// the match, or -1 if there is none. Buffers can be longer than 2^31 - 1
+// bytes, so the index is returned to JS as a double.
+int64_t IndexOfBufferImpl(const char* haystack,
+                          size_t haystack_length,
+                          const char* needle,
+                          size_t needle_length,
+                          int64_t offset_i64,
+                          enum encoding enc,
+                          bool is_forward) {
   int64_t opt_offset = IndexOfOffset(haystack_length,
                                      offset_i64,
                                      needle_length,
@@ -998,29 +1141,28 @@ void IndexOfBuffer(const FunctionCallbackInfo<Value>& args) {
 
   if (needle_length == 0) {
     // Match String#indexOf() and String#lastIndexOf() behavior.
-    args.GetReturnValue().Set(static_cast<double>(opt_offset));
-    return;
+    return opt_offset;
   }
 
   if (haystack_length == 0) {
-    return args.GetReturnValue().Set(-1);
+    return -1;
   }
 
   if (opt_offset <= -1) {
-    return args.GetReturnValue().Set(-1);
+    return -1;
   }
   size_t offset = static_cast<size_t>(opt_offset);
   CHECK_LT(offset, haystack_length);
   if ((is_forward && needle_length + offset > haystack_length) ||
       needle_length > haystack_length) {
-    return args.GetReturnValue().Set(-1);
+    return -1;
   }
 
   size_t result = haystack_length;
 
   if (enc == UCS2) {
     if (haystack_length < 2 || needle_length < 2) {
-      return args.GetReturnValue().Set(-1);
+      return -1;
     }
     result = SearchString(
         reinterpret_cast<const uint16_t*>(haystack),
@@ -1040,41 +1182,115 @@ void IndexOfBuffer(const FunctionCallbackInfo<Value>& args) {
         is_forward);
   }
 
-  args.GetReturnValue().Set(
-      result == haystack_length ? -1 : static_cast<int>(result));
+  return result == haystack_length ? -1 : static_cast<int64_t>(result);
 }
 
-void IndexOfNumber(const FunctionCallbackInfo<Value>& args) {
-  CHECK(args[1]->IsUint32());
+void IndexOfBuffer(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[1]->IsObject());
   CHECK(args[2]->IsNumber());
-  CHECK(args[3]->IsBoolean());
+  CHECK(args[3]->IsInt32());
+  CHECK(args[4]->IsBoolean());
 
-  THROW_AND_RETURN_UNLESS_BUFFER(Environment::GetCurrent(args), args[0]);
-  ArrayBufferViewContents<char> buffer(args[0]);
+  enum encoding enc = static_cast<enum encoding>(args[3].As<Int32>()->Value());
 
-  uint32_t needle = args[1].As<Uint32>()->Value();
+  THROW_AND_RETURN_UNLESS_BUFFER(Environment::GetCurrent(args), args[0]);
+  THROW_AND_RETURN_UNLESS_BUFFER(Environment::GetCurrent(args), args[1]);
+  ArrayBufferViewContents<char> haystack_contents(args[0]);
+  ArrayBufferViewContents<char> needle_contents(args[1]);
   int64_t offset_i64 = args[2].As<Integer>()->Value();
-  bool is_forward = args[3]->IsTrue();
+  bool is_forward = args[4]->IsTrue();
 
-  int64_t opt_offset =
-      IndexOfOffset(buffer.length(), offset_i64, 1, is_forward);
-  if (opt_offset <= -1 || buffer.length() == 0) {
-    return args.GetReturnValue().Set(-1);
+  int64_t result = IndexOfBufferImpl(haystack_contents.data(),
+                                     haystack_contents.length(),
+                                     needle_contents.data(),
+                                     needle_contents.length(),
+                                     offset_i64,
+                                     enc,
+                                     is_forward);
+  args.GetReturnValue().Set(static_cast<double>(result));
+}
+
+double FastIndexOfBuffer(Local<Value> receiver,
+                         const FastApiTypedArray<uint8_t>& haystack,
+                         const FastApiTypedArray<uint8_t>& needle,
+                         double offset,
+                         int32_t enc,
+                         bool is_forward) {
+  uint8_t* haystack_data;
+  CHECK(haystack.getStorageIfAligned(&haystack_data));
+  uint8_t* needle_data;
+  CHECK(needle.getStorageIfAligned(&needle_data));
+
+  return static_cast<double>(
+      IndexOfBufferImpl(reinterpret_cast<const char*>(haystack_data),
+                        haystack.length(),
+                        reinterpret_cast<const char*>(needle_data),
+                        needle.length(),
+                        static_cast<int64_t>(offset),
+                        static_cast<enum encoding>(enc),
+                        is_forward));
+}
+
+CFunction fast_index_of_buffer(CFunction::Make(FastIndexOfBuffer));
+
+// Shared by IndexOfNumber() and FastIndexOfNumber(). Returns the index of
+// the match, or -1 if there is none, like IndexOfBufferImpl().
+int64_t IndexOfNumberImpl(const char* data,
+                          size_t length,
+                          uint32_t needle,
+                          int64_t offset_i64,
+                          bool is_forward) {
+  int64_t opt_offset = IndexOfOffset(length, offset_i64, 1, is_forward);
+  if (opt_offset <= -1 || length == 0) {
+    return -1;
   }
   size_t offset = static_cast<size_t>(opt_offset);
-  CHECK_LT(offset, buffer.length());
+  CHECK_LT(offset, length);
 
   const void* ptr;
   if (is_forward) {
-    ptr = memchr(buffer.data() + offset, needle, buffer.length() - offset);
+    ptr = memchr(data + offset, needle, length - offset);
   } else {
-    ptr = node::stringsearch::MemrchrFill(buffer.data(), needle, offset + 1);
+    ptr = node::stringsearch::MemrchrFill(data, needle, offset + 1);
   }
   const char* ptr_char = static_cast<const char*>(ptr);
-  args.GetReturnValue().Set(ptr ? static_cast<int>(ptr_char - buffer.data())
-                                : -1);
+  return ptr ? static_cast<int64_t>(ptr_char - data) : -1;
 }
 
+void IndexOfNumber(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[1]->IsUint32());
+  CHECK(args[2]->IsNumber());
+  CHECK(args[3]->IsBoolean());
+
+  THROW_AND_RETURN_UNLESS_BUFFER(Environment::GetCurrent(args), args[0]);
+  ArrayBufferViewContents<char> buffer(args[0]);
+
+  uint32_t needle = args[1].As<Uint32>()->Value();
+  int64_t offset_i64 = args[2].As<Integer>()->Value();
+  bool is_forward = args[3]->IsTrue();
+
+  args.GetReturnValue().Set(static_cast<double>(IndexOfNumberImpl(
+      buffer.data(), buffer.length(), needle, offset_i64, is_forward)));
+}
+
+double FastIndexOfNumber(Local<Value> receiver,
+                         const FastApiTypedArray<uint8_t>& buffer,
+                         uint32_t needle,
+                         double offset,
+                         bool is_forward) {
+  uint8_t* buffer_data;
+  CHECK(buffer.getStorageIfAligned(&buffer_data));
+
+  return static_cast<double>(
+      IndexOfNumberImpl(reinterpret_cast<const char*>(buffer_data),
+                        buffer.length(),
+                        needle,
+                        static_cast<int64_t>(offset),
+                        is_forward));
+}
+
+CFunction fast_index_of_number(CFunction::Make(FastIndexOfNumber));
+
 
 void Swap16(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -1102,6 +1318,17 @@ void Swap64(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(args[0]);
 }
 
+template <void (*swap)(char*, size_t)>
+void FastSwap(Local<Value> receiver, const FastApiTypedArray<uint8_t>& buffer) {
+  uint8_t* data;
+  CHECK(buffer.getStorageIfAligned(&data));
+  swap(reinterpret_cast<char*>(data), buffer.length());
+}
+
+CFunction fast_swap16(CFunction::Make(FastSwap<SwapBytes16>));
+CFunction fast_swap32(CFunction::Make(FastSwap<SwapBytes32>));
+CFunction fast_swap64(CFunction::Make(FastSwap<SwapBytes64>));
+
 
 // Encode a single string to a UTF-8 Uint8Array (not Buffer).
 // Used in TextEncoder.prototype.encode.
@@ -1122,11 +1349,22 @@ static void EncodeUtf8String(const FunctionCallbackInfo<Value>& args) {
 
     CHECK(bs);
 
-    str->WriteUtf8(isolate,
-                   static_cast<char*>(bs->Data()),
-                   -1,  // We are certain that `data` is sufficiently large
-                   nullptr,
-                   String::NO_NULL_TERMINATION | String::REPLACE_INVALID_UTF8);
+    // Every character outside of ASCII takes up more than one byte in UTF-8,
+    // so if the lengths match the string can be copied out without encoding.
+    if (length == static_cast<size_t>(str->Length())) {
+      str->WriteOneByte(isolate,
+                        static_cast<uint8_t*>(bs->Data()),
+                        0,
+                        -1,
+                        String::NO_NULL_TERMINATION);
+    } else {
+      str->WriteUtf8(isolate,
+                     static_cast<char*>(bs->Data()),
+                     -1,  // We are certain that `data` is sufficiently large
+                     nullptr,
+                     String::NO_NULL_TERMINATION |
+                         String::REPLACE_INVALID_UTF8);
+    }
 
     ab = ArrayBuffer::New(isolate, std::move(bs));
   }
@@ -1157,6 +1395,24 @@ static void EncodeInto(const FunctionCallbackInfo<Value>& args) {
       static_cast<char*>(result_arr->Buffer()->Data()) +
       result_arr->ByteOffset());
 
+  // An ASCII string that fits can be copied out as Latin-1, and the number
+  // of characters read equals the number of bytes written. Every character
+  // outside of ASCII takes up more than one byte in UTF-8, so the string is
+  // ASCII if the lengths match.
+  const int length = source->Length();
+  if (source->IsOneByte() &&
+      static_cast<size_t>(length) <= dest_length &&
+      source->Utf8Length(isolate) == length) {
+    source->WriteOneByte(isolate,
+                         reinterpret_cast<uint8_t*>(write_result),
+                         0,
+                         length,
+                         String::NO_NULL_TERMINATION);
+    results[0] = length;
+    results[1] = length;
+    return;
+  }
+
   int nchars;
   int written = source->WriteUtf8(
       isolate,
@@ -1168,6 +1424,73 @@ static void EncodeInto(const FunctionCallbackInfo<Value>& args) {
   results[1] = written;
 }
 
+static void IsUtf8(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK_EQ(args.Length(), 1);
+  CHECK(args[0]->IsArrayBufferView() || args[0]->IsArrayBuffer() ||
+        args[0]->IsSharedArrayBuffer());
+  ArrayBufferViewContents<char> buffer;
+  buffer.ReadValue(args[0]);
+  if (buffer.WasDetached()) {
+    return THROW_ERR_INVALID_STATE(env,
+                                   "Cannot validate on a detached buffer");
+  }
+  args.GetReturnValue().Set(IsValidUtf8(buffer.data(), buffer.length()));
+}
+
+static void IsAscii(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK_EQ(args.Length(), 1);
+  CHECK(args[0]->IsArrayBufferView() || args[0]->IsArrayBuffer() ||
+        args[0]->IsSharedArrayBuffer());
+  ArrayBufferViewContents<char> buffer;
+  buffer.ReadValue(args[0]);
+  if (buffer.WasDetached()) {
+    return THROW_ERR_INVALID_STATE(env,
+                                   "Cannot validate on a detached buffer");
+  }
+  args.GetReturnValue().Set(node::IsAscii(buffer.data(), buffer.length()));
+}
+
+// Decodes a whole UTF-8 input for TextDecoder.prototype.decode() when it is
+// not streaming, without going through an ICU converter.
+// Returns undefined if `fatal` is set and the input is malformed.
+static void DecodeUTF8(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  CHECK_GE(args.Length(), 3);
+  CHECK(args[0]->IsArrayBufferView());
+
+  ArrayBufferViewContents<char> buffer(args[0]);
+  const bool ignore_bom = args[1]->IsTrue();
+  const bool has_fatal = args[2]->IsTrue();
+
+  const char* data = buffer.data();
+  size_t length = buffer.length();
+
+  if (has_fatal && !IsValidUtf8(data, length))
+    return;
+
+  if (!ignore_bom && length >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+    data += 3;
+    length -= 3;
+  }
+
+  if (length == 0)
+    return args.GetReturnValue().SetEmptyString();
+
+  Local<Value> error;
+  MaybeLocal<Value> maybe_ret =
+      StringBytes::Encode(isolate, data, length, UTF8, &error);
+  Local<Value> ret;
+  if (!maybe_ret.ToLocal(&ret)) {
+    CHECK(!error.IsEmpty());
+    isolate->ThrowException(error);
+    return;
+  }
+  args.GetReturnValue().Set(ret);
+}
+
 
 void SetBufferPrototype(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -1283,24 +1606,35 @@ void Initialize(Local<Object> target,
   SetMethod(context, target, "setBufferPrototype", SetBufferPrototype);
   SetMethodNoSideEffect(context, target, "createFromString", CreateFromString);
 
-  SetMethodNoSideEffect(context, target, "byteLengthUtf8", ByteLengthUtf8);
-  SetMethod(context, target, "copy", Copy);
-  SetMethodNoSideEffect(context, target, "compare", Compare);
-  SetMethodNoSideEffect(context, target, "compareOffset", CompareOffset);
-  SetMethod(context, target, "fill", Fill);
-  SetMethodNoSideEffect(context, target, "indexOfBuffer", IndexOfBuffer);
-  SetMethodNoSideEffect(context, target, "indexOfNumber", IndexOfNumber);
+  SetFastMethodNoSideEffect(context,
+                            target,
+                            "byteLengthUtf8",
+                            ByteLengthUtf8,
+                            &fast_byte_length_utf8);
+  SetFastMethod(context, target, "copy", Copy, &fast_copy);
+  SetFastMethodNoSideEffect(context, target, "compare", Compare, &fast_compare);
+  SetFastMethodNoSideEffect(
+      context, target, "compareOffset", CompareOffset, &fast_compare_offset);
+  SetFastMethod(context, target, "fill", Fill, &fast_fill);
+  SetFastMethodNoSideEffect(
+      context, target, "indexOfBuffer", IndexOfBuffer, &fast_index_of_buffer);
+  SetFastMethodNoSideEffect(
+      context, target, "indexOfNumber", IndexOfNumber, &fast_index_of_number);
   SetMethodNoSideEffect(context, target, "indexOfString", IndexOfString);
 
   SetMethod(context, target, "detachArrayBuffer", DetachArrayBuffer);
   SetMethod(context, target, "copyArrayBuffer", CopyArrayBuffer);
 
-  SetMethod(context, target, "swap16", Swap16);
-  SetMethod(context, target, "swap32", Swap32);
-  SetMethod(context, target, "swap64", Swap64);
+  SetFastMethod(context, target, "swap16", Swap16, &fast_swap16);
+  SetFastMethod(context, target, "swap32", Swap32, &fast_swap32);
+  SetFastMethod(context, target, "swap64", Swap64, &fast_swap64);
 
   SetMethod(context, target, "encodeInto", EncodeInto);
   SetMethodNoSideEffect(context, target, "encodeUtf8String", EncodeUtf8String);
+  SetMethodNoSideEffect(context, target, "decodeUTF8", DecodeUTF8);
+
+  SetMethodNoSideEffect(context, target, "isUtf8", IsUtf8);
+  SetMethodNoSideEffect(context, target, "isAscii", IsAscii);
 
   target
       ->Set(context,
@@ -1341,20 +1675,44 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(CreateFromString);
 
   registry->Register(ByteLengthUtf8);
+  registry->Register(FastByteLengthUtf8);
+  registry->Register(fast_byte_length_utf8.GetTypeInfo());
   registry->Register(Copy);
+  registry->Register(FastCopy);
+  registry->Register(fast_copy.GetTypeInfo());
   registry->Register(Compare);
+  registry->Register(FastCompare);
+  registry->Register(fast_compare.GetTypeInfo());
   registry->Register(CompareOffset);
+  registry->Register(FastCompareOffset);
+  registry->Register(fast_compare_offset.GetTypeInfo());
   registry->Register(Fill);
+  registry->Register(FastFill);
+  registry->Register(fast_fill.GetTypeInfo());
   registry->Register(IndexOfBuffer);
+  registry->Register(FastIndexOfBuffer);
+  registry->Register(fast_index_of_buffer.GetTypeInfo());
   registry->Register(IndexOfNumber);
+  registry->Register(FastIndexOfNumber);
+  registry->Register(fast_index_of_number.GetTypeInfo());
   registry->Register(IndexOfString);
 
   registry->Register(Swap16);
   registry->Register(Swap32);
   registry->Register(Swap64);
+  registry->Register(FastSwap<SwapBytes16>);
+  registry->Register(FastSwap<SwapBytes32>);
+  registry->Register(FastSwap<SwapBytes64>);
+  registry->Register(fast_swap16.GetTypeInfo());
+  registry->Register(fast_swap32.GetTypeInfo());
+  registry->Register(fast_swap64.GetTypeInfo());
 
   registry->Register(EncodeInto);
   registry->Register(EncodeUtf8String);
+  registry->Register(DecodeUTF8);
+
+  registry->Register(IsUtf8);
+  registry->Register(IsAscii);
 
   registry->Register(StringSlice<ASCII>);
   registry->Register(StringSlice<BASE64>);
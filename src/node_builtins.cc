@@ -240,7 +240,7 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(
       OneByteString(isolate, filename_s.c_str(), filename_s.size());
   ScriptOrigin origin(isolate, filename, 0, 0, true);
 
-  ScriptCompiler::CachedData* cached_data = nullptr;
+  std::shared_ptr<ScriptCompiler::CachedData> cached_data;
   {
     // Note: The lock here should not extend into the
     // `CompileFunctionInContext()` call below, because this function may
@@ -249,9 +249,10 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(
     Mutex::ScopedLock lock(code_cache_mutex_);
     auto cache_it = code_cache_.find(id);
     if (cache_it != code_cache_.end()) {
-      // Transfer ownership to ScriptCompiler::Source later.
-      cached_data = cache_it->second.release();
-      code_cache_.erase(cache_it);
+      // Keep the entry in the map so that other threads compiling the same
+      // module in the meantime can use it too. Holding a reference keeps the
+      // buffer alive even if the entry gets replaced.
+      cached_data = cache_it->second;
     }
   }
 
@@ -259,7 +260,16 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(
   ScriptCompiler::CompileOptions options =
       has_cache ? ScriptCompiler::kConsumeCodeCache
                 : ScriptCompiler::kEagerCompile;
-  ScriptCompiler::Source script_source(source, origin, cached_data);
+  // ScriptCompiler::Source takes ownership of the CachedData object, but must
+  // not free the shared buffer.
+  ScriptCompiler::Source script_source(
+      source,
+      origin,
+      has_cache ? new ScriptCompiler::CachedData(
+                      cached_data->data,
+                      cached_data->length,
+                      ScriptCompiler::CachedData::BufferNotOwned)
+                : nullptr);
 
   per_process::Debug(DebugCategory::CODE_CACHE,
                      "Compiling %s %s code cache\n",
@@ -306,20 +316,27 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(
                                                                : "is accepted");
   }
 
+  // The cache was accepted, so there is nothing new to store. Regenerating it
+  // here would serialize the function on every compilation, i.e. once per
+  // module for every worker that is started.
+  if (*result == Result::kWithCache) {
+    return scope.Escape(fun);
+  }
+
   // Generate new cache for next compilation
-  std::unique_ptr<ScriptCompiler::CachedData> new_cached_data(
+  std::shared_ptr<ScriptCompiler::CachedData> new_cached_data(
       ScriptCompiler::CreateCodeCacheForFunction(fun));
   CHECK_NOT_NULL(new_cached_data);
 
   {
     Mutex::ScopedLock lock(code_cache_mutex_);
     const auto it = code_cache_.find(id);
-    // TODO(joyeecheung): it's safer for each thread to have its own
-    // copy of the code cache map.
     if (it == code_cache_.end()) {
       code_cache_.emplace(id, std::move(new_cached_data));
-    } else {
-      it->second.reset(new_cached_data.release());
+    } else if (it->second == cached_data) {
+      // Only replace the entry if no other thread has done so since we
+      // looked it up.
+      it->second = std::move(new_cached_data);
     }
   }
 
@@ -443,9 +460,9 @@ void BuiltinLoader::RefreshCodeCache(const std::vector<CodeCacheInfo>& in) {
     auto cache_it = out->find(item.id);
     if (cache_it != out->end()) {
       // Release the old cache and replace it with the new copy.
-      cache_it->second.reset(new_cache.release());
+      cache_it->second = std::move(new_cache);
     } else {
-      out->emplace(item.id, new_cache.release());
+      out->emplace(item.id, std::move(new_cache));
     }
   }
   loader->has_code_cache_ = true;
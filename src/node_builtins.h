@@ -21,9 +21,11 @@ class ExternalReferenceRegistry;
 namespace builtins {
 
 using BuiltinSourceMap = std::map<std::string, UnionBytes>;
+// The cache entries are shared by all threads that compile built-in modules,
+// so that concurrently starting workers can consume them at the same time.
 using BuiltinCodeCacheMap =
     std::unordered_map<std::string,
-                       std::unique_ptr<v8::ScriptCompiler::CachedData>>;
+                       std::shared_ptr<v8::ScriptCompiler::CachedData>>;
 
 struct CodeCacheInfo {
   std::string id;
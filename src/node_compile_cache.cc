@@ -0,0 +1,407 @@
+#include "node_compile_cache.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_internals.h"
+#include "threadpoolwork-inl.h"
+#include "util-inl.h"
+#include "zlib.h"
+
+#if HAVE_OPENSSL
+#include "openssl/sha.h"
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace node {
+
+using v8::Isolate;
+using v8::Local;
+using v8::ScriptCompiler;
+using v8::String;
+
+namespace {
+
+// Layout of the cache file. Integers are stored in host byte order, the file
+// is not meant to be shared between machines.
+//
+//   [ FileHeader ]
+//   [ RecordHeader ][ file name ][ padding ][ cached data ][ padding ]  ...
+//
+// The cached data of each record is aligned to kRecordAlignment bytes, so
+// that V8 can consume it from the mapped file without copying it first.
+struct FileHeader {
+  uint32_t magic;
+  // ScriptCompiler::CachedDataVersionTag(), i.e. the V8 version and flags.
+  uint32_t version_tag;
+  uint32_t record_count;
+  // crc32 of everything after the header.
+  uint32_t checksum;
+  uint64_t payload_size;
+};
+
+struct RecordHeader {
+  uint32_t type;
+  uint32_t filename_size;
+  uint32_t data_size;
+  uint32_t reserved;
+  SourceHash source_hash;
+};
+
+constexpr uint32_t kMagic = 0x3263636e;  // "ncc2"
+constexpr size_t kRecordAlignment = 8;
+static_assert(sizeof(FileHeader) % kRecordAlignment == 0,
+              "FileHeader must keep records aligned");
+static_assert(sizeof(RecordHeader) % kRecordAlignment == 0,
+              "RecordHeader must keep records aligned");
+
+const char kPadding[kRecordAlignment] = {};
+
+size_t PaddingFor(size_t size) {
+  return RoundUp(size, kRecordAlignment) - size;
+}
+
+}  // anonymous namespace
+
+std::shared_ptr<CompileCacheFile> CompileCacheFile::Load(
+    const std::string& path) {
+  std::shared_ptr<CompileCacheFile> file(new CompileCacheFile());
+#ifdef _WIN32
+  if (ReadFileSync(&file->contents_, path.c_str()) != 0 ||
+      file->contents_.empty()) {
+    return nullptr;
+  }
+  file->data_ = reinterpret_cast<const uint8_t*>(file->contents_.data());
+  file->size_ = file->contents_.size();
+#else
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return nullptr;
+  struct stat st;
+  void* mapping = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    mapping =
+        mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (mapping == MAP_FAILED) return nullptr;
+  file->data_ = static_cast<const uint8_t*>(mapping);
+  file->size_ = st.st_size;
+#endif
+  return file;
+}
+
+CompileCacheFile::~CompileCacheFile() {
+#ifndef _WIN32
+  if (data_ != nullptr)
+    munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+}
+
+class CacheFileWriter::WriteWork final : public ThreadPoolWork {
+ public:
+  WriteWork(Environment* env,
+            const CacheFileWriter* writer,
+            std::unique_ptr<Snapshot> snapshot)
+      : ThreadPoolWork(env),
+        path_(writer->path_),
+        category_(writer->category_),
+        name_(writer->name_),
+        generation_(writer->generation_),
+        snapshot_(std::move(snapshot)),
+        state_(writer->write_state_) {}
+
+  void DoThreadPoolWork() override {
+    Mutex::ScopedLock lock(state_->mutex);
+    // A newer version of the entries has been written in the meantime.
+    if (generation_ <= state_->written_generation) return;
+
+    std::vector<uv_buf_t> bufs = snapshot_->Serialize();
+    const int err = WriteFileAtomically(
+        path_.c_str(), state_->temp_path.c_str(), bufs.data(), bufs.size());
+    if (err < 0) {
+      per_process::Debug(category_,
+                         "Could not write %s %s: %s\n",
+                         name_,
+                         path_,
+                         uv_strerror(err));
+      return;
+    }
+    state_->written_generation = generation_;
+    per_process::Debug(category_,
+                       "Wrote %d entries to %s %s\n",
+                       snapshot_->entry_count(),
+                       name_,
+                       path_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    delete this;
+  }
+
+ private:
+  const std::string path_;
+  const DebugCategory category_;
+  const char* const name_;
+  const uint64_t generation_;
+  std::unique_ptr<Snapshot> snapshot_;
+  std::shared_ptr<WriteState> state_;
+};
+
+CacheFileWriter::CacheFileWriter(Environment* env,
+                                 const std::string& path,
+                                 DebugCategory category,
+                                 const char* name,
+                                 TakeSnapshot take_snapshot)
+    : env_(env),
+      path_(path),
+      category_(category),
+      name_(name),
+      take_snapshot_(std::move(take_snapshot)),
+      write_state_(std::make_shared<WriteState>()) {
+  write_state_->temp_path = SPrintF(
+      "%s.%d.%d.tmp", path, uv_os_getpid(), env->thread_id());
+  env->AtExit([](void* arg) {
+    static_cast<CacheFileWriter*>(arg)->Flush(true);
+  }, this);
+}
+
+void CacheFileWriter::EntryAdded() {
+  generation_++;
+  if (!flush_scheduled_) {
+    // Wait until the current tick is done, so that all modules that are
+    // loaded synchronously during startup are written out together.
+    flush_scheduled_ = true;
+    env_->SetImmediate([this](Environment* env) { Flush(false); });
+  }
+}
+
+void CacheFileWriter::Flush(bool sync) {
+  flush_scheduled_ = false;
+  if (generation_ == flushed_generation_) return;
+  flushed_generation_ = generation_;
+
+  std::unique_ptr<WriteWork> work =
+      std::make_unique<WriteWork>(env_, this, take_snapshot_());
+  if (sync) {
+    work->DoThreadPoolWork();
+  } else {
+    work.release()->ScheduleWork();
+  }
+}
+
+class CompileCache::Snapshot final : public CacheFileWriter::Snapshot {
+ public:
+  Snapshot(uint32_t version_tag, std::shared_ptr<CompileCacheFile> file)
+      : version_tag_(version_tag), file_(std::move(file)) {}
+
+  EntryList* entries() { return entries_; }
+
+  std::vector<uv_buf_t> Serialize() override;
+  size_t entry_count() const override { return header_.record_count; }
+
+ private:
+  const uint32_t version_tag_;
+  EntryList entries_[static_cast<size_t>(CachedCodeType::kCount)];
+  // Keeps the entries that point into the loaded file valid.
+  std::shared_ptr<CompileCacheFile> file_;
+  FileHeader header_ = {};
+  std::vector<RecordHeader> records_;
+};
+
+std::vector<uv_buf_t> CompileCache::Snapshot::Serialize() {
+  size_t record_count = 0;
+  for (const EntryList& list : entries_)
+    record_count += list.size();
+
+  records_.reserve(record_count);
+  std::vector<uv_buf_t> bufs;
+  bufs.reserve(1 + record_count * 5);
+
+  header_.magic = kMagic;
+  header_.version_tag = version_tag_;
+  header_.record_count = static_cast<uint32_t>(record_count);
+  header_.checksum = crc32_z(0, nullptr, 0);
+  header_.payload_size = 0;
+  bufs.push_back(uv_buf_init(reinterpret_cast<char*>(&header_),
+                             sizeof(header_)));
+
+  auto append = [&](const void* data, size_t size) {
+    if (size == 0) return;
+    char* base = const_cast<char*>(static_cast<const char*>(data));
+    bufs.push_back(uv_buf_init(base, size));
+    header_.checksum =
+        crc32_z(header_.checksum, reinterpret_cast<const Bytef*>(base), size);
+    header_.payload_size += size;
+  };
+
+  for (size_t type = 0; type < arraysize(entries_); type++) {
+    for (const auto& it : entries_[type]) {
+      const std::string& filename = it.first;
+      const Entry& entry = *it.second;
+      records_.push_back({static_cast<uint32_t>(type),
+                          static_cast<uint32_t>(filename.size()),
+                          static_cast<uint32_t>(entry.size),
+                          0,
+                          entry.source_hash});
+      append(&records_.back(), sizeof(RecordHeader));
+      append(filename.data(), filename.size());
+      append(kPadding, PaddingFor(filename.size()));
+      append(entry.data, entry.size);
+      append(kPadding, PaddingFor(entry.size));
+    }
+  }
+  return bufs;
+}
+
+CompileCache::CompileCache(Environment* env, const std::string& path)
+    : env_(env),
+      path_(path),
+      version_tag_(ScriptCompiler::CachedDataVersionTag()),
+      writer_(env,
+              path,
+              DebugCategory::COMPILE_CACHE,
+              "compile cache",
+              [this]() { return TakeSnapshot(); }) {
+  Load();
+}
+
+CompileCache::~CompileCache() = default;
+
+void CompileCache::Load() {
+  file_ = CompileCacheFile::Load(path_);
+  if (!file_) {
+    Debug(env_, DebugCategory::COMPILE_CACHE,
+          "Could not read compile cache %s\n", path_);
+    return;
+  }
+
+  const uint8_t* data = file_->data();
+  const size_t size = file_->size();
+  FileHeader header;
+  if (size < sizeof(header)) {
+    Debug(env_, DebugCategory::COMPILE_CACHE,
+          "Compile cache %s is truncated\n", path_);
+    file_.reset();
+    return;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (header.magic != kMagic ||
+      header.version_tag != version_tag_ ||
+      header.payload_size != size - sizeof(header) ||
+      crc32_z(0, data + sizeof(header), header.payload_size) !=
+          header.checksum) {
+    Debug(env_, DebugCategory::COMPILE_CACHE,
+          "Compile cache %s is invalid or was written by another version "
+          "of V8\n", path_);
+    file_.reset();
+    return;
+  }
+
+  size_t offset = sizeof(header);
+  for (uint32_t i = 0; i < header.record_count; i++) {
+    RecordHeader record;
+    if (size - offset < sizeof(record)) break;
+    memcpy(&record, data + offset, sizeof(record));
+    offset += sizeof(record);
+
+    const size_t filename_size =
+        record.filename_size + PaddingFor(record.filename_size);
+    const size_t data_size = record.data_size + PaddingFor(record.data_size);
+    if (record.type >= static_cast<uint32_t>(CachedCodeType::kCount) ||
+        size - offset < filename_size ||
+        size - offset - filename_size < data_size) {
+      break;
+    }
+
+    std::string filename(reinterpret_cast<const char*>(data + offset),
+                         record.filename_size);
+    offset += filename_size;
+    auto entry = std::make_shared<Entry>();
+    entry->source_hash = record.source_hash;
+    entry->data = data + offset;
+    entry->size = record.data_size;
+    offset += data_size;
+    entries_[record.type].emplace(std::move(filename), std::move(entry));
+  }
+
+  Debug(env_, DebugCategory::COMPILE_CACHE,
+        "Loaded %d entries from compile cache %s\n",
+        header.record_count, path_);
+}
+
+ScriptCompiler::CachedData* CompileCache::Get(CachedCodeType type,
+                                              Local<String> filename,
+                                              Local<String> source,
+                                              CompileCacheKey* key) {
+  Isolate* isolate = env_->isolate();
+  Utf8Value filename_utf8(isolate, filename);
+  Utf8Value source_utf8(isolate, source);
+  key->type = type;
+  key->filename = filename_utf8.ToString();
+#if HAVE_OPENSSL
+  static_assert(std::tuple_size<SourceHash>::value == SHA256_DIGEST_LENGTH,
+                "SourceHash must hold a SHA-256 digest");
+  SHA256(reinterpret_cast<const unsigned char*>(source_utf8.out()),
+         source_utf8.length(),
+         key->source_hash.data());
+#else
+  // Environment::compile_cache() does not create a cache without OpenSSL.
+  UNREACHABLE();
+#endif
+
+  const EntryMap& entries = entries_[static_cast<size_t>(type)];
+  auto it = entries.find(key->filename);
+  if (it == entries.end()) {
+    Debug(env_, DebugCategory::COMPILE_CACHE,
+          "No cached code for %s\n", key->filename);
+    return nullptr;
+  }
+  const Entry& entry = *it->second;
+  if (entry.source_hash != key->source_hash) {
+    Debug(env_, DebugCategory::COMPILE_CACHE,
+          "Cached code for %s is outdated\n", key->filename);
+    return nullptr;
+  }
+  Debug(env_, DebugCategory::COMPILE_CACHE,
+        "Found cached code for %s\n", key->filename);
+  return new ScriptCompiler::CachedData(
+      entry.data,
+      entry.size,
+      ScriptCompiler::CachedData::BufferNotOwned);
+}
+
+void CompileCache::Put(CompileCacheKey&& key,
+                       std::unique_ptr<ScriptCompiler::CachedData> data) {
+  if (!data || data->length <= 0) return;
+  Debug(env_, DebugCategory::COMPILE_CACHE,
+        "Caching code for %s\n", key.filename);
+
+  auto entry = std::make_shared<Entry>();
+  entry->source_hash = key.source_hash;
+  entry->data = data->data;
+  entry->size = data->length;
+  entry->owned_data = std::move(data);
+  entries_[static_cast<size_t>(key.type)][std::move(key.filename)] =
+      std::move(entry);
+  writer_.EntryAdded();
+}
+
+std::unique_ptr<CacheFileWriter::Snapshot>
+CompileCache::TakeSnapshot() const {
+  auto snapshot = std::make_unique<Snapshot>(version_tag_, file_);
+  for (size_t i = 0; i < static_cast<size_t>(CachedCodeType::kCount); i++) {
+    EntryList* list = &snapshot->entries()[i];
+    list->reserve(entries_[i].size());
+    for (const auto& it : entries_[i])
+      list->emplace_back(it.first, it.second);
+  }
+  return snapshot;
+}
+
+}  // namespace node
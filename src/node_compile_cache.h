@@ -0,0 +1,180 @@
+#ifndef SRC_NODE_COMPILE_CACHE_H_
+#define SRC_NODE_COMPILE_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <array>
+#include <cinttypes>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "debug_utils.h"
+#include "node_mutex.h"
+#include "uv.h"
+#include "v8.h"
+
+namespace node {
+
+class Environment;
+
+enum class CachedCodeType : uint32_t {
+  kCommonJS = 0,
+  kESM,
+  kCount
+};
+
+// Identifies the code that was compiled, see CompileCache::Get().
+// SHA-256 of the UTF-8 encoded source text.
+using SourceHash = std::array<uint8_t, 32>;
+
+struct CompileCacheKey {
+  CachedCodeType type;
+  std::string filename;
+  SourceHash source_hash;
+};
+
+// The contents of a compile cache file on disk. On POSIX systems the file is
+// memory-mapped, so that only the parts that are actually used are read.
+class CompileCacheFile {
+ public:
+  // Returns nullptr if the file does not exist or cannot be read.
+  static std::shared_ptr<CompileCacheFile> Load(const std::string& path);
+  ~CompileCacheFile();
+
+  CompileCacheFile(const CompileCacheFile&) = delete;
+  CompileCacheFile& operator=(const CompileCacheFile&) = delete;
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  CompileCacheFile() = default;
+
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+#ifdef _WIN32
+  std::string contents_;
+#endif
+};
+
+// Writes the file of a cache that is loaded on startup, like CompileCache and
+// ResolutionCache. Once entries are added, the file is written on the
+// threadpool after the current tick, and synchronously when the Environment
+// exits. Each write replaces the whole file with a snapshot of the cache.
+class CacheFileWriter {
+ public:
+  // The contents of the cache at the time the write was scheduled.
+  class Snapshot {
+   public:
+    virtual ~Snapshot() = default;
+    // Returns the buffers that make up the file. Runs on the threadpool.
+    virtual std::vector<uv_buf_t> Serialize() = 0;
+    virtual size_t entry_count() const = 0;
+  };
+  using TakeSnapshot = std::function<std::unique_ptr<Snapshot>()>;
+
+  // `name` is used in debug output for `category`.
+  CacheFileWriter(Environment* env,
+                  const std::string& path,
+                  DebugCategory category,
+                  const char* name,
+                  TakeSnapshot take_snapshot);
+
+  CacheFileWriter(const CacheFileWriter&) = delete;
+  CacheFileWriter& operator=(const CacheFileWriter&) = delete;
+
+  // Schedules a write.
+  void EntryAdded();
+  // Writes the file if entries were added since the last time.
+  void Flush(bool sync);
+
+ private:
+  // Only one thread writes the file at a time, and a write never replaces the
+  // file with a version that is older than the last one that was written.
+  struct WriteState {
+    Mutex mutex;
+    uint64_t written_generation = 0;
+    // Unique per process and thread.
+    std::string temp_path;
+  };
+
+  class WriteWork;
+
+  Environment* const env_;
+  const std::string path_;
+  const DebugCategory category_;
+  const char* const name_;
+  const TakeSnapshot take_snapshot_;
+
+  // Incremented whenever an entry is added.
+  uint64_t generation_ = 0;
+  uint64_t flushed_generation_ = 0;
+  bool flush_scheduled_ = false;
+  std::shared_ptr<WriteState> write_state_;
+};
+
+// An opt-in cache for the code that V8 compiles for user-land CommonJS and
+// ES modules, enabled with --experimental-compile-cache=file.
+//
+// All entries are stored in a single file that is loaded on startup. An entry
+// is used if the file name and the SHA-256 of the source text match, and the
+// file is discarded altogether if it was written by a different version of V8
+// or with different V8 flags. New entries are written back asynchronously once
+// the current tick is done, and synchronously when the Environment exits.
+class CompileCache {
+ public:
+  CompileCache(Environment* env, const std::string& path);
+  ~CompileCache();
+
+  CompileCache(const CompileCache&) = delete;
+  CompileCache& operator=(const CompileCache&) = delete;
+
+  // Returns the cached code for the given version of `source`, or nullptr.
+  // The returned object does not own its buffer, which remains valid until
+  // the next Put() for the same file. `key` is filled in for that Put().
+  v8::ScriptCompiler::CachedData* Get(CachedCodeType type,
+                                      v8::Local<v8::String> filename,
+                                      v8::Local<v8::String> source,
+                                      CompileCacheKey* key);
+  // Stores the code that was compiled for `key` because it was not found in
+  // the cache or was rejected by V8.
+  void Put(CompileCacheKey&& key,
+           std::unique_ptr<v8::ScriptCompiler::CachedData> data);
+
+  // Writes all entries to disk if new ones were added since the last time.
+  void Flush(bool sync) { writer_.Flush(sync); }
+
+ private:
+  struct Entry {
+    SourceHash source_hash;
+    // Points either into `file_` or into `owned_data`.
+    const uint8_t* data;
+    size_t size;
+    std::unique_ptr<v8::ScriptCompiler::CachedData> owned_data;
+  };
+  using EntryMap =
+      std::unordered_map<std::string, std::shared_ptr<const Entry>>;
+  using EntryList =
+      std::vector<std::pair<std::string, std::shared_ptr<const Entry>>>;
+
+  class Snapshot;
+
+  void Load();
+  std::unique_ptr<CacheFileWriter::Snapshot> TakeSnapshot() const;
+
+  Environment* const env_;
+  const std::string path_;
+  const uint32_t version_tag_;
+  std::shared_ptr<CompileCacheFile> file_;
+  EntryMap entries_[static_cast<size_t>(CachedCodeType::kCount)];
+  CacheFileWriter writer_;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_COMPILE_CACHE_H_
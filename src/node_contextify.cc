@@ -24,6 +24,7 @@
 #include "base_object-inl.h"
 #include "memory_tracker-inl.h"
 #include "module_wrap.h"
+#include "node_compile_cache.h"
 #include "node_context_data.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
@@ -1064,12 +1065,24 @@ void ContextifyContext::CompileFunction(
     params_buf = args[8].As<Array>();
   }
 
+  // Argument 10: whether to use the compile cache (optional), only set by
+  // the CommonJS loader.
+  CompileCache* compile_cache = nullptr;
+  if (args[9]->IsTrue()) {
+    CHECK(cached_data_buf.IsEmpty());
+    compile_cache = env->compile_cache();
+  }
+
   // Read cache from cached data buffer
   ScriptCompiler::CachedData* cached_data = nullptr;
+  CompileCacheKey compile_cache_key;
   if (!cached_data_buf.IsEmpty()) {
     uint8_t* data = static_cast<uint8_t*>(cached_data_buf->Buffer()->Data());
     cached_data = new ScriptCompiler::CachedData(
       data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
+  } else if (compile_cache != nullptr) {
+    cached_data = compile_cache->Get(
+        CachedCodeType::kCommonJS, filename, code, &compile_cache_key);
   }
 
   // Get the function id
@@ -1145,6 +1158,15 @@ void ContextifyContext::CompileFunction(
     return;
   }
 
+  if (compile_cache != nullptr &&
+      (source.GetCachedData() == nullptr ||
+       source.GetCachedData()->rejected)) {
+    compile_cache->Put(
+        std::move(compile_cache_key),
+        std::unique_ptr<ScriptCompiler::CachedData>(
+            ScriptCompiler::CreateCodeCacheForFunction(fn)));
+  }
+
   Local<Object> cache_key;
   if (!env->compiled_fn_entry_template()->NewInstance(
            context).ToLocal(&cache_key)) {
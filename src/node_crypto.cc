@@ -52,6 +52,7 @@ namespace crypto {
   V(Random)                                                                    \
   V(RSAAlg)                                                                    \
   V(SecureContext)                                                             \
+  V(SessionStoreHandle)                                                        \
   V(Sign)                                                                      \
   V(SPKAC)                                                                     \
   V(Timing)                                                                    \
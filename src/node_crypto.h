@@ -44,6 +44,7 @@
 #include "crypto/crypto_random.h"
 #include "crypto/crypto_rsa.h"
 #include "crypto/crypto_scrypt.h"
+#include "crypto/crypto_session_store.h"
 #include "crypto/crypto_sig.h"
 #include "crypto/crypto_spkac.h"
 #include "crypto/crypto_timing.h"
@@ -8,6 +8,7 @@
 #include "tracing/trace_event.h"
 
 #include "string_bytes.h"
+#include "threadpoolwork-inl.h"
 
 #include <fcntl.h>
 #include <sys/types.h>
@@ -17,6 +18,9 @@
 #include <climits>
 
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace node {
 
@@ -24,6 +28,7 @@ namespace fs_dir {
 
 using fs::FSReqAfterScope;
 using fs::FSReqBase;
+using fs::FSReqThreadPoolWork;
 using fs::FSReqWrapSync;
 using fs::GetReqWrap;
 
@@ -40,6 +45,7 @@ using v8::Null;
 using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
+using v8::Uint32;
 using v8::Value;
 
 #define TRACE_NAME(name) "fs_dir.sync." #name
@@ -95,6 +101,7 @@ void DirHandle::MemoryInfo(MemoryTracker* tracker) const {
 // will crash the process immediately.
 inline void DirHandle::GCClose() {
   if (closed_) return;
+  CloseWalk();
   uv_fs_t req;
   int ret = uv_fs_closedir(nullptr, &req, dir_, nullptr);
   uv_fs_req_cleanup(&req);
@@ -148,6 +155,7 @@ void DirHandle::Close(const FunctionCallbackInfo<Value>& args) {
 
   dir->closing_ = false;
   dir->closed_ = true;
+  dir->CloseWalk();
 
   FSReqBase* req_wrap_async = GetReqWrap(args, 0);
   if (req_wrap_async != nullptr) {  // close(req)
@@ -295,6 +303,338 @@ void DirHandle::Read(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+static int DirentTypeFromMode(uint64_t mode) {
+  switch (mode & S_IFMT) {
+    case S_IFREG:
+      return UV_DIRENT_FILE;
+    case S_IFDIR:
+      return UV_DIRENT_DIR;
+    case S_IFLNK:
+      return UV_DIRENT_LINK;
+    case S_IFCHR:
+      return UV_DIRENT_CHAR;
+#ifdef S_IFBLK
+    case S_IFBLK:
+      return UV_DIRENT_BLOCK;
+#endif
+#ifdef S_IFIFO
+    case S_IFIFO:
+      return UV_DIRENT_FIFO;
+#endif
+#ifdef S_IFSOCK
+    case S_IFSOCK:
+      return UV_DIRENT_SOCKET;
+#endif
+    default:
+      return UV_DIRENT_UNKNOWN;
+  }
+}
+
+void DirHandle::CloseWalk() {
+  if (walk_.current != nullptr && walk_.current != dir_) {
+    uv_fs_t req;
+    uv_fs_closedir(nullptr, &req, walk_.current, nullptr);
+    uv_fs_req_cleanup(&req);
+  }
+  walk_.current = nullptr;
+}
+
+// Reads the next batch of up to `size` entries for DirHandle::ReadStats(),
+// together with their lstat() information, so that JS does not need to stat
+// every entry on its own.
+class DirWalkBatch final {
+ public:
+  DirWalkBatch(DirHandle* dir, std::string&& root, size_t size, bool recursive)
+      : dir_(dir), root_(std::move(root)), size_(size), recursive_(recursive) {}
+
+  DirWalkBatch(const DirWalkBatch&) = delete;
+  DirWalkBatch& operator=(const DirWalkBatch&) = delete;
+
+  // No other operation may use the DirHandle meanwhile.
+  int Run();
+
+  // Returns null when the walk is complete, or
+  // [names, types, parents, directories, stats]. Entry i is called names[i]
+  // and has the UV_DIRENT_* type types[i]. It is located in
+  // directories[parents[i]], a path relative to the directory that was
+  // opened. Its fs.Stats fields start at
+  // stats[i * kFsStatsFieldsNumber].
+  MaybeLocal<Value> ToValue(Environment* env,
+                            enum encoding encoding,
+                            Local<Value>* error) const;
+
+  Local<Value> ToException(Environment* env) const {
+    return UVException(
+        env->isolate(), err_, syscall_, nullptr, error_path_.c_str());
+  }
+
+  // Fills in the context object of a synchronous call, like SyncCall() does.
+  void SetContext(Environment* env, Local<Value> ctx) const;
+
+ private:
+  struct Entry {
+    std::string name;
+    size_t parent;
+    uv_stat_t stat;
+  };
+
+  int Fail(int err, const char* syscall, std::string&& path) {
+    err_ = err;
+    syscall_ = syscall;
+    error_path_ = std::move(path);
+    return err;
+  }
+
+  std::string FullPath(const std::string& relative) const {
+    return relative.empty() ? root_ : root_ + kPathSeparator + relative;
+  }
+
+  DirHandle* dir_;
+  std::string root_;
+  size_t size_;
+  bool recursive_;
+
+  std::vector<Entry> entries_;
+  std::vector<std::string> directories_;
+
+  int err_ = 0;
+  const char* syscall_ = nullptr;
+  std::string error_path_;
+};
+
+int DirWalkBatch::Run() {
+  DirHandle::Walk* walk = &dir_->walk_;
+  if (dir_->dirents_.size() < size_)
+    dir_->dirents_.resize(size_);
+
+  while (entries_.size() < size_) {
+    if (walk->current == nullptr) {
+      if (!walk->started) {
+        walk->started = true;
+        walk->current = dir_->dir();
+      } else if (walk->pending.empty()) {
+        break;  // Done.
+      } else {
+        walk->prefix = std::move(walk->pending.front());
+        walk->pending.pop_front();
+        const std::string path = FullPath(walk->prefix);
+        uv_fs_t req;
+        const int err = uv_fs_opendir(nullptr, &req, path.c_str(), nullptr);
+        uv_dir_t* dir = static_cast<uv_dir_t*>(req.ptr);
+        uv_fs_req_cleanup(&req);
+        // Directories that were removed or replaced since they were listed
+        // are skipped, like the entries that disappear below.
+        if (err == UV_ENOENT || err == UV_ENOTDIR)
+          continue;
+        if (err < 0)
+          return Fail(err, "opendir", std::string(path));
+        walk->current = dir;
+      }
+      directories_.push_back(walk->prefix);
+    } else if (directories_.empty()) {
+      directories_.push_back(walk->prefix);
+    }
+
+    uv_dir_t* dir = walk->current;
+    dir->dirents = dir_->dirents_.data();
+    dir->nentries = size_ - entries_.size();
+    uv_fs_t req;
+    const int count = uv_fs_readdir(nullptr, &req, dir, nullptr);
+    if (count < 0) {
+      uv_fs_req_cleanup(&req);
+      return Fail(count, "scandir", FullPath(walk->prefix));
+    }
+    if (count == 0) {
+      uv_fs_req_cleanup(&req);
+      dir_->CloseWalk();
+      walk->prefix.clear();
+      continue;
+    }
+
+    for (int i = 0; i < count; i++) {
+      Entry entry;
+      entry.name = dir->dirents[i].name;
+      entry.parent = directories_.size() - 1;
+      std::string relative = walk->prefix.empty() ?
+          entry.name : walk->prefix + kPathSeparator + entry.name;
+      const std::string path = FullPath(relative);
+
+      uv_fs_t stat_req;
+      const int err = uv_fs_lstat(nullptr, &stat_req, path.c_str(), nullptr);
+      entry.stat = stat_req.statbuf;
+      uv_fs_req_cleanup(&stat_req);
+      if (err == UV_ENOENT)
+        continue;  // Removed since it was listed.
+      if (err < 0) {
+        uv_fs_req_cleanup(&req);
+        return Fail(err, "lstat", std::string(path));
+      }
+
+      if (recursive_ && (entry.stat.st_mode & S_IFMT) == S_IFDIR)
+        walk->pending.push_back(std::move(relative));
+      entries_.push_back(std::move(entry));
+    }
+    uv_fs_req_cleanup(&req);
+  }
+
+  return 0;
+}
+
+MaybeLocal<Value> DirWalkBatch::ToValue(Environment* env,
+                                        enum encoding encoding,
+                                        Local<Value>* error) const {
+  Isolate* isolate = env->isolate();
+  if (entries_.empty())
+    return Null(isolate);
+
+  const size_t count = entries_.size();
+  MaybeStackBuffer<Local<Value>, 64> names(count);
+  MaybeStackBuffer<Local<Value>, 64> types(count);
+  MaybeStackBuffer<Local<Value>, 64> parents(count);
+  constexpr size_t kFieldsPerEntry =
+      static_cast<size_t>(FsStatsOffset::kFsStatsFieldsNumber);
+  AliasedFloat64Array stats(isolate, count * kFieldsPerEntry);
+
+  for (size_t i = 0; i < count; i++) {
+    const Entry& entry = entries_[i];
+    if (!StringBytes::Encode(isolate,
+                             entry.name.data(),
+                             entry.name.size(),
+                             encoding,
+                             error).ToLocal(&names[i])) {
+      return MaybeLocal<Value>();
+    }
+    types[i] = Integer::New(isolate, DirentTypeFromMode(entry.stat.st_mode));
+    parents[i] =
+        Integer::NewFromUnsigned(isolate, static_cast<uint32_t>(entry.parent));
+    fs::FillStatsArray(&stats, &entry.stat, i * kFieldsPerEntry);
+  }
+
+  MaybeStackBuffer<Local<Value>, 8> directories(directories_.size());
+  for (size_t i = 0; i < directories_.size(); i++) {
+    if (!StringBytes::Encode(isolate,
+                             directories_[i].data(),
+                             directories_[i].size(),
+                             encoding,
+                             error).ToLocal(&directories[i])) {
+      return MaybeLocal<Value>();
+    }
+  }
+
+  Local<Value> result[] = {
+      Array::New(isolate, names.out(), count),
+      Array::New(isolate, types.out(), count),
+      Array::New(isolate, parents.out(), count),
+      Array::New(isolate, directories.out(), directories_.size()),
+      stats.GetJSArray(),
+  };
+  return Array::New(isolate, result, arraysize(result));
+}
+
+void DirWalkBatch::SetContext(Environment* env, Local<Value> ctx) const {
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  Local<Object> ctx_obj = ctx.As<Object>();
+  ctx_obj->Set(context, env->errno_string(), Integer::New(isolate, err_))
+      .Check();
+  ctx_obj->Set(context,
+               env->syscall_string(),
+               OneByteString(isolate, syscall_)).Check();
+  Local<Value> path;
+  if (ToV8Value(context, error_path_).ToLocal(&path))
+    ctx_obj->Set(context, env->path_string(), path).Check();
+}
+
+class DirWalkWork final : public FSReqThreadPoolWork {
+ public:
+  DirWalkWork(FSReqBase* req_wrap,
+              DirHandle* dir,
+              std::string&& root,
+              size_t size,
+              bool recursive)
+      : FSReqThreadPoolWork(req_wrap),
+        dir_(dir),
+        batch_(dir, std::move(root), size, recursive) {}
+
+  void DoThreadPoolWork() override { result_ = batch_.Run(); }
+
+ protected:
+  void Settle(FSReqBase* req_wrap) override {
+    Environment* env = req_wrap->env();
+    if (result_ < 0)
+      return req_wrap->Reject(batch_.ToException(env));
+
+    Local<Value> error;
+    Local<Value> value;
+    if (!batch_.ToValue(env, req_wrap->encoding(), &error).ToLocal(&value)) {
+      CHECK(!error.IsEmpty());
+      return req_wrap->Reject(error);
+    }
+    req_wrap->Resolve(value);
+  }
+
+ private:
+  // Keeps the directory open until the batch has been read.
+  BaseObjectPtr<DirHandle> dir_;
+  DirWalkBatch batch_;
+  int result_ = 0;
+};
+
+// Like Read(), but also returns the lstat() information of every entry and
+// can descend into subdirectories. See DirWalkBatch::ToValue() for the
+// format of the result.
+// 0 path       string or Buffer, the path the directory was opened with
+// 1 encoding   encoding of the names
+// 2 batchSize  maximum number of entries to return
+// 3 recursive  boolean, whether to list subdirectories as well
+void DirHandle::ReadStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 5);
+
+  DirHandle* dir;
+  ASSIGN_OR_RETURN_UNWRAP(&dir, args.Holder());
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+  const enum encoding encoding = ParseEncoding(isolate, args[1], UTF8);
+  CHECK(args[2]->IsUint32());
+  const size_t batch_size = args[2].As<Uint32>()->Value();
+  CHECK_GT(batch_size, 0);
+  const bool recursive = args[3]->IsTrue();
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 4);
+  if (req_wrap_async != nullptr) {
+    // dir.readStats(path, encoding, batchSize, recursive, req)
+    req_wrap_async->Init("scandir", nullptr, 0, encoding);
+    auto* work = new DirWalkWork(
+        req_wrap_async, dir, path.ToString(), batch_size, recursive);
+    work->ScheduleWork();
+    req_wrap_async->SetReturnValue(args);
+  } else {
+    // dir.readStats(path, encoding, batchSize, recursive, undefined, ctx)
+    CHECK_EQ(argc, 6);
+    env->PrintSyncTrace();
+    DirWalkBatch batch(dir, path.ToString(), batch_size, recursive);
+    FS_DIR_SYNC_TRACE_BEGIN(readdir);
+    const int err = batch.Run();
+    FS_DIR_SYNC_TRACE_END(readdir);
+    if (err < 0)
+      return batch.SetContext(env, args[5]);
+
+    Local<Value> error;
+    Local<Value> value;
+    if (!batch.ToValue(env, encoding, &error).ToLocal(&value)) {
+      Local<Object> ctx = args[5].As<Object>();
+      USE(ctx->Set(env->context(), env->error_string(), error));
+      return;
+    }
+    args.GetReturnValue().Set(value);
+  }
+}
+
 void AfterOpenDir(uv_fs_t* req) {
   FSReqBase* req_wrap = FSReqBase::from_req(req);
   FSReqAfterScope after(req_wrap, req);
@@ -359,6 +699,7 @@ void Initialize(Local<Object> target,
   Local<FunctionTemplate> dir = NewFunctionTemplate(isolate, DirHandle::New);
   dir->Inherit(AsyncWrap::GetConstructorTemplate(env));
   SetProtoMethod(isolate, dir, "read", DirHandle::Read);
+  SetProtoMethod(isolate, dir, "readStats", DirHandle::ReadStats);
   SetProtoMethod(isolate, dir, "close", DirHandle::Close);
   Local<ObjectTemplate> dirt = dir->InstanceTemplate();
   dirt->SetInternalFieldCount(DirHandle::kInternalFieldCount);
@@ -370,6 +711,7 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(OpenDir);
   registry->Register(DirHandle::New);
   registry->Register(DirHandle::Read);
+  registry->Register(DirHandle::ReadStats);
   registry->Register(DirHandle::Close);
 }
 
@@ -5,6 +5,10 @@
 
 #include "node_file.h"
 
+#include <deque>
+#include <string>
+#include <vector>
+
 namespace node {
 
 namespace fs_dir {
@@ -17,6 +21,7 @@ class DirHandle : public AsyncWrap {
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Read(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void ReadStats(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Close(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   inline uv_dir_t* dir() { return dir_; }
@@ -33,14 +38,30 @@ class DirHandle : public AsyncWrap {
  private:
   DirHandle(Environment* env, v8::Local<v8::Object> obj, uv_dir_t* dir);
 
+  friend class DirWalkBatch;
+
   // Synchronous close that emits a warning
   void GCClose();
+  // Closes the subdirectory that ReadStats() is currently reading, if any.
+  void CloseWalk();
 
   uv_dir_t* dir_;
   // Multiple entries are read through a single libuv call.
   std::vector<uv_dirent_t> dirents_;
   bool closing_ = false;
   bool closed_ = false;
+
+  // Position of ReadStats(), which lists the entries of the directory and,
+  // if asked to, of all subdirectories in breadth-first order.
+  struct Walk {
+    bool started = false;
+    // Either `dir_` or an open subdirectory.
+    uv_dir_t* current = nullptr;
+    // Path of `current` relative to the directory, empty for `dir_`.
+    std::string prefix;
+    // Relative paths of the subdirectories that are left to read.
+    std::deque<std::string> pending;
+  } walk_;
 };
 
 }  // namespace fs_dir
@@ -11,6 +11,51 @@
 namespace node {
 
 using CFunctionCallback = void (*)(v8::Local<v8::Value> receiver);
+using CFunctionCallbackWithOneByteString =
+    uint32_t (*)(v8::Local<v8::Value>, const v8::FastOneByteString&);
+using CFunctionCallbackWithTypedArray =
+    void (*)(v8::Local<v8::Value>, const v8::FastApiTypedArray<uint8_t>&);
+using CFunctionCallbackWithTwoTypedArrays =
+    int32_t (*)(v8::Local<v8::Value>,
+                const v8::FastApiTypedArray<uint8_t>&,
+                const v8::FastApiTypedArray<uint8_t>&);
+using CFunctionCallbackBufferCompareOffset =
+    int32_t (*)(v8::Local<v8::Value>,
+                const v8::FastApiTypedArray<uint8_t>&,
+                const v8::FastApiTypedArray<uint8_t>&,
+                uint32_t,
+                uint32_t,
+                uint32_t,
+                uint32_t,
+                v8::FastApiCallbackOptions&);
+using CFunctionCallbackBufferCopy =
+    uint32_t (*)(v8::Local<v8::Value>,
+                 const v8::FastApiTypedArray<uint8_t>&,
+                 const v8::FastApiTypedArray<uint8_t>&,
+                 uint32_t,
+                 uint32_t,
+                 uint32_t,
+                 v8::FastApiCallbackOptions&);
+using CFunctionCallbackBufferFill =
+    int32_t (*)(v8::Local<v8::Value>,
+                const v8::FastApiTypedArray<uint8_t>&,
+                const v8::FastApiTypedArray<uint8_t>&,
+                uint32_t,
+                uint32_t,
+                v8::Local<v8::Value>);
+using CFunctionCallbackBufferIndexOfBuffer =
+    int32_t (*)(v8::Local<v8::Value>,
+                const v8::FastApiTypedArray<uint8_t>&,
+                const v8::FastApiTypedArray<uint8_t>&,
+                double,
+                int32_t,
+                bool);
+using CFunctionCallbackBufferIndexOfNumber =
+    int32_t (*)(v8::Local<v8::Value>,
+                const v8::FastApiTypedArray<uint8_t>&,
+                uint32_t,
+                double,
+                bool);
 
 // This class manages the external references from the V8 heap
 // to the C++ addresses in Node.js.
@@ -20,6 +65,14 @@ class ExternalReferenceRegistry {
 
 #define ALLOWED_EXTERNAL_REFERENCE_TYPES(V)                                    \
   V(CFunctionCallback)                                                         \
+  V(CFunctionCallbackWithOneByteString)                                        \
+  V(CFunctionCallbackWithTypedArray)                                           \
+  V(CFunctionCallbackWithTwoTypedArrays)                                       \
+  V(CFunctionCallbackBufferCompareOffset)                                      \
+  V(CFunctionCallbackBufferCopy)                                               \
+  V(CFunctionCallbackBufferFill)                                               \
+  V(CFunctionCallbackBufferIndexOfBuffer)                                      \
+  V(CFunctionCallbackBufferIndexOfNumber)                                      \
   V(const v8::CFunctionInfo*)                                                  \
   V(v8::FunctionCallback)                                                      \
   V(v8::AccessorGetterCallback)                                                \
@@ -74,6 +127,7 @@ class ExternalReferenceRegistry {
   V(process_methods)                                                           \
   V(process_object)                                                            \
   V(report)                                                                    \
+  V(ring_channel)                                                              \
   V(task_queue)                                                                \
   V(tcp_wrap)                                                                  \
   V(tty_wrap)                                                                  \
@@ -4,6 +4,7 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "node_file.h"
+#include "node_file_uring.h"
 #include "req_wrap-inl.h"
 
 namespace node {
@@ -285,6 +286,28 @@ FSReqBase* AsyncCall(Environment* env,
                        after, fn, fn_args...);
 }
 
+// Like AsyncCall(), but runs the request on the io_uring of the environment
+// when one is enabled and able to take it. `uring_fn` is the IoUring method
+// that corresponds to the libuv function `fn`.
+template <typename UringFunc, typename Func, typename... Args>
+FSReqBase* AsyncUringCall(Environment* env,
+                          FSReqBase* req_wrap,
+                          const v8::FunctionCallbackInfo<v8::Value>& args,
+                          const char* syscall, enum encoding enc,
+                          uv_fs_cb after, UringFunc uring_fn,
+                          Func fn, Args... fn_args) {
+  CHECK_NOT_NULL(req_wrap);
+  IoUring* ring = IoUring::Get(req_wrap->binding_data());
+  if (ring != nullptr) {
+    req_wrap->Init(syscall, nullptr, 0, enc);
+    if ((ring->*uring_fn)(req_wrap->req(), fn_args..., after) == 0) {
+      req_wrap->SetReturnValue(args);
+      return req_wrap;
+    }
+  }
+  return AsyncCall(env, req_wrap, args, syscall, enc, after, fn, fn_args...);
+}
+
 // Template counterpart of SYNC_CALL, except that it only puts
 // the error number and the syscall in the context instead of
 // creating an error in the C++ land.
@@ -23,8 +23,11 @@
 #include "aliased_buffer.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
+#include "node_errors.h"
 #include "node_external_reference.h"
+#include "node_package_json.h"
 #include "node_process-inl.h"
+#include "node_resolution_cache.h"
 #include "node_stat_watcher.h"
 #include "util-inl.h"
 
@@ -33,6 +36,7 @@
 #include "req_wrap-inl.h"
 #include "stream_base-inl.h"
 #include "string_bytes.h"
+#include "threadpoolwork-inl.h"
 
 #include <fcntl.h>
 #include <sys/types.h>
@@ -45,7 +49,21 @@
 # include <io.h>
 #endif
 
+#ifndef _WIN32
+# include <dirent.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+#if defined(__linux__) && !defined(FICLONE)
+# define FICLONE _IOW(0x94, 9, int)
+#endif
+
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace node {
 
@@ -662,6 +680,23 @@ bool FSReqAfterScope::Proceed() {
   return true;
 }
 
+FSReqThreadPoolWork::FSReqThreadPoolWork(FSReqBase* req_wrap)
+    : ThreadPoolWork(req_wrap->env()), req_wrap_(req_wrap) {}
+
+void FSReqThreadPoolWork::AfterThreadPoolWork(int status) {
+  std::unique_ptr<FSReqThreadPoolWork> self(this);
+  BaseObjectPtr<FSReqBase> req_wrap = std::move(req_wrap_);
+  Environment* env = req_wrap->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  CHECK_EQ(status, 0);
+
+  req_wrap->Detach();
+  if (!env->can_call_into_js())
+    return;
+  Settle(req_wrap.get());
+}
+
 void AfterNoArgs(uv_fs_t* req) {
   FSReqBase* req_wrap = FSReqBase::from_req(req);
   FSReqAfterScope after(req_wrap, req);
@@ -861,8 +896,8 @@ void Close(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(args, 1);
   if (req_wrap_async != nullptr) {  // close(fd, req)
-    AsyncCall(env, req_wrap_async, args, "close", UTF8, AfterNoArgs,
-              uv_fs_close, fd);
+    AsyncUringCall(env, req_wrap_async, args, "close", UTF8, AfterNoArgs,
+                   &IoUring::Close, uv_fs_close, fd);
   } else {  // close(fd, undefined, ctx)
     CHECK_EQ(argc, 3);
     FSReqWrapSync req_wrap_sync;
@@ -930,45 +965,76 @@ static void InternalModuleReadJSON(const FunctionCallbackInfo<Value>& args) {
   }
 
   const size_t size = offset - start;
-  char* p = &chars[start];
-  char* pe = &chars[size];
-  char* pos[2];
-  char** ppos = &pos[0];
-
-  while (p < pe) {
-    char c = *p++;
-    if (c == '\\' && p < pe && *p == '"') p++;
-    if (c != '"') continue;
-    *ppos++ = p;
-    if (ppos < &pos[2]) continue;
-    ppos = &pos[0];
-
-    char* s = &pos[0][0];
-    char* se = &pos[1][-1];  // Exclude quote.
-    size_t n = se - s;
-
-    if (n == 4) {
-      if (0 == memcmp(s, "main", 4)) break;
-      if (0 == memcmp(s, "name", 4)) break;
-      if (0 == memcmp(s, "type", 4)) break;
-    } else if (n == 7) {
-      if (0 == memcmp(s, "exports", 7)) break;
-      if (0 == memcmp(s, "imports", 7)) break;
-    }
-  }
-
+  const bool contains_keys =
+      package_json::ContainsKeys(&chars[start], &chars[start] + size);
 
   Local<Value> return_value[] = {
     String::NewFromUtf8(isolate,
                         &chars[start],
                         v8::NewStringType::kNormal,
                         size).ToLocalChecked(),
-    Boolean::New(isolate, p < pe ? true : false)
+    Boolean::New(isolate, contains_keys)
   };
   args.GetReturnValue().Set(
     Array::New(isolate, return_value, arraysize(return_value)));
 }
 
+// Reads the fields of a package.json file that module resolution uses, see
+// package_json::Read(). Returns undefined if the file cannot be read. If it
+// cannot be parsed, returns [string, boolean] like InternalModuleReadJSON().
+// Otherwise returns [name, main, type, exports, imports, json_fields], where
+// missing fields are undefined and bit i of json_fields is set if field i is
+// JSON text that still needs to be parsed, instead of a string value.
+static void InternalModuleReadPackageJSON(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK(args[0]->IsString());
+  node::Utf8Value path(isolate, args[0]);
+  if (strlen(*path) != path.length())
+    return;  // Contains a nul byte.
+
+  std::shared_ptr<const package_json::PackageJson> package_json =
+      package_json::Read(path.ToString());
+  if (!package_json)
+    return;
+
+  auto to_string = [&](const std::string& text) {
+    return String::NewFromUtf8(isolate,
+                               text.data(),
+                               v8::NewStringType::kNormal,
+                               text.size());
+  };
+
+  if (!package_json->parsed) {
+    Local<Value> return_value[2];
+    if (!to_string(package_json->source).ToLocal(&return_value[0]))
+      return;
+    return_value[1] = Boolean::New(isolate, package_json->contains_keys);
+    args.GetReturnValue().Set(
+        Array::New(isolate, return_value, arraysize(return_value)));
+    return;
+  }
+
+  constexpr size_t kFieldCount = package_json::PackageJson::kFieldCount;
+  Local<Value> return_value[kFieldCount + 1];
+  uint32_t json_fields = 0;
+  for (size_t i = 0; i < kFieldCount; i++) {
+    const package_json::PackageJson::Value& field = package_json->fields[i];
+    if (!field.present) {
+      return_value[i] = Undefined(isolate);
+      continue;
+    }
+    if (!to_string(field.text).ToLocal(&return_value[i]))
+      return;
+    if (field.is_json) json_fields |= 1 << i;
+  }
+  return_value[kFieldCount] = Integer::NewFromUnsigned(isolate, json_fields);
+  args.GetReturnValue().Set(
+      Array::New(isolate, return_value, arraysize(return_value)));
+}
+
 // Used to speed up module loading.  Returns 0 if the path refers to
 // a file, 1 when it's a directory or < 0 on error (usually -ENOENT.)
 // The speedup comes from not creating thousands of Stat and Error objects.
@@ -989,6 +1055,67 @@ static void InternalModuleStat(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(rc);
 }
 
+// Returns the file that require() resolved `request` to, if it is known from
+// the cache enabled with --experimental-resolution-cache and the directories
+// and files it depended on are unchanged. Returns undefined otherwise.
+// 0 context  string identifying the parent module's lookup paths
+// 1 request  string
+static void InternalModuleGetCachedResolution(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ResolutionCache* cache = env->resolution_cache();
+  if (cache == nullptr) return;
+
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsString());
+  Utf8Value context(env->isolate(), args[0]);
+  Utf8Value request(env->isolate(), args[1]);
+
+  const std::string* filename =
+      cache->Get(context.ToString(), request.ToString());
+  if (filename == nullptr) return;
+  Local<Value> result;
+  if (ToV8Value(env->context(), *filename).ToLocal(&result))
+    args.GetReturnValue().Set(result);
+}
+
+// Stores the result of a resolution for InternalModuleGetCachedResolution().
+// 0 context       string
+// 1 request       string
+// 2 filename      string
+// 3 dependencies  array of the directories and files the result depends on
+static void InternalModuleCacheResolution(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ResolutionCache* cache = env->resolution_cache();
+  if (cache == nullptr) return;
+
+  Isolate* isolate = env->isolate();
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsString());
+  CHECK(args[2]->IsString());
+  CHECK(args[3]->IsArray());
+  Utf8Value context(isolate, args[0]);
+  Utf8Value request(isolate, args[1]);
+  Utf8Value filename(isolate, args[2]);
+
+  Local<Array> array = args[3].As<Array>();
+  std::vector<std::string> dependencies;
+  dependencies.reserve(array->Length());
+  for (uint32_t i = 0; i < array->Length(); i++) {
+    Local<Value> value;
+    if (!array->Get(env->context(), i).ToLocal(&value))
+      return;
+    CHECK(value->IsString());
+    dependencies.emplace_back(*Utf8Value(isolate, value));
+  }
+
+  cache->Put(context.ToString(),
+             request.ToString(),
+             filename.ToString(),
+             dependencies);
+}
+
 static void Stat(const FunctionCallbackInfo<Value>& args) {
   BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
   Environment* env = binding_data->env();
@@ -1002,8 +1129,8 @@ static void Stat(const FunctionCallbackInfo<Value>& args) {
   bool use_bigint = args[1]->IsTrue();
   FSReqBase* req_wrap_async = GetReqWrap(args, 2, use_bigint);
   if (req_wrap_async != nullptr) {  // stat(path, use_bigint, req)
-    AsyncCall(env, req_wrap_async, args, "stat", UTF8, AfterStat,
-              uv_fs_stat, *path);
+    AsyncUringCall(env, req_wrap_async, args, "stat", UTF8, AfterStat,
+                   &IoUring::Stat, uv_fs_stat, *path);
   } else {  // stat(path, use_bigint, undefined, ctx)
     CHECK_EQ(argc, 4);
     FSReqWrapSync req_wrap_sync;
@@ -1033,8 +1160,8 @@ static void LStat(const FunctionCallbackInfo<Value>& args) {
   bool use_bigint = args[1]->IsTrue();
   FSReqBase* req_wrap_async = GetReqWrap(args, 2, use_bigint);
   if (req_wrap_async != nullptr) {  // lstat(path, use_bigint, req)
-    AsyncCall(env, req_wrap_async, args, "lstat", UTF8, AfterStat,
-              uv_fs_lstat, *path);
+    AsyncUringCall(env, req_wrap_async, args, "lstat", UTF8, AfterStat,
+                   &IoUring::LStat, uv_fs_lstat, *path);
   } else {  // lstat(path, use_bigint, undefined, ctx)
     CHECK_EQ(argc, 4);
     FSReqWrapSync req_wrap_sync;
@@ -1065,8 +1192,8 @@ static void FStat(const FunctionCallbackInfo<Value>& args) {
   bool use_bigint = args[1]->IsTrue();
   FSReqBase* req_wrap_async = GetReqWrap(args, 2, use_bigint);
   if (req_wrap_async != nullptr) {  // fstat(fd, use_bigint, req)
-    AsyncCall(env, req_wrap_async, args, "fstat", UTF8, AfterStat,
-              uv_fs_fstat, fd);
+    AsyncUringCall(env, req_wrap_async, args, "fstat", UTF8, AfterStat,
+                   &IoUring::FStat, uv_fs_fstat, fd);
   } else {  // fstat(fd, use_bigint, undefined, ctx)
     CHECK_EQ(argc, 4);
     FSReqWrapSync req_wrap_sync;
@@ -1246,8 +1373,8 @@ static void Fdatasync(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(args, 1);
   if (req_wrap_async != nullptr) {
-    AsyncCall(env, req_wrap_async, args, "fdatasync", UTF8, AfterNoArgs,
-              uv_fs_fdatasync, fd);
+    AsyncUringCall(env, req_wrap_async, args, "fdatasync", UTF8, AfterNoArgs,
+                   &IoUring::Fdatasync, uv_fs_fdatasync, fd);
   } else {
     CHECK_EQ(argc, 3);
     FSReqWrapSync req_wrap_sync;
@@ -1268,8 +1395,8 @@ static void Fsync(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(args, 1);
   if (req_wrap_async != nullptr) {
-    AsyncCall(env, req_wrap_async, args, "fsync", UTF8, AfterNoArgs,
-              uv_fs_fsync, fd);
+    AsyncUringCall(env, req_wrap_async, args, "fsync", UTF8, AfterNoArgs,
+                   &IoUring::Fsync, uv_fs_fsync, fd);
   } else {
     CHECK_EQ(argc, 3);
     FSReqWrapSync req_wrap_sync;
@@ -1324,6 +1451,370 @@ static void RMDir(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+#ifndef _WIN32
+// An error hit by a recursive operation, with the path of the entry that
+// failed.
+struct TreeError {
+  int err = 0;
+  const char* syscall = nullptr;
+  std::string path;
+  std::string dest;
+
+  Local<Value> ToException(Isolate* isolate) const {
+    return UVException(isolate,
+                       err,
+                       syscall,
+                       nullptr,
+                       path.c_str(),
+                       dest.empty() ? nullptr : dest.c_str());
+  }
+};
+
+// The errors hit by a recursive operation, which goes on with the other
+// entries when one of them fails. Only the first kMaxErrors are kept.
+class TreeErrors {
+ public:
+  static constexpr size_t kMaxErrors = 100;
+
+  bool empty() const { return errors_.empty(); }
+  // The first error, or 0.
+  int err() const { return errors_.empty() ? 0 : errors_[0].err; }
+
+  void Add(int err,
+           const char* syscall,
+           const std::string& path,
+           const std::string& dest) {
+    if (errors_.size() < kMaxErrors)
+      errors_.push_back({-err, syscall, path, dest});
+  }
+
+  // A single error is reported as it is. Several are reported as an
+  // AggregateError with the message and code of the first one, like
+  // aggregateTwoErrors() in lib/internal/errors.js does.
+  Local<Value> ToException(Environment* env) const {
+    Isolate* isolate = env->isolate();
+    Local<Context> context = env->context();
+    CHECK(!errors_.empty());
+    Local<Value> first = errors_[0].ToException(isolate);
+    if (errors_.size() == 1) return first;
+
+    std::vector<Local<Value>> exceptions;
+    exceptions.reserve(errors_.size());
+    for (const TreeError& error : errors_)
+      exceptions.push_back(error.ToException(isolate));
+
+    Local<Value> ctor;
+    Local<Value> message;
+    Local<Value> code;
+    Local<Value> aggregate;
+    if (!env->primordials()
+             ->Get(context, FIXED_ONE_BYTE_STRING(isolate, "AggregateError"))
+             .ToLocal(&ctor) ||
+        !ctor->IsFunction() ||
+        !first.As<Object>()->Get(context, env->message_string())
+             .ToLocal(&message) ||
+        !first.As<Object>()->Get(context, env->code_string())
+             .ToLocal(&code)) {
+      return first;
+    }
+    Local<Value> argv[] = {
+        Array::New(isolate, exceptions.data(), exceptions.size()), message};
+    if (!ctor.As<Function>()
+             ->NewInstance(context, arraysize(argv), argv)
+             .ToLocal(&aggregate) ||
+        aggregate.As<Object>()
+            ->Set(context, env->code_string(), code)
+            .IsNothing()) {
+      return first;
+    }
+    return aggregate;
+  }
+
+  // Fills in the context object of a synchronous call, like SyncCall() does
+  // for a single error.
+  void SetContext(Environment* env, Local<Value> ctx) const {
+    Isolate* isolate = env->isolate();
+    Local<Context> context = env->context();
+    Local<Object> ctx_obj = ctx.As<Object>();
+    if (errors_.size() > 1) {
+      ctx_obj->Set(context, env->error_string(), ToException(env)).Check();
+      return;
+    }
+    const TreeError& error = errors_[0];
+    ctx_obj->Set(context, env->errno_string(), Integer::New(isolate, error.err))
+        .Check();
+    ctx_obj->Set(context,
+                 env->syscall_string(),
+                 OneByteString(isolate, error.syscall)).Check();
+    Local<Value> value;
+    if (ToV8Value(context, error.path).ToLocal(&value))
+      ctx_obj->Set(context, env->path_string(), value).Check();
+    if (!error.dest.empty() && ToV8Value(context, error.dest).ToLocal(&value))
+      ctx_obj->Set(context, env->dest_string(), value).Check();
+  }
+
+ private:
+  std::vector<TreeError> errors_;
+};
+
+// Directories are processed while they are open, so that their entries can
+// be addressed relative to their file descriptors. Below this depth, each
+// directory is read in full and closed before its entries are processed, and
+// they are addressed by path instead, so that deep trees do not run out of
+// file descriptors.
+static constexpr int kMaxOpenTreeDepth = 32;
+
+struct DirEntry {
+  std::string name;
+  unsigned char type;
+};
+
+static bool IsDotOrDotDot(const char* name) {
+  return name[0] == '.' &&
+         (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+// Reads the remaining entries of a directory, except for . and ..
+// Returns 0 or an errno value.
+static int ReadDirEntries(DIR* dir, std::vector<DirEntry>* entries) {
+  errno = 0;
+  while (dirent* entry = readdir(dir)) {
+    if (!IsDotOrDotDot(entry->d_name))
+      entries->push_back({entry->d_name, entry->d_type});
+    errno = 0;
+  }
+  return errno;
+}
+
+// Appends a name returned by readdir() to the path of its directory.
+static std::string JoinPath(const std::string& dir, const char* name) {
+  std::string path = dir;
+  if (path.empty() || path.back() != '/') path += '/';
+  path += name;
+  return path;
+}
+
+// Runs a recursive job such as RmTreeJob on the threadpool and settles the
+// FSReqBase with the result of its ToValue().
+template <typename Job>
+class TreeWork final : public FSReqThreadPoolWork {
+ public:
+  template <typename... Args>
+  TreeWork(FSReqBase* req_wrap, Args&&... args)
+      : FSReqThreadPoolWork(req_wrap), job_(std::forward<Args>(args)...) {}
+
+  void DoThreadPoolWork() override { job_.Run(); }
+
+ protected:
+  void Settle(FSReqBase* req_wrap) override {
+    Environment* env = req_wrap->env();
+    if (!job_.errors().empty())
+      return req_wrap->Reject(job_.errors().ToException(env));
+    req_wrap->Resolve(job_.ToValue(env));
+  }
+
+ private:
+  Job job_;
+};
+
+// Removes a file, or a directory and everything below it, without following
+// symbolic links. Entries are addressed relative to their parent directory's
+// file descriptor, so each of them costs a single unlinkat(2) call.
+class RmTreeJob final {
+ public:
+  explicit RmTreeJob(std::string&& path) : path_(std::move(path)) {}
+
+  RmTreeJob(const RmTreeJob&) = delete;
+  RmTreeJob& operator=(const RmTreeJob&) = delete;
+
+  // Entries that are already gone are not an error. Returns the first error.
+  int Run() {
+    Remove(AT_FDCWD, path_.c_str(), path_, DT_UNKNOWN, 0);
+    return errors_.err();
+  }
+
+  const TreeErrors& errors() const { return errors_; }
+  Local<Value> ToValue(Environment* env) const {
+    return Undefined(env->isolate());
+  }
+
+ private:
+  // Directories that are modified while they are being read may not list
+  // every entry, so they are read again if they are not empty at the end.
+  static constexpr int kMaxDirectoryPasses = 4;
+
+  bool Remove(int dirfd,
+              const char* name,
+              const std::string& path,
+              unsigned char type,
+              int depth);
+  bool RemoveDirectory(int dirfd,
+                       const char* name,
+                       const std::string& path,
+                       int unlink_errno,
+                       int depth);
+  bool Fail(int err, const char* syscall, const std::string& path) {
+    errors_.Add(err, syscall, path, std::string());
+    return false;
+  }
+
+  std::string path_;
+  TreeErrors errors_;
+};
+
+bool RmTreeJob::Remove(int dirfd,
+                       const char* name,
+                       const std::string& path,
+                       unsigned char type,
+                       int depth) {
+  int unlink_errno = 0;
+  if (type != DT_DIR) {
+    if (unlinkat(dirfd, name, 0) == 0 || errno == ENOENT)
+      return true;
+    // Linux reports EISDIR for directories, other systems EPERM.
+    if (errno != EISDIR && errno != EPERM)
+      return Fail(errno, "unlink", path);
+    unlink_errno = errno;
+  }
+  return RemoveDirectory(dirfd, name, path, unlink_errno, depth);
+}
+
+bool RmTreeJob::RemoveDirectory(int dirfd,
+                                const char* name,
+                                const std::string& path,
+                                int unlink_errno,
+                                int depth) {
+  constexpr int kFlags = O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC;
+  const int fd = openat(dirfd, name, kFlags);
+  if (fd == -1) {
+    const int open_errno = errno;
+    if (open_errno == ENOENT)
+      return true;
+    if (open_errno == ENOTDIR || open_errno == ELOOP) {
+      // Not a directory after all: unlink() failed for another reason, or
+      // the entry was replaced since readdir() returned it.
+      if (unlink_errno != 0)
+        return Fail(unlink_errno, "unlink", path);
+      return Remove(dirfd, name, path, DT_UNKNOWN, depth);
+    }
+    // Directories that cannot be read can still be removed if empty.
+    if (unlinkat(dirfd, name, AT_REMOVEDIR) == 0 || errno == ENOENT)
+      return true;
+    return Fail(open_errno, "scandir", path);
+  }
+
+  DIR* dir = fdopendir(fd);
+  if (dir == nullptr) {
+    const int err = errno;
+    close(fd);
+    return Fail(err, "scandir", path);
+  }
+
+  const bool by_path = depth >= kMaxOpenTreeDepth;
+  bool ok = true;
+  for (int pass = 1;; pass++) {
+    bool saw_entries = false;
+    int err = 0;
+    if (by_path) {
+      std::vector<DirEntry> entries;
+      err = ReadDirEntries(dir, &entries);
+      closedir(dir);
+      dir = nullptr;
+      saw_entries = !entries.empty();
+      for (const DirEntry& entry : entries) {
+        const std::string entry_path = JoinPath(path, entry.name.c_str());
+        if (!Remove(AT_FDCWD,
+                    entry_path.c_str(),
+                    entry_path,
+                    entry.type,
+                    depth + 1)) {
+          ok = false;
+        }
+      }
+    } else {
+      errno = 0;
+      while (dirent* entry = readdir(dir)) {
+        if (IsDotOrDotDot(entry->d_name)) continue;
+        saw_entries = true;
+        if (!Remove(::dirfd(dir),
+                    entry->d_name,
+                    JoinPath(path, entry->d_name),
+                    entry->d_type,
+                    depth + 1)) {
+          ok = false;
+        }
+        errno = 0;
+      }
+      err = errno;
+    }
+    if (err != 0) {
+      ok = Fail(err, "scandir", path);
+      break;
+    }
+    // The entries that could not be removed have been reported already, and
+    // keep the directory from being removed.
+    if (!ok)
+      break;
+
+    if (unlinkat(dirfd, name, AT_REMOVEDIR) == 0 || errno == ENOENT)
+      break;
+    if ((errno != ENOTEMPTY && errno != EEXIST) || !saw_entries ||
+        pass == kMaxDirectoryPasses) {
+      ok = Fail(errno, "rmdir", path);
+      break;
+    }
+    if (!by_path) {
+      rewinddir(dir);
+      continue;
+    }
+    const int fd = openat(dirfd, name, kFlags);
+    if (fd == -1) {
+      if (errno != ENOENT)
+        ok = Fail(errno, "scandir", path);
+      break;
+    }
+    dir = fdopendir(fd);
+    if (dir == nullptr) {
+      ok = Fail(errno, "scandir", path);
+      close(fd);
+      break;
+    }
+  }
+  if (dir != nullptr)
+    closedir(dir);
+  return ok;
+}
+
+// Removes a file or directory tree, like `rm -rf`. Used by fs.rm() and
+// friends on POSIX systems.
+// 0 path  string or Buffer
+static void RmTree(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 1);
+  if (req_wrap_async != nullptr) {  // rmTree(path, req)
+    req_wrap_async->Init("rm", nullptr, 0, UTF8);
+    auto* work = new TreeWork<RmTreeJob>(req_wrap_async, path.ToString());
+    work->ScheduleWork();
+    req_wrap_async->SetReturnValue(args);
+  } else {  // rmTree(path, undefined, ctx)
+    CHECK_EQ(argc, 3);
+    env->PrintSyncTrace();
+    RmTreeJob job(path.ToString());
+    FS_SYNC_TRACE_BEGIN(rm);
+    const int err = job.Run();
+    FS_SYNC_TRACE_END(rm);
+    if (err < 0) job.errors().SetContext(env, args[2]);
+  }
+}
+#endif  // _WIN32
+
 int MKDirpSync(uv_loop_t* loop,
                uv_fs_t* req,
                const std::string& path,
@@ -1707,8 +2198,8 @@ static void Open(const FunctionCallbackInfo<Value>& args) {
   FSReqBase* req_wrap_async = GetReqWrap(args, 3);
   if (req_wrap_async != nullptr) {  // open(path, flags, mode, req)
     req_wrap_async->set_is_plain_open(true);
-    AsyncCall(env, req_wrap_async, args, "open", UTF8, AfterInteger,
-              uv_fs_open, *path, flags, mode);
+    AsyncUringCall(env, req_wrap_async, args, "open", UTF8, AfterInteger,
+                   &IoUring::Open, uv_fs_open, *path, flags, mode);
   } else {  // open(path, flags, mode, undefined, ctx)
     CHECK_EQ(argc, 5);
     FSReqWrapSync req_wrap_sync;
@@ -1740,8 +2231,9 @@ static void OpenFileHandle(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(args, 3);
   if (req_wrap_async != nullptr) {  // openFileHandle(path, flags, mode, req)
-    AsyncCall(env, req_wrap_async, args, "open", UTF8, AfterOpenFileHandle,
-              uv_fs_open, *path, flags, mode);
+    AsyncUringCall(env, req_wrap_async, args, "open", UTF8,
+                   AfterOpenFileHandle, &IoUring::Open, uv_fs_open, *path,
+                   flags, mode);
   } else {  // openFileHandle(path, flags, mode, undefined, ctx)
     CHECK_EQ(argc, 5);
     FSReqWrapSync req_wrap_sync;
@@ -1789,6 +2281,477 @@ static void CopyFile(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+#ifndef _WIN32
+// Copies the contents of a directory into a directory that was just created
+// for them, which is what fs.cp() does for every directory that does not
+// exist at the destination yet. The checks that fs.cp() makes for existing
+// destinations are therefore not needed. Options have the same meaning as
+// for fs.cp().
+class CpTreeJob final {
+ public:
+  CpTreeJob(std::string&& src,
+            std::string&& dest,
+            bool dereference,
+            bool preserve_timestamps,
+            bool verbatim_symlinks)
+      : src_(std::move(src)),
+        dest_(std::move(dest)),
+        dereference_(dereference),
+        preserve_timestamps_(preserve_timestamps),
+        verbatim_symlinks_(verbatim_symlinks) {}
+
+  CpTreeJob(const CpTreeJob&) = delete;
+  CpTreeJob& operator=(const CpTreeJob&) = delete;
+
+  // Returns the first error. Stops at the first entry that cannot be copied,
+  // such as a socket, and unsupported_type() then tells its UV_DIRENT_* type.
+  int Run();
+
+  const TreeErrors& errors() const { return errors_; }
+  bool has_unsupported_entry() const { return has_unsupported_entry_; }
+  int unsupported_type() const { return unsupported_type_; }
+  const std::string& unsupported_path() const { return unsupported_path_; }
+
+  // Returns undefined, or [type, dest] for an entry that cannot be copied so
+  // that JS can create the same error as for the top-level path.
+  Local<Value> ToValue(Environment* env) const;
+
+ private:
+  static constexpr size_t kCopyBufferSize = 64 * 1024;
+
+  // Entries are addressed relative to the file descriptors of their source
+  // and destination directories, or by path (with AT_FDCWD) below
+  // kMaxOpenTreeDepth.
+  bool CopyDirectory(int src_fd,
+                     int dest_fd,
+                     const std::string& src,
+                     const std::string& dest,
+                     int depth);
+  bool CopyEntry(int src_dirfd,
+                 const char* src_name,
+                 int dest_dirfd,
+                 const char* dest_name,
+                 const std::string& src_dir,
+                 const std::string& src,
+                 const std::string& dest,
+                 int depth);
+  bool CopySubdirectory(int src_dirfd,
+                        const char* src_name,
+                        int dest_dirfd,
+                        const char* dest_name,
+                        const struct stat& st,
+                        const std::string& src,
+                        const std::string& dest,
+                        int depth);
+  bool CopyFile(int src_dirfd,
+                const char* src_name,
+                int dest_dirfd,
+                const char* dest_name,
+                const struct stat& st,
+                const std::string& src,
+                const std::string& dest);
+  int CopyData(int in, int out, const struct stat& st);
+  bool CopyLink(int src_dirfd,
+                const char* src_name,
+                int dest_dirfd,
+                const char* dest_name,
+                const struct stat& st,
+                const std::string& src_dir,
+                const std::string& src,
+                const std::string& dest);
+  bool Fail(int err,
+            const char* syscall,
+            const std::string& path,
+            const std::string& dest = std::string()) {
+    errors_.Add(err, syscall, path, dest);
+    return false;
+  }
+
+  std::string src_;
+  std::string dest_;
+  bool dereference_;
+  bool preserve_timestamps_;
+  bool verbatim_symlinks_;
+
+  std::unique_ptr<char[]> buffer_;
+  TreeErrors errors_;
+  bool has_unsupported_entry_ = false;
+  int unsupported_type_ = UV_DIRENT_UNKNOWN;
+  std::string unsupported_path_;
+};
+
+// Same as path.resolve(base, path) for a relative `path`.
+static std::string ResolvePath(const std::string& base,
+                               const std::string& path) {
+  std::string joined;
+  if (base.empty() || base[0] != '/') {
+    char cwd[PATH_MAX];
+    size_t size = sizeof(cwd);
+    if (uv_cwd(cwd, &size) == 0) joined.assign(cwd, size);
+    joined += '/';
+  }
+  joined += base + '/' + path;
+
+  std::vector<std::string> segments;
+  size_t start = 0;
+  while (start <= joined.size()) {
+    size_t end = joined.find('/', start);
+    if (end == std::string::npos) end = joined.size();
+    std::string segment = joined.substr(start, end - start);
+    if (segment == "..") {
+      if (!segments.empty()) segments.pop_back();
+    } else if (!segment.empty() && segment != ".") {
+      segments.push_back(std::move(segment));
+    }
+    start = end + 1;
+  }
+
+  std::string resolved;
+  for (const std::string& segment : segments) resolved += '/' + segment;
+  return resolved.empty() ? "/" : resolved;
+}
+
+int CpTreeJob::Run() {
+  const int src_fd = open(src_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (src_fd == -1) {
+    Fail(errno, "opendir", src_);
+    return errors_.err();
+  }
+  const int dest_fd = open(dest_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (dest_fd == -1) {
+    Fail(errno, "open", dest_);
+    close(src_fd);
+    return errors_.err();
+  }
+  CopyDirectory(src_fd, dest_fd, src_, dest_, 0);
+  return errors_.err();
+}
+
+// Takes ownership of both file descriptors.
+bool CpTreeJob::CopyDirectory(int src_fd,
+                              int dest_fd,
+                              const std::string& src,
+                              const std::string& dest,
+                              int depth) {
+  DIR* dir = fdopendir(src_fd);
+  if (dir == nullptr) {
+    const int err = errno;
+    close(src_fd);
+    close(dest_fd);
+    return Fail(err, "opendir", src);
+  }
+
+  bool ok = true;
+  int err = 0;
+  if (depth >= kMaxOpenTreeDepth) {
+    std::vector<DirEntry> entries;
+    err = ReadDirEntries(dir, &entries);
+    closedir(dir);
+    close(dest_fd);
+    for (const DirEntry& entry : entries) {
+      if (has_unsupported_entry_) break;
+      const std::string src_path = JoinPath(src, entry.name.c_str());
+      const std::string dest_path = JoinPath(dest, entry.name.c_str());
+      if (!CopyEntry(AT_FDCWD, src_path.c_str(), AT_FDCWD, dest_path.c_str(),
+                     src, src_path, dest_path, depth + 1)) {
+        ok = false;
+      }
+    }
+  } else {
+    errno = 0;
+    while (dirent* entry = readdir(dir)) {
+      const char* name = entry->d_name;
+      if (IsDotOrDotDot(name)) continue;
+      if (!CopyEntry(::dirfd(dir), name, dest_fd, name,
+                     src, JoinPath(src, name), JoinPath(dest, name),
+                     depth + 1)) {
+        ok = false;
+      }
+      if (has_unsupported_entry_) break;
+      errno = 0;
+    }
+    err = has_unsupported_entry_ ? 0 : errno;
+    closedir(dir);
+    close(dest_fd);
+  }
+  if (err != 0) ok = Fail(err, "scandir", src);
+  return ok && !has_unsupported_entry_;
+}
+
+bool CpTreeJob::CopyEntry(int src_dirfd,
+                          const char* src_name,
+                          int dest_dirfd,
+                          const char* dest_name,
+                          const std::string& src_dir,
+                          const std::string& src,
+                          const std::string& dest,
+                          int depth) {
+  struct stat st;
+  if (fstatat(src_dirfd, src_name, &st,
+              dereference_ ? 0 : AT_SYMLINK_NOFOLLOW) == -1) {
+    return Fail(errno, dereference_ ? "stat" : "lstat", src);
+  }
+  if (S_ISDIR(st.st_mode)) {
+    return CopySubdirectory(
+        src_dirfd, src_name, dest_dirfd, dest_name, st, src, dest, depth);
+  }
+  if (S_ISREG(st.st_mode) || S_ISCHR(st.st_mode) || S_ISBLK(st.st_mode))
+    return CopyFile(src_dirfd, src_name, dest_dirfd, dest_name, st, src, dest);
+  if (S_ISLNK(st.st_mode)) {
+    return CopyLink(
+        src_dirfd, src_name, dest_dirfd, dest_name, st, src_dir, src, dest);
+  }
+  has_unsupported_entry_ = true;
+  unsupported_type_ = S_ISSOCK(st.st_mode) ? UV_DIRENT_SOCKET :
+                      S_ISFIFO(st.st_mode) ? UV_DIRENT_FIFO :
+                      UV_DIRENT_UNKNOWN;
+  unsupported_path_ = dest;
+  return false;
+}
+
+bool CpTreeJob::CopySubdirectory(int src_dirfd,
+                                 const char* src_name,
+                                 int dest_dirfd,
+                                 const char* dest_name,
+                                 const struct stat& st,
+                                 const std::string& src,
+                                 const std::string& dest,
+                                 int depth) {
+  if (mkdirat(dest_dirfd, dest_name, 0777) == -1)
+    return Fail(errno, "mkdir", dest);
+
+  const int src_fd = openat(src_dirfd,
+                            src_name,
+                            O_RDONLY | O_DIRECTORY | O_CLOEXEC |
+                                (dereference_ ? 0 : O_NOFOLLOW));
+  if (src_fd == -1)
+    return Fail(errno, "opendir", src);
+  const int dest_fd = openat(dest_dirfd,
+                             dest_name,
+                             O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+  if (dest_fd == -1) {
+    const int err = errno;
+    close(src_fd);
+    return Fail(err, "open", dest);
+  }
+
+  if (!CopyDirectory(src_fd, dest_fd, src, dest, depth))
+    return false;
+  // Like fs.cp(), only apply the mode once the contents have been copied, in
+  // case it does not allow writing.
+  if (fchmodat(dest_dirfd, dest_name, st.st_mode & 07777, 0) == -1)
+    return Fail(errno, "chmod", dest);
+  return true;
+}
+
+bool CpTreeJob::CopyFile(int src_dirfd,
+                         const char* src_name,
+                         int dest_dirfd,
+                         const char* dest_name,
+                         const struct stat& st,
+                         const std::string& src,
+                         const std::string& dest) {
+  const int in = openat(src_dirfd, src_name, O_RDONLY | O_CLOEXEC);
+  if (in == -1)
+    return Fail(errno, "copyfile", src, dest);
+  const int out = openat(dest_dirfd,
+                         dest_name,
+                         O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                         st.st_mode & 0777);
+  if (out == -1) {
+    const int err = errno;
+    close(in);
+    return Fail(err, "copyfile", src, dest);
+  }
+
+  bool ok = true;
+  const int err = CopyData(in, out, st);
+  if (err != 0) {
+    ok = Fail(err, "copyfile", src, dest);
+  } else if (preserve_timestamps_) {
+    // The access time may have been changed by reading the file.
+    struct stat updated;
+    if (fstat(in, &updated) == -1) {
+      ok = Fail(errno, "stat", src);
+    } else {
+#ifdef __APPLE__
+      const struct timespec times[2] = {updated.st_atimespec,
+                                        updated.st_mtimespec};
+#else
+      const struct timespec times[2] = {updated.st_atim, updated.st_mtim};
+#endif
+      if (futimens(out, times) == -1)
+        ok = Fail(errno, "utime", dest);
+    }
+  }
+  if (ok && fchmod(out, st.st_mode & 07777) == -1)
+    ok = Fail(errno, "chmod", dest);
+
+  close(in);
+  if (close(out) == -1 && ok && errno != EINTR && errno != EINPROGRESS)
+    ok = Fail(errno, "copyfile", src, dest);
+  return ok;
+}
+
+// Returns 0 or an errno value.
+int CpTreeJob::CopyData(int in, int out, const struct stat& st) {
+#ifdef __linux__
+  if (S_ISREG(st.st_mode)) {
+    // Share the data blocks if the file system supports it (Btrfs, XFS, ...).
+    if (ioctl(out, FICLONE, in) == 0)
+      return 0;
+
+#ifdef __NR_copy_file_range
+    // Let the kernel copy the data without a round trip through user space.
+    // If nothing at all is copied, the file is read normally instead: files
+    // in /proc and sysfs claim to be empty or, on older kernels, make
+    // copy_file_range() return 0 even though they have data.
+    bool copied = false;
+    for (;;) {
+      const ssize_t n = syscall(
+          __NR_copy_file_range, in, nullptr, out, nullptr, 1 << 30, 0);
+      if (n > 0) {
+        copied = true;
+        continue;
+      }
+      if (n == 0)
+        break;
+      if (errno == EINTR)
+        continue;
+      if (!copied &&
+          (errno == ENOSYS || errno == EXDEV || errno == EINVAL ||
+           errno == EOPNOTSUPP || errno == EPERM || errno == EBADF)) {
+        break;  // Not supported for these files, use read() and write().
+      }
+      return errno;
+    }
+    if (copied)
+      return 0;
+#endif  // __NR_copy_file_range
+  }
+#endif  // __linux__
+
+  // Like uv_fs_copyfile(), which fs.cp() uses otherwise, only copy as much
+  // of a device as fstat() reports, so that endless ones such as /dev/zero
+  // are not read forever.
+  uint64_t remaining =
+      S_ISREG(st.st_mode) ? UINT64_MAX : static_cast<uint64_t>(st.st_size);
+  if (!buffer_) buffer_.reset(new char[kCopyBufferSize]);
+  while (remaining > 0) {
+    ssize_t n = read(in,
+                     buffer_.get(),
+                     std::min<uint64_t>(kCopyBufferSize, remaining));
+    if (n == 0)
+      return 0;
+    if (n == -1) {
+      if (errno == EINTR) continue;
+      return errno;
+    }
+    remaining -= n;
+    for (ssize_t written = 0; written < n;) {
+      const ssize_t w = write(out, buffer_.get() + written, n - written);
+      if (w == -1) {
+        if (errno == EINTR) continue;
+        return errno;
+      }
+      written += w;
+    }
+  }
+  return 0;
+}
+
+bool CpTreeJob::CopyLink(int src_dirfd,
+                         const char* src_name,
+                         int dest_dirfd,
+                         const char* dest_name,
+                         const struct stat& st,
+                         const std::string& src_dir,
+                         const std::string& src,
+                         const std::string& dest) {
+  std::string target(st.st_size > 0 ? st.st_size : PATH_MAX, '\0');
+  for (;;) {
+    const ssize_t n =
+        readlinkat(src_dirfd, src_name, &target[0], target.size());
+    if (n == -1)
+      return Fail(errno, "readlink", src);
+    // A return value that fills the buffer may have been truncated.
+    if (static_cast<size_t>(n) < target.size()) {
+      target.resize(n);
+      break;
+    }
+    target.resize(target.size() * 2);
+  }
+
+  if (!verbatim_symlinks_ && (target.empty() || target[0] != '/'))
+    target = ResolvePath(src_dir, target);
+
+  if (symlinkat(target.c_str(), dest_dirfd, dest_name) == -1)
+    return Fail(errno, "symlink", target, dest);
+  return true;
+}
+
+Local<Value> CpTreeJob::ToValue(Environment* env) const {
+  Isolate* isolate = env->isolate();
+  if (!has_unsupported_entry_)
+    return Undefined(isolate);
+  Local<Value> path;
+  if (!ToV8Value(env->context(), unsupported_path_).ToLocal(&path))
+    return Undefined(isolate);
+  Local<Value> result[] = {Integer::New(isolate, unsupported_type_), path};
+  return Array::New(isolate, result, arraysize(result));
+}
+
+// Copies the contents of a directory into a newly created one. Used by
+// fs.cp() and friends on POSIX systems when no filter is given.
+// 0 src                 string or Buffer, an existing directory
+// 1 dest                string or Buffer, an empty directory
+// 2 dereference         boolean
+// 3 preserveTimestamps  boolean
+// 4 verbatimSymlinks    boolean
+static void CpTree(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 6);
+
+  BufferValue src(isolate, args[0]);
+  CHECK_NOT_NULL(*src);
+  BufferValue dest(isolate, args[1]);
+  CHECK_NOT_NULL(*dest);
+  const bool dereference = args[2]->IsTrue();
+  const bool preserve_timestamps = args[3]->IsTrue();
+  const bool verbatim_symlinks = args[4]->IsTrue();
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 5);
+  if (req_wrap_async != nullptr) {  // cpTree(src, dest, ..., req)
+    req_wrap_async->Init("cp", nullptr, 0, UTF8);
+    auto* work = new TreeWork<CpTreeJob>(req_wrap_async,
+                                         src.ToString(),
+                                         dest.ToString(),
+                                         dereference,
+                                         preserve_timestamps,
+                                         verbatim_symlinks);
+    work->ScheduleWork();
+    req_wrap_async->SetReturnValue(args);
+  } else {  // cpTree(src, dest, ..., undefined, ctx)
+    CHECK_EQ(argc, 7);
+    env->PrintSyncTrace();
+    CpTreeJob job(src.ToString(),
+                  dest.ToString(),
+                  dereference,
+                  preserve_timestamps,
+                  verbatim_symlinks);
+    FS_SYNC_TRACE_BEGIN(cp);
+    const int err = job.Run();
+    FS_SYNC_TRACE_END(cp);
+    if (err < 0)
+      return job.errors().SetContext(env, args[6]);
+    args.GetReturnValue().Set(job.ToValue(env));
+  }
+}
+#endif  // _WIN32
+
 
 // Wrapper for write(2).
 //
@@ -1832,8 +2795,8 @@ static void WriteBuffer(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(args, 5);
   if (req_wrap_async != nullptr) {  // write(fd, buffer, off, len, pos, req)
-    AsyncCall(env, req_wrap_async, args, "write", UTF8, AfterInteger,
-              uv_fs_write, fd, &uvbuf, 1, pos);
+    AsyncUringCall(env, req_wrap_async, args, "write", UTF8, AfterInteger,
+                   &IoUring::Write, uv_fs_write, fd, &uvbuf, 1, pos);
   } else {  // write(fd, buffer, off, len, pos, undefined, ctx)
     CHECK_EQ(argc, 7);
     FSReqWrapSync req_wrap_sync;
@@ -1877,8 +2840,9 @@ static void WriteBuffers(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(args, 3);
   if (req_wrap_async != nullptr) {  // writeBuffers(fd, chunks, pos, req)
-    AsyncCall(env, req_wrap_async, args, "write", UTF8, AfterInteger,
-              uv_fs_write, fd, *iovs, iovs.length(), pos);
+    AsyncUringCall(env, req_wrap_async, args, "write", UTF8, AfterInteger,
+                   &IoUring::Write, uv_fs_write, fd, *iovs, iovs.length(),
+                   pos);
   } else {  // writeBuffers(fd, chunks, pos, undefined, ctx)
     CHECK_EQ(argc, 5);
     FSReqWrapSync req_wrap_sync;
@@ -2035,8 +2999,8 @@ static void Read(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(args, 5);
   if (req_wrap_async != nullptr) {  // read(fd, buffer, offset, len, pos, req)
-    AsyncCall(env, req_wrap_async, args, "read", UTF8, AfterInteger,
-              uv_fs_read, fd, &uvbuf, 1, pos);
+    AsyncUringCall(env, req_wrap_async, args, "read", UTF8, AfterInteger,
+                   &IoUring::Read, uv_fs_read, fd, &uvbuf, 1, pos);
   } else {  // read(fd, buffer, offset, len, pos, undefined, ctx)
     CHECK_EQ(argc, 7);
     FSReqWrapSync req_wrap_sync;
@@ -2081,8 +3045,9 @@ static void ReadBuffers(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(args, 3);
   if (req_wrap_async != nullptr) {  // readBuffers(fd, buffers, pos, req)
-    AsyncCall(env, req_wrap_async, args, "read", UTF8, AfterInteger,
-              uv_fs_read, fd, *iovs, iovs.length(), pos);
+    AsyncUringCall(env, req_wrap_async, args, "read", UTF8, AfterInteger,
+                   &IoUring::Read, uv_fs_read, fd, *iovs, iovs.length(),
+                   pos);
   } else {  // readBuffers(fd, buffers, undefined, ctx)
     CHECK_EQ(argc, 5);
     FSReqWrapSync req_wrap_sync;
@@ -2095,6 +3060,345 @@ static void ReadBuffers(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Reads a whole file without returning to JS in between: open, fstat, a
+// single read into an allocation of the reported size (or chunked reads
+// until EOF when the size is unknown, e.g. for pipes and most of /proc),
+// and close.
+class ReadFileJob final {
+ public:
+  // Same limits as kIoMaxLength and kReadFileUnknownBufferLength in
+  // lib/internal/fs/utils.js.
+  static constexpr uint64_t kIoMaxLength = (1ull << 31) - 1;
+  static constexpr size_t kUnknownSizeChunk = 64 * 1024;
+
+  ReadFileJob(uv_loop_t* loop, std::string&& path, int flags)
+      : loop_(loop), path_(std::move(path)), flags_(flags) {}
+  ~ReadFileJob() { free(data_); }
+
+  ReadFileJob(const ReadFileJob&) = delete;
+  ReadFileJob& operator=(const ReadFileJob&) = delete;
+
+  // Also stored in result(), along with the failed syscall().
+  int Run();
+
+  int result() const { return result_; }
+  bool too_large() const {
+    return result_ == UV_EFBIG && file_size() > kIoMaxLength;
+  }
+  const char* syscall() const { return syscall_; }
+  const std::string& path() const { return path_; }
+
+  // Creates the error for a failed Run().
+  Local<Value> ToException(Environment* env) const;
+
+  // Hands off the contents as a Buffer, or decodes them into a string.
+  MaybeLocal<Value> ToValue(Environment* env,
+                            enum encoding encoding,
+                            Local<Value>* error);
+
+ private:
+  int Read(uv_file fd);
+  // What fstat() reported, or what has been read if the size is unknown.
+  uint64_t file_size() const { return std::max<uint64_t>(size_, length_); }
+
+  uv_loop_t* loop_;
+  std::string path_;
+  int flags_;
+
+  int result_ = 0;
+  const char* syscall_ = nullptr;
+  uint64_t size_ = 0;
+  char* data_ = nullptr;
+  size_t length_ = 0;
+};
+
+int ReadFileJob::Run() {
+  uv_fs_t req;
+  const int fd = uv_fs_open(loop_, &req, path_.c_str(), flags_, 0666, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0) {
+    syscall_ = "open";
+    return result_ = fd;
+  }
+
+  int err = uv_fs_fstat(loop_, &req, fd, nullptr);
+  if (err == 0) {
+    const uv_stat_t* const s = static_cast<const uv_stat_t*>(req.ptr);
+    size_ = (s->st_mode & S_IFMT) == S_IFREG ? s->st_size : 0;
+  } else {
+    syscall_ = "fstat";
+  }
+  uv_fs_req_cleanup(&req);
+
+  if (err == 0) {
+    if (size_ > kIoMaxLength) {
+      err = UV_EFBIG;
+    } else {
+      err = Read(fd);
+      if (err < 0) syscall_ = "read";
+    }
+  }
+
+  const int close_err = uv_fs_close(loop_, &req, fd, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (err == 0 && close_err < 0) {
+    err = close_err;
+    syscall_ = "close";
+  }
+  return result_ = err;
+}
+
+int ReadFileJob::Read(uv_file fd) {
+  size_t capacity = 0;
+  for (;;) {
+    if (length_ == capacity) {
+      // Files are not read past the size fstat() reported, like the
+      // chunked implementation in JS.
+      if (size_ > 0 && length_ == size_)
+        break;
+      // Files of unknown size are read one byte past kIoMaxLength at most,
+      // to tell whether they are too large.
+      capacity = size_ > 0 ? static_cast<size_t>(size_)
+                           : std::min<size_t>(
+                                 std::max(capacity * 2, kUnknownSizeChunk),
+                                 kIoMaxLength + 1);
+      char* data = static_cast<char*>(realloc(data_, capacity));
+      if (data == nullptr)
+        return UV_ENOMEM;
+      data_ = data;
+    }
+
+    uv_buf_t buf = uv_buf_init(data_ + length_,
+                               static_cast<unsigned int>(capacity - length_));
+    uv_fs_t req;
+    const int bytes_read = uv_fs_read(loop_, &req, fd, &buf, 1, -1, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (bytes_read < 0)
+      return bytes_read;
+    if (bytes_read == 0)
+      break;
+    length_ += bytes_read;
+    if (length_ > kIoMaxLength)
+      return UV_EFBIG;
+  }
+
+  // Give back what was over-allocated for files of unknown size.
+  if (length_ < capacity && length_ > 0) {
+    char* data = static_cast<char*>(realloc(data_, length_));
+    if (data != nullptr) data_ = data;
+  }
+  return 0;
+}
+
+Local<Value> ReadFileJob::ToException(Environment* env) const {
+  CHECK_LT(result_, 0);
+  if (too_large()) {
+    return ERR_FS_FILE_TOO_LARGE(env->isolate(),
+                                 "File size (%d) is greater than 2 GiB",
+                                 file_size());
+  }
+  return UVException(
+      env->isolate(), result_, syscall_, nullptr, path_.c_str(), nullptr);
+}
+
+MaybeLocal<Value> ReadFileJob::ToValue(Environment* env,
+                                       enum encoding encoding,
+                                       Local<Value>* error) {
+  CHECK_EQ(result_, 0);
+  if (length_ > Buffer::kMaxLength) {
+    *error = ERR_BUFFER_TOO_LARGE(env->isolate());
+    return MaybeLocal<Value>();
+  }
+
+  if (encoding == BUFFER) {
+    char* data = data_;
+    data_ = nullptr;
+    Local<Object> buffer;
+    if (!Buffer::New(env, data, length_).ToLocal(&buffer)) {
+      *error = ERR_MEMORY_ALLOCATION_FAILED(env->isolate());
+      return MaybeLocal<Value>();
+    }
+    return buffer;
+  }
+
+  return StringBytes::Encode(env->isolate(), data_, length_, encoding, error);
+}
+
+class ReadFileWork final : public FSReqThreadPoolWork {
+ public:
+  ReadFileWork(FSReqBase* req_wrap, std::string&& path, int flags)
+      : FSReqThreadPoolWork(req_wrap),
+        job_(req_wrap->env()->event_loop(), std::move(path), flags) {}
+
+  void DoThreadPoolWork() override { job_.Run(); }
+
+ protected:
+  void Settle(FSReqBase* req_wrap) override {
+    Environment* env = req_wrap->env();
+    if (job_.result() < 0)
+      return req_wrap->Reject(job_.ToException(env));
+
+    Local<Value> error;
+    Local<Value> value;
+    if (!job_.ToValue(env, req_wrap->encoding(), &error).ToLocal(&value)) {
+      CHECK(!error.IsEmpty());
+      return req_wrap->Reject(error);
+    }
+    req_wrap->Resolve(value);
+  }
+
+ private:
+  ReadFileJob job_;
+};
+
+// Reads a whole file and returns its contents as a Buffer, or as a string if
+// an encoding is given. Used by fs.readFile() and friends when they are
+// passed a path.
+// 0 path      string or Buffer
+// 1 flags     open(2) flags
+// 2 encoding  if undefined, return a Buffer
+static void ReadFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 4);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+
+  CHECK(args[1]->IsInt32());
+  const int flags = args[1].As<Int32>()->Value();
+
+  const enum encoding encoding = ParseEncoding(isolate, args[2], BUFFER);
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 3);
+  if (req_wrap_async != nullptr) {  // readFile(path, flags, encoding, req)
+    req_wrap_async->Init("open", nullptr, 0, encoding);
+    auto* work = new ReadFileWork(req_wrap_async, path.ToString(), flags);
+    work->ScheduleWork();
+    req_wrap_async->SetReturnValue(args);
+  } else {  // readFile(path, flags, encoding, undefined, ctx)
+    CHECK_EQ(argc, 5);
+    env->PrintSyncTrace();
+    ReadFileJob job(env->event_loop(), path.ToString(), flags);
+    FS_SYNC_TRACE_BEGIN(readFile);
+    const int err = job.Run();
+    FS_SYNC_TRACE_END(readFile);
+    if (job.too_large()) {
+      isolate->ThrowException(job.ToException(env));
+      return;
+    }
+    if (err < 0) {
+      Local<Object> ctx = args[4].As<Object>();
+      Local<Context> context = env->context();
+      ctx->Set(context, env->errno_string(), Integer::New(isolate, err))
+          .Check();
+      ctx->Set(context,
+               env->syscall_string(),
+               OneByteString(isolate, job.syscall())).Check();
+      return;
+    }
+
+    Local<Value> error;
+    Local<Value> value;
+    if (!job.ToValue(env, encoding, &error).ToLocal(&value)) {
+      CHECK(!error.IsEmpty());
+      isolate->ThrowException(error);
+      return;
+    }
+    args.GetReturnValue().Set(value);
+  }
+}
+
+// Reads a list of files one after another in a single threadpool job, so
+// that callers which need many small files at once, like the ES module
+// loader, do not pay for a round trip through the event loop per file.
+// Callers split long lists over several requests to read them in parallel.
+class ReadFilesWork final : public FSReqThreadPoolWork {
+ public:
+  ReadFilesWork(FSReqBase* req_wrap, std::vector<std::string>&& paths,
+                int flags)
+      : FSReqThreadPoolWork(req_wrap) {
+    jobs_.reserve(paths.size());
+    for (std::string& path : paths) {
+      jobs_.emplace_back(std::make_unique<ReadFileJob>(
+          req_wrap->env()->event_loop(), std::move(path), flags));
+    }
+  }
+
+  void DoThreadPoolWork() override {
+    for (const auto& job : jobs_)
+      job->Run();
+  }
+
+ protected:
+  void Settle(FSReqBase* req_wrap) override {
+    Environment* env = req_wrap->env();
+    // A file that cannot be read does not fail the whole request, its entry
+    // in the result is the error instead.
+    std::vector<Local<Value>> results(jobs_.size());
+    for (size_t i = 0; i < jobs_.size(); i++) {
+      ReadFileJob* job = jobs_[i].get();
+      if (job->result() < 0) {
+        results[i] = job->ToException(env);
+        continue;
+      }
+      Local<Value> error;
+      if (!job->ToValue(env, req_wrap->encoding(), &error)
+               .ToLocal(&results[i])) {
+        CHECK(!error.IsEmpty());
+        results[i] = error;
+      }
+    }
+    req_wrap->Resolve(Array::New(env->isolate(), results.data(),
+                                 results.size()));
+  }
+
+ private:
+  std::vector<std::unique_ptr<ReadFileJob>> jobs_;
+};
+
+// Reads whole files like readFile(), and resolves with an array that holds
+// either the contents or the error for each of them.
+// 0 paths     array of strings
+// 1 flags     open(2) flags
+// 2 encoding  if undefined, return Buffers
+// 3 req
+static void ReadFiles(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+
+  CHECK_EQ(args.Length(), 4);
+
+  CHECK(args[0]->IsArray());
+  Local<Array> array = args[0].As<Array>();
+  std::vector<std::string> paths;
+  paths.reserve(array->Length());
+  for (uint32_t i = 0; i < array->Length(); i++) {
+    Local<Value> value;
+    if (!array->Get(context, i).ToLocal(&value))
+      return;
+    BufferValue path(isolate, value);
+    CHECK_NOT_NULL(*path);
+    paths.emplace_back(path.ToString());
+  }
+
+  CHECK(args[1]->IsInt32());
+  const int flags = args[1].As<Int32>()->Value();
+
+  const enum encoding encoding = ParseEncoding(isolate, args[2], BUFFER);
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 3);
+  CHECK_NOT_NULL(req_wrap_async);
+  req_wrap_async->Init("open", nullptr, 0, encoding);
+  auto* work = new ReadFilesWork(req_wrap_async, std::move(paths), flags);
+  work->ScheduleWork();
+  req_wrap_async->SetReturnValue(args);
+}
+
+
 /* fs.chmod(path, mode);
  * Wrapper for chmod(1) / EIO_CHMOD
  */
@@ -2439,6 +3743,8 @@ void Initialize(Local<Object> target,
   SetMethod(context, target, "openFileHandle", OpenFileHandle);
   SetMethod(context, target, "read", Read);
   SetMethod(context, target, "readBuffers", ReadBuffers);
+  SetMethod(context, target, "readFile", ReadFile);
+  SetMethod(context, target, "readFiles", ReadFiles);
   SetMethod(context, target, "fdatasync", Fdatasync);
   SetMethod(context, target, "fsync", Fsync);
   SetMethod(context, target, "rename", Rename);
@@ -2447,7 +3753,19 @@ void Initialize(Local<Object> target,
   SetMethod(context, target, "mkdir", MKDir);
   SetMethod(context, target, "readdir", ReadDir);
   SetMethod(context, target, "internalModuleReadJSON", InternalModuleReadJSON);
+  SetMethod(context,
+            target,
+            "internalModuleReadPackageJSON",
+            InternalModuleReadPackageJSON);
   SetMethod(context, target, "internalModuleStat", InternalModuleStat);
+  SetMethod(context,
+            target,
+            "internalModuleGetCachedResolution",
+            InternalModuleGetCachedResolution);
+  SetMethod(context,
+            target,
+            "internalModuleCacheResolution",
+            InternalModuleCacheResolution);
   SetMethod(context, target, "stat", Stat);
   SetMethod(context, target, "lstat", LStat);
   SetMethod(context, target, "fstat", FStat);
@@ -2460,6 +3778,10 @@ void Initialize(Local<Object> target,
   SetMethod(context, target, "writeString", WriteString);
   SetMethod(context, target, "realpath", RealPath);
   SetMethod(context, target, "copyFile", CopyFile);
+#ifndef _WIN32
+  SetMethod(context, target, "rmTree", RmTree);
+  SetMethod(context, target, "cpTree", CpTree);
+#endif
 
   SetMethod(context, target, "chmod", Chmod);
   SetMethod(context, target, "fchmod", FChmod);
@@ -2555,6 +3877,8 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(OpenFileHandle);
   registry->Register(Read);
   registry->Register(ReadBuffers);
+  registry->Register(ReadFile);
+  registry->Register(ReadFiles);
   registry->Register(Fdatasync);
   registry->Register(Fsync);
   registry->Register(Rename);
@@ -2563,7 +3887,10 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(MKDir);
   registry->Register(ReadDir);
   registry->Register(InternalModuleReadJSON);
+  registry->Register(InternalModuleReadPackageJSON);
   registry->Register(InternalModuleStat);
+  registry->Register(InternalModuleGetCachedResolution);
+  registry->Register(InternalModuleCacheResolution);
   registry->Register(Stat);
   registry->Register(LStat);
   registry->Register(FStat);
@@ -2576,6 +3903,10 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(WriteString);
   registry->Register(RealPath);
   registry->Register(CopyFile);
+#ifndef _WIN32
+  registry->Register(RmTree);
+  registry->Register(CpTree);
+#endif
 
   registry->Register(Chmod);
   registry->Register(FChmod);
@@ -4,6 +4,7 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "aliased_buffer.h"
+#include "node_internals.h"
 #include "node_messaging.h"
 #include "node_snapshotable.h"
 #include "stream_base.h"
@@ -12,6 +13,7 @@ namespace node {
 namespace fs {
 
 class FileHandleReadWrap;
+class IoUring;
 
 class BindingData : public SnapshotableObject {
  public:
@@ -23,6 +25,11 @@ class BindingData : public SnapshotableObject {
   std::vector<BaseObjectPtr<FileHandleReadWrap>>
       file_handle_read_wrap_freelist;
 
+  // Created on first use by IoUring::Get() if --experimental-fs-io-uring is
+  // set, and owned by the environment's cleanup hooks.
+  IoUring* io_uring = nullptr;
+  bool io_uring_unavailable = false;
+
   SERIALIZABLE_OBJECT_METHODS()
   static constexpr FastStringKey type_name{"node::fs::BindingData"};
   static constexpr EmbedderObjectType type_int =
@@ -209,6 +216,29 @@ class FSReqAfterScope final {
   v8::Context::Scope context_scope_;
 };
 
+// Runs a request that takes more than a single uv_fs_*() call, like reading
+// a whole file, on the threadpool and then hands the FSReqBase to Settle().
+// The FSReqBase is detached first, like FSReqAfterScope does, and Settle()
+// is skipped if JS cannot be called into anymore.
+//
+// The work is done by job classes such as ReadFileJob, which the synchronous
+// bindings run on the main thread as well. Their Run() methods return 0 or a
+// libuv error code and must not touch JS.
+class FSReqThreadPoolWork : public ThreadPoolWork {
+ public:
+  explicit FSReqThreadPoolWork(FSReqBase* req_wrap);
+
+  void AfterThreadPoolWork(int status) final;
+
+ protected:
+  // Resolves or rejects `req_wrap`. Called with a HandleScope and the
+  // context of its Environment entered.
+  virtual void Settle(FSReqBase* req_wrap) = 0;
+
+ private:
+  BaseObjectPtr<FSReqBase> req_wrap_;
+};
+
 class FileHandle;
 
 // A request wrap specifically for uv_fs_read()s scheduled for reading
@@ -0,0 +1,604 @@
+#include "node_file_uring.h"  // NOLINT(build/include_inline)
+
+#include "env-inl.h"
+#include "node_file-inl.h"
+#include "util-inl.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+// IORING_FEAT_RW_CUR_POS was added in Linux 5.6 together with the opcodes
+// used below (openat, close, statx), so its presence in the kernel headers
+// tells us that all of them can be compiled in.
+#ifdef IORING_FEAT_RW_CUR_POS
+#define NODE_HAVE_IO_URING 1
+#endif
+
+#ifdef NODE_HAVE_IO_URING
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#endif
+
+namespace node {
+namespace fs {
+
+#ifdef NODE_HAVE_IO_URING
+
+namespace {
+
+// Enough to keep a fast NVMe device busy while keeping the locked memory of
+// the rings well below the default RLIMIT_MEMLOCK of older kernels.
+constexpr unsigned kRingEntries = 256;
+
+// UIO_MAXIOV, the most buffers readv(2) and writev(2) accept.
+constexpr unsigned kMaxBuffers = 1024;
+
+// struct statx as defined by the kernel ABI. <linux/stat.h> conflicts with the
+// definitions in the glibc headers, so it is not included here.
+struct StatxTimestamp {
+  int64_t tv_sec;
+  uint32_t tv_nsec;
+  int32_t unused0;
+};
+
+struct Statx {
+  uint32_t stx_mask;
+  uint32_t stx_blksize;
+  uint64_t stx_attributes;
+  uint32_t stx_nlink;
+  uint32_t stx_uid;
+  uint32_t stx_gid;
+  uint16_t stx_mode;
+  uint16_t unused0;
+  uint64_t stx_ino;
+  uint64_t stx_size;
+  uint64_t stx_blocks;
+  uint64_t stx_attributes_mask;
+  StatxTimestamp stx_atime;
+  StatxTimestamp stx_btime;
+  StatxTimestamp stx_ctime;
+  StatxTimestamp stx_mtime;
+  uint32_t stx_rdev_major;
+  uint32_t stx_rdev_minor;
+  uint32_t stx_dev_major;
+  uint32_t stx_dev_minor;
+  uint64_t unused1[14];
+};
+
+// STATX_BASIC_STATS | STATX_BTIME, the same mask that libuv requests.
+constexpr uint32_t kStatxMask = 0xFFF;
+
+void StatxToUvStat(const Statx& statx, uv_stat_t* stat) {
+  stat->st_dev = makedev(statx.stx_dev_major, statx.stx_dev_minor);
+  stat->st_mode = statx.stx_mode;
+  stat->st_nlink = statx.stx_nlink;
+  stat->st_uid = statx.stx_uid;
+  stat->st_gid = statx.stx_gid;
+  stat->st_rdev = makedev(statx.stx_rdev_major, statx.stx_rdev_minor);
+  stat->st_ino = statx.stx_ino;
+  stat->st_size = statx.stx_size;
+  stat->st_blksize = statx.stx_blksize;
+  stat->st_blocks = statx.stx_blocks;
+  stat->st_atim.tv_sec = statx.stx_atime.tv_sec;
+  stat->st_atim.tv_nsec = statx.stx_atime.tv_nsec;
+  stat->st_mtim.tv_sec = statx.stx_mtime.tv_sec;
+  stat->st_mtim.tv_nsec = statx.stx_mtime.tv_nsec;
+  stat->st_ctim.tv_sec = statx.stx_ctime.tv_sec;
+  stat->st_ctim.tv_nsec = statx.stx_ctime.tv_nsec;
+  stat->st_birthtim.tv_sec = statx.stx_btime.tv_sec;
+  stat->st_birthtim.tv_nsec = statx.stx_btime.tv_nsec;
+  stat->st_flags = 0;
+  stat->st_gen = 0;
+}
+
+int io_uring_setup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(int fd,
+                   unsigned to_submit,
+                   unsigned min_complete,
+                   unsigned flags) {
+  return static_cast<int>(syscall(
+      __NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int io_uring_register(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+template <typename T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+}  // anonymous namespace
+
+struct IoUring::Op {
+  Op(uv_fs_t* req, uv_fs_cb cb, uv_fs_type type, const char* path = "")
+      : req(req), cb(cb), type(type), path(path) {
+    memset(&statx, 0, sizeof(statx));
+  }
+
+  uv_fs_t* req;
+  uv_fs_cb cb;
+  uv_fs_type type;
+  std::string path;
+  MaybeStackBuffer<uv_buf_t, 4> bufs;
+  Statx statx;
+};
+
+IoUring::IoUring(Environment* env, BindingData* binding_data)
+    : env_(env), binding_data_(binding_data) {}
+
+IoUring::~IoUring() {
+  CHECK_EQ(in_flight_, 0);
+  if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_)
+    munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != nullptr) munmap(sq_ring_, sq_ring_size_);
+  if (event_fd_ != -1) close(event_fd_);
+  if (ring_fd_ != -1) close(ring_fd_);
+}
+
+IoUring* IoUring::Get(BindingData* binding_data) {
+  if (binding_data->io_uring != nullptr) return binding_data->io_uring;
+  if (binding_data->io_uring_unavailable) return nullptr;
+
+  Environment* env = binding_data->env();
+  if (!env->options()->experimental_fs_io_uring || env->is_stopping())
+    return nullptr;
+
+  IoUring* ring = new IoUring(env, binding_data);
+  if (!ring->Init()) {
+    delete ring;
+    // Don't retry on every request, the answer is not going to change.
+    binding_data->io_uring_unavailable = true;
+    return nullptr;
+  }
+  binding_data->io_uring = ring;
+  return ring;
+}
+
+bool IoUring::Init() {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = io_uring_setup(kRingEntries, &params);
+  if (ring_fd_ < 0) return false;  // ENOSYS, EPERM from seccomp, ...
+
+  // Every opcode this class submits must be supported by the kernel.
+  constexpr unsigned kProbeOps = IORING_OP_STATX + 1;
+  size_t probe_size =
+      sizeof(io_uring_probe) + kProbeOps * sizeof(io_uring_probe_op);
+  std::unique_ptr<char[]> probe_storage(new char[probe_size]());
+  io_uring_probe* probe =
+      reinterpret_cast<io_uring_probe*>(probe_storage.get());
+  if (io_uring_register(ring_fd_, IORING_REGISTER_PROBE, probe, kProbeOps) < 0)
+    return false;
+  for (unsigned op : {IORING_OP_READV,
+                      IORING_OP_WRITEV,
+                      IORING_OP_FSYNC,
+                      IORING_OP_OPENAT,
+                      IORING_OP_CLOSE,
+                      IORING_OP_STATX}) {
+    if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+      return false;
+  }
+  can_use_current_position_ = params.features & IORING_FEAT_RW_CUR_POS;
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap)
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+  void* sq_ring = mmap(nullptr,
+                       sq_ring_size_,
+                       PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE,
+                       ring_fd_,
+                       IORING_OFF_SQ_RING);
+  if (sq_ring == MAP_FAILED) return false;
+  sq_ring_ = sq_ring;
+
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    void* cq_ring = mmap(nullptr,
+                         cq_ring_size_,
+                         PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE,
+                         ring_fd_,
+                         IORING_OFF_CQ_RING);
+    if (cq_ring == MAP_FAILED) return false;
+    cq_ring_ = cq_ring;
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(nullptr,
+                    sqes_size_,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    ring_fd_,
+                    IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) return false;
+  sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+  sq_head_ = RingField<uint32_t>(sq_ring_, params.sq_off.head);
+  sq_tail_ = RingField<uint32_t>(sq_ring_, params.sq_off.tail);
+  sq_array_ = RingField<uint32_t>(sq_ring_, params.sq_off.array);
+  sq_mask_ = *RingField<uint32_t>(sq_ring_, params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+
+  cq_head_ = RingField<uint32_t>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingField<uint32_t>(cq_ring_, params.cq_off.tail);
+  cqes_ = RingField<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+  cq_mask_ = *RingField<uint32_t>(cq_ring_, params.cq_off.ring_mask);
+  cq_entries_ = params.cq_entries;
+
+  event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (event_fd_ < 0) return false;
+  if (io_uring_register(ring_fd_, IORING_REGISTER_EVENTFD, &event_fd_, 1) < 0)
+    return false;
+
+  uv_loop_t* loop = env_->event_loop();
+  if (uv_poll_init(loop, &poll_handle_, event_fd_) != 0) return false;
+  CHECK_EQ(uv_prepare_init(loop, &prepare_handle_), 0);
+  poll_handle_.data = this;
+  prepare_handle_.data = this;
+  open_handles_ = 2;
+
+  CHECK_EQ(uv_poll_start(&poll_handle_, UV_READABLE, OnPoll), 0);
+  CHECK_EQ(uv_prepare_start(&prepare_handle_, OnPrepare), 0);
+  // The poll handle is only referenced while requests are in flight, and the
+  // prepare handle never keeps the loop alive on its own.
+  uv_unref(reinterpret_cast<uv_handle_t*>(&poll_handle_));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&prepare_handle_));
+
+  env_->AddCleanupHook(Cleanup, this);
+  return true;
+}
+
+void IoUring::Cleanup(void* arg) {
+  IoUring* ring = static_cast<IoUring*>(arg);
+
+  // Environment::RunCleanup() has normally waited for all requests already.
+  // If not, block until the kernel is done with our buffers and paths.
+  while (ring->in_flight_ > 0) {
+    ring->SubmitOrFail();
+    if (ring->in_flight_ > 0 &&
+        io_uring_enter(ring->ring_fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0) {
+      CHECK_EQ(errno, EINTR);
+    }
+    ring->ReapCompletions();
+  }
+
+  ring->binding_data_->io_uring = nullptr;
+  ring->binding_data_->io_uring_unavailable = true;
+
+  auto on_close = [](auto* handle) {
+    IoUring* ring = static_cast<IoUring*>(handle->data);
+    if (--ring->open_handles_ == 0) delete ring;
+  };
+  ring->env_->CloseHandle(&ring->poll_handle_, on_close);
+  ring->env_->CloseHandle(&ring->prepare_handle_, on_close);
+}
+
+io_uring_sqe* IoUring::NextSqe() {
+  // Never have more requests outstanding than fit into the completion ring,
+  // so that completions cannot overflow.
+  if (in_flight_ >= cq_entries_) return nullptr;
+
+  uint32_t tail = *sq_tail_;
+  if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+    // More requests than entries in a single tick; submit what we have so
+    // far early. Errors are dealt with when the loop submits the rest.
+    if (Submit() < 0 ||
+        tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+      return nullptr;
+    }
+  }
+
+  io_uring_sqe* sqe = &sqes_[tail & sq_mask_];
+  memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+void IoUring::Enqueue(io_uring_sqe* sqe, Op* op) {
+  sqe->user_data = reinterpret_cast<uintptr_t>(op);
+
+  uint32_t tail = *sq_tail_;
+  sq_array_[tail & sq_mask_] = tail & sq_mask_;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+  unsubmitted_++;
+  if (in_flight_++ == 0)
+    uv_ref(reinterpret_cast<uv_handle_t*>(&poll_handle_));
+  env_->IncreaseWaitingRequestCounter();
+}
+
+int IoUring::Submit() {
+  while (unsubmitted_ > 0) {
+    int rc = io_uring_enter(ring_fd_, unsubmitted_, 0, 0);
+    if (rc < 0) {
+      if (errno == EINTR) continue;
+      return -errno;
+    }
+    if (rc == 0) break;
+    unsubmitted_ -= rc;
+  }
+  return 0;
+}
+
+void IoUring::SubmitOrFail() {
+  int err = Submit();
+  if (err == 0 || unsubmitted_ == 0) return;
+
+  // The kernel is temporarily out of resources, but it will post completions
+  // for requests it already has, and the next tick will try again.
+  if ((err == UV_EAGAIN || err == UV_EBUSY) && in_flight_ > unsubmitted_)
+    return;
+
+  // Nothing else is going to wake up the loop; take the entries back out of
+  // the submission ring and fail their requests.
+  uint32_t tail = *sq_tail_;
+  uint32_t head = tail - unsubmitted_;
+  __atomic_store_n(sq_tail_, head, __ATOMIC_RELEASE);
+  unsubmitted_ = 0;
+  for (; head != tail; head++) {
+    io_uring_sqe* sqe = &sqes_[sq_array_[head & sq_mask_]];
+    Complete(reinterpret_cast<Op*>(sqe->user_data), err);
+  }
+}
+
+void IoUring::ReapCompletions() {
+  for (;;) {
+    uint32_t head = *cq_head_;
+    if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) break;
+    io_uring_cqe* cqe = &cqes_[head & cq_mask_];
+    Op* op = reinterpret_cast<Op*>(cqe->user_data);
+    int result = cqe->res;
+    // Hand the slot back before running the callback, which may queue more.
+    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    Complete(op, result);
+  }
+}
+
+void IoUring::Complete(Op* op, int result) {
+  std::unique_ptr<Op> op_ptr(op);
+
+  if (--in_flight_ == 0)
+    uv_unref(reinterpret_cast<uv_handle_t*>(&poll_handle_));
+
+  // Make the request look like one that libuv has completed, so that
+  // uv_fs_req_cleanup() and the After*() callbacks can handle it.
+  uv_fs_t* req = op->req;
+  memset(req, 0, sizeof(*req));
+  req->type = UV_FS;
+  req->loop = env_->event_loop();
+  req->fs_type = op->type;
+  req->result = result;
+  if (!op->path.empty()) req->path = op->path.c_str();
+
+  if (result == 0 && (op->type == UV_FS_STAT || op->type == UV_FS_LSTAT ||
+                      op->type == UV_FS_FSTAT)) {
+    StatxToUvStat(op->statx, &req->statbuf);
+    req->ptr = &req->statbuf;
+  }
+  // Like uv__fs_close(), a close that was interrupted still released the fd.
+  if (op->type == UV_FS_CLOSE &&
+      (result == UV_EINTR || result == -EINPROGRESS)) {
+    req->result = 0;
+  }
+
+  env_->DecreaseWaitingRequestCounter();
+  op->cb(req);
+}
+
+void IoUring::OnPrepare(uv_prepare_t* handle) {
+  static_cast<IoUring*>(handle->data)->SubmitOrFail();
+}
+
+void IoUring::OnPoll(uv_poll_t* handle, int status, int events) {
+  IoUring* ring = static_cast<IoUring*>(handle->data);
+  uint64_t count;
+  while (read(ring->event_fd_, &count, sizeof(count)) < 0 && errno == EINTR) {
+  }
+  ring->ReapCompletions();
+}
+
+int IoUring::Open(uv_fs_t* req,
+                  const char* path,
+                  int flags,
+                  int mode,
+                  uv_fs_cb cb) {
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) return UV_EAGAIN;
+
+  Op* op = new Op(req, cb, UV_FS_OPEN, path);
+  sqe->opcode = IORING_OP_OPENAT;
+  sqe->fd = AT_FDCWD;
+  sqe->addr = reinterpret_cast<uintptr_t>(op->path.c_str());
+  sqe->len = mode;
+  sqe->open_flags = flags | O_CLOEXEC;
+  Enqueue(sqe, op);
+  return 0;
+}
+
+int IoUring::Close(uv_fs_t* req, uv_file file, uv_fs_cb cb) {
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) return UV_EAGAIN;
+
+  Op* op = new Op(req, cb, UV_FS_CLOSE);
+  sqe->opcode = IORING_OP_CLOSE;
+  sqe->fd = file;
+  Enqueue(sqe, op);
+  return 0;
+}
+
+int IoUring::QueueReadWrite(uv_fs_t* req,
+                            uv_fs_type type,
+                            uv_file file,
+                            const uv_buf_t bufs[],
+                            unsigned int nbufs,
+                            int64_t offset,
+                            uv_fs_cb cb) {
+  // Like libuv, treat any negative offset as "use the file position".
+  if (offset < 0 && !can_use_current_position_) return UV_ENOTSUP;
+  if (nbufs > kMaxBuffers) return UV_ENOTSUP;
+
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) return UV_EAGAIN;
+
+  Op* op = new Op(req, cb, type);
+  // The kernel reads the iovec array when it issues the request.
+  op->bufs.AllocateSufficientStorage(nbufs);
+  memcpy(op->bufs.out(), bufs, nbufs * sizeof(*bufs));
+
+  sqe->opcode = type == UV_FS_READ ? IORING_OP_READV : IORING_OP_WRITEV;
+  sqe->fd = file;
+  sqe->addr = reinterpret_cast<uintptr_t>(op->bufs.out());
+  sqe->len = nbufs;
+  sqe->off = offset < 0 ? static_cast<uint64_t>(-1) : offset;
+  Enqueue(sqe, op);
+  return 0;
+}
+
+int IoUring::Read(uv_fs_t* req,
+                  uv_file file,
+                  const uv_buf_t bufs[],
+                  unsigned int nbufs,
+                  int64_t offset,
+                  uv_fs_cb cb) {
+  return QueueReadWrite(req, UV_FS_READ, file, bufs, nbufs, offset, cb);
+}
+
+int IoUring::Write(uv_fs_t* req,
+                   uv_file file,
+                   const uv_buf_t bufs[],
+                   unsigned int nbufs,
+                   int64_t offset,
+                   uv_fs_cb cb) {
+  return QueueReadWrite(req, UV_FS_WRITE, file, bufs, nbufs, offset, cb);
+}
+
+int IoUring::QueueStat(uv_fs_t* req,
+                       uv_fs_type type,
+                       uv_file file,
+                       const char* path,
+                       uv_fs_cb cb) {
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) return UV_EAGAIN;
+
+  Op* op = new Op(req, cb, type, path);
+  sqe->opcode = IORING_OP_STATX;
+  sqe->fd = type == UV_FS_FSTAT ? file : AT_FDCWD;
+  sqe->addr = reinterpret_cast<uintptr_t>(op->path.c_str());
+  sqe->len = kStatxMask;
+  sqe->off = reinterpret_cast<uintptr_t>(&op->statx);
+  if (type == UV_FS_LSTAT)
+    sqe->statx_flags = AT_SYMLINK_NOFOLLOW;
+  else if (type == UV_FS_FSTAT)
+    sqe->statx_flags = AT_EMPTY_PATH;
+  Enqueue(sqe, op);
+  return 0;
+}
+
+int IoUring::Stat(uv_fs_t* req, const char* path, uv_fs_cb cb) {
+  return QueueStat(req, UV_FS_STAT, -1, path, cb);
+}
+
+int IoUring::LStat(uv_fs_t* req, const char* path, uv_fs_cb cb) {
+  return QueueStat(req, UV_FS_LSTAT, -1, path, cb);
+}
+
+int IoUring::FStat(uv_fs_t* req, uv_file file, uv_fs_cb cb) {
+  // The path stays empty, so it is not reported in error messages.
+  return QueueStat(req, UV_FS_FSTAT, file, "", cb);
+}
+
+int IoUring::QueueFsync(uv_fs_t* req,
+                        uv_fs_type type,
+                        uv_file file,
+                        uv_fs_cb cb) {
+  io_uring_sqe* sqe = NextSqe();
+  if (sqe == nullptr) return UV_EAGAIN;
+
+  Op* op = new Op(req, cb, type);
+  sqe->opcode = IORING_OP_FSYNC;
+  sqe->fd = file;
+  if (type == UV_FS_FDATASYNC) sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+  Enqueue(sqe, op);
+  return 0;
+}
+
+int IoUring::Fsync(uv_fs_t* req, uv_file file, uv_fs_cb cb) {
+  return QueueFsync(req, UV_FS_FSYNC, file, cb);
+}
+
+int IoUring::Fdatasync(uv_fs_t* req, uv_file file, uv_fs_cb cb) {
+  return QueueFsync(req, UV_FS_FDATASYNC, file, cb);
+}
+
+#else  // !NODE_HAVE_IO_URING
+
+IoUring* IoUring::Get(BindingData* binding_data) {
+  return nullptr;
+}
+
+int IoUring::Open(uv_fs_t*, const char*, int, int, uv_fs_cb) {
+  return UV_ENOSYS;
+}
+
+int IoUring::Close(uv_fs_t*, uv_file, uv_fs_cb) {
+  return UV_ENOSYS;
+}
+
+int IoUring::Read(
+    uv_fs_t*, uv_file, const uv_buf_t[], unsigned int, int64_t, uv_fs_cb) {
+  return UV_ENOSYS;
+}
+
+int IoUring::Write(
+    uv_fs_t*, uv_file, const uv_buf_t[], unsigned int, int64_t, uv_fs_cb) {
+  return UV_ENOSYS;
+}
+
+int IoUring::Stat(uv_fs_t*, const char*, uv_fs_cb) {
+  return UV_ENOSYS;
+}
+
+int IoUring::LStat(uv_fs_t*, const char*, uv_fs_cb) {
+  return UV_ENOSYS;
+}
+
+int IoUring::FStat(uv_fs_t*, uv_file, uv_fs_cb) {
+  return UV_ENOSYS;
+}
+
+int IoUring::Fsync(uv_fs_t*, uv_file, uv_fs_cb) {
+  return UV_ENOSYS;
+}
+
+int IoUring::Fdatasync(uv_fs_t*, uv_file, uv_fs_cb) {
+  return UV_ENOSYS;
+}
+
+#endif  // NODE_HAVE_IO_URING
+
+}  // namespace fs
+}  // namespace node
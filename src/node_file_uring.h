@@ -0,0 +1,137 @@
+#ifndef SRC_NODE_FILE_URING_H_
+#define SRC_NODE_FILE_URING_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstdint>
+#include "uv.h"
+
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace node {
+
+class Environment;
+
+namespace fs {
+
+class BindingData;
+
+// Runs asynchronous file system requests on a Linux io_uring instead of the
+// libuv threadpool. Enabled with --experimental-fs-io-uring.
+//
+// Requests are queued in the submission ring and handed to the kernel in one
+// io_uring_enter(2) call per event loop iteration, right before the loop
+// blocks for I/O. The kernel signals completions through an eventfd that is
+// watched by the loop; each completion fills in the uv_fs_t of the request
+// and invokes its callback exactly as libuv would, so the usual After*()
+// functions resolve the FSReqCallback or FSReqPromise.
+//
+// The methods mirror the uv_fs_*() functions of the same name. They return 0
+// when the request was queued, or a negative error code when the ring cannot
+// take it (kernel support missing, ring full, ...), in which case the caller
+// should dispatch the request to the threadpool as usual.
+class IoUring {
+ public:
+  // Returns the ring of the environment that `binding_data` belongs to,
+  // creating it on first use. Returns nullptr if io_uring is not enabled or
+  // not supported by the system.
+  static IoUring* Get(BindingData* binding_data);
+
+  int Open(uv_fs_t* req, const char* path, int flags, int mode, uv_fs_cb cb);
+  int Close(uv_fs_t* req, uv_file file, uv_fs_cb cb);
+  int Read(uv_fs_t* req,
+           uv_file file,
+           const uv_buf_t bufs[],
+           unsigned int nbufs,
+           int64_t offset,
+           uv_fs_cb cb);
+  int Write(uv_fs_t* req,
+            uv_file file,
+            const uv_buf_t bufs[],
+            unsigned int nbufs,
+            int64_t offset,
+            uv_fs_cb cb);
+  int Stat(uv_fs_t* req, const char* path, uv_fs_cb cb);
+  int LStat(uv_fs_t* req, const char* path, uv_fs_cb cb);
+  int FStat(uv_fs_t* req, uv_file file, uv_fs_cb cb);
+  int Fsync(uv_fs_t* req, uv_file file, uv_fs_cb cb);
+  int Fdatasync(uv_fs_t* req, uv_file file, uv_fs_cb cb);
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+ private:
+  struct Op;
+
+  IoUring(Environment* env, BindingData* binding_data);
+  ~IoUring();
+
+  bool Init();
+  io_uring_sqe* NextSqe();
+  void Enqueue(io_uring_sqe* sqe, Op* op);
+  int Submit();
+  void SubmitOrFail();
+  void ReapCompletions();
+  void Complete(Op* op, int result);
+
+  int QueueReadWrite(uv_fs_t* req,
+                     uv_fs_type type,
+                     uv_file file,
+                     const uv_buf_t bufs[],
+                     unsigned int nbufs,
+                     int64_t offset,
+                     uv_fs_cb cb);
+  int QueueStat(uv_fs_t* req,
+                uv_fs_type type,
+                uv_file file,
+                const char* path,
+                uv_fs_cb cb);
+  int QueueFsync(uv_fs_t* req, uv_fs_type type, uv_file file, uv_fs_cb cb);
+
+  static void OnPrepare(uv_prepare_t* handle);
+  static void OnPoll(uv_poll_t* handle, int status, int events);
+  static void Cleanup(void* arg);
+
+  Environment* env_;
+  BindingData* binding_data_;
+
+  int ring_fd_ = -1;
+  int event_fd_ = -1;
+  bool can_use_current_position_ = false;
+
+  void* sq_ring_ = nullptr;
+  void* cq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  uint32_t cq_entries_ = 0;
+
+  // Entries written to the submission ring but not yet consumed by the kernel.
+  uint32_t unsubmitted_ = 0;
+  // Requests queued or submitted for which no completion was reaped yet.
+  uint32_t in_flight_ = 0;
+
+  uv_prepare_t prepare_handle_;
+  uv_poll_t poll_handle_;
+  int open_handles_ = 0;
+};
+
+}  // namespace fs
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_FILE_URING_H_
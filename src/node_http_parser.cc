@@ -50,9 +50,10 @@ namespace node {
 namespace {  // NOLINT(build/namespaces)
 
 using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
 using v8::Boolean;
 using v8::Context;
-using v8::EscapableHandleScope;
 using v8::Exception;
 using v8::Function;
 using v8::FunctionCallbackInfo;
@@ -63,10 +64,12 @@ using v8::Integer;
 using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
+using v8::NewStringType;
 using v8::Number;
 using v8::Object;
 using v8::String;
 using v8::Uint32;
+using v8::Uint32Array;
 using v8::Undefined;
 using v8::Value;
 
@@ -77,6 +80,7 @@ const uint32_t kOnBody = 3;
 const uint32_t kOnMessageComplete = 4;
 const uint32_t kOnExecute = 5;
 const uint32_t kOnTimeout = 6;
+const uint32_t kOnEvents = 7;
 // Any more fields than this will be flushed into JS
 const size_t kMaxHeaderFieldsCount = 32;
 
@@ -87,6 +91,10 @@ const uint32_t kLenientKeepAlive = 1 << 2;
 const uint32_t kLenientAll = kLenientHeaders | kLenientChunkedLength |
   kLenientKeepAlive;
 
+// Flags of a kOnHeadersComplete entry in the batched event log.
+const uint32_t kEventShouldKeepAlive = 1 << 0;
+const uint32_t kEventHasHeaders = 1 << 1;
+
 inline bool IsOWS(char c) {
   return c == ' ' || c == '\t';
 }
@@ -100,9 +108,12 @@ class BindingData : public BaseObject {
 
   std::vector<char> parser_buffer;
   bool parser_buffer_in_use = false;
+  // Reused by SerializeHeaders() for every outgoing header block.
+  std::vector<char> header_buffer;
 
   void MemoryInfo(MemoryTracker* tracker) const override {
     tracker->TrackField("parser_buffer", parser_buffer);
+    tracker->TrackField("header_buffer", header_buffer);
   }
   SET_SELF_SIZE(BindingData)
   SET_MEMORY_INFO_NAME(BindingData)
@@ -271,6 +282,11 @@ class Parser : public AsyncWrap, public StreamListener {
       connectionsList_->PushActive(this);
     }
 
+    if (batch_events_) {
+      batch_log_.push_back(kOnMessageBegin);
+      return 0;
+    }
+
     Local<Value> cb = object()->Get(env()->context(), kOnMessageBegin)
                               .ToLocalChecked();
     if (cb->IsFunction()) {
@@ -361,6 +377,16 @@ class Parser : public AsyncWrap, public StreamListener {
     headers_completed_ = true;
     header_nread_ = 0;
 
+    if (batch_events_) {
+      // Only upgrade requests need an answer from JS land before the parser
+      // can go on, everything else is just added to the event log.
+      if (!parser_.upgrade)
+        return RecordHeadersComplete();
+      FlushEvents();
+      if (got_exception_)
+        return -1;
+    }
+
     // Arguments for the on-headers-complete javascript callback. This
     // list needs to be kept in sync with the actual argument list for
     // `parserOnHeadersComplete` in lib/_http_common.js.
@@ -392,6 +418,12 @@ class Parser : public AsyncWrap, public StreamListener {
     if (have_flushed_) {
       // Slow case, flush remaining headers.
       Flush();
+      if (batch_events_) {
+        // Flush() only recorded them, deliver them before the upgrade.
+        FlushEvents();
+        if (got_exception_)
+          return -1;
+      }
     } else {
       // Fast case, pass headers and URL to JS land.
       argv[A_HEADERS] = CreateHeaders();
@@ -453,6 +485,21 @@ class Parser : public AsyncWrap, public StreamListener {
     if (length == 0)
       return 0;
 
+    if (batch_events_) {
+      // Body chunks are copied out of the read buffer in one piece when the
+      // event log is flushed, so only their position is recorded here.
+      CHECK_NOT_NULL(current_buffer_data_);
+      CHECK_GE(at, current_buffer_data_);
+      CHECK_LE(at + length, current_buffer_data_ + current_buffer_len_);
+      if (batch_body_start_ == nullptr)
+        batch_body_start_ = at;
+      batch_body_end_ = at + length;
+      batch_log_.push_back(kOnBody);
+      batch_log_.push_back(static_cast<uint32_t>(at - batch_body_start_));
+      batch_log_.push_back(static_cast<uint32_t>(length));
+      return 0;
+    }
+
     Environment* env = this->env();
     HandleScope handle_scope(env->isolate());
 
@@ -476,8 +523,6 @@ class Parser : public AsyncWrap, public StreamListener {
 
 
   int on_message_complete() {
-    HandleScope scope(env()->isolate());
-
     // Important: Pop from the lists BEFORE resetting the last_message_start_
     // otherwise std::set.erase will fail.
     if (connectionsList_ != nullptr) {
@@ -491,6 +536,15 @@ class Parser : public AsyncWrap, public StreamListener {
       connectionsList_->Push(this);
     }
 
+    if (batch_events_) {
+      if (num_fields_)
+        Flush();  // Record trailing HTTP headers.
+      batch_log_.push_back(kOnMessageComplete);
+      return 0;
+    }
+
+    HandleScope scope(env()->isolate());
+
     if (num_fields_)
       Flush();  // Flush trailing HTTP headers.
 
@@ -631,10 +685,15 @@ class Parser : public AsyncWrap, public StreamListener {
       ASSIGN_OR_RETURN_UNWRAP(&connectionsList, args[4]);
     }
 
+    bool batch_events = args.Length() > 5 && args[5]->IsTrue();
+
     llhttp_type_t type =
         static_cast<llhttp_type_t>(args[0].As<Int32>()->Value());
 
     CHECK(type == HTTP_REQUEST || type == HTTP_RESPONSE);
+    // The return value of onHeadersComplete() decides how a response is
+    // parsed, so only request parsers can batch their events.
+    CHECK_IMPLIES(batch_events, type == HTTP_REQUEST);
     Parser* parser;
     ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
     // Should always be called from the same context.
@@ -647,7 +706,7 @@ class Parser : public AsyncWrap, public StreamListener {
 
     parser->set_provider_type(provider);
     parser->AsyncReset(args[1].As<Object>());
-    parser->Init(type, max_http_header_size, lenient_flags);
+    parser->Init(type, max_http_header_size, lenient_flags, batch_events);
 
     if (connectionsList != nullptr) {
       parser->connectionsList_ = connectionsList;
@@ -775,11 +834,24 @@ class Parser : public AsyncWrap, public StreamListener {
     if (nread == 0)
       return;
 
-    Local<Value> ret = Execute(buf.base, nread);
+    Local<Value> ret = Execute(buf.base, nread, !batch_events_);
 
     // Exception
-    if (ret.IsEmpty())
+    if (ret.IsEmpty()) {
+      if (batch_events_)
+        FlushEvents();
       return;
+    }
+
+    // Hand the result to kOnExecute in the same callback as the events.
+    if (batch_events_) {
+      current_buffer_len_ = nread;
+      current_buffer_data_ = buf.base;
+      FlushEvents(ret);
+      current_buffer_len_ = 0;
+      current_buffer_data_ = nullptr;
+      return;
+    }
 
     Local<Value> cb =
         object()->Get(env()->context(), kOnExecute).ToLocalChecked();
@@ -798,9 +870,10 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
-  Local<Value> Execute(const char* data, size_t len) {
-    EscapableHandleScope scope(env()->isolate());
-
+  // Creates its values in the caller's handle scope, which is also where
+  // the batched events are left if `flush_events` is false, for the caller
+  // to flush.
+  Local<Value> Execute(const char* data, size_t len, bool flush_events = true) {
     current_buffer_len_ = len;
     current_buffer_data_ = data;
     got_exception_ = false;
@@ -826,6 +899,9 @@ class Parser : public AsyncWrap, public StreamListener {
       }
     }
 
+    if (flush_events)
+      FlushEvents();
+
     // Apply pending pause
     if (pending_pause_) {
       pending_pause_ = false;
@@ -837,7 +913,7 @@ class Parser : public AsyncWrap, public StreamListener {
 
     // If there was an exception in one of the callbacks
     if (got_exception_)
-      return scope.Escape(Local<Value>());
+      return Local<Value>();
 
     Local<Integer> nread_obj = Integer::New(env()->isolate(), nread);
 
@@ -868,14 +944,14 @@ class Parser : public AsyncWrap, public StreamListener {
 
       obj->Set(env()->context(), env()->code_string(), code).Check();
       obj->Set(env()->context(), env()->reason_string(), reason).Check();
-      return scope.Escape(e);
+      return e;
     }
 
     // No return value is needed for `Finish()`
     if (data == nullptr) {
-      return scope.Escape(Local<Value>());
+      return Local<Value>();
     }
-    return scope.Escape(nread_obj);
+    return nread_obj;
   }
 
   Local<Array> CreateHeaders() {
@@ -893,6 +969,15 @@ class Parser : public AsyncWrap, public StreamListener {
 
   // spill headers and request path to JS land
   void Flush() {
+    if (batch_events_) {
+      batch_log_.push_back(kOnHeaders);
+      batch_values_.push_back(CreateHeaders());
+      batch_values_.push_back(url_.ToString(env()));
+      url_.Reset();
+      have_flushed_ = true;
+      return;
+    }
+
     HandleScope scope(env()->isolate());
 
     Local<Object> obj = object();
@@ -918,8 +1003,96 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  int RecordHeadersComplete() {
+    uint32_t flags = 0;
+    if (llhttp_should_keep_alive(&parser_))
+      flags |= kEventShouldKeepAlive;
+
+    if (have_flushed_) {
+      // Slow case, record remaining headers.
+      Flush();
+    } else {
+      flags |= kEventHasHeaders;
+    }
+
+    batch_log_.push_back(kOnHeadersComplete);
+    batch_log_.push_back(parser_.http_major);
+    batch_log_.push_back(parser_.http_minor);
+    batch_log_.push_back(parser_.method);
+    batch_log_.push_back(flags);
+
+    if (flags & kEventHasHeaders) {
+      batch_values_.push_back(CreateHeaders());
+      batch_values_.push_back(url_.ToString(env()));
+    }
+
+    num_fields_ = 0;
+    num_values_ = 0;
+    return 0;
+  }
+
+
+  // Hands all events recorded since the last call to JS land in a single
+  // callback: a Uint32Array with the event log, an array with the headers
+  // and URLs it refers to, and an ArrayBuffer with the body chunks. If the
+  // result of Execute() is given, it is passed on to kOnExecute by the same
+  // callback, which then also runs the task queues.
+  void FlushEvents(Local<Value> execute_result = Local<Value>()) {
+    if (batch_log_.empty() && execute_result.IsEmpty())
+      return;
+
+    Environment* env = this->env();
+    Isolate* isolate = env->isolate();
+
+    size_t log_size = batch_log_.size() * sizeof(batch_log_[0]);
+    std::shared_ptr<BackingStore> log_store =
+        ArrayBuffer::NewBackingStore(isolate, log_size);
+    memcpy(log_store->Data(), batch_log_.data(), log_size);
+    Local<ArrayBuffer> log_buffer = ArrayBuffer::New(isolate, log_store);
+
+    Local<Value> argv[] = {
+      Uint32Array::New(log_buffer, 0, batch_log_.size()),
+      Array::New(isolate, batch_values_.data(), batch_values_.size()),
+      Undefined(isolate),
+      execute_result.IsEmpty() ? Undefined(isolate).As<Value>() : execute_result
+    };
+
+    if (batch_body_start_ != nullptr) {
+      size_t body_size = batch_body_end_ - batch_body_start_;
+      std::shared_ptr<BackingStore> body_store =
+          ArrayBuffer::NewBackingStore(isolate, body_size);
+      memcpy(body_store->Data(), batch_body_start_, body_size);
+      argv[2] = ArrayBuffer::New(isolate, body_store);
+    }
+
+    // Start over before calling into JS land, which may parse more data.
+    batch_log_.clear();
+    batch_values_.clear();
+    batch_body_start_ = batch_body_end_ = nullptr;
+
+    Local<Value> cb = object()->Get(env->context(), kOnEvents)
+                              .ToLocalChecked();
+    if (!cb->IsFunction())
+      return;
+
+    MaybeLocal<Value> r;
+    if (!execute_result.IsEmpty()) {
+      r = MakeCallback(cb.As<Function>(), arraysize(argv), argv);
+    } else {
+      InternalCallbackScope callback_scope(
+          this, InternalCallbackScope::kSkipTaskQueues);
+      r = cb.As<Function>()->Call(
+          env->context(), object(), arraysize(argv), argv);
+      if (r.IsEmpty()) callback_scope.MarkAsFailed();
+    }
+
+    if (r.IsEmpty())
+      got_exception_ = true;
+  }
+
+
   void Init(llhttp_type_t type, uint64_t max_http_header_size,
-            uint32_t lenient_flags) {
+            uint32_t lenient_flags, bool batch_events) {
     llhttp_init(&parser_, type, &settings);
 
     if (lenient_flags & kLenientHeaders) {
@@ -941,6 +1114,10 @@ class Parser : public AsyncWrap, public StreamListener {
     got_exception_ = false;
     headers_completed_ = false;
     max_http_header_size_ = max_http_header_size;
+    batch_events_ = batch_events;
+    batch_log_.clear();
+    batch_values_.clear();
+    batch_body_start_ = batch_body_end_ = nullptr;
   }
 
 
@@ -991,6 +1168,16 @@ class Parser : public AsyncWrap, public StreamListener {
   uint64_t last_message_start_;
   ConnectionsList* connectionsList_;
 
+  // In batched mode, the llhttp callbacks only record what happened, and
+  // FlushEvents() delivers everything to JS land once llhttp_execute()
+  // returns. The values are created in the handle scope of the caller of
+  // Execute().
+  bool batch_events_ = false;
+  std::vector<uint32_t> batch_log_;
+  std::vector<Local<Value>> batch_values_;
+  const char* batch_body_start_ = nullptr;
+  const char* batch_body_end_ = nullptr;
+
   BaseObjectPtr<BindingData> binding_data_;
 
   // These are helper functions for filling `http_parser_settings`, which turn
@@ -1170,6 +1357,101 @@ const llhttp_settings_t Parser::settings = {
 };
 
 
+// Header blocks larger than this are not kept around between calls.
+const size_t kMaxPooledHeaderBufferSize = 64 * 1024;
+
+// tchar from RFC 7230, section 3.2.6. Mirrors checkIsHttpToken() in
+// lib/_http_common.js.
+inline bool IsTokenChar(uint16_t c) {
+  if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+      (c >= '0' && c <= '9')) {
+    return true;
+  }
+  return c != 0 && c < 0x80 && strchr("!#$%&'*+-.^_`|~", c) != nullptr;
+}
+
+// Tab, visible US-ASCII and obs-text. Mirrors checkInvalidHeaderChar() in
+// lib/_http_common.js.
+inline bool IsHeaderValueChar(uint16_t c) {
+  return c == '\t' || (c >= 0x20 && c <= 0x7e) || (c >= 0x80 && c <= 0xff);
+}
+
+// Appends `str` to `out` as Latin-1, returning false if any character is
+// rejected by `IsValid`.
+template <bool (*IsValid)(uint16_t)>
+bool AppendHeaderString(Isolate* isolate,
+                        Local<String> str,
+                        std::vector<char>* out) {
+  const int length = str->Length();
+  const size_t offset = out->size();
+  out->resize(offset + length);
+  uint8_t* dest = reinterpret_cast<uint8_t*>(out->data() + offset);
+
+  if (str->IsOneByte()) {
+    str->WriteOneByte(isolate, dest, 0, length, String::NO_NULL_TERMINATION);
+    for (int i = 0; i < length; i++) {
+      if (!IsValid(dest[i]))
+        return false;
+    }
+    return true;
+  }
+
+  TwoByteValue value(isolate, str);
+  for (int i = 0; i < length; i++) {
+    if (!IsValid(value[i]))
+      return false;
+    dest[i] = static_cast<uint8_t>(value[i]);
+  }
+  return true;
+}
+
+// serializeHeaders(headers) takes a flat [name, value, name, value, ...]
+// array of strings and returns the "name: value\r\n" lines for it. If a name
+// is not a valid token or a value contains invalid characters, the index of
+// that name is returned instead, so that JS can throw the usual error.
+void SerializeHeaders(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  BindingData* binding_data = Environment::GetBindingData<BindingData>(args);
+  CHECK(args[0]->IsArray());
+  Local<Array> headers = args[0].As<Array>();
+  const uint32_t length = headers->Length();
+
+  std::vector<char>& out = binding_data->header_buffer;
+  out.clear();
+  for (uint32_t i = 0; i + 1 < length; i += 2) {
+    Local<Value> name;
+    Local<Value> value;
+    if (!headers->Get(env->context(), i).ToLocal(&name) ||
+        !headers->Get(env->context(), i + 1).ToLocal(&value)) {
+      return;
+    }
+    if (!name->IsString() || name.As<String>()->Length() == 0 ||
+        !value->IsString() ||
+        !AppendHeaderString<IsTokenChar>(isolate, name.As<String>(), &out)) {
+      return args.GetReturnValue().Set(i);
+    }
+    out.push_back(':');
+    out.push_back(' ');
+    if (!AppendHeaderString<IsHeaderValueChar>(
+            isolate, value.As<String>(), &out)) {
+      return args.GetReturnValue().Set(i);
+    }
+    out.push_back('\r');
+    out.push_back('\n');
+  }
+
+  Local<String> result;
+  if (String::NewFromOneByte(isolate,
+                             reinterpret_cast<const uint8_t*>(out.data()),
+                             NewStringType::kNormal,
+                             out.size()).ToLocal(&result)) {
+    args.GetReturnValue().Set(result);
+  }
+  if (out.capacity() > kMaxPooledHeaderBufferSize)
+    std::vector<char>().swap(out);
+}
+
 void InitializeHttpParser(Local<Object> target,
                           Local<Value> unused,
                           Local<Context> context,
@@ -1201,6 +1483,12 @@ void InitializeHttpParser(Local<Object> target,
          Integer::NewFromUnsigned(env->isolate(), kOnExecute));
   t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnTimeout"),
          Integer::NewFromUnsigned(env->isolate(), kOnTimeout));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnEvents"),
+         Integer::NewFromUnsigned(env->isolate(), kOnEvents));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kEventShouldKeepAlive"),
+         Integer::NewFromUnsigned(env->isolate(), kEventShouldKeepAlive));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kEventHasHeaders"),
+         Integer::NewFromUnsigned(env->isolate(), kEventHasHeaders));
 
   t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kLenientNone"),
          Integer::NewFromUnsigned(env->isolate(), kLenientNone));
@@ -1240,6 +1528,8 @@ void InitializeHttpParser(Local<Object> target,
 
   SetConstructorFunction(context, target, "HTTPParser", t);
 
+  SetMethod(context, target, "serializeHeaders", SerializeHeaders);
+
   Local<FunctionTemplate> c =
       NewFunctionTemplate(isolate, ConnectionsList::New);
   c->InstanceTemplate()
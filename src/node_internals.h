@@ -95,6 +95,17 @@ std::string GetHumanReadableProcessName();
 v8::Maybe<bool> InitializeContextRuntime(v8::Local<v8::Context> context);
 v8::Maybe<bool> InitializePrimordials(v8::Local<v8::Context> context);
 
+// Creates the Environment of a Worker from the worker context of
+// `snapshot_data`. Returns nullptr if that fails.
+Environment* CreateWorkerEnvironmentFromSnapshot(
+    IsolateData* isolate_data,
+    const SnapshotData* snapshot_data,
+    const std::vector<std::string>& args,
+    const std::vector<std::string>& exec_args,
+    EnvironmentFlags::Flags flags,
+    ThreadId thread_id,
+    std::unique_ptr<InspectorParentHandle> inspector_parent_handle);
+
 class NodeArrayBufferAllocator : public ArrayBufferAllocator {
  public:
   inline uint32_t* zero_fill_field() { return &zero_fill_field_; }
@@ -356,6 +367,12 @@ int WriteFileSync(const char* path, uv_buf_t buf);
 int WriteFileSync(v8::Isolate* isolate,
                   const char* path,
                   v8::Local<v8::String> string);
+// Writes `bufs` to `temp_path` and then renames it to `path`, so that
+// readers never see a partially written file. Returns 0 or a libuv error code.
+int WriteFileAtomically(const char* path,
+                        const char* temp_path,
+                        const uv_buf_t* bufs,
+                        size_t count);
 
 class DiagnosticFilename {
  public:
@@ -10,6 +10,8 @@
 #include "node_process-inl.h"
 #include "util-inl.h"
 
+#include <optional>
+
 using node::contextify::ContextifyContext;
 using node::errors::TryCatchScope;
 using v8::Array;
@@ -23,16 +25,25 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::Global;
 using v8::HandleScope;
+using v8::IndexFilter;
+using v8::Int32;
+using v8::Integer;
 using v8::Isolate;
 using v8::Just;
+using v8::KeyCollectionMode;
 using v8::Local;
 using v8::Maybe;
 using v8::MaybeLocal;
+using v8::NewStringType;
 using v8::Nothing;
+using v8::Number;
 using v8::Object;
+using v8::PropertyFilter;
 using v8::SharedArrayBuffer;
 using v8::String;
 using v8::Symbol;
+using v8::TypedArray;
+using v8::Uint32;
 using v8::Value;
 using v8::ValueDeserializer;
 using v8::ValueSerializer;
@@ -74,7 +85,417 @@ Message::Message(MallocedBuffer<char>&& buffer)
     : main_message_buf_(std::move(buffer)) {}
 
 bool Message::IsCloseMessage() const {
-  return main_message_buf_.data == nullptr;
+  return !is_fast_ && main_message_buf_.data == nullptr;
+}
+
+namespace {
+
+// Tags of the compact encoding used by Message::SerializeFast().
+enum class FastTag : uint8_t {
+  kUndefined,
+  kNull,
+  kTrue,
+  kFalse,
+  kInt32,
+  kDouble,
+  kOneByteString,
+  kTwoByteString,
+  kObject,
+  kArray,
+  kTypedArray,
+};
+
+#define FAST_TYPED_ARRAY_TYPES(V)                                             \
+  V(Uint8Array)                                                               \
+  V(Uint8ClampedArray)                                                        \
+  V(Int8Array)                                                                \
+  V(Uint16Array)                                                              \
+  V(Int16Array)                                                               \
+  V(Uint32Array)                                                              \
+  V(Int32Array)                                                               \
+  V(Float32Array)                                                             \
+  V(Float64Array)                                                             \
+  V(BigUint64Array)                                                           \
+  V(BigInt64Array)
+
+enum class FastTypedArrayType : uint8_t {
+#define V(Type) k##Type,
+  FAST_TYPED_ARRAY_TYPES(V)
+#undef V
+};
+
+// Objects and arrays with more entries than this are left to
+// v8::ValueSerializer, which is faster for large ones.
+constexpr uint32_t kMaxFastEntries = 64;
+
+class FastMessageWriter {
+ public:
+  template <typename T>
+  void WriteRaw(T value) {
+    memcpy(Reserve(sizeof(value)), &value, sizeof(value));
+  }
+
+  void WriteTag(FastTag tag) { WriteRaw(static_cast<uint8_t>(tag)); }
+
+  void WriteString(Isolate* isolate, Local<String> string) {
+    uint32_t length = string->Length();
+    if (string->IsOneByte()) {
+      WriteTag(FastTag::kOneByteString);
+      WriteRaw(length);
+      string->WriteOneByte(isolate,
+                           reinterpret_cast<uint8_t*>(Reserve(length)),
+                           0,
+                           length,
+                           String::NO_NULL_TERMINATION);
+    } else {
+      WriteTag(FastTag::kTwoByteString);
+      WriteRaw(length);
+      // The payload is not necessarily aligned for uint16_t.
+      MaybeStackBuffer<uint16_t, 128> chars(length);
+      string->Write(isolate, chars.out(), 0, length,
+                    String::NO_NULL_TERMINATION);
+      memcpy(Reserve(length * sizeof(uint16_t)),
+             chars.out(),
+             length * sizeof(uint16_t));
+    }
+  }
+
+  // Returns false if `value` is not a primitive that can be encoded.
+  bool WritePrimitive(Isolate* isolate, Local<Value> value) {
+    if (value->IsString()) {
+      WriteString(isolate, value.As<String>());
+    } else if (value->IsInt32()) {
+      WriteTag(FastTag::kInt32);
+      WriteRaw(value.As<Int32>()->Value());
+    } else if (value->IsNumber()) {
+      WriteTag(FastTag::kDouble);
+      WriteRaw(value.As<Number>()->Value());
+    } else if (value->IsUndefined()) {
+      WriteTag(FastTag::kUndefined);
+    } else if (value->IsNull()) {
+      WriteTag(FastTag::kNull);
+    } else if (value->IsTrue()) {
+      WriteTag(FastTag::kTrue);
+    } else if (value->IsFalse()) {
+      WriteTag(FastTag::kFalse);
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  char* Reserve(size_t size) {
+    size_t offset = buffer_.length();
+    if (offset + size > buffer_.capacity()) {
+      buffer_.AllocateSufficientStorage(
+          std::max(offset + size, buffer_.capacity() * 2));
+    }
+    buffer_.SetLength(offset + size);
+    return buffer_.out() + offset;
+  }
+
+  MaybeStackBuffer<char, 256>* buffer() { return &buffer_; }
+
+ private:
+  MaybeStackBuffer<char, 256> buffer_;
+};
+
+class FastMessageReader {
+ public:
+  FastMessageReader(const char* data, size_t size)
+      : data_(data), end_(data + size) {}
+
+  const char* Read(size_t size) {
+    CHECK_LE(size, static_cast<size_t>(end_ - data_));
+    const char* ret = data_;
+    data_ += size;
+    return ret;
+  }
+
+  template <typename T>
+  T ReadRaw() {
+    T value;
+    memcpy(&value, Read(sizeof(value)), sizeof(value));
+    return value;
+  }
+
+  FastTag ReadTag() { return static_cast<FastTag>(ReadRaw<uint8_t>()); }
+
+  MaybeLocal<String> ReadString(Isolate* isolate,
+                                FastTag tag,
+                                NewStringType type) {
+    uint32_t length = ReadRaw<uint32_t>();
+    if (tag == FastTag::kOneByteString) {
+      return String::NewFromOneByte(
+          isolate, reinterpret_cast<const uint8_t*>(Read(length)), type,
+          length);
+    }
+    CHECK_EQ(tag, FastTag::kTwoByteString);
+    MaybeStackBuffer<uint16_t, 128> chars(length);
+    memcpy(chars.out(), Read(length * sizeof(uint16_t)),
+           length * sizeof(uint16_t));
+    return String::NewFromTwoByte(isolate, chars.out(), type, length);
+  }
+
+  MaybeLocal<Value> ReadPrimitive(Isolate* isolate, FastTag tag) {
+    switch (tag) {
+      case FastTag::kUndefined:
+        return v8::Undefined(isolate);
+      case FastTag::kNull:
+        return v8::Null(isolate);
+      case FastTag::kTrue:
+        return v8::True(isolate);
+      case FastTag::kFalse:
+        return v8::False(isolate);
+      case FastTag::kInt32:
+        return Integer::New(isolate, ReadRaw<int32_t>());
+      case FastTag::kDouble:
+        return Number::New(isolate, ReadRaw<double>());
+      default: {
+        Local<String> string;
+        if (!ReadString(isolate, tag, NewStringType::kNormal)
+                 .ToLocal(&string)) {
+          return MaybeLocal<Value>();
+        }
+        return string;
+      }
+    }
+  }
+
+ private:
+  const char* data_;
+  const char* const end_;
+};
+
+}  // anonymous namespace
+
+Maybe<bool> Message::SerializeFast(Environment* env,
+                                   Local<Context> context,
+                                   Local<Value> input) {
+  Isolate* isolate = env->isolate();
+  FastMessageWriter writer;
+
+  if (writer.WritePrimitive(isolate, input)) {
+    // Nothing else to do.
+  } else if (input->IsArray()) {
+    Local<Array> array = input.As<Array>();
+    uint32_t length = array->Length();
+    if (length > kMaxFastEntries)
+      return Just(false);
+    // Named properties of arrays are cloned as well.
+    Local<Array> names;
+    if (!array->GetPropertyNames(
+                  context,
+                  KeyCollectionMode::kOwnOnly,
+                  static_cast<PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                              v8::SKIP_SYMBOLS),
+                  IndexFilter::kSkipIndices)
+             .ToLocal(&names)) {
+      return Nothing<bool>();
+    }
+    if (names->Length() != 0)
+      return Just(false);
+
+    writer.WriteTag(FastTag::kArray);
+    writer.WriteRaw(length);
+    for (uint32_t i = 0; i < length; i++) {
+      // Read elements through their property descriptors so that no getter
+      // runs before we might fall back to v8::ValueSerializer, which would
+      // run it again. Holes have to be preserved and accessor elements have
+      // to run in order, so both are left to v8::ValueSerializer.
+      Local<String> key;
+      Local<Value> descriptor;
+      if (!Uint32::New(isolate, i)->ToString(context).ToLocal(&key) ||
+          !array->GetOwnPropertyDescriptor(context, key)
+               .ToLocal(&descriptor)) {
+        return Nothing<bool>();
+      }
+      if (!descriptor->IsObject())
+        return Just(false);
+      bool is_data;
+      if (!descriptor.As<Object>()
+               ->HasOwnProperty(context, env->value_string())
+               .To(&is_data)) {
+        return Nothing<bool>();
+      }
+      if (!is_data)
+        return Just(false);
+      Local<Value> element;
+      if (!descriptor.As<Object>()
+               ->Get(context, env->value_string())
+               .ToLocal(&element)) {
+        return Nothing<bool>();
+      }
+      if (!writer.WritePrimitive(isolate, element))
+        return Just(false);
+    }
+  } else if (input->IsTypedArray()) {
+    // Like v8::ValueSerializer, copy the whole underlying buffer.
+    Local<TypedArray> view = input.As<TypedArray>();
+    Local<ArrayBuffer> buffer = view->Buffer();
+    size_t byte_length = buffer->ByteLength();
+    // Views on SharedArrayBuffers share their memory with the receiver, and
+    // detached buffers cannot be cloned at all.
+    if (buffer->IsSharedArrayBuffer() || byte_length == 0)
+      return Just(false);
+
+    FastTypedArrayType type;
+#define V(Type)                                                               \
+    if (view->Is##Type()) {                                                   \
+      type = FastTypedArrayType::k##Type;                                     \
+    } else  // NOLINT(readability/braces)
+    FAST_TYPED_ARRAY_TYPES(V)
+#undef V
+    {
+      return Just(false);
+    }
+
+    writer.WriteTag(FastTag::kTypedArray);
+    writer.WriteRaw(type);
+    writer.WriteRaw(view->ByteOffset());
+    writer.WriteRaw(view->Length());
+    writer.WriteRaw(byte_length);
+    memcpy(writer.Reserve(byte_length), buffer->Data(), byte_length);
+  } else if (input->IsObject()) {
+    // Only plain objects whose properties are all data properties. Getters
+    // must not run here if we might fall back to v8::ValueSerializer later,
+    // which would run them again.
+    Local<Object> object = input.As<Object>();
+    if (object->IsProxy() ||
+        object->InternalFieldCount() != 0 ||
+        !object->GetConstructorName()->StrictEquals(env->object_string())) {
+      return Just(false);
+    }
+    Local<Array> keys;
+    if (!object->GetOwnPropertyNames(
+                   context,
+                   static_cast<PropertyFilter>(v8::ONLY_ENUMERABLE |
+                                               v8::SKIP_SYMBOLS))
+             .ToLocal(&keys)) {
+      return Nothing<bool>();
+    }
+    uint32_t count = keys->Length();
+    if (count > kMaxFastEntries)
+      return Just(false);
+
+    writer.WriteTag(FastTag::kObject);
+    writer.WriteRaw(count);
+    for (uint32_t i = 0; i < count; i++) {
+      Local<Value> key;
+      if (!keys->Get(context, i).ToLocal(&key))
+        return Nothing<bool>();
+      // Integer keys are returned as numbers.
+      if (!key->IsString())
+        return Just(false);
+      bool is_accessor;
+      if (!object->HasRealNamedCallbackProperty(context, key.As<String>())
+               .To(&is_accessor)) {
+        return Nothing<bool>();
+      }
+      if (is_accessor)
+        return Just(false);
+      Local<Value> value;
+      if (!object->Get(context, key).ToLocal(&value))
+        return Nothing<bool>();
+      writer.WriteString(isolate, key.As<String>());
+      if (!writer.WritePrimitive(isolate, value))
+        return Just(false);
+    }
+  } else {
+    return Just(false);
+  }
+
+  MaybeStackBuffer<char, 256>* payload = writer.buffer();
+  size_t size = payload->length();
+  if (size <= kInlinePayloadSize) {
+    memcpy(inline_payload_, payload->out(), size);
+    inline_payload_size_ = size;
+  } else if (payload->IsAllocated()) {
+    main_message_buf_ = MallocedBuffer<char>(payload->out(), size);
+    payload->Release();
+  } else {
+    main_message_buf_ = MallocedBuffer<char>(size);
+    memcpy(main_message_buf_.data, payload->out(), size);
+  }
+  is_fast_ = true;
+  return Just(true);
+}
+
+MaybeLocal<Value> Message::DeserializeFast(Environment* env,
+                                           Local<Context> context) {
+  Isolate* isolate = env->isolate();
+  FastMessageReader reader =
+      main_message_buf_.is_empty()
+          ? FastMessageReader(inline_payload_, inline_payload_size_)
+          : FastMessageReader(main_message_buf_.data, main_message_buf_.size);
+  FastTag tag = reader.ReadTag();
+  if (tag != FastTag::kArray &&
+      tag != FastTag::kObject &&
+      tag != FastTag::kTypedArray) {
+    return reader.ReadPrimitive(isolate, tag);
+  }
+
+  // Objects are created in the current Context. Usually, the caller has
+  // entered `context` already.
+  EscapableHandleScope handle_scope(isolate);
+  std::optional<Context::Scope> context_scope;
+  if (isolate->GetCurrentContext() != context)
+    context_scope.emplace(context);
+
+  Local<Value> result;
+  switch (tag) {
+    case FastTag::kArray: {
+      uint32_t length = reader.ReadRaw<uint32_t>();
+      MaybeStackBuffer<Local<Value>, kMaxFastEntries> elements(length);
+      for (uint32_t i = 0; i < length; i++) {
+        if (!reader.ReadPrimitive(isolate, reader.ReadTag())
+                 .ToLocal(&elements[i])) {
+          return {};
+        }
+      }
+      result = Array::New(isolate, elements.out(), length);
+      break;
+    }
+    case FastTag::kObject: {
+      uint32_t count = reader.ReadRaw<uint32_t>();
+      Local<Object> object = Object::New(isolate);
+      for (uint32_t i = 0; i < count; i++) {
+        // Internalized keys let objects of the same shape share their map.
+        Local<String> key;
+        Local<Value> value;
+        if (!reader.ReadString(isolate, reader.ReadTag(),
+                               NewStringType::kInternalized).ToLocal(&key) ||
+            !reader.ReadPrimitive(isolate, reader.ReadTag()).ToLocal(&value) ||
+            object->CreateDataProperty(context, key, value).IsNothing()) {
+          return {};
+        }
+      }
+      result = object;
+      break;
+    }
+    case FastTag::kTypedArray: {
+      FastTypedArrayType type = reader.ReadRaw<FastTypedArrayType>();
+      size_t byte_offset = reader.ReadRaw<size_t>();
+      size_t length = reader.ReadRaw<size_t>();
+      size_t byte_length = reader.ReadRaw<size_t>();
+      std::unique_ptr<BackingStore> store =
+          ArrayBuffer::NewBackingStore(isolate, byte_length);
+      memcpy(store->Data(), reader.Read(byte_length), byte_length);
+      Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, std::move(store));
+      switch (type) {
+#define V(Type)                                                               \
+        case FastTypedArrayType::k##Type:                                     \
+          result = v8::Type::New(buffer, byte_offset, length);                \
+          break;
+        FAST_TYPED_ARRAY_TYPES(V)
+#undef V
+      }
+      break;
+    }
+    default:
+      UNREACHABLE();
+  }
+  return handle_scope.Escape(result);
 }
 
 namespace {
@@ -128,9 +549,11 @@ class DeserializerDelegate : public ValueDeserializer::Delegate {
 MaybeLocal<Value> Message::Deserialize(Environment* env,
                                        Local<Context> context,
                                        Local<Value>* port_list) {
-  Context::Scope context_scope(context);
-
   CHECK(!IsCloseMessage());
+  if (is_fast_)
+    return DeserializeFast(env, context);
+
+  Context::Scope context_scope(context);
   if (port_list != nullptr && !transferables_.empty()) {
     // Need to create this outside of the EscapableHandleScope, but inside
     // the Context::Scope.
@@ -413,6 +836,15 @@ Maybe<bool> Message::Serialize(Environment* env,
 
   // Verify that we're not silently overwriting an existing message.
   CHECK(main_message_buf_.is_empty());
+  CHECK(!is_fast_);
+
+  if (transfer_list_v.length() == 0) {
+    bool serialized;
+    if (!SerializeFast(env, context, input).To(&serialized))
+      return Nothing<bool>();
+    if (serialized)
+      return Just(true);
+  }
 
   SerializerDelegate delegate(env, context, this);
   ValueSerializer serializer(env->isolate(), &delegate);
@@ -538,6 +970,90 @@ void Message::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("transferables", transferables_);
 }
 
+// Up to this many unused queue nodes are kept around per thread.
+static constexpr size_t kMaxCachedQueueNodes = 256;
+
+// Set once the cache of the current thread is gone. Queues may still be
+// destroyed after that, e.g. during process teardown.
+static thread_local bool queue_node_cache_destroyed = false;
+
+struct IncomingMessageQueue::NodeCache {
+  ~NodeCache() {
+    queue_node_cache_destroyed = true;
+    for (Node* node : nodes)
+      delete node;
+  }
+
+  std::vector<Node*> nodes;
+};
+
+thread_local IncomingMessageQueue::NodeCache IncomingMessageQueue::node_cache_;
+
+IncomingMessageQueue::Node* IncomingMessageQueue::NewNode(
+    std::shared_ptr<Message> message) {
+  Node* node;
+  if (queue_node_cache_destroyed || node_cache_.nodes.empty()) {
+    node = new Node();
+  } else {
+    node = node_cache_.nodes.back();
+    node_cache_.nodes.pop_back();
+  }
+  node->next.store(nullptr, std::memory_order_relaxed);
+  node->message = std::move(message);
+  return node;
+}
+
+void IncomingMessageQueue::DeleteNode(Node* node) {
+  node->message.reset();
+  if (!queue_node_cache_destroyed &&
+      node_cache_.nodes.size() < kMaxCachedQueueNodes) {
+    node_cache_.nodes.push_back(node);
+  } else {
+    delete node;
+  }
+}
+
+IncomingMessageQueue::IncomingMessageQueue()
+    : head_(NewNode({})), tail_(head_.load()) {}
+
+IncomingMessageQueue::~IncomingMessageQueue() {
+  while (Pop()) {}
+  CHECK_EQ(tail_, head_.load());
+  DeleteNode(tail_);
+}
+
+void IncomingMessageQueue::Push(std::shared_ptr<Message> message) {
+  Node* node = NewNode(std::move(message));
+  size_.fetch_add(1, std::memory_order_relaxed);
+  Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+  // Until this store, the consumer sees the queue end at `prev`.
+  prev->next.store(node, std::memory_order_release);
+}
+
+Message* IncomingMessageQueue::Peek() const {
+  Node* next = tail_->next.load(std::memory_order_acquire);
+  return next != nullptr ? next->message.get() : nullptr;
+}
+
+std::shared_ptr<Message> IncomingMessageQueue::Pop() {
+  Node* next = tail_->next.load(std::memory_order_acquire);
+  if (next == nullptr)
+    return {};
+  std::shared_ptr<Message> message = std::move(next->message);
+  DeleteNode(tail_);
+  tail_ = next;
+  size_.fetch_sub(1, std::memory_order_relaxed);
+  return message;
+}
+
+void IncomingMessageQueue::MemoryInfo(MemoryTracker* tracker) const {
+  for (Node* node = tail_->next.load(std::memory_order_acquire);
+       node != nullptr;
+       node = node->next.load(std::memory_order_acquire)) {
+    tracker->TrackField("message", node->message);
+  }
+}
+
 MessagePortData::MessagePortData(MessagePort* owner)
     : owner_(owner) {
 }
@@ -548,21 +1064,31 @@ MessagePortData::~MessagePortData() {
 }
 
 void MessagePortData::MemoryInfo(MemoryTracker* tracker) const {
-  Mutex::ScopedLock lock(mutex_);
   tracker->TrackField("incoming_messages", incoming_messages_);
 }
 
 void MessagePortData::AddToIncomingQueue(std::shared_ptr<Message> message) {
   // This function will be called by other threads.
-  Mutex::ScopedLock lock(mutex_);
-  incoming_messages_.emplace_back(std::move(message));
+  incoming_messages_.Push(std::move(message));
+
+  // Pairs with the fence in ResetWakeup(): either the receiver sees the new
+  // message, or we see that it needs to be woken up again.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (wakeup_pending_.exchange(true))
+    return;
 
+  Mutex::ScopedLock lock(mutex_);
   if (owner_ != nullptr) {
     Debug(owner_, "Adding message to incoming queue");
     owner_->TriggerAsync();
   }
 }
 
+void MessagePortData::ResetWakeup() {
+  wakeup_pending_.store(false, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
 void MessagePortData::Entangle(MessagePortData* a, MessagePortData* b) {
   auto group = std::make_shared<SiblingGroup>();
   group->Entangle({a, b});
@@ -692,9 +1218,8 @@ MaybeLocal<Value> MessagePort::ReceiveMessage(Local<Context> context,
                                               Local<Value>* port_list) {
   std::shared_ptr<Message> received;
   {
-    // Get the head of the message queue.
-    Mutex::ScopedLock lock(data_->mutex_);
-
+    // Get the head of the message queue. Only this thread removes messages
+    // from it, so no lock is needed.
     Debug(this, "MessagePort has message");
 
     bool wants_message =
@@ -704,14 +1229,11 @@ MaybeLocal<Value> MessagePort::ReceiveMessage(Local<Context> context,
     // - There are no pending messages
     // - We are not intending to receive messages, and the message we would
     //   receive is not the final "close" message.
-    if (data_->incoming_messages_.empty() ||
-        (!wants_message &&
-         !data_->incoming_messages_.front()->IsCloseMessage())) {
+    Message* front = data_->incoming_messages_.Peek();
+    if (front == nullptr || (!wants_message && !front->IsCloseMessage()))
       return env()->no_message_symbol();
-    }
 
-    received = data_->incoming_messages_.front();
-    data_->incoming_messages_.pop_front();
+    received = data_->incoming_messages_.Pop();
   }
 
   if (received->IsCloseMessage()) {
@@ -730,9 +1252,11 @@ void MessagePort::OnMessage(MessageProcessingMode mode) {
   Local<Context> context =
       object(env()->isolate())->GetCreationContext().ToLocalChecked();
 
+  if (data_)
+    data_->ResetWakeup();
+
   size_t processing_limit;
   if (mode == MessageProcessingMode::kNormalOperation) {
-    Mutex::ScopedLock(data_->mutex_);
     processing_limit = std::max(data_->incoming_messages_.size(),
                                 static_cast<size_t>(1000));
   } else {
@@ -994,7 +1518,6 @@ void MessagePort::PostMessage(const FunctionCallbackInfo<Value>& args) {
 void MessagePort::Start() {
   Debug(this, "Start receiving messages");
   receiving_messages_ = true;
-  Mutex::ScopedLock lock(data_->mutex_);
   if (!data_->incoming_messages_.empty())
     TriggerAsync();
 }
@@ -6,7 +6,7 @@
 #include "env.h"
 #include "node_mutex.h"
 #include "v8.h"
-#include <deque>
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <set>
@@ -106,7 +106,24 @@ class Message : public MemoryRetainer {
   SET_SELF_SIZE(Message)
 
  private:
+  // Messages without a transfer list that consist of a single primitive, a
+  // flat object or array of primitives, or a single typed array use a compact
+  // encoding instead of the one of v8::ValueSerializer. Returns Just(false)
+  // if `input` is not one of those.
+  v8::Maybe<bool> SerializeFast(Environment* env,
+                                v8::Local<v8::Context> context,
+                                v8::Local<v8::Value> input);
+  v8::MaybeLocal<v8::Value> DeserializeFast(Environment* env,
+                                            v8::Local<v8::Context> context);
+
+  // Compactly encoded payloads up to this size are stored inline, larger
+  // ones in main_message_buf_.
+  static constexpr size_t kInlinePayloadSize = 64;
+
   MallocedBuffer<char> main_message_buf_;
+  bool is_fast_ = false;
+  size_t inline_payload_size_ = 0;
+  char inline_payload_[kInlinePayloadSize];
   // TODO(addaleax): Make this a std::variant to save storage size in the common
   // case (which is that all of these vectors are empty) once that is available
   // with C++17.
@@ -163,6 +180,56 @@ class SiblingGroup final : public std::enable_shared_from_this<SiblingGroup> {
   static Map groups_;
 };
 
+// The queue of messages that have been sent to a MessagePort but not received
+// yet. Any thread may push messages without taking a lock. Only the thread that
+// currently owns the receiving port may look at or pop messages.
+// Queue nodes are recycled through small per-thread caches. When two threads
+// exchange messages, each reuses the nodes of the messages it received for
+// the messages it sends, so steady traffic does not allocate.
+class IncomingMessageQueue final : public MemoryRetainer {
+ public:
+  IncomingMessageQueue();
+  ~IncomingMessageQueue() override;
+
+  IncomingMessageQueue(const IncomingMessageQueue&) = delete;
+  IncomingMessageQueue& operator=(const IncomingMessageQueue&) = delete;
+
+  // This may be called from any thread.
+  void Push(std::shared_ptr<Message> message);
+
+  // The oldest message, or nullptr if there is none.
+  Message* Peek() const;
+  // Removes the oldest message, or returns an empty pointer if there is none.
+  std::shared_ptr<Message> Pop();
+  bool empty() const { return Peek() == nullptr; }
+  // This may be called from any thread, and may already include messages
+  // that are still in the process of being pushed.
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(IncomingMessageQueue)
+  SET_SELF_SIZE(IncomingMessageQueue)
+
+ private:
+  struct Node {
+    std::atomic<Node*> next;
+    std::shared_ptr<Message> message;
+  };
+  struct NodeCache;
+  static thread_local NodeCache node_cache_;
+
+  static Node* NewNode(std::shared_ptr<Message> message);
+  static void DeleteNode(Node* node);
+
+  // The most recently pushed node. Producers swap themselves in here and then
+  // link the previous node to themselves.
+  std::atomic<Node*> head_;
+  // A node whose message has already been popped, followed by the oldest
+  // message in the queue.
+  Node* tail_;
+  std::atomic<size_t> size_ {0};
+};
+
 // This contains all data for a `MessagePort` instance that is not tied to
 // a specific Environment/Isolate/event loop, for easier transfer between those.
 class MessagePortData : public TransferData {
@@ -175,7 +242,8 @@ class MessagePortData : public TransferData {
   MessagePortData(const MessagePortData& other) = delete;
   MessagePortData& operator=(const MessagePortData& other) = delete;
 
-  // Add a message to the incoming queue and notify the receiver.
+  // Add a message to the incoming queue and notify the receiver, unless it
+  // already has a notification pending.
   // This may be called from any thread.
   void AddToIncomingQueue(std::shared_ptr<Message> message);
   v8::Maybe<bool> Dispatch(
@@ -202,13 +270,20 @@ class MessagePortData : public TransferData {
   SET_SELF_SIZE(MessagePortData)
 
  private:
-  // This mutex protects all fields below it, with the exception of
-  // sibling_.
-  mutable Mutex mutex_;
+  // Called by the receiving side before it looks at the queue. Messages that
+  // are added after this notify the receiver again.
+  void ResetWakeup();
+
   // TODO(addaleax): Make this a std::variant<std::shared_ptr, std::unique_ptr>
   // once that is available with C++17, because std::shared_ptr comes with
   // overhead that is only necessary for BroadcastChannel.
-  std::deque<std::shared_ptr<Message>> incoming_messages_;
+  IncomingMessageQueue incoming_messages_;
+  // Whether the owner has been notified of new messages since it last
+  // called ResetWakeup().
+  std::atomic<bool> wakeup_pending_ {false};
+  // This mutex protects all fields below it, with the exception of
+  // sibling_.
+  mutable Mutex mutex_;
   MessagePort* owner_ = nullptr;
   std::shared_ptr<SiblingGroup> group_;
   friend class MessagePort;
@@ -362,6 +362,14 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "experimental ES Module support for webassembly modules",
             &EnvironmentOptions::experimental_wasm_modules,
             kAllowedInEnvironment);
+  AddOption("--experimental-compile-cache",
+            "cache the code compiled for CommonJS and ES modules in a file",
+            &EnvironmentOptions::experimental_compile_cache,
+            kAllowedInEnvironment);
+  AddOption("--experimental-fs-io-uring",
+            "run asynchronous file system operations on io_uring on Linux",
+            &EnvironmentOptions::experimental_fs_io_uring,
+            kAllowedInEnvironment);
   AddOption("--experimental-import-meta-resolve",
             "experimental ES Module import.meta.resolve() support",
             &EnvironmentOptions::experimental_import_meta_resolve,
@@ -385,6 +393,10 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             &EnvironmentOptions::experimental_repl_await,
             kAllowedInEnvironment,
             true);
+  AddOption("--experimental-resolution-cache",
+            "cache the files that require() resolved to in a file",
+            &EnvironmentOptions::experimental_resolution_cache,
+            kAllowedInEnvironment);
   AddOption("--experimental-vm-modules",
             "experimental ES Module support in vm module",
             &EnvironmentOptions::experimental_vm_modules,
@@ -755,6 +767,11 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "set V8's thread pool size",
             &PerProcessOptions::v8_thread_pool_size,
             kAllowedInEnvironment);
+  AddOption("--experimental-idle-tasks",
+            "run V8 idle tasks and garbage collection work while the event "
+            "loop is idle",
+            &PerProcessOptions::experimental_idle_tasks,
+            kAllowedInEnvironment);
   AddOption("--zero-fill-buffers",
             "automatically zero-fill all newly allocated Buffer and "
             "SlowBuffer instances",
@@ -107,7 +107,9 @@ class EnvironmentOptions : public Options {
   std::vector<std::string> conditions;
   std::string dns_result_order;
   bool enable_source_maps = false;
+  std::string experimental_compile_cache;
   bool experimental_fetch = true;
+  bool experimental_fs_io_uring = false;
   bool experimental_global_customevent = false;
   bool experimental_global_web_crypto = false;
   bool experimental_https_modules = false;
@@ -119,6 +121,7 @@ class EnvironmentOptions : public Options {
   std::string experimental_policy_integrity;
   bool has_policy_integrity_string = false;
   bool experimental_repl_await = true;
+  std::string experimental_resolution_cache;
   bool experimental_vm_modules = false;
   bool expose_internals = false;
   bool force_node_api_uncaught_exceptions_policy = false;
@@ -232,6 +235,7 @@ class PerProcessOptions : public Options {
   std::string trace_event_categories;
   std::string trace_event_file_pattern = "node_trace.${rotation}.log";
   int64_t v8_thread_pool_size = 4;
+  bool experimental_idle_tasks = false;
   bool zero_fill_all_buffers = false;
   bool debug_arraybuffer_allocations = false;
   std::string disable_proto;
@@ -0,0 +1,352 @@
+#include "node_package_json.h"
+#include "node_mutex.h"
+#include "util.h"
+#include "uv.h"
+
+#include <sys/stat.h>
+
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace node {
+namespace package_json {
+
+namespace {
+
+constexpr struct {
+  const char* name;
+  size_t length;
+} kFieldNames[PackageJson::kFieldCount] = {
+  {"name", 4},
+  {"main", 4},
+  {"type", 4},
+  {"exports", 7},
+  {"imports", 7},
+};
+
+// A validating JSON parser that only looks at the keys of the top-level
+// object. It accepts exactly what JSON.parse() accepts, so that files are
+// only handed to JS for the error message when JSON.parse() would throw.
+class Parser {
+ public:
+  Parser(const char* begin, const char* end) : p_(begin), end_(end) {}
+
+  bool ParseTopLevelObject(PackageJson* result) {
+    SkipWhitespace();
+    if (Peek() != '{') return false;
+    p_++;
+    SkipWhitespace();
+    if (Peek() == '}') {
+      p_++;
+    } else {
+      for (;;) {
+        const char* key = p_ + 1;
+        bool key_has_escapes;
+        if (Peek() != '"' || !SkipString(&key_has_escapes)) return false;
+        const size_t key_length = p_ - 1 - key;
+        // Keys could only match a field name after unescaping them.
+        if (key_has_escapes) return false;
+
+        SkipWhitespace();
+        if (Peek() != ':') return false;
+        p_++;
+        SkipWhitespace();
+
+        const char* value = p_;
+        bool value_has_escapes = false;
+        const bool is_string = Peek() == '"';
+        if (is_string ? !SkipString(&value_has_escapes) : !SkipValue())
+          return false;
+
+        for (size_t i = 0; i < arraysize(kFieldNames); i++) {
+          if (key_length != kFieldNames[i].length ||
+              memcmp(key, kFieldNames[i].name, key_length) != 0) {
+            continue;
+          }
+          // Like with JSON.parse(), the last occurrence of a key wins.
+          PackageJson::Value* field = &result->fields[i];
+          field->present = true;
+          field->is_json = !is_string || value_has_escapes ||
+                           i == PackageJson::kExports ||
+                           i == PackageJson::kImports;
+          if (field->is_json) {
+            field->text.assign(value, p_ - value);
+          } else {
+            field->text.assign(value + 1, p_ - value - 2);
+          }
+          break;
+        }
+
+        SkipWhitespace();
+        if (Peek() == ',') {
+          p_++;
+          SkipWhitespace();
+          continue;
+        }
+        if (Peek() != '}') return false;
+        p_++;
+        break;
+      }
+    }
+    SkipWhitespace();
+    return p_ == end_;
+  }
+
+ private:
+  // Returns '\0' at the end of the input, which is never valid where a token
+  // is expected, and not allowed unescaped in strings.
+  char Peek() const { return p_ < end_ ? *p_ : '\0'; }
+
+  void SkipWhitespace() {
+    while (p_ < end_ &&
+           (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) {
+      p_++;
+    }
+  }
+
+  static bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+  static bool IsHexDigit(char c) {
+    return IsDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+  }
+
+  bool SkipString(bool* has_escapes) {
+    *has_escapes = false;
+    p_++;  // Opening quote.
+    for (;;) {
+      const unsigned char c = Peek();
+      if (c == '"') {
+        p_++;
+        return true;
+      }
+      if (c < 0x20) return false;
+      p_++;
+      if (c != '\\') continue;
+
+      *has_escapes = true;
+      switch (Peek()) {
+        case '"': case '\\': case '/':
+        case 'b': case 'f': case 'n': case 'r': case 't':
+          p_++;
+          break;
+        case 'u':
+          p_++;
+          for (int i = 0; i < 4; i++) {
+            if (!IsHexDigit(Peek())) return false;
+            p_++;
+          }
+          break;
+        default:
+          return false;
+      }
+    }
+  }
+
+  bool SkipDigits() {
+    if (!IsDigit(Peek())) return false;
+    while (IsDigit(Peek())) p_++;
+    return true;
+  }
+
+  bool SkipNumber() {
+    if (Peek() == '-') p_++;
+    if (Peek() == '0') {
+      p_++;
+    } else if (!SkipDigits()) {
+      return false;
+    }
+    if (Peek() == '.') {
+      p_++;
+      if (!SkipDigits()) return false;
+    }
+    if (Peek() == 'e' || Peek() == 'E') {
+      p_++;
+      if (Peek() == '+' || Peek() == '-') p_++;
+      if (!SkipDigits()) return false;
+    }
+    return true;
+  }
+
+  bool SkipLiteral(const char* literal, size_t length) {
+    if (static_cast<size_t>(end_ - p_) < length ||
+        memcmp(p_, literal, length) != 0) {
+      return false;
+    }
+    p_ += length;
+    return true;
+  }
+
+  // Skips a key and the colon that follows it, inside an object.
+  bool SkipKey() {
+    bool has_escapes;
+    if (Peek() != '"' || !SkipString(&has_escapes)) return false;
+    SkipWhitespace();
+    if (Peek() != ':') return false;
+    p_++;
+    return true;
+  }
+
+  // Skips any value without recursing, so that deeply nested values cannot
+  // exhaust the stack.
+  bool SkipValue() {
+    std::vector<char> open;
+    for (;;) {
+      SkipWhitespace();
+      switch (Peek()) {
+        case '{':
+          p_++;
+          SkipWhitespace();
+          if (Peek() == '}') {
+            p_++;
+            break;
+          }
+          open.push_back('}');
+          if (!SkipKey()) return false;
+          continue;
+        case '[':
+          p_++;
+          SkipWhitespace();
+          if (Peek() == ']') {
+            p_++;
+            break;
+          }
+          open.push_back(']');
+          continue;
+        case '"': {
+          bool has_escapes;
+          if (!SkipString(&has_escapes)) return false;
+          break;
+        }
+        case 't':
+          if (!SkipLiteral("true", 4)) return false;
+          break;
+        case 'f':
+          if (!SkipLiteral("false", 5)) return false;
+          break;
+        case 'n':
+          if (!SkipLiteral("null", 4)) return false;
+          break;
+        default:
+          if (!SkipNumber()) return false;
+          break;
+      }
+
+      // A complete value was skipped, close all containers that end here.
+      for (;;) {
+        if (open.empty()) return true;
+        SkipWhitespace();
+        if (Peek() == open.back()) {
+          p_++;
+          open.pop_back();
+          continue;
+        }
+        if (Peek() != ',') return false;
+        p_++;
+        if (open.back() == '}') {
+          SkipWhitespace();
+          if (!SkipKey()) return false;
+        }
+        break;
+      }
+    }
+  }
+
+  const char* p_;
+  const char* const end_;
+};
+
+struct CacheEntry {
+  uint64_t size;
+  uint64_t inode;
+  uv_timespec_t mtime;
+  std::shared_ptr<const PackageJson> package_json;
+};
+
+Mutex cache_mutex;
+std::unordered_map<std::string, CacheEntry> cache;
+
+}  // anonymous namespace
+
+bool ContainsKeys(const char* begin, const char* end) {
+  const char* p = begin;
+  const char* key = nullptr;
+  while (p < end) {
+    const char c = *p++;
+    if (c == '\\' && p < end && *p == '"') p++;
+    if (c != '"') continue;
+    if (key == nullptr) {
+      key = p;
+      continue;
+    }
+    const size_t length = p - 1 - key;  // Exclude the closing quote.
+    for (const auto& field : kFieldNames) {
+      if (length == field.length && memcmp(key, field.name, length) == 0)
+        return true;
+    }
+    key = nullptr;
+  }
+  return false;
+}
+
+bool Parse(const char* begin, const char* end, PackageJson* result) {
+  Parser parser(begin, end);
+  result->parsed = parser.ParseTopLevelObject(result);
+  result->contains_keys = false;
+  for (PackageJson::Value& field : result->fields) {
+    if (!result->parsed) field = PackageJson::Value();
+    result->contains_keys = result->contains_keys || field.present;
+  }
+  if (!result->parsed) {
+    result->source.assign(begin, end - begin);
+    result->contains_keys = ContainsKeys(begin, end);
+  }
+  return result->parsed;
+}
+
+std::shared_ptr<const PackageJson> Read(const std::string& path) {
+  uv_fs_t req;
+  int err = uv_fs_stat(nullptr, &req, path.c_str(), nullptr);
+  CacheEntry entry;
+  if (err == 0) {
+    const uv_stat_t* const s = static_cast<const uv_stat_t*>(req.ptr);
+    entry.size = s->st_size;
+    entry.inode = s->st_ino;
+    entry.mtime = s->st_mtim;
+    if ((s->st_mode & S_IFMT) == S_IFDIR) err = UV_EISDIR;
+  }
+  uv_fs_req_cleanup(&req);
+  if (err != 0) return nullptr;
+
+  {
+    Mutex::ScopedLock lock(cache_mutex);
+    auto it = cache.find(path);
+    if (it != cache.end() &&
+        it->second.size == entry.size &&
+        it->second.inode == entry.inode &&
+        it->second.mtime.tv_sec == entry.mtime.tv_sec &&
+        it->second.mtime.tv_nsec == entry.mtime.tv_nsec) {
+      return it->second.package_json;
+    }
+  }
+
+  std::string contents;
+  if (ReadFileSync(&contents, path.c_str()) != 0) return nullptr;
+
+  const char* begin = contents.data();
+  const char* end = begin + contents.size();
+  if (contents.size() >= 3 && memcmp(begin, "\xEF\xBB\xBF", 3) == 0)
+    begin += 3;  // Skip UTF-8 BOM.
+
+  auto package_json = std::make_shared<PackageJson>();
+  Parse(begin, end, package_json.get());
+  entry.package_json = package_json;
+
+  Mutex::ScopedLock lock(cache_mutex);
+  cache[path] = std::move(entry);
+  return package_json;
+}
+
+}  // namespace package_json
+}  // namespace node
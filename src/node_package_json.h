@@ -0,0 +1,53 @@
+#ifndef SRC_NODE_PACKAGE_JSON_H_
+#define SRC_NODE_PACKAGE_JSON_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <memory>
+#include <string>
+
+namespace node {
+namespace package_json {
+
+// The fields of a package.json file that module resolution looks at.
+struct PackageJson {
+  enum Field { kName, kMain, kType, kExports, kImports, kFieldCount };
+
+  struct Value {
+    bool present = false;
+    // Whether `text` is JSON text that still needs to be parsed, or the
+    // contents of a string without escape sequences.
+    bool is_json = false;
+    std::string text;
+  };
+
+  // False if the file is not valid JSON, or does not contain an object at the
+  // top level. In that case `source` holds its contents, so that JS can handle
+  // it like before, e.g. to report the parse error.
+  bool parsed = false;
+  std::string source;
+  // Whether one of the names of the fields appears anywhere in the file.
+  bool contains_keys = false;
+  Value fields[kFieldCount];
+};
+
+// Returns whether one of the names of the fields appears in quotes anywhere
+// in the text, as a quick check for files that cannot be parsed.
+bool ContainsKeys(const char* begin, const char* end);
+
+// Validates `begin` to `end` as JSON and extracts the fields from the
+// top-level object, without building a representation of the rest.
+bool Parse(const char* begin, const char* end, PackageJson* result);
+
+// Reads and parses a package.json file, and returns nullptr if it cannot be
+// read. Results are cached in a table that is shared by all threads of the
+// process, and are reused as long as the size, modification time and inode
+// of the file are unchanged.
+std::shared_ptr<const PackageJson> Read(const std::string& path);
+
+}  // namespace package_json
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_PACKAGE_JSON_H_
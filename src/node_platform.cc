@@ -5,52 +5,105 @@
 #include "debug_utils-inl.h"
 #include <algorithm>  // find_if(), find(), move()
 #include <cmath>  // llround()
+#include <deque>
 #include <memory>  // unique_ptr(), shared_ptr(), make_shared()
 
+#ifndef _WIN32
+#include <poll.h>  // poll()
+#endif
+
 namespace node {
 
 using v8::Isolate;
 using v8::Object;
 using v8::Platform;
 using v8::Task;
+using v8::TaskPriority;
 
 namespace {
 
 struct PlatformWorkerData {
-  TaskQueue<Task>* task_queue;
+  WorkerThreadsTaskRunner* runner;
   Mutex* platform_workers_mutex;
   ConditionVariable* platform_workers_ready;
   int* pending_platform_workers;
-  int id;
+  size_t id;
 };
 
-static void PlatformWorkerThread(void* data) {
-  std::unique_ptr<PlatformWorkerData>
-      worker_data(static_cast<PlatformWorkerData*>(data));
+// Idle periods are capped so that idle tasks cannot delay the handling of I/O
+// that arrives unexpectedly by too much. 50 ms is what browsers use, too.
+constexpr double kMaxIdlePeriodMs = 50;
+// Shorter idle periods are not worth waking up idle tasks for.
+constexpr double kMinIdlePeriodMs = 1;
 
-  TaskQueue<Task>* pending_worker_tasks = worker_data->task_queue;
-  TRACE_EVENT_METADATA1("__metadata", "thread_name", "name",
-                        "PlatformWorkerThread");
+constexpr size_t kNumTaskPriorities =
+    static_cast<size_t>(TaskPriority::kMaxPriority) + 1;
 
-  // Notify the main thread that the platform worker is ready.
-  {
-    Mutex::ScopedLock lock(*worker_data->platform_workers_mutex);
-    (*worker_data->pending_platform_workers)--;
-    worker_data->platform_workers_ready->Signal(lock);
+// The queue that belongs to the platform worker running on this thread, if
+// any. Used to keep tasks posted by a worker on the same thread.
+struct CurrentWorker {
+  const WorkerThreadsTaskRunner* runner;
+  size_t index;
+};
+thread_local CurrentWorker current_worker = { nullptr, 0 };
+
+}  // namespace
+
+// One queue per worker thread, with a separate FIFO for each task priority.
+// The sizes can be read without taking the lock, so that workers looking for
+// tasks to steal can skip empty queues cheaply.
+class WorkerThreadsTaskRunner::WorkerQueue {
+ public:
+  WorkerQueue() {
+    for (size_t i = 0; i < kNumTaskPriorities; i++)
+      sizes_[i] = 0;
+    CHECK_EQ(0, uv_sem_init(&wakeup, 0));
   }
+  ~WorkerQueue() { uv_sem_destroy(&wakeup); }
 
-  while (std::unique_ptr<Task> task = pending_worker_tasks->BlockingPop()) {
-    task->Run();
-    pending_worker_tasks->NotifyOfCompletion();
+  void Push(std::unique_ptr<Task> task, size_t priority) {
+    Mutex::ScopedLock lock(mutex_);
+    tasks_[priority].push_back(std::move(task));
+    sizes_[priority]++;
   }
-}
 
-}  // namespace
+  std::unique_ptr<Task> Pop(size_t priority) {
+    if (Size(priority) == 0)
+      return nullptr;
+    Mutex::ScopedLock lock(mutex_);
+    if (tasks_[priority].empty())
+      return nullptr;
+    std::unique_ptr<Task> task = std::move(tasks_[priority].front());
+    tasks_[priority].pop_front();
+    sizes_[priority]--;
+    return task;
+  }
+
+  size_t Size(size_t priority) const {
+    return sizes_[priority].load(std::memory_order_relaxed);
+  }
+
+  // Only updated by the worker that owns this queue.
+  std::atomic<uint64_t> tasks_run {0};
+  std::atomic<uint64_t> tasks_stolen {0};
+  std::atomic<uint64_t> steal_attempts {0};
+
+  // Set by the owning worker before it waits on `wakeup`. Whoever resets it
+  // posts `wakeup` once, so every worker has its own wakeup call and posting
+  // a task does not need a lock that all workers share.
+  std::atomic<bool> sleeping {false};
+  uv_sem_t wakeup;
+
+ private:
+  Mutex mutex_;
+  std::deque<std::unique_ptr<Task>> tasks_[kNumTaskPriorities];
+  std::atomic<size_t> sizes_[kNumTaskPriorities];
+};
 
 class WorkerThreadsTaskRunner::DelayedTaskScheduler {
  public:
-  explicit DelayedTaskScheduler(TaskQueue<Task>* tasks)
-    : pending_worker_tasks_(tasks) {}
+  explicit DelayedTaskScheduler(WorkerThreadsTaskRunner* runner)
+    : runner_(runner) {}
 
   std::unique_ptr<uv_thread_t> Start() {
     auto start_thread = [](void* data) {
@@ -141,7 +194,7 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   static void RunTask(uv_timer_t* timer) {
     DelayedTaskScheduler* scheduler =
         ContainerOf(&DelayedTaskScheduler::loop_, timer->loop);
-    scheduler->pending_worker_tasks_->Push(scheduler->TakeTimerTask(timer));
+    scheduler->runner_->PostTask(scheduler->TakeTimerTask(timer));
   }
 
   std::unique_ptr<Task> TakeTimerTask(uv_timer_t* timer) {
@@ -155,7 +208,7 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   }
 
   uv_sem_t ready_;
-  TaskQueue<Task>* pending_worker_tasks_;
+  WorkerThreadsTaskRunner* runner_;
 
   TaskQueue<Task> tasks_;
   uv_loop_t loop_;
@@ -170,18 +223,23 @@ WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
   Mutex::ScopedLock lock(platform_workers_mutex);
   int pending_platform_workers = thread_pool_size;
 
-  delayed_task_scheduler_ = std::make_unique<DelayedTaskScheduler>(
-      &pending_worker_tasks_);
+  // Tasks need a queue even if no worker threads can be started.
+  for (int i = 0; i < std::max(thread_pool_size, 1); i++)
+    queues_.emplace_back(std::make_unique<WorkerQueue>());
+
+  delayed_task_scheduler_ = std::make_unique<DelayedTaskScheduler>(this);
   threads_.push_back(delayed_task_scheduler_->Start());
 
   for (int i = 0; i < thread_pool_size; i++) {
     PlatformWorkerData* worker_data = new PlatformWorkerData{
-      &pending_worker_tasks_, &platform_workers_mutex,
-      &platform_workers_ready, &pending_platform_workers, i
+      this, &platform_workers_mutex,
+      &platform_workers_ready, &pending_platform_workers,
+      static_cast<size_t>(i)
     };
     std::unique_ptr<uv_thread_t> t { new uv_thread_t() };
-    if (uv_thread_create(t.get(), PlatformWorkerThread,
-                         worker_data) != 0) {
+    if (uv_thread_create(t.get(), WorkerThread, worker_data) != 0) {
+      delete worker_data;
+      pending_platform_workers -= thread_pool_size - i;
       break;
     }
     threads_.push_back(std::move(t));
@@ -194,8 +252,124 @@ WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
   }
 }
 
-void WorkerThreadsTaskRunner::PostTask(std::unique_ptr<Task> task) {
-  pending_worker_tasks_.Push(std::move(task));
+WorkerThreadsTaskRunner::~WorkerThreadsTaskRunner() = default;
+
+void WorkerThreadsTaskRunner::WorkerThread(void* data) {
+  std::unique_ptr<PlatformWorkerData>
+      worker_data(static_cast<PlatformWorkerData*>(data));
+
+  WorkerThreadsTaskRunner* runner = worker_data->runner;
+  size_t index = worker_data->id;
+  WorkerQueue* queue = runner->queues_[index].get();
+  current_worker = { runner, index };
+  TRACE_EVENT_METADATA1("__metadata", "thread_name", "name",
+                        "PlatformWorkerThread");
+
+  // Notify the main thread that the platform worker is ready.
+  {
+    Mutex::ScopedLock lock(*worker_data->platform_workers_mutex);
+    (*worker_data->pending_platform_workers)--;
+    worker_data->platform_workers_ready->Signal(lock);
+  }
+
+  while (std::unique_ptr<Task> task = runner->NextTask(index)) {
+    task->Run();
+    task.reset();
+    queue->tasks_run.fetch_add(1, std::memory_order_relaxed);
+    runner->NotifyOfCompletion();
+  }
+}
+
+void WorkerThreadsTaskRunner::PostTask(std::unique_ptr<Task> task,
+                                       TaskPriority priority) {
+  // Tasks posted by a worker usually belong to the job or the GC phase it is
+  // working on, so keep them close. Everything else is spread evenly.
+  size_t index;
+  if (current_worker.runner == this) {
+    index = current_worker.index;
+  } else {
+    index = next_queue_.fetch_add(1, std::memory_order_relaxed) %
+            queues_.size();
+  }
+
+  outstanding_tasks_++;
+  queues_[index]->Push(std::move(task), static_cast<size_t>(priority));
+  posted_tasks_++;
+  WakeWorker(index);
+}
+
+// Wakes up one sleeping worker, preferably the owner of queue `index`.
+// A worker marks itself as idle and sleeping before it checks
+// `posted_tasks_` a last time, and this is called after incrementing it, so
+// either the worker sees the new task or it is found here.
+void WorkerThreadsTaskRunner::WakeWorker(size_t index) {
+  if (idle_workers_ == 0)
+    return;
+  for (size_t i = 0; i < queues_.size(); i++) {
+    WorkerQueue* queue = queues_[(index + i) % queues_.size()].get();
+    bool sleeping = true;
+    if (queue->sleeping && queue->sleeping.compare_exchange_strong(sleeping,
+                                                                  false)) {
+      uv_sem_post(&queue->wakeup);
+      return;
+    }
+  }
+}
+
+std::unique_ptr<Task> WorkerThreadsTaskRunner::FindTask(size_t index) {
+  WorkerQueue* own = queues_[index].get();
+  size_t count = queues_.size();
+
+  // A more urgent task that is waiting in another queue is preferred over
+  // a less urgent one in the worker's own queue.
+  for (size_t priority = kNumTaskPriorities; priority-- > 0;) {
+    std::unique_ptr<Task> task = own->Pop(priority);
+    for (size_t i = 1; !task && i < count; i++) {
+      WorkerQueue* victim = queues_[(index + i) % count].get();
+      if (victim->Size(priority) == 0)
+        continue;
+      own->steal_attempts.fetch_add(1, std::memory_order_relaxed);
+      task = victim->Pop(priority);
+      if (task)
+        own->tasks_stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (task)
+      return task;
+  }
+  return nullptr;
+}
+
+std::unique_ptr<Task> WorkerThreadsTaskRunner::NextTask(size_t index) {
+  WorkerQueue* queue = queues_[index].get();
+  while (!stopped_) {
+    // Tasks that were posted while looking may have been taken by other
+    // workers already. Only tasks posted after this point keep the worker
+    // awake, so that it does not keep searching in vain.
+    const uint64_t posted = posted_tasks_;
+    if (std::unique_ptr<Task> task = FindTask(index))
+      return task;
+
+    idle_workers_++;
+    queue->sleeping = true;
+    if (posted_tasks_ != posted || stopped_) {
+      bool sleeping = true;
+      // Unless the wakeup call is on its way already.
+      if (queue->sleeping.compare_exchange_strong(sleeping, false)) {
+        idle_workers_--;
+        continue;
+      }
+    }
+    uv_sem_wait(&queue->wakeup);
+    idle_workers_--;
+  }
+  return nullptr;
+}
+
+void WorkerThreadsTaskRunner::NotifyOfCompletion() {
+  if (--outstanding_tasks_ == 0) {
+    Mutex::ScopedLock lock(drain_mutex_);
+    tasks_drained_.Broadcast(lock);
+  }
 }
 
 void WorkerThreadsTaskRunner::PostDelayedTask(std::unique_ptr<Task> task,
@@ -204,11 +378,18 @@ void WorkerThreadsTaskRunner::PostDelayedTask(std::unique_ptr<Task> task,
 }
 
 void WorkerThreadsTaskRunner::BlockingDrain() {
-  pending_worker_tasks_.BlockingDrain();
+  Mutex::ScopedLock lock(drain_mutex_);
+  while (outstanding_tasks_ > 0)
+    tasks_drained_.Wait(lock);
 }
 
 void WorkerThreadsTaskRunner::Shutdown() {
-  pending_worker_tasks_.Stop();
+  stopped_ = true;
+  for (const auto& queue : queues_) {
+    bool sleeping = true;
+    if (queue->sleeping.compare_exchange_strong(sleeping, false))
+      uv_sem_post(&queue->wakeup);
+  }
   delayed_task_scheduler_->Stop();
   for (size_t i = 0; i < threads_.size(); i++) {
     CHECK_EQ(0, uv_thread_join(threads_[i].get()));
@@ -216,16 +397,58 @@ void WorkerThreadsTaskRunner::Shutdown() {
 }
 
 int WorkerThreadsTaskRunner::NumberOfWorkerThreads() const {
-  return threads_.size();
+  // Don't count the delayed task scheduler, V8 sizes its jobs based on this.
+  return threads_.size() - 1;
+}
+
+PlatformWorkerPoolStats WorkerThreadsTaskRunner::GetStats() const {
+  PlatformWorkerPoolStats stats;
+  for (const auto& queue : queues_) {
+    stats.pending_user_blocking_tasks +=
+        queue->Size(static_cast<size_t>(TaskPriority::kUserBlocking));
+    stats.pending_user_visible_tasks +=
+        queue->Size(static_cast<size_t>(TaskPriority::kUserVisible));
+    stats.pending_best_effort_tasks +=
+        queue->Size(static_cast<size_t>(TaskPriority::kBestEffort));
+  }
+  // The first thread is the delayed task scheduler.
+  for (size_t i = 0; i + 1 < threads_.size(); i++) {
+    PlatformWorkerStats worker;
+    worker.tasks_run = queues_[i]->tasks_run.load(std::memory_order_relaxed);
+    worker.tasks_stolen =
+        queues_[i]->tasks_stolen.load(std::memory_order_relaxed);
+    worker.steal_attempts =
+        queues_[i]->steal_attempts.load(std::memory_order_relaxed);
+    stats.workers.push_back(worker);
+  }
+  return stats;
 }
 
 PerIsolatePlatformData::PerIsolatePlatformData(
-    Isolate* isolate, uv_loop_t* loop)
-  : isolate_(isolate), loop_(loop) {
+    Isolate* isolate, uv_loop_t* loop, bool idle_tasks_enabled)
+  : isolate_(isolate),
+    loop_(loop),
+    idle_tasks_enabled_(idle_tasks_enabled),
+    io_wakeup_interval_ms_(kMaxIdlePeriodMs) {
   flush_tasks_ = new uv_async_t();
   CHECK_EQ(0, uv_async_init(loop, flush_tasks_, FlushTasks));
   flush_tasks_->data = static_cast<void*>(this);
   uv_unref(reinterpret_cast<uv_handle_t*>(flush_tasks_));
+
+  if (idle_tasks_enabled_) {
+    idle_prepare_ = new uv_prepare_t();
+    CHECK_EQ(0, uv_prepare_init(loop, idle_prepare_));
+    idle_prepare_->data = static_cast<void*>(this);
+    CHECK_EQ(0, uv_prepare_start(idle_prepare_, OnLoopPrepare));
+    uv_unref(reinterpret_cast<uv_handle_t*>(idle_prepare_));
+
+    idle_check_ = new uv_check_t();
+    CHECK_EQ(0, uv_check_init(loop, idle_check_));
+    idle_check_->data = static_cast<void*>(this);
+    CHECK_EQ(0, uv_check_start(idle_check_, OnLoopCheck));
+    uv_unref(reinterpret_cast<uv_handle_t*>(idle_check_));
+    uv_handle_count_ += 2;
+  }
 }
 
 std::shared_ptr<v8::TaskRunner>
@@ -239,7 +462,110 @@ void PerIsolatePlatformData::FlushTasks(uv_async_t* handle) {
 }
 
 void PerIsolatePlatformData::PostIdleTask(std::unique_ptr<v8::IdleTask> task) {
-  UNREACHABLE();
+  CHECK(idle_tasks_enabled_);
+  if (flush_tasks_ == nullptr) {
+    // V8 may post tasks during Isolate disposal. In that case, the only
+    // sensible path forward is to discard the task.
+    return;
+  }
+  // Idle tasks are picked up by the next idle period of the event loop, so
+  // there is no need to wake it up.
+  idle_tasks_.Push(std::move(task));
+}
+
+void PerIsolatePlatformData::OnLoopPrepare(uv_prepare_t* handle) {
+  auto platform_data = static_cast<PerIsolatePlatformData*>(handle->data);
+  platform_data->idle_start_ = 0;
+  double deadline_in_seconds = platform_data->EstimateIdleDeadline();
+  if (deadline_in_seconds == 0)
+    return;
+  platform_data->RunIdleTasks(deadline_in_seconds);
+}
+
+void PerIsolatePlatformData::OnLoopCheck(uv_check_t* handle) {
+  auto platform_data = static_cast<PerIsolatePlatformData*>(handle->data);
+  if (platform_data->idle_start_ == 0)
+    return;
+  double idle_ms = (uv_hrtime() - platform_data->idle_start_) / 1e6;
+  int timeout = platform_data->idle_poll_timeout_;
+  double& interval = platform_data->io_wakeup_interval_ms_;
+  // Timers fire with millisecond granularity.
+  if (timeout < 0 || idle_ms + 1 < timeout) {
+    // Something other than a timer ended the idle period early.
+    interval = 0.75 * interval + 0.25 * idle_ms;
+  } else {
+    // The loop slept until the next timer was due without being disturbed,
+    // so I/O is less frequent than estimated.
+    interval = std::min(interval * 2, kMaxIdlePeriodMs);
+  }
+}
+
+// Returns the point in time until which the event loop is expected to stay
+// idle, or 0 if it is not going to be idle for long enough.
+double PerIsolatePlatformData::EstimateIdleDeadline() {
+  // uv_backend_timeout() is 0 if there are callbacks that need to run right
+  // away, and the time until the next timer is due otherwise.
+  int timeout = uv_backend_timeout(loop_);
+  if (timeout == 0)
+    return 0;
+
+#ifndef _WIN32
+  // I/O that is ready already is handled as soon as the loop polls for it.
+  int backend_fd = uv_backend_fd(loop_);
+  if (backend_fd != -1) {
+    struct pollfd pfd = { backend_fd, POLLIN, 0 };
+    if (poll(&pfd, 1, 0) != 0)
+      return 0;
+  }
+#endif
+
+  uint64_t now = uv_hrtime();
+  idle_start_ = now;
+  idle_poll_timeout_ = timeout;
+
+  // I/O may still arrive at any time. Guess when from how long the loop
+  // stayed idle recently.
+  double idle_ms = std::min(kMaxIdlePeriodMs, io_wakeup_interval_ms_);
+  if (timeout > 0)
+    idle_ms = std::min(idle_ms, static_cast<double>(timeout));
+  if (idle_ms < kMinIdlePeriodMs)
+    return 0;
+  return now / 1e9 + idle_ms / 1e3;
+}
+
+void PerIsolatePlatformData::RunIdleTasks(double deadline_in_seconds) {
+  // Tasks that are posted while running idle tasks wait for the next idle
+  // period, like foreground tasks do.
+  std::queue<std::unique_ptr<v8::IdleTask>> tasks = idle_tasks_.PopAll();
+  // Without idle tasks, V8 has not asked for any idle time work, and giving
+  // it the idle period anyway would only make it start such work on its own.
+  if (tasks.empty())
+    return;
+  if (UNLIKELY(per_process::enabled_debug_list.enabled(
+          DebugCategory::IDLE_TASKS))) {
+    per_process::Debug(DebugCategory::IDLE_TASKS,
+                       "Idle period of %d ms, running %d idle tasks\n",
+                       llround((deadline_in_seconds - uv_hrtime() / 1e9) * 1e3),
+                       tasks.size());
+  }
+  DebugSealHandleScope scope(isolate_);
+  while (!tasks.empty()) {
+    if (uv_hrtime() / 1e9 >= deadline_in_seconds) {
+      // Out of time, keep the rest for the next idle period.
+      while (!tasks.empty()) {
+        idle_tasks_.Push(std::move(tasks.front()));
+        tasks.pop();
+      }
+      return;
+    }
+    std::unique_ptr<v8::IdleTask> task = std::move(tasks.front());
+    tasks.pop();
+    task->Run(deadline_in_seconds);
+  }
+  // Use what is left of the idle period for garbage collection work that V8
+  // did not post a task for, such as finishing incremental marking.
+  if (uv_hrtime() / 1e9 < deadline_in_seconds)
+    isolate_->IdleNotificationDeadline(deadline_in_seconds);
 }
 
 void PerIsolatePlatformData::PostTask(std::unique_ptr<Task> task) {
@@ -296,6 +622,7 @@ void PerIsolatePlatformData::Shutdown() {
   // effectively deleting the tasks instead of running them.
   foreground_delayed_tasks_.PopAll();
   foreground_tasks_.PopAll();
+  idle_tasks_.PopAll();
   scheduled_delayed_tasks_.clear();
 
   // Both destroying the scheduled_delayed_tasks_ lists and closing
@@ -303,14 +630,30 @@ void PerIsolatePlatformData::Shutdown() {
   // non-closed handles, and when that reaches zero, we inform any shutdown
   // callbacks that the platform is done as far as this Isolate is concerned.
   self_reference_ = shared_from_this();
+  if (idle_tasks_enabled_) {
+    uv_close(reinterpret_cast<uv_handle_t*>(idle_prepare_),
+             [](uv_handle_t* handle) {
+      std::unique_ptr<uv_prepare_t> idle_prepare {
+          reinterpret_cast<uv_prepare_t*>(handle) };
+      static_cast<PerIsolatePlatformData*>(idle_prepare->data)
+          ->DecreaseHandleCount();
+    });
+    uv_close(reinterpret_cast<uv_handle_t*>(idle_check_),
+             [](uv_handle_t* handle) {
+      std::unique_ptr<uv_check_t> idle_check {
+          reinterpret_cast<uv_check_t*>(handle) };
+      static_cast<PerIsolatePlatformData*>(idle_check->data)
+          ->DecreaseHandleCount();
+    });
+    idle_prepare_ = nullptr;
+    idle_check_ = nullptr;
+  }
   uv_close(reinterpret_cast<uv_handle_t*>(flush_tasks_),
            [](uv_handle_t* handle) {
     std::unique_ptr<uv_async_t> flush_tasks {
         reinterpret_cast<uv_async_t*>(handle) };
-    PerIsolatePlatformData* platform_data =
-        static_cast<PerIsolatePlatformData*>(flush_tasks->data);
-    platform_data->DecreaseHandleCount();
-    platform_data->self_reference_.reset();
+    static_cast<PerIsolatePlatformData*>(flush_tasks->data)
+        ->DecreaseHandleCount();
   });
   flush_tasks_ = nullptr;
 }
@@ -320,6 +663,8 @@ void PerIsolatePlatformData::DecreaseHandleCount() {
   if (--uv_handle_count_ == 0) {
     for (const auto& callback : shutdown_callbacks_)
       callback.cb(callback.data);
+    // This may delete the object, so it has to come last.
+    self_reference_.reset();
   }
 }
 
@@ -349,8 +694,14 @@ NodePlatform::~NodePlatform() {
 }
 
 void NodePlatform::RegisterIsolate(Isolate* isolate, uv_loop_t* loop) {
+  bool idle_tasks_enabled;
+  {
+    Mutex::ScopedLock lock(per_process::cli_options_mutex);
+    idle_tasks_enabled = per_process::cli_options->experimental_idle_tasks;
+  }
   Mutex::ScopedLock lock(per_isolate_mutex_);
-  auto delegate = std::make_shared<PerIsolatePlatformData>(isolate, loop);
+  auto delegate = std::make_shared<PerIsolatePlatformData>(
+      isolate, loop, idle_tasks_enabled);
   IsolatePlatformDelegate* ptr = delegate.get();
   auto insertion = per_isolate_.emplace(
     isolate,
@@ -405,6 +756,10 @@ int NodePlatform::NumberOfWorkerThreads() {
   return worker_thread_task_runner_->NumberOfWorkerThreads();
 }
 
+PlatformWorkerPoolStats NodePlatform::GetWorkerPoolStats() const {
+  return worker_thread_task_runner_->GetStats();
+}
+
 void PerIsolatePlatformData::RunForegroundTask(std::unique_ptr<Task> task) {
   DebugSealHandleScope scope(isolate_);
   Environment* env = Environment::GetCurrent(isolate_);
@@ -487,7 +842,19 @@ bool PerIsolatePlatformData::FlushForegroundTasksInternal() {
 }
 
 void NodePlatform::CallOnWorkerThread(std::unique_ptr<Task> task) {
-  worker_thread_task_runner_->PostTask(std::move(task));
+  worker_thread_task_runner_->PostTask(std::move(task),
+                                       TaskPriority::kUserVisible);
+}
+
+void NodePlatform::CallBlockingTaskOnWorkerThread(std::unique_ptr<Task> task) {
+  worker_thread_task_runner_->PostTask(std::move(task),
+                                       TaskPriority::kUserBlocking);
+}
+
+void NodePlatform::CallLowPriorityTaskOnWorkerThread(
+    std::unique_ptr<Task> task) {
+  worker_thread_task_runner_->PostTask(std::move(task),
+                                       TaskPriority::kBestEffort);
 }
 
 void NodePlatform::CallDelayedOnWorkerThread(std::unique_ptr<Task> task,
@@ -518,6 +885,11 @@ bool NodePlatform::FlushForegroundTasks(Isolate* isolate) {
   return per_isolate->FlushForegroundTasksInternal();
 }
 
+// V8's default job handle is kept on purpose. It keeps track of the job's
+// concurrency and of the joining thread, and posts its worker tasks through
+// Call*OnWorkerThread() with the job's priority, so they already run from
+// the work-stealing queues above. It never has more worker tasks in flight
+// than NumberOfWorkerThreads() returns.
 std::unique_ptr<v8::JobHandle> NodePlatform::CreateJob(
     v8::TaskPriority priority, std::unique_ptr<v8::JobTask> job_task) {
   return v8::platform::NewDefaultJobHandle(
@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <atomic>
 #include <queue>
 #include <unordered_map>
 #include <vector>
@@ -55,7 +56,9 @@ class PerIsolatePlatformData :
     public v8::TaskRunner,
     public std::enable_shared_from_this<PerIsolatePlatformData> {
  public:
-  PerIsolatePlatformData(v8::Isolate* isolate, uv_loop_t* loop);
+  PerIsolatePlatformData(v8::Isolate* isolate,
+                         uv_loop_t* loop,
+                         bool idle_tasks_enabled = false);
   ~PerIsolatePlatformData() override;
 
   std::shared_ptr<v8::TaskRunner> GetForegroundTaskRunner() override;
@@ -63,7 +66,7 @@ class PerIsolatePlatformData :
   void PostIdleTask(std::unique_ptr<v8::IdleTask> task) override;
   void PostDelayedTask(std::unique_ptr<v8::Task> task,
                        double delay_in_seconds) override;
-  bool IdleTasksEnabled() override { return false; }
+  bool IdleTasksEnabled() override { return idle_tasks_enabled_; }
 
   // Non-nestable tasks are treated like regular tasks.
   bool NonNestableTasksEnabled() const override { return true; }
@@ -90,6 +93,15 @@ class PerIsolatePlatformData :
   void RunForegroundTask(std::unique_ptr<v8::Task> task);
   static void RunForegroundTask(uv_timer_t* timer);
 
+  // Idle tasks run right before the event loop blocks waiting for I/O. The
+  // prepare handle estimates how long the loop is going to stay idle and runs
+  // idle tasks until that deadline, the check handle measures how long it
+  // actually stayed idle.
+  static void OnLoopPrepare(uv_prepare_t* handle);
+  static void OnLoopCheck(uv_check_t* handle);
+  double EstimateIdleDeadline();
+  void RunIdleTasks(double deadline_in_seconds);
+
   struct ShutdownCallback {
     void (*cb)(void*);
     void* data;
@@ -106,18 +118,49 @@ class PerIsolatePlatformData :
   TaskQueue<v8::Task> foreground_tasks_;
   TaskQueue<DelayedTask> foreground_delayed_tasks_;
 
+  const bool idle_tasks_enabled_;
+  uv_prepare_t* idle_prepare_ = nullptr;
+  uv_check_t* idle_check_ = nullptr;
+  TaskQueue<v8::IdleTask> idle_tasks_;
+  // uv_hrtime() when the loop went idle, and the poll timeout it went idle
+  // with, or 0 if it did not go idle in the current iteration.
+  uint64_t idle_start_ = 0;
+  int idle_poll_timeout_ = 0;
+  // Moving average of how long the loop stays idle before it is woken up by
+  // I/O, in milliseconds.
+  double io_wakeup_interval_ms_;
+
   // Use a custom deleter because libuv needs to close the handle first.
   typedef std::unique_ptr<DelayedTask, void(*)(DelayedTask*)>
       DelayedTaskPointer;
   std::vector<DelayedTaskPointer> scheduled_delayed_tasks_;
 };
 
+struct PlatformWorkerStats {
+  uint64_t tasks_run = 0;
+  uint64_t tasks_stolen = 0;
+  uint64_t steal_attempts = 0;
+};
+
+struct PlatformWorkerPoolStats {
+  size_t pending_user_blocking_tasks = 0;
+  size_t pending_user_visible_tasks = 0;
+  size_t pending_best_effort_tasks = 0;
+  std::vector<PlatformWorkerStats> workers;
+};
+
 // This acts as the single worker thread task runner for all Isolates.
+// Every worker thread owns a queue. Tasks posted from a worker thread go into
+// its own queue, all other tasks are spread over the queues round-robin.
+// Workers that run out of tasks steal them from the other queues, and tasks
+// with a higher v8::TaskPriority always run first.
 class WorkerThreadsTaskRunner {
  public:
   explicit WorkerThreadsTaskRunner(int thread_pool_size);
+  ~WorkerThreadsTaskRunner();
 
-  void PostTask(std::unique_ptr<v8::Task> task);
+  void PostTask(std::unique_ptr<v8::Task> task,
+                v8::TaskPriority priority = v8::TaskPriority::kUserVisible);
   void PostDelayedTask(std::unique_ptr<v8::Task> task,
                        double delay_in_seconds);
 
@@ -125,9 +168,31 @@ class WorkerThreadsTaskRunner {
   void Shutdown();
 
   int NumberOfWorkerThreads() const;
+  PlatformWorkerPoolStats GetStats() const;
 
  private:
-  TaskQueue<v8::Task> pending_worker_tasks_;
+  class WorkerQueue;
+
+  static void WorkerThread(void* data);
+  std::unique_ptr<v8::Task> NextTask(size_t index);
+  std::unique_ptr<v8::Task> FindTask(size_t index);
+  void WakeWorker(size_t index);
+  void NotifyOfCompletion();
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::atomic<size_t> next_queue_ {0};
+  // Incremented for every posted task. Workers only go to sleep if nothing
+  // was posted since they last looked for a task.
+  std::atomic<uint64_t> posted_tasks_ {0};
+  // Number of workers that are asleep or about to be. Posting a task only
+  // looks for a worker to wake up if there are any.
+  std::atomic<int> idle_workers_ {0};
+  std::atomic<bool> stopped_ {false};
+
+  Mutex drain_mutex_;
+  ConditionVariable tasks_drained_;
+  // Number of tasks that were posted but have not finished yet.
+  std::atomic<int64_t> outstanding_tasks_ {0};
 
   class DelayedTaskScheduler;
   std::unique_ptr<DelayedTaskScheduler> delayed_task_scheduler_;
@@ -145,9 +210,14 @@ class NodePlatform : public MultiIsolatePlatform {
   void DrainTasks(v8::Isolate* isolate) override;
   void Shutdown();
 
+  PlatformWorkerPoolStats GetWorkerPoolStats() const;
+
   // v8::Platform implementation.
   int NumberOfWorkerThreads() override;
   void CallOnWorkerThread(std::unique_ptr<v8::Task> task) override;
+  void CallBlockingTaskOnWorkerThread(std::unique_ptr<v8::Task> task) override;
+  void CallLowPriorityTaskOnWorkerThread(
+      std::unique_ptr<v8::Task> task) override;
   void CallDelayedOnWorkerThread(std::unique_ptr<v8::Task> task,
                                  double delay_in_seconds) override;
   bool IdleTasksEnabled(v8::Isolate* isolate) override;
@@ -6,6 +6,8 @@
 #include "node_internals.h"
 #include "node_metadata.h"
 #include "node_mutex.h"
+#include "node_platform.h"
+#include "node_v8_platform-inl.h"
 #include "node_worker.h"
 #include "util.h"
 
@@ -69,6 +71,7 @@ static void PrintJavaScriptErrorProperties(JSONWriter* writer,
                                            Local<Value> error);
 static void PrintNativeStack(JSONWriter* writer);
 static void PrintResourceUsage(JSONWriter* writer);
+static void PrintPlatformWorkers(JSONWriter* writer);
 static void PrintGCStatistics(JSONWriter* writer, Isolate* isolate);
 static void PrintSystemInformation(JSONWriter* writer);
 static void PrintLoadedLibraries(JSONWriter* writer);
@@ -285,6 +288,9 @@ static void WriteNodeReport(Isolate* isolate,
   // Report OS and current thread resource usage
   PrintResourceUsage(&writer);
 
+  // Report the state of the V8 platform worker pool
+  PrintPlatformWorkers(&writer);
+
   writer.json_arraystart("libuv");
   if (env != nullptr) {
     uv_walk(env->event_loop(), WalkHandle, static_cast<void*>(&writer));
@@ -701,6 +707,31 @@ static void PrintResourceUsage(JSONWriter* writer) {
 #endif  // RUSAGE_THREAD
 }
 
+// Report queue depths and per-thread counters of the platform worker pool.
+static void PrintPlatformWorkers(JSONWriter* writer) {
+  NodePlatform* platform = per_process::v8_platform.Platform();
+  if (platform == nullptr) return;
+
+  PlatformWorkerPoolStats stats = platform->GetWorkerPoolStats();
+  writer->json_objectstart("platformWorkers");
+  writer->json_keyvalue("threads", stats.workers.size());
+  writer->json_objectstart("pendingTasks");
+  writer->json_keyvalue("userBlocking", stats.pending_user_blocking_tasks);
+  writer->json_keyvalue("userVisible", stats.pending_user_visible_tasks);
+  writer->json_keyvalue("bestEffort", stats.pending_best_effort_tasks);
+  writer->json_objectend();
+  writer->json_arraystart("threadStats");
+  for (const PlatformWorkerStats& worker : stats.workers) {
+    writer->json_start();
+    writer->json_keyvalue("tasksRun", worker.tasks_run);
+    writer->json_keyvalue("tasksStolen", worker.tasks_stolen);
+    writer->json_keyvalue("stealAttempts", worker.steal_attempts);
+    writer->json_end();
+  }
+  writer->json_arrayend();
+  writer->json_objectend();
+}
+
 // Report operating system information.
 static void PrintSystemInformation(JSONWriter* writer) {
   uv_env_item_t* envitems;
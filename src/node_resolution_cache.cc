@@ -0,0 +1,290 @@
+#include "node_resolution_cache.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_internals.h"
+#include "node_options-inl.h"
+#include "util-inl.h"
+#include "zlib.h"
+
+#include <cstring>
+
+namespace node {
+
+namespace {
+
+// Layout of the cache file. Integers are stored in host byte order, the file
+// is not meant to be shared between machines.
+//
+//   [ FileHeader ]
+//   [ uint32_t size ][ string ]  ...  (FileHeader::string_count times)
+//   [ RecordHeader ][ DependencyRecord ]  ...  ...
+//
+// Records refer to strings by their index.
+struct FileHeader {
+  uint32_t magic;
+  // Hash of the Node.js version and of the options that affect resolution.
+  uint32_t version_tag;
+  uint32_t string_count;
+  uint32_t record_count;
+  // crc32 of everything after the header.
+  uint32_t checksum;
+  uint32_t reserved;
+  uint64_t payload_size;
+};
+
+struct RecordHeader {
+  uint32_t context;
+  uint32_t request;
+  uint32_t filename;
+  uint32_t dependency_count;
+};
+
+struct DependencyRecord {
+  uint32_t path;
+  uint32_t reserved;
+  int64_t mtime;
+};
+
+constexpr uint32_t kMagic = 0x3163726e;  // "nrc1"
+
+uint32_t ComputeVersionTag(Environment* env) {
+  std::string tag = NODE_VERSION;
+  tag += env->options()->preserve_symlinks ? ":1" : ":0";
+  tag += env->options()->preserve_symlinks_main ? ":1" : ":0";
+  for (const std::string& condition : env->options()->conditions) {
+    tag += ':';
+    tag += condition;
+  }
+  return crc32_z(0, reinterpret_cast<const Bytef*>(tag.data()), tag.size());
+}
+
+// Reads integers and strings from the file without assuming any alignment.
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  bool Read(T* out) {
+    if (size_ - offset_ < sizeof(*out)) return false;
+    memcpy(out, data_ + offset_, sizeof(*out));
+    offset_ += sizeof(*out);
+    return true;
+  }
+
+  bool ReadString(std::string* out) {
+    uint32_t size;
+    if (!Read(&size) || size_ - offset_ < size) return false;
+    out->assign(reinterpret_cast<const char*>(data_ + offset_), size);
+    offset_ += size;
+    return true;
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+template <typename T>
+void Append(std::string* out, const T& value) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // anonymous namespace
+
+class ResolutionCache::Snapshot final : public CacheFileWriter::Snapshot {
+ public:
+  Snapshot(const FileHeader& header, std::string&& payload)
+      : header_(header), payload_(std::move(payload)) {}
+
+  std::vector<uv_buf_t> Serialize() override {
+    header_.payload_size = payload_.size();
+    header_.checksum = crc32_z(0,
+                               reinterpret_cast<const Bytef*>(payload_.data()),
+                               payload_.size());
+    return {
+      uv_buf_init(reinterpret_cast<char*>(&header_), sizeof(header_)),
+      uv_buf_init(&payload_[0], payload_.size()),
+    };
+  }
+
+  size_t entry_count() const override { return header_.record_count; }
+
+ private:
+  FileHeader header_;
+  std::string payload_;
+};
+
+ResolutionCache::ResolutionCache(Environment* env, const std::string& path)
+    : env_(env),
+      path_(path),
+      version_tag_(ComputeVersionTag(env)),
+      writer_(env,
+              path,
+              DebugCategory::RESOLUTION_CACHE,
+              "resolution cache",
+              [this]() { return TakeSnapshot(); }) {
+  Load();
+}
+
+ResolutionCache::~ResolutionCache() = default;
+
+void ResolutionCache::Load() {
+  std::shared_ptr<CompileCacheFile> file = CompileCacheFile::Load(path_);
+  if (!file) {
+    Debug(env_, DebugCategory::RESOLUTION_CACHE,
+          "Could not read resolution cache %s\n", path_);
+    return;
+  }
+
+  Reader reader(file->data(), file->size());
+  FileHeader header;
+  if (!reader.Read(&header) ||
+      header.magic != kMagic ||
+      header.version_tag != version_tag_ ||
+      header.payload_size != file->size() - sizeof(header) ||
+      crc32_z(0, file->data() + sizeof(header), header.payload_size) !=
+          header.checksum) {
+    Debug(env_, DebugCategory::RESOLUTION_CACHE,
+          "Resolution cache %s is invalid or was written by another version "
+          "of Node.js or with other options\n", path_);
+    return;
+  }
+
+  std::vector<std::string> strings(header.string_count);
+  for (std::string& string : strings) {
+    if (!reader.ReadString(&string)) return;
+  }
+
+  for (uint32_t i = 0; i < header.record_count; i++) {
+    RecordHeader record;
+    if (!reader.Read(&record) ||
+        record.context >= strings.size() ||
+        record.request >= strings.size() ||
+        record.filename >= strings.size()) {
+      return;
+    }
+    Entry entry;
+    entry.filename = strings[record.filename];
+    for (uint32_t j = 0; j < record.dependency_count; j++) {
+      DependencyRecord dependency;
+      if (!reader.Read(&dependency) || dependency.path >= strings.size())
+        return;
+      entry.dependencies.push_back({strings[dependency.path],
+                                    dependency.mtime});
+    }
+    entries_[strings[record.context]].emplace(strings[record.request],
+                                              std::move(entry));
+  }
+
+  Debug(env_, DebugCategory::RESOLUTION_CACHE,
+        "Loaded %d entries from resolution cache %s\n",
+        header.record_count, path_);
+}
+
+ResolutionCache::Mtime ResolutionCache::GetMtime(const std::string& path) {
+  auto it = mtimes_.find(path);
+  if (it != mtimes_.end()) return it->second;
+
+  if (!clear_mtimes_scheduled_) {
+    // Files and directories may change while the process is running, but not
+    // while the modules that are required synchronously are being loaded.
+    clear_mtimes_scheduled_ = true;
+    env_->SetImmediate([this](Environment* env) {
+      clear_mtimes_scheduled_ = false;
+      mtimes_.clear();
+    });
+  }
+
+  uv_fs_t req;
+  Mtime mtime = kMissing;
+  if (uv_fs_stat(nullptr, &req, path.c_str(), nullptr) == 0) {
+    const uv_stat_t* const s = static_cast<const uv_stat_t*>(req.ptr);
+    mtime = static_cast<Mtime>(s->st_mtim.tv_sec) * 1000000000 +
+            s->st_mtim.tv_nsec;
+  }
+  uv_fs_req_cleanup(&req);
+  mtimes_.emplace(path, mtime);
+  return mtime;
+}
+
+const std::string* ResolutionCache::Get(const std::string& context,
+                                        const std::string& request) {
+  auto context_it = entries_.find(context);
+  if (context_it == entries_.end()) return nullptr;
+  auto it = context_it->second.find(request);
+  if (it == context_it->second.end()) return nullptr;
+
+  const Entry& entry = it->second;
+  for (const Dependency& dependency : entry.dependencies) {
+    if (GetMtime(dependency.path) != dependency.mtime) {
+      Debug(env_, DebugCategory::RESOLUTION_CACHE,
+            "Resolution of %s is outdated, %s changed\n",
+            request, dependency.path);
+      return nullptr;
+    }
+  }
+  Debug(env_, DebugCategory::RESOLUTION_CACHE,
+        "Found cached resolution of %s to %s\n", request, entry.filename);
+  return &entry.filename;
+}
+
+void ResolutionCache::Put(const std::string& context,
+                          const std::string& request,
+                          std::string&& filename,
+                          const std::vector<std::string>& dependencies) {
+  Debug(env_, DebugCategory::RESOLUTION_CACHE,
+        "Caching resolution of %s to %s\n", request, filename);
+
+  Entry entry;
+  entry.filename = std::move(filename);
+  entry.dependencies.reserve(dependencies.size());
+  for (const std::string& path : dependencies)
+    entry.dependencies.push_back({path, GetMtime(path)});
+  entries_[context][request] = std::move(entry);
+  writer_.EntryAdded();
+}
+
+std::unique_ptr<CacheFileWriter::Snapshot>
+ResolutionCache::TakeSnapshot() const {
+  std::unordered_map<std::string, uint32_t> string_indices;
+  std::string strings;
+  auto add_string = [&](const std::string& string) {
+    auto result = string_indices.emplace(string, string_indices.size());
+    if (result.second) {
+      Append(&strings, static_cast<uint32_t>(string.size()));
+      strings += string;
+    }
+    return result.first->second;
+  };
+
+  FileHeader header = {};
+  header.magic = kMagic;
+  header.version_tag = version_tag_;
+
+  std::string records;
+  for (const auto& context : entries_) {
+    const uint32_t context_index = add_string(context.first);
+    for (const auto& it : context.second) {
+      const Entry& entry = it.second;
+      Append(&records, RecordHeader {
+        context_index,
+        add_string(it.first),
+        add_string(entry.filename),
+        static_cast<uint32_t>(entry.dependencies.size()),
+      });
+      for (const Dependency& dependency : entry.dependencies) {
+        Append(&records, DependencyRecord {
+          add_string(dependency.path), 0, dependency.mtime
+        });
+      }
+      header.record_count++;
+    }
+  }
+
+  header.string_count = static_cast<uint32_t>(string_indices.size());
+  strings += records;
+  return std::make_unique<Snapshot>(header, std::move(strings));
+}
+
+}  // namespace node
@@ -0,0 +1,95 @@
+#ifndef SRC_NODE_RESOLUTION_CACHE_H_
+#define SRC_NODE_RESOLUTION_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "node_compile_cache.h"
+
+namespace node {
+
+class Environment;
+
+// An opt-in cache for the results of the CommonJS require() resolution
+// algorithm, enabled with --experimental-resolution-cache=file.
+//
+// An entry maps a request and the context it was made in (the directory of
+// the parent module, its lookup paths and the known extensions) to the file
+// that it resolved to. Along with it, the modification times of the
+// directories that were searched and of the package.json files that were read
+// are stored. An entry is only used while all of them are unchanged, which
+// costs one stat() per dependency instead of one per probed file name, and
+// dependencies that are shared between entries are only checked once per
+// tick.
+//
+// The entries are stored in a single file with a table of unique strings,
+// so that the long lists of lookup paths shared by all modules in a
+// directory are only stored once. The file is discarded altogether if it was
+// written by a different version of Node.js or with options that affect the
+// resolution, like --preserve-symlinks. New entries are written back
+// asynchronously once the current tick is done, and synchronously when the
+// Environment exits.
+class ResolutionCache {
+ public:
+  ResolutionCache(Environment* env, const std::string& path);
+  ~ResolutionCache();
+
+  ResolutionCache(const ResolutionCache&) = delete;
+  ResolutionCache& operator=(const ResolutionCache&) = delete;
+
+  // Returns the file that `request` resolved to, or nullptr if it is not
+  // cached or one of its dependencies changed.
+  const std::string* Get(const std::string& context,
+                         const std::string& request);
+  // Stores the result of a resolution that depended on the given directories
+  // and files.
+  void Put(const std::string& context,
+           const std::string& request,
+           std::string&& filename,
+           const std::vector<std::string>& dependencies);
+
+  // Writes all entries to disk if new ones were added since the last time.
+  void Flush(bool sync) { writer_.Flush(sync); }
+
+ private:
+  // Modification time in nanoseconds, or kMissing.
+  using Mtime = int64_t;
+  static constexpr Mtime kMissing = -1;
+
+  struct Dependency {
+    std::string path;
+    Mtime mtime;
+  };
+  struct Entry {
+    std::string filename;
+    std::vector<Dependency> dependencies;
+  };
+  using EntryMap = std::unordered_map<std::string, Entry>;
+
+  class Snapshot;
+
+  void Load();
+  std::unique_ptr<CacheFileWriter::Snapshot> TakeSnapshot() const;
+  // Returns the modification time of `path`, from the file system the first
+  // time it is asked for during a tick.
+  Mtime GetMtime(const std::string& path);
+
+  Environment* const env_;
+  const std::string path_;
+  const uint32_t version_tag_;
+  // Indexed by context, then by request.
+  std::unordered_map<std::string, EntryMap> entries_;
+  std::unordered_map<std::string, Mtime> mtimes_;
+  bool clear_mtimes_scheduled_ = false;
+  CacheFileWriter writer_;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_RESOLUTION_CACHE_H_
@@ -0,0 +1,582 @@
+#include "node_ring_channel.h"
+
+#include "async_wrap-inl.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_buffer.h"
+#include "node_errors.h"
+#include "node_external_reference.h"
+#include "node_internals.h"
+#include "util-inl.h"
+
+#include <algorithm>
+
+namespace node {
+
+using v8::Array;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::Uint32;
+using v8::Value;
+
+namespace worker {
+
+namespace {
+
+// Writers commit their records in the order in which they reserved space for
+// them. Waiting for another writer is short, unless that writer's thread was
+// descheduled in the middle of copying its record. Spin first, then give the
+// CPU to that thread a few times, and only then block.
+constexpr size_t kSpinsBeforeYield = 64;
+constexpr size_t kYieldsBeforeWait = 16;
+
+}  // anonymous namespace
+
+SharedRing::SharedRing(size_t capacity)
+    : capacity_(capacity),
+      data_(new uint64_t[capacity / sizeof(uint64_t)]) {
+  CHECK_GE(capacity, kMinCapacity);
+  CHECK_LE(capacity, kMaxCapacity);
+  CHECK_EQ(capacity & (capacity - 1), 0);
+}
+
+bool SharedRing::Fits(uint64_t write_pos,
+                      uint64_t read_pos,
+                      size_t record_size,
+                      size_t* padding) const {
+  size_t offset = write_pos & (capacity_ - 1);
+  size_t skip = offset + record_size > capacity_ ? capacity_ - offset : 0;
+  *padding = skip;
+  return write_pos + skip + record_size - read_pos <= capacity_;
+}
+
+bool SharedRing::Write(const uv_buf_t* bufs, size_t count) {
+  size_t size = 0;
+  for (size_t i = 0; i < count; i++)
+    size += bufs[i].len;
+  CHECK_LE(size, max_record_size());
+  const size_t record_size = RecordSize(size);
+
+  uint64_t pos = reserve_pos_.load(std::memory_order_relaxed);
+  size_t padding;
+  do {
+    // Acquiring `read_pos_` makes sure that the reader is done with the
+    // space before it is overwritten.
+    if (!Fits(pos, read_pos_.load(std::memory_order_acquire),
+              record_size, &padding)) {
+      return false;
+    }
+  } while (!reserve_pos_.compare_exchange_weak(pos,
+                                               pos + padding + record_size,
+                                               std::memory_order_relaxed));
+
+  if (padding > 0) {
+    RecordHeader header { static_cast<uint32_t>(padding), kPaddingRecord };
+    memcpy(At(pos), &header, sizeof(header));
+  }
+  char* dest = At(pos + padding);
+  RecordHeader header { static_cast<uint32_t>(size), 0 };
+  memcpy(dest, &header, sizeof(header));
+  dest += sizeof(header);
+  for (size_t i = 0; i < count; i++) {
+    memcpy(dest, bufs[i].base, bufs[i].len);
+    dest += bufs[i].len;
+  }
+
+  WaitForCommit(pos);
+  commit_pos_.store(pos + padding + record_size, std::memory_order_release);
+
+  // Pairs with the fences in WaitForCommit() and WaitForData(). Either the
+  // next writer sees our commit, or we see that it is blocked on
+  // `commit_cond_`. Either the reader sees the new record when it looks at
+  // the ring again, or we see that it is waiting.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (commit_waiters_.load(std::memory_order_relaxed) > 0) {
+    Mutex::ScopedLock lock(commit_mutex_);
+    commit_cond_.Broadcast(lock);
+  }
+  if (reader_waiting_.load(std::memory_order_relaxed) &&
+      reader_waiting_.exchange(false)) {
+    NotifyReader();
+  }
+  return true;
+}
+
+void SharedRing::WaitForCommit(uint64_t pos) {
+  for (size_t spins = 0; spins < kSpinsBeforeYield + kYieldsBeforeWait;
+       spins++) {
+    if (commit_pos_.load(std::memory_order_acquire) == pos)
+      return;
+    if (spins >= kSpinsBeforeYield)
+      uv_sleep(0);
+  }
+
+  Mutex::ScopedLock lock(commit_mutex_);
+  commit_waiters_.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  // The writer before us takes `commit_mutex_` before it wakes us up, so it
+  // cannot do that between this check and Wait().
+  while (commit_pos_.load(std::memory_order_acquire) != pos)
+    commit_cond_.Wait(lock);
+  commit_waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+const char* SharedRing::Peek(size_t* size) {
+  uint64_t pos = read_pos_.load(std::memory_order_relaxed);
+  while (pos != commit_pos_.load(std::memory_order_acquire)) {
+    RecordHeader header;
+    memcpy(&header, At(pos), sizeof(header));
+    if (header.flags & kPaddingRecord) {
+      pos += header.size;
+      read_pos_.store(pos, std::memory_order_release);
+      continue;
+    }
+    *size = header.size;
+    return At(pos) + sizeof(header);
+  }
+  return nullptr;
+}
+
+void SharedRing::Consume(size_t size) {
+  read_pos_.store(read_pos_.load(std::memory_order_relaxed) + RecordSize(size),
+                  std::memory_order_release);
+
+  // Pairs with the fence in WaitForSpace().
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (writers_waiting_.load(std::memory_order_relaxed))
+    NotifyWriters();
+}
+
+void SharedRing::AddWriter() {
+  writer_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SharedRing::RemoveWriter() {
+  // Records of the last writer are committed before the reader can see that
+  // there are no writers left.
+  if (writer_count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    NotifyReader();
+}
+
+bool SharedRing::HasWriters() const {
+  return writer_count_.load(std::memory_order_acquire) > 0;
+}
+
+void SharedRing::SetReader(RingReader* reader) {
+  Mutex::ScopedLock lock(mutex_);
+  reader_ = reader;
+}
+
+bool SharedRing::WaitForData() {
+  reader_waiting_.store(true, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (commit_pos_.load(std::memory_order_relaxed) ==
+      read_pos_.load(std::memory_order_relaxed)) {
+    return true;
+  }
+  // A writer that saw the flag already will send a notification that turns
+  // out to be unnecessary, which is harmless.
+  reader_waiting_.store(false, std::memory_order_relaxed);
+  return false;
+}
+
+void SharedRing::WaitForSpace(RingWriter* writer, size_t size) {
+  {
+    Mutex::ScopedLock lock(mutex_);
+    if (std::find(waiting_writers_.begin(), waiting_writers_.end(), writer) ==
+        waiting_writers_.end()) {
+      waiting_writers_.push_back(writer);
+    }
+    writers_waiting_.store(true, std::memory_order_relaxed);
+  }
+
+  // Pairs with the fence in Consume(). Either the reader sees that we are
+  // waiting, or we see the space that it has released.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  size_t padding;
+  if (Fits(reserve_pos_.load(std::memory_order_relaxed),
+           read_pos_.load(std::memory_order_relaxed),
+           RecordSize(size),
+           &padding)) {
+    NotifyWriters();
+  }
+}
+
+void SharedRing::StopWaitingForSpace(RingWriter* writer) {
+  Mutex::ScopedLock lock(mutex_);
+  waiting_writers_.erase(
+      std::remove(waiting_writers_.begin(), waiting_writers_.end(), writer),
+      waiting_writers_.end());
+}
+
+void SharedRing::NotifyReader() {
+  Mutex::ScopedLock lock(mutex_);
+  if (reader_ != nullptr)
+    reader_->TriggerAsync();
+}
+
+void SharedRing::NotifyWriters() {
+  Mutex::ScopedLock lock(mutex_);
+  writers_waiting_.store(false, std::memory_order_relaxed);
+  for (RingWriter* writer : waiting_writers_)
+    writer->TriggerAsync();
+  waiting_writers_.clear();
+}
+
+void SharedRing::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("data", capacity_);
+}
+
+RingReader::RingReader(Environment* env,
+                       Local<Object> wrap,
+                       std::shared_ptr<SharedRing> ring)
+    : HandleWrap(env,
+                 wrap,
+                 reinterpret_cast<uv_handle_t*>(&async_),
+                 AsyncWrap::PROVIDER_RINGREADER),
+      ring_(std::move(ring)) {
+  CHECK_EQ(uv_async_init(env->event_loop(), &async_, [](uv_async_t* handle) {
+    RingReader* reader = ContainerOf(&RingReader::async_, handle);
+    reader->OnReadable();
+  }), 0);
+  ring_->SetReader(this);
+  // Records might have been written before this reader was created, e.g.
+  // while it was being transferred to this thread.
+  if (!ring_->WaitForData())
+    TriggerAsync();
+  Debug(this, "Created ring reader");
+}
+
+RingReader* RingReader::New(Environment* env,
+                            Local<Context> context,
+                            std::shared_ptr<SharedRing> ring) {
+  Context::Scope context_scope(context);
+  Local<Object> instance;
+  if (!GetConstructorTemplate(env)
+           ->InstanceTemplate()
+           ->NewInstance(context)
+           .ToLocal(&instance)) {
+    return nullptr;
+  }
+  return new RingReader(env, instance, std::move(ring));
+}
+
+void RingReader::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsUint32());
+  new RingReader(env,
+                 args.This(),
+                 std::make_shared<SharedRing>(args[0].As<Uint32>()
+                                                  ->Value()));
+}
+
+void RingReader::CreateWriter(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  RingReader* reader;
+  ASSIGN_OR_RETURN_UNWRAP(&reader, args.Holder());
+  CHECK(reader->ring_);
+  RingWriter* writer = RingWriter::New(env, env->context(), reader->ring_);
+  if (writer != nullptr)
+    args.GetReturnValue().Set(writer->object());
+}
+
+void RingReader::Read(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  RingReader* reader;
+  ASSIGN_OR_RETURN_UNWRAP(&reader, args.Holder());
+  SharedRing* ring = reader->ring_.get();
+  if (ring == nullptr)
+    return args.GetReturnValue().SetNull();
+
+  size_t size;
+  const char* data;
+  while ((data = ring->Peek(&size)) == nullptr) {
+    if (!ring->HasWriters()) {
+      // The last writer may have committed a record right before it went
+      // away.
+      if ((data = ring->Peek(&size)) != nullptr)
+        break;
+      return args.GetReturnValue().SetNull();
+    }
+    if (ring->WaitForData())
+      return;
+  }
+
+  Local<Object> buffer;
+  if (!Buffer::Copy(env, data, size).ToLocal(&buffer))
+    return;
+  ring->Consume(size);
+  args.GetReturnValue().Set(buffer);
+}
+
+void RingReader::GetMaxRecordSize(const FunctionCallbackInfo<Value>& args) {
+  RingReader* reader;
+  ASSIGN_OR_RETURN_UNWRAP(&reader, args.Holder());
+  CHECK(reader->ring_);
+  args.GetReturnValue().Set(static_cast<double>(
+      reader->ring_->max_record_size()));
+}
+
+void RingReader::TriggerAsync() {
+  CHECK_EQ(uv_async_send(&async_), 0);
+}
+
+void RingReader::OnReadable() {
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+  MakeCallback(env()->onreadable_string(), 0, nullptr);
+}
+
+void RingReader::Close(Local<Value> close_callback) {
+  // Once this returns, no writer can be in the middle of notifying us.
+  if (ring_) {
+    ring_->SetReader(nullptr);
+    ring_.reset();
+  }
+  HandleWrap::Close(close_callback);
+}
+
+BaseObject::TransferMode RingReader::GetTransferMode() const {
+  if (!ring_ || IsHandleClosing())
+    return TransferMode::kUntransferable;
+  return TransferMode::kTransferable;
+}
+
+std::unique_ptr<worker::TransferData> RingReader::TransferForMessaging() {
+  auto data = std::make_unique<TransferData>(ring_);
+  Close();
+  return data;
+}
+
+BaseObjectPtr<BaseObject> RingReader::TransferData::Deserialize(
+    Environment* env,
+    Local<Context> context,
+    std::unique_ptr<worker::TransferData> self) {
+  RingReader* reader = RingReader::New(env, context, std::move(ring_));
+  // The last writer might have gone away while no reader was listening.
+  if (reader != nullptr && !reader->ring_->HasWriters())
+    reader->TriggerAsync();
+  return BaseObjectPtr<RingReader> { reader };
+}
+
+void RingReader::TransferData::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("ring", ring_);
+}
+
+void RingReader::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("ring", ring_);
+}
+
+Local<FunctionTemplate> RingReader::GetConstructorTemplate(Environment* env) {
+  Local<FunctionTemplate> tmpl = env->ring_reader_constructor_template();
+  if (tmpl.IsEmpty()) {
+    Isolate* isolate = env->isolate();
+    tmpl = NewFunctionTemplate(isolate, RingReader::New);
+    tmpl->SetClassName(FIXED_ONE_BYTE_STRING(isolate, "RingReader"));
+    tmpl->InstanceTemplate()->SetInternalFieldCount(kInternalFieldCount);
+    tmpl->Inherit(HandleWrap::GetConstructorTemplate(env));
+    SetProtoMethod(isolate, tmpl, "createWriter", CreateWriter);
+    SetProtoMethod(isolate, tmpl, "read", Read);
+    SetProtoMethodNoSideEffect(
+        isolate, tmpl, "getMaxRecordSize", GetMaxRecordSize);
+    env->set_ring_reader_constructor_template(tmpl);
+  }
+  return tmpl;
+}
+
+RingWriter::RingWriter(Environment* env,
+                       Local<Object> wrap,
+                       std::shared_ptr<SharedRing> ring)
+    : HandleWrap(env,
+                 wrap,
+                 reinterpret_cast<uv_handle_t*>(&async_),
+                 AsyncWrap::PROVIDER_RINGWRITER),
+      ring_(std::move(ring)) {
+  CHECK_EQ(uv_async_init(env->event_loop(), &async_, [](uv_async_t* handle) {
+    RingWriter* writer = ContainerOf(&RingWriter::async_, handle);
+    writer->OnDrain();
+  }), 0);
+  ring_->AddWriter();
+  Debug(this, "Created ring writer");
+}
+
+RingWriter* RingWriter::New(Environment* env,
+                            Local<Context> context,
+                            std::shared_ptr<SharedRing> ring) {
+  Context::Scope context_scope(context);
+  Local<Object> instance;
+  if (!GetConstructorTemplate(env)
+           ->InstanceTemplate()
+           ->NewInstance(context)
+           .ToLocal(&instance)) {
+    return nullptr;
+  }
+  return new RingWriter(env, instance, std::move(ring));
+}
+
+void RingWriter::New(const FunctionCallbackInfo<Value>& args) {
+  // Writers are created through RingReader::CreateWriter() or by cloning
+  // an existing one.
+  Environment* env = Environment::GetCurrent(args);
+  THROW_ERR_CONSTRUCT_CALL_INVALID(env);
+}
+
+void RingWriter::Write(const FunctionCallbackInfo<Value>& args) {
+  RingWriter* writer;
+  ASSIGN_OR_RETURN_UNWRAP(&writer, args.Holder());
+  CHECK(writer->ring_);
+
+  MaybeStackBuffer<uv_buf_t, 16> bufs(1);
+  if (args[0]->IsArray()) {
+    Local<Array> chunks = args[0].As<Array>();
+    Local<Context> context = writer->env()->context();
+    bufs.AllocateSufficientStorage(chunks->Length());
+    for (uint32_t i = 0; i < chunks->Length(); i++) {
+      Local<Value> chunk;
+      if (!chunks->Get(context, i).ToLocal(&chunk))
+        return;
+      CHECK(chunk->IsArrayBufferView());
+      bufs[i] = uv_buf_init(Buffer::Data(chunk), Buffer::Length(chunk));
+    }
+  } else {
+    CHECK(args[0]->IsArrayBufferView());
+    bufs[0] = uv_buf_init(Buffer::Data(args[0]), Buffer::Length(args[0]));
+  }
+
+  if (writer->ring_->Write(*bufs, bufs.length()))
+    return args.GetReturnValue().Set(true);
+
+  size_t size = 0;
+  for (size_t i = 0; i < bufs.length(); i++)
+    size += bufs[i].len;
+  writer->ring_->WaitForSpace(writer, size);
+  args.GetReturnValue().Set(false);
+}
+
+void RingWriter::GetMaxRecordSize(const FunctionCallbackInfo<Value>& args) {
+  RingWriter* writer;
+  ASSIGN_OR_RETURN_UNWRAP(&writer, args.Holder());
+  CHECK(writer->ring_);
+  args.GetReturnValue().Set(static_cast<double>(
+      writer->ring_->max_record_size()));
+}
+
+void RingWriter::TriggerAsync() {
+  CHECK_EQ(uv_async_send(&async_), 0);
+}
+
+void RingWriter::OnDrain() {
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+  MakeCallback(env()->ondrain_string(), 0, nullptr);
+}
+
+void RingWriter::Close(Local<Value> close_callback) {
+  // Once this returns, the reader cannot be in the middle of notifying us.
+  if (ring_) {
+    ring_->StopWaitingForSpace(this);
+    ring_->RemoveWriter();
+    ring_.reset();
+  }
+  HandleWrap::Close(close_callback);
+}
+
+BaseObject::TransferMode RingWriter::GetTransferMode() const {
+  if (!ring_ || IsHandleClosing())
+    return TransferMode::kUntransferable;
+  return TransferMode::kCloneable;
+}
+
+std::unique_ptr<worker::TransferData> RingWriter::CloneForMessaging() const {
+  return std::make_unique<TransferData>(ring_);
+}
+
+RingWriter::TransferData::TransferData(std::shared_ptr<SharedRing> ring)
+    : ring_(std::move(ring)) {
+  // Writers that are on their way to another thread still count, so that
+  // the reader does not see the end of the ring too early.
+  ring_->AddWriter();
+}
+
+RingWriter::TransferData::~TransferData() {
+  ring_->RemoveWriter();
+}
+
+BaseObjectPtr<BaseObject> RingWriter::TransferData::Deserialize(
+    Environment* env,
+    Local<Context> context,
+    std::unique_ptr<worker::TransferData> self) {
+  return BaseObjectPtr<RingWriter> { RingWriter::New(env, context, ring_) };
+}
+
+void RingWriter::TransferData::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("ring", ring_);
+}
+
+void RingWriter::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("ring", ring_);
+}
+
+Local<FunctionTemplate> RingWriter::GetConstructorTemplate(Environment* env) {
+  Local<FunctionTemplate> tmpl = env->ring_writer_constructor_template();
+  if (tmpl.IsEmpty()) {
+    Isolate* isolate = env->isolate();
+    tmpl = NewFunctionTemplate(isolate, RingWriter::New);
+    tmpl->SetClassName(FIXED_ONE_BYTE_STRING(isolate, "RingWriter"));
+    tmpl->InstanceTemplate()->SetInternalFieldCount(kInternalFieldCount);
+    tmpl->Inherit(HandleWrap::GetConstructorTemplate(env));
+    SetProtoMethod(isolate, tmpl, "write", Write);
+    SetProtoMethodNoSideEffect(
+        isolate, tmpl, "getMaxRecordSize", GetMaxRecordSize);
+    env->set_ring_writer_constructor_template(tmpl);
+  }
+  return tmpl;
+}
+
+namespace {
+
+void Initialize(Local<Object> target,
+                Local<Value> unused,
+                Local<Context> context,
+                void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+  SetConstructorFunction(
+      context, target, "RingReader", RingReader::GetConstructorTemplate(env));
+  SetConstructorFunction(
+      context, target, "RingWriter", RingWriter::GetConstructorTemplate(env));
+
+  Isolate* isolate = env->isolate();
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "kMinCapacity"),
+              Number::New(isolate, SharedRing::kMinCapacity)).Check();
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "kMaxCapacity"),
+              Number::New(isolate, SharedRing::kMaxCapacity)).Check();
+}
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(RingReader::New);
+  registry->Register(RingReader::CreateWriter);
+  registry->Register(RingReader::Read);
+  registry->Register(RingReader::GetMaxRecordSize);
+  registry->Register(RingWriter::New);
+  registry->Register(RingWriter::Write);
+  registry->Register(RingWriter::GetMaxRecordSize);
+}
+
+}  // anonymous namespace
+
+}  // namespace worker
+}  // namespace node
+
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(ring_channel, node::worker::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(ring_channel,
+                               node::worker::RegisterExternalReferences)
@@ -0,0 +1,257 @@
+#ifndef SRC_NODE_RING_CHANNEL_H_
+#define SRC_NODE_RING_CHANNEL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "handle_wrap.h"
+#include "node_messaging.h"
+#include "node_mutex.h"
+#include "uv.h"
+#include "v8.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace node {
+namespace worker {
+
+class RingReader;
+class RingWriter;
+
+// A fixed-size ring buffer of length-prefixed records in memory that is shared
+// between threads. Any number of threads may write records to it, but only a
+// single thread reads them.
+//
+// Writers reserve space by advancing `reserve_pos_` and make their records
+// visible to the reader by advancing `commit_pos_` once all records that were
+// reserved before theirs have been committed. The reader advances `read_pos_`
+// after it is done with a record. All three positions only ever grow, their
+// value modulo the capacity is the offset into the buffer.
+class SharedRing final : public MemoryRetainer {
+ public:
+  static constexpr size_t kMinCapacity = 4096;
+  static constexpr size_t kMaxCapacity = size_t{1} << 30;
+
+  // `capacity` must be a power of two between kMinCapacity and kMaxCapacity.
+  explicit SharedRing(size_t capacity);
+  ~SharedRing() override = default;
+
+  SharedRing(const SharedRing&) = delete;
+  SharedRing& operator=(const SharedRing&) = delete;
+
+  size_t capacity() const { return capacity_; }
+  // Records larger than this are never accepted by Write().
+  size_t max_record_size() const {
+    return capacity_ / 2 - sizeof(RecordHeader);
+  }
+
+  // Appends one record that consists of the concatenation of `bufs`. Returns
+  // false if the ring does not have enough space left for it.
+  bool Write(const uv_buf_t* bufs, size_t count);
+
+  // Returns the oldest record, or nullptr if there is none. The record stays
+  // valid until it is released with Consume(). Only the reader may call this.
+  const char* Peek(size_t* size);
+  void Consume(size_t size);
+
+  void AddWriter();
+  void RemoveWriter();
+  bool HasWriters() const;
+
+  // Sets the reader that is notified when records become available.
+  void SetReader(RingReader* reader);
+  // Asks for the reader to be notified when the next record is committed.
+  // Returns false if one was committed in the meantime, i.e. the reader should
+  // look at the ring again instead of waiting.
+  bool WaitForData();
+
+  // Asks for `writer` to be notified once a record of `size` bytes may fit.
+  void WaitForSpace(RingWriter* writer, size_t size);
+  void StopWaitingForSpace(RingWriter* writer);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(SharedRing)
+  SET_SELF_SIZE(SharedRing)
+
+ private:
+  struct RecordHeader {
+    uint32_t size;
+    uint32_t flags;
+  };
+  // Fills the space up to the end of the buffer when a record does not fit
+  // into it anymore.
+  static constexpr uint32_t kPaddingRecord = 1;
+
+  static size_t RecordSize(size_t size) {
+    return RoundUp(sizeof(RecordHeader) + size, sizeof(RecordHeader));
+  }
+  char* At(uint64_t position) const {
+    return reinterpret_cast<char*>(data_.get()) + (position & (capacity_ - 1));
+  }
+  bool Fits(uint64_t write_pos,
+            uint64_t read_pos,
+            size_t record_size,
+            size_t* padding) const;
+
+  // Blocks until all records that were reserved before `pos` are committed.
+  void WaitForCommit(uint64_t pos);
+  void NotifyReader();
+  void NotifyWriters();
+
+  const size_t capacity_;
+  const std::unique_ptr<uint64_t[]> data_;
+
+  // Writers and the reader touch different positions, keep them on different
+  // cache lines.
+  static constexpr size_t kCacheLineSize = 64;
+  alignas(kCacheLineSize) std::atomic<uint64_t> reserve_pos_ {0};
+  alignas(kCacheLineSize) std::atomic<uint64_t> commit_pos_ {0};
+  alignas(kCacheLineSize) std::atomic<uint64_t> read_pos_ {0};
+
+  alignas(kCacheLineSize) std::atomic<bool> reader_waiting_ {false};
+  std::atomic<bool> writers_waiting_ {false};
+  std::atomic<size_t> writer_count_ {0};
+
+  // Writers that wait for an earlier writer to commit its record block on
+  // `commit_cond_` once they have spun for a while.
+  std::atomic<size_t> commit_waiters_ {0};
+  Mutex commit_mutex_;
+  ConditionVariable commit_cond_;
+
+  // Protects `reader_` and `waiting_writers_`, so that they are not closed
+  // while they are being notified.
+  Mutex mutex_;
+  RingReader* reader_ = nullptr;
+  std::vector<RingWriter*> waiting_writers_;
+};
+
+// The reading end of a SharedRing. It can be moved to another thread by
+// listing it in the transfer list of a postMessage() call.
+class RingReader : public HandleWrap {
+ public:
+  static RingReader* New(Environment* env,
+                         v8::Local<v8::Context> context,
+                         std::shared_ptr<SharedRing> ring);
+
+  // new RingReader(capacity)
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // reader.createWriter()
+  static void CreateWriter(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // reader.read() returns the oldest record as a Buffer, undefined if there
+  // is none, or null if there is none and all writers are gone.
+  static void Read(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // reader.getMaxRecordSize()
+  static void GetMaxRecordSize(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
+      Environment* env);
+
+  // May be called from any thread, with the mutex of the ring held.
+  void TriggerAsync();
+
+  void Close(
+      v8::Local<v8::Value> close_callback = v8::Local<v8::Value>()) override;
+
+  TransferMode GetTransferMode() const override;
+  std::unique_ptr<worker::TransferData> TransferForMessaging() override;
+
+  class TransferData : public worker::TransferData {
+   public:
+    explicit TransferData(std::shared_ptr<SharedRing> ring)
+        : ring_(std::move(ring)) {}
+
+    BaseObjectPtr<BaseObject> Deserialize(
+        Environment* env,
+        v8::Local<v8::Context> context,
+        std::unique_ptr<worker::TransferData> self) override;
+
+    void MemoryInfo(MemoryTracker* tracker) const override;
+    SET_MEMORY_INFO_NAME(RingReader::TransferData)
+    SET_SELF_SIZE(TransferData)
+
+   private:
+    std::shared_ptr<SharedRing> ring_;
+  };
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(RingReader)
+  SET_SELF_SIZE(RingReader)
+
+ private:
+  RingReader(Environment* env,
+             v8::Local<v8::Object> wrap,
+             std::shared_ptr<SharedRing> ring);
+
+  void OnReadable();
+
+  std::shared_ptr<SharedRing> ring_;
+  uv_async_t async_;
+};
+
+// A writing end of a SharedRing. Cloning it through postMessage() creates
+// another writer for the same ring.
+class RingWriter : public HandleWrap {
+ public:
+  static RingWriter* New(Environment* env,
+                         v8::Local<v8::Context> context,
+                         std::shared_ptr<SharedRing> ring);
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // writer.write(data) appends one record that consists of `data`, a
+  // Buffer, or of the concatenation of an array of Buffers. Returns false if
+  // the ring is full, in which case ondrain() is called once it may fit.
+  static void Write(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // writer.getMaxRecordSize()
+  static void GetMaxRecordSize(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
+      Environment* env);
+
+  // May be called from any thread, with the mutex of the ring held.
+  void TriggerAsync();
+
+  void Close(
+      v8::Local<v8::Value> close_callback = v8::Local<v8::Value>()) override;
+
+  TransferMode GetTransferMode() const override;
+  std::unique_ptr<worker::TransferData> CloneForMessaging() const override;
+
+  class TransferData : public worker::TransferData {
+   public:
+    explicit TransferData(std::shared_ptr<SharedRing> ring);
+    ~TransferData() override;
+
+    BaseObjectPtr<BaseObject> Deserialize(
+        Environment* env,
+        v8::Local<v8::Context> context,
+        std::unique_ptr<worker::TransferData> self) override;
+
+    void MemoryInfo(MemoryTracker* tracker) const override;
+    SET_MEMORY_INFO_NAME(RingWriter::TransferData)
+    SET_SELF_SIZE(TransferData)
+
+   private:
+    std::shared_ptr<SharedRing> ring_;
+  };
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(RingWriter)
+  SET_SELF_SIZE(RingWriter)
+
+ private:
+  RingWriter(Environment* env,
+             v8::Local<v8::Object> wrap,
+             std::shared_ptr<SharedRing> ring);
+
+  void OnDrain();
+
+  std::shared_ptr<SharedRing> ring_;
+  uv_async_t async_;
+};
+
+}  // namespace worker
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_RING_CHANNEL_H_
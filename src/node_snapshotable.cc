@@ -739,6 +739,7 @@ size_t FileWriter::Write(const SnapshotMetadata& data) {
 // [    ...       ]  v8_snapshot_blob_data from SnapshotCreator::CreateBlob()
 // [    ...       ]  isolate_data_info
 // [    ...       ]  env_info
+// [    ...       ]  worker_env_info
 // [    ...       ]  code_cache
 
 void SnapshotData::ToBlob(FILE* out) const {
@@ -757,6 +758,8 @@ void SnapshotData::ToBlob(FILE* out) const {
   w.Debug("Write isolate_data_indices\n");
   written_total += w.Write<IsolateDataSerializeInfo>(isolate_data_info);
   written_total += w.Write<EnvSerializeInfo>(env_info);
+  w.Debug("Write worker_env_info\n");
+  written_total += w.Write<EnvSerializeInfo>(worker_env_info);
   w.Debug("Write code_cache\n");
   written_total += w.WriteVector<builtins::CodeCacheInfo>(code_cache);
   w.Debug("SnapshotData::ToBlob() Wrote %d bytes\n", written_total);
@@ -782,6 +785,8 @@ bool SnapshotData::FromBlob(SnapshotData* out, FILE* in) {
   r.Debug("Read isolate_data_info\n");
   out->isolate_data_info = r.Read<IsolateDataSerializeInfo>();
   out->env_info = r.Read<EnvSerializeInfo>();
+  r.Debug("Read worker_env_info\n");
+  out->worker_env_info = r.Read<EnvSerializeInfo>();
   r.Debug("Read code_cache\n");
   out->code_cache = r.ReadVector<builtins::CodeCacheInfo>();
 
@@ -937,6 +942,11 @@ static const int v8_snapshot_blob_size = )"
      << R"(
   // -- env_info ends --
   ,
+  // -- worker_env_info begins --
+)" << data->worker_env_info
+     << R"(
+  // -- worker_env_info ends --
+  ,
   // -- code_cache begins --
   {)";
   for (const auto& item : data->code_cache) {
@@ -991,6 +1001,7 @@ int SnapshotBuilder::Generate(SnapshotData* out,
       true, 10, v8::StackTrace::StackTraceOptions::kDetailed);
 
   Environment* env = nullptr;
+  Environment* worker_env = nullptr;
   std::unique_ptr<NodeMainInstance> main_instance =
       NodeMainInstance::Create(isolate,
                                uv_default_loop(),
@@ -1006,6 +1017,9 @@ int SnapshotBuilder::Generate(SnapshotData* out,
     if (env != nullptr) {
       FreeEnvironment(env);
     }
+    if (worker_env != nullptr) {
+      FreeEnvironment(worker_env);
+    }
     main_instance->Dispose();
     per_process::v8_platform.Platform()->UnregisterIsolate(isolate);
   });
@@ -1087,8 +1101,6 @@ int SnapshotBuilder::Generate(SnapshotData* out,
       }
 
       // Serialize the native states
-      out->isolate_data_info =
-          main_instance->isolate_data()->Serialize(&creator);
       out->env_info = env->Serialize(&creator);
 
 #ifdef NODE_USE_NODE_CODE_CACHE
@@ -1107,6 +1119,36 @@ int SnapshotBuilder::Generate(SnapshotData* out,
 #endif
     }
 
+    // The context that workers start from. It is bootstrapped without any of
+    // the user code above, and without the parts of the bootstrap that depend
+    // on the kind of thread, which the worker runs after deserializing it.
+    Local<Context> worker_context = NewContext(isolate);
+    if (worker_context.IsEmpty()) {
+      return BOOTSTRAP_ERROR;
+    }
+    {
+      Context::Scope context_scope(worker_context);
+
+      // Workers never own the process state.
+      worker_env = new Environment(main_instance->isolate_data(),
+                                   worker_context,
+                                   args,
+                                   exec_args,
+                                   nullptr,
+                                   node::EnvironmentFlags::kNoFlags,
+                                   {});
+      if (worker_env->BootstrapInternalLoaders().IsEmpty() ||
+          worker_env->BootstrapNode().IsEmpty()) {
+        return BOOTSTRAP_ERROR;
+      }
+      out->worker_env_info = worker_env->Serialize(&creator);
+    }
+
+    // Only now that both Environments are bootstrapped are all per-isolate
+    // templates in place.
+    out->isolate_data_info =
+        main_instance->isolate_data()->Serialize(&creator);
+
     // Global handles to the contexts can't be disposed before the
     // blob is created. So initialize all the contexts before adding them.
     // TODO(joyeecheung): figure out how to remove this restriction.
@@ -1116,6 +1158,9 @@ int SnapshotBuilder::Generate(SnapshotData* out,
     index = creator.AddContext(main_context,
                                {SerializeNodeContextInternalFields, env});
     CHECK_EQ(index, SnapshotData::kNodeMainContextIndex);
+    index = creator.AddContext(
+        worker_context, {SerializeNodeContextInternalFields, worker_env});
+    CHECK_EQ(index, SnapshotData::kNodeWorkerContextIndex);
   }
 
   // Must be out of HandleScope
@@ -1138,7 +1183,9 @@ int SnapshotBuilder::Generate(SnapshotData* out,
   // no handles are left open in the environment after the blob is created
   // (which should trigger a GC and close all handles that can be closed).
   bool queues_are_empty =
-      env->req_wrap_queue()->IsEmpty() && env->handle_wrap_queue()->IsEmpty();
+      env->req_wrap_queue()->IsEmpty() && env->handle_wrap_queue()->IsEmpty() &&
+      worker_env->req_wrap_queue()->IsEmpty() &&
+      worker_env->handle_wrap_queue()->IsEmpty();
   if (!queues_are_empty ||
       per_process::enabled_debug_list.enabled(DebugCategory::MKSNAPSHOT)) {
     PrintLibuvHandleInformation(env->event_loop(), stderr);
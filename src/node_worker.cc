@@ -177,20 +177,29 @@ class WorkerThreadData {
       isolate->SetStackLimit(w->stack_base_);
 
       HandleScope handle_scope(isolate);
-      isolate_data_.reset(CreateIsolateData(isolate,
-                                            &loop_,
-                                            w_->platform_,
-                                            allocator.get()));
+      // When the isolate was created from the snapshot, the per-isolate
+      // strings and templates can be deserialized from it as well instead of
+      // being created from scratch.
+      const SnapshotData* snapshot_data = w_->snapshot_data();
+      isolate_data_.reset(new IsolateData(
+          isolate,
+          &loop_,
+          w_->platform_,
+          allocator.get(),
+          snapshot_data == nullptr ? nullptr
+                                   : &snapshot_data->isolate_data_info));
       CHECK(isolate_data_);
       if (w_->per_isolate_opts_)
         isolate_data_->set_options(std::move(w_->per_isolate_opts_));
       isolate_data_->set_worker_context(w_);
+      isolate_data_->set_snapshot_data(snapshot_data);
       isolate_data_->max_young_gen_size =
           params.constraints.max_young_generation_size_in_bytes();
     }
 
     Mutex::ScopedLock lock(w_->mutex_);
     w_->isolate_ = isolate;
+    w_->startup_milestones_[kStartupIsolateCreated] = uv_hrtime();
   }
 
   ~WorkerThreadData() {
@@ -258,6 +267,7 @@ void Worker::Run() {
       "__metadata", "thread_name", "name",
       TRACE_STR_COPY(name.c_str()));
   CHECK_NOT_NULL(platform_);
+  MarkStartupMilestone(kStartupThreadStart);
 
   Debug(this, "Creating isolate for worker with id %llu", thread_id_.id);
 
@@ -294,7 +304,20 @@ void Worker::Run() {
     {
       HandleScope handle_scope(isolate_);
       Local<Context> context;
-      {
+      if (deserialize_environment_) {
+        // The Environment and its Context are deserialized together.
+        env_.reset(CreateWorkerEnvironmentFromSnapshot(
+            data.isolate_data_.get(),
+            snapshot_data_,
+            std::move(argv_),
+            std::move(exec_argv_),
+            static_cast<EnvironmentFlags::Flags>(environment_flags_),
+            thread_id_,
+            std::move(inspector_parent_handle_)));
+        if (is_stopped()) return;
+        CHECK_NOT_NULL(env_);
+        context = env_->context();
+      } else {
         // We create the Context object before we have an Environment* in place
         // that we could use for error handling. If creation fails due to
         // resource constraints, we need something in place to handle it,
@@ -321,16 +344,18 @@ void Worker::Run() {
       CHECK(!context.IsEmpty());
       Context::Scope context_scope(context);
       {
-        env_.reset(CreateEnvironment(
-            data.isolate_data_.get(),
-            context,
-            std::move(argv_),
-            std::move(exec_argv_),
-            static_cast<EnvironmentFlags::Flags>(environment_flags_),
-            thread_id_,
-            std::move(inspector_parent_handle_)));
-        if (is_stopped()) return;
-        CHECK_NOT_NULL(env_);
+        if (!env_) {
+          env_.reset(CreateEnvironment(
+              data.isolate_data_.get(),
+              context,
+              std::move(argv_),
+              std::move(exec_argv_),
+              static_cast<EnvironmentFlags::Flags>(environment_flags_),
+              thread_id_,
+              std::move(inspector_parent_handle_)));
+          if (is_stopped()) return;
+          CHECK_NOT_NULL(env_);
+        }
         env_->set_env_vars(std::move(env_vars_));
         SetProcessExitHandler(env_.get(), [this](Environment*, int exit_code) {
           Exit(exit_code);
@@ -340,6 +365,7 @@ void Worker::Run() {
         Mutex::ScopedLock lock(mutex_);
         if (stopped_) return;
         this->env_ = env_.get();
+        startup_milestones_[kStartupEnvironmentCreated] = uv_hrtime();
       }
       Debug(this, "Created Environment for worker with id %llu", thread_id_.id);
       if (is_stopped()) return;
@@ -352,6 +378,7 @@ void Worker::Run() {
         if (LoadEnvironment(env_.get(), StartExecutionCallback{}).IsEmpty())
           return;
 
+        MarkStartupMilestone(kStartupBootstrapComplete);
         Debug(this, "Loaded environment for worker %llu", thread_id_.id);
       }
     }
@@ -568,9 +595,11 @@ void Worker::New(const FunctionCallbackInfo<Value>& args) {
     exec_argv_out = env->exec_argv();
   }
 
-  bool use_node_snapshot = per_process::cli_options->node_snapshot;
-  const SnapshotData* snapshot_data =
-      use_node_snapshot ? SnapshotBuilder::GetEmbeddedSnapshotData() : nullptr;
+  // Start from the snapshot that the parent was started from, which may be
+  // one that was built with --build-snapshot.
+  const SnapshotData* snapshot_data = env->isolate_data()->snapshot_data();
+  if (snapshot_data == nullptr && per_process::cli_options->node_snapshot)
+    snapshot_data = SnapshotBuilder::GetEmbeddedSnapshotData();
 
   Worker* worker = new Worker(env,
                               args.This(),
@@ -597,6 +626,13 @@ void Worker::New(const FunctionCallbackInfo<Value>& args) {
     worker->environment_flags_ |= EnvironmentFlags::kNoGlobalSearchPaths;
   if (env->no_browser_globals())
     worker->environment_flags_ |= EnvironmentFlags::kNoBrowserGlobals;
+
+  // The worker context in the snapshot was bootstrapped with the options of
+  // the process and with browser globals. Workers with options of their own
+  // or without browser globals have to be bootstrapped from scratch.
+  worker->deserialize_environment_ =
+      snapshot_data != nullptr && !per_isolate_opts &&
+      !(worker->environment_flags_ & EnvironmentFlags::kNoBrowserGlobals);
 }
 
 void Worker::StartThread(const FunctionCallbackInfo<Value>& args) {
@@ -605,6 +641,7 @@ void Worker::StartThread(const FunctionCallbackInfo<Value>& args) {
   Mutex::ScopedLock lock(w->mutex_);
 
   w->stopped_ = false;
+  w->startup_milestones_[kStartupSpawnStart] = uv_hrtime();
 
   if (w->resource_limits_[kStackSizeMb] > 0) {
     if (w->resource_limits_[kStackSizeMb] * kMB < kStackBufferSize) {
@@ -714,6 +751,30 @@ Local<Float64Array> Worker::GetResourceLimits(Isolate* isolate) const {
   return Float64Array::New(ab, 0, kTotalResourceLimitCount);
 }
 
+void Worker::GetStartupMilestones(const FunctionCallbackInfo<Value>& args) {
+  Worker* w;
+  ASSIGN_OR_RETURN_UNWRAP(&w, args.This());
+
+  const double time_origin = static_cast<double>(w->env()->time_origin());
+  Local<ArrayBuffer> ab = ArrayBuffer::New(
+      args.GetIsolate(), kTotalStartupMilestoneCount * sizeof(double));
+  double* milestones = static_cast<double*>(ab->Data());
+  {
+    Mutex::ScopedLock lock(w->mutex_);
+    for (size_t i = 0; i < kTotalStartupMilestoneCount; i++) {
+      const uint64_t time = w->startup_milestones_[i];
+      milestones[i] = time == 0 ? -1 : (time - time_origin) / 1e6;
+    }
+  }
+  args.GetReturnValue().Set(
+      Float64Array::New(ab, 0, kTotalStartupMilestoneCount));
+}
+
+void Worker::MarkStartupMilestone(StartupMilestones milestone) {
+  Mutex::ScopedLock lock(mutex_);
+  startup_milestones_[milestone] = uv_hrtime();
+}
+
 void Worker::Exit(int code, const char* error_code, const char* error_message) {
   Mutex::ScopedLock lock(mutex_);
   Debug(this, "Worker %llu called Exit(%d, %s, %s)",
@@ -855,6 +916,8 @@ void InitWorker(Local<Object> target,
     SetProtoMethod(isolate, w, "takeHeapSnapshot", Worker::TakeHeapSnapshot);
     SetProtoMethod(isolate, w, "loopIdleTime", Worker::LoopIdleTime);
     SetProtoMethod(isolate, w, "loopStartTime", Worker::LoopStartTime);
+    SetProtoMethod(
+        isolate, w, "getStartupMilestones", Worker::GetStartupMilestones);
 
     SetConstructorFunction(context, target, "Worker", w);
   }
@@ -905,6 +968,12 @@ void InitWorker(Local<Object> target,
   NODE_DEFINE_CONSTANT(target, kCodeRangeSizeMb);
   NODE_DEFINE_CONSTANT(target, kStackSizeMb);
   NODE_DEFINE_CONSTANT(target, kTotalResourceLimitCount);
+  NODE_DEFINE_CONSTANT(target, kStartupSpawnStart);
+  NODE_DEFINE_CONSTANT(target, kStartupThreadStart);
+  NODE_DEFINE_CONSTANT(target, kStartupIsolateCreated);
+  NODE_DEFINE_CONSTANT(target, kStartupEnvironmentCreated);
+  NODE_DEFINE_CONSTANT(target, kStartupBootstrapComplete);
+  NODE_DEFINE_CONSTANT(target, kTotalStartupMilestoneCount);
 }
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
@@ -919,6 +988,7 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(Worker::TakeHeapSnapshot);
   registry->Register(Worker::LoopIdleTime);
   registry->Register(Worker::LoopStartTime);
+  registry->Register(Worker::GetStartupMilestones);
 }
 
 }  // anonymous namespace
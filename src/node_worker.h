@@ -23,6 +23,17 @@ enum ResourceLimits {
   kTotalResourceLimitCount
 };
 
+// Points in time during the startup of a worker thread, see
+// Worker::GetStartupMilestones().
+enum StartupMilestones {
+  kStartupSpawnStart,
+  kStartupThreadStart,
+  kStartupIsolateCreated,
+  kStartupEnvironmentCreated,
+  kStartupBootstrapComplete,
+  kTotalStartupMilestoneCount
+};
+
 // A worker thread, as represented in its parent thread.
 class Worker : public AsyncWrap {
  public:
@@ -74,8 +85,16 @@ class Worker : public AsyncWrap {
   static void TakeHeapSnapshot(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void LoopIdleTime(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void LoopStartTime(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // Returns a Float64Array with the time at which each startup milestone was
+  // reached, in milliseconds relative to the time origin of the parent
+  // thread, or -1 for milestones that have not been reached (yet).
+  static void GetStartupMilestones(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
 
  private:
+  // Records the current time for `milestone`. May be called from any thread.
+  void MarkStartupMilestone(StartupMilestones milestone);
+
   bool CreateEnvMessagePort(Environment* env);
   static size_t NearHeapLimit(void* data, size_t current_heap_limit,
                               size_t initial_heap_limit);
@@ -103,6 +122,9 @@ class Worker : public AsyncWrap {
   double resource_limits_[kTotalResourceLimitCount];
   void UpdateResourceConstraints(v8::ResourceConstraints* constraints);
 
+  // High-resolution timestamps in nanoseconds, 0 if not reached yet.
+  uint64_t startup_milestones_[kTotalStartupMilestoneCount] = {};
+
   // Full size of the thread's stack.
   size_t stack_size_ = 4 * 1024 * 1024;
   // Stack buffer size that is not available to the JS engine.
@@ -127,6 +149,9 @@ class Worker : public AsyncWrap {
   Environment* env_ = nullptr;
 
   const SnapshotData* snapshot_data_ = nullptr;
+  // Whether the Environment is deserialized from the worker context of
+  // `snapshot_data_` instead of being bootstrapped from scratch.
+  bool deserialize_environment_ = false;
   friend class WorkerThreadData;
 };
 
@@ -1,8 +1,16 @@
 #include "stream_pipe.h"
 #include "stream_base-inl.h"
 #include "node_buffer.h"
+#include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
 namespace node {
 
 using v8::BackingStore;
@@ -11,11 +19,14 @@ using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Int32;
+using v8::Integer;
 using v8::Isolate;
 using v8::Just;
 using v8::Local;
 using v8::Maybe;
 using v8::Nothing;
+using v8::Number;
 using v8::Object;
 using v8::Value;
 
@@ -307,6 +318,203 @@ void StreamPipe::PendingWrites(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(pipe->pending_writes_);
 }
 
+#ifdef __linux__
+namespace {
+
+// Upper bound for the data sent by a single threadpool round, so that a fast
+// receiver does not occupy a threadpool thread for the whole file.
+constexpr uint64_t kMaxBytesPerRound = 16 * 1024 * 1024;
+// Returned by SendChunks() when the round ended because of that limit.
+constexpr int kSendYield = 1;
+
+}  // anonymous namespace
+
+class SendFilePipe::SendFileWork final : public ThreadPoolWork {
+ public:
+  explicit SendFileWork(SendFilePipe* pipe)
+      : ThreadPoolWork(pipe->env()), pipe_(pipe) {}
+
+  void DoThreadPoolWork() override { result_ = pipe_->SendChunks(); }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<SendFileWork> self(this);
+    CHECK_EQ(status, 0);
+    pipe_->AfterSend(result_);
+  }
+
+ private:
+  BaseObjectPtr<SendFilePipe> pipe_;
+  int result_ = 0;
+};
+
+SendFilePipe::SendFilePipe(Environment* env,
+                           Local<Object> obj,
+                           int in_fd,
+                           int out_fd,
+                           int64_t position,
+                           int64_t length)
+    : AsyncWrap(env, obj, AsyncWrap::PROVIDER_STREAMPIPE),
+      in_fd_(in_fd),
+      sink_fd_(out_fd),
+      position_(position),
+      remaining_(length) {
+  MakeWeak();
+}
+
+SendFilePipe::~SendFilePipe() {
+  CHECK(!is_sending_);
+  ClosePoll();
+}
+
+int SendFilePipe::SendChunks() {
+  uint64_t sent = 0;
+  while (remaining_ != 0) {
+    if (sent >= kMaxBytesPerRound)
+      return kSendYield;
+
+    size_t length = kMaxBytesPerRound;
+    if (remaining_ > 0 && static_cast<uint64_t>(remaining_) < length)
+      length = static_cast<size_t>(remaining_);
+
+    off_t offset = position_;
+    ssize_t n =
+        sendfile(out_fd_, in_fd_, position_ < 0 ? nullptr : &offset, length);
+    if (n == -1) {
+      if (errno == EINTR)
+        continue;
+      // This includes UV_EAGAIN when the socket buffer is full.
+      return -errno;
+    }
+    if (n == 0)  // End of file.
+      break;
+
+    sent += n;
+    bytes_sent_ += n;
+    if (position_ >= 0)
+      position_ = offset;
+    if (remaining_ > 0)
+      remaining_ -= n;
+  }
+  return 0;
+}
+
+void SendFilePipe::ScheduleSend() {
+  is_sending_ = true;
+  (new SendFileWork(this))->ScheduleWork();
+}
+
+void SendFilePipe::AfterSend(int status) {
+  is_sending_ = false;
+  if (is_canceled_)
+    return Finish(status == 0 ? 0 : UV_ECANCELED);
+  if (status == kSendYield)
+    return ScheduleSend();
+  if (status != UV_EAGAIN)
+    return Finish(status);
+
+  int err = uv_poll_start(poll_, UV_WRITABLE | UV_DISCONNECT, OnWritable);
+  if (err != 0)
+    Finish(err);
+}
+
+void SendFilePipe::OnWritable(uv_poll_t* handle, int status, int events) {
+  SendFilePipe* pipe = static_cast<SendFilePipe*>(handle->data);
+  uv_poll_stop(handle);
+  if (status < 0)
+    return pipe->Finish(status);
+  pipe->ScheduleSend();
+}
+
+void SendFilePipe::Finish(int status) {
+  CHECK(!is_sending_);
+  CHECK(!is_closed_);
+  is_closed_ = true;
+  ClosePoll();
+
+  // Report back asynchronously, since this can be called from unpipe().
+  BaseObjectPtr<SendFilePipe> strong_ref{this};
+  env()->SetImmediate([this, strong_ref, status](Environment* env) {
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+    MakeWeak();
+    Local<Value> argv[] = {
+        Integer::New(env->isolate(), status),
+        Number::New(env->isolate(), static_cast<double>(bytes_sent_)),
+    };
+    MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+  });
+}
+
+void SendFilePipe::ClosePoll() {
+  if (poll_ == nullptr)
+    return;
+  const int fd = out_fd_;
+  env()->CloseHandle(poll_, [fd](uv_poll_t* handle) {
+    close(fd);
+    delete handle;
+  });
+  poll_ = nullptr;
+  out_fd_ = -1;
+}
+
+void SendFilePipe::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsInt32());   // fd
+  CHECK(args[1]->IsNumber());  // position, or -1
+  CHECK(args[2]->IsNumber());  // length, or -1
+  CHECK(args[3]->IsObject());  // sink
+  StreamBase* sink = StreamBase::FromObject(args[3].As<Object>());
+  CHECK_NOT_NULL(sink);
+
+  new SendFilePipe(env,
+                   args.This(),
+                   args[0].As<Int32>()->Value(),
+                   sink->GetFD(),
+                   static_cast<int64_t>(args[1].As<Number>()->Value()),
+                   static_cast<int64_t>(args[2].As<Number>()->Value()));
+}
+
+void SendFilePipe::Start(const FunctionCallbackInfo<Value>& args) {
+  SendFilePipe* pipe;
+  ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
+  CHECK(pipe->is_closed_);
+  CHECK_NULL(pipe->poll_);
+
+  if (pipe->sink_fd_ < 0)
+    return args.GetReturnValue().Set(UV_EBADF);
+  const int fd = fcntl(pipe->sink_fd_, F_DUPFD_CLOEXEC, 0);
+  if (fd == -1)
+    return args.GetReturnValue().Set(-errno);
+
+  uv_poll_t* poll = new uv_poll_t;
+  int err = uv_poll_init(pipe->env()->event_loop(), poll, fd);
+  if (err != 0) {
+    delete poll;
+    close(fd);
+    return args.GetReturnValue().Set(err);
+  }
+  poll->data = pipe;
+  pipe->poll_ = poll;
+  pipe->out_fd_ = fd;
+  pipe->is_closed_ = false;
+  pipe->ClearWeak();
+  pipe->ScheduleSend();
+  args.GetReturnValue().Set(0);
+}
+
+void SendFilePipe::Unpipe(const FunctionCallbackInfo<Value>& args) {
+  SendFilePipe* pipe;
+  ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
+  if (pipe->is_closed_ || pipe->is_canceled_)
+    return;
+  pipe->is_canceled_ = true;
+  // A running threadpool round finishes the pipe once it returns.
+  if (!pipe->is_sending_)
+    pipe->Finish(UV_ECANCELED);
+}
+#endif  // __linux__
+
 namespace {
 
 void InitializeStreamPipe(Local<Object> target,
@@ -326,6 +534,17 @@ void InitializeStreamPipe(Local<Object> target,
   pipe->InstanceTemplate()->SetInternalFieldCount(
       StreamPipe::kInternalFieldCount);
   SetConstructorFunction(context, target, "StreamPipe", pipe);
+
+#ifdef __linux__
+  Local<FunctionTemplate> sendfile_pipe =
+      NewFunctionTemplate(isolate, SendFilePipe::New);
+  SetProtoMethod(isolate, sendfile_pipe, "start", SendFilePipe::Start);
+  SetProtoMethod(isolate, sendfile_pipe, "unpipe", SendFilePipe::Unpipe);
+  sendfile_pipe->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  sendfile_pipe->InstanceTemplate()->SetInternalFieldCount(
+      SendFilePipe::kInternalFieldCount);
+  SetConstructorFunction(context, target, "SendFilePipe", sendfile_pipe);
+#endif
 }
 
 }  // anonymous namespace
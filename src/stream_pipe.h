@@ -69,6 +69,57 @@ class StreamPipe : public AsyncWrap {
   WritableListener writable_listener_;
 };
 
+#ifdef __linux__
+// Copies a file into the file descriptor of a TCP or pipe stream with
+// sendfile(2), so that its contents never pass through userland buffers.
+// The copying happens on the threadpool. Whenever the socket buffer fills
+// up, the stream is polled for writability before the next round starts.
+class SendFilePipe : public AsyncWrap {
+ public:
+  ~SendFilePipe() override;
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Unpipe(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(SendFilePipe)
+  SET_SELF_SIZE(SendFilePipe)
+
+ private:
+  class SendFileWork;
+
+  SendFilePipe(Environment* env,
+               v8::Local<v8::Object> obj,
+               int in_fd,
+               int out_fd,
+               int64_t position,
+               int64_t length);
+
+  int SendChunks();
+  void ScheduleSend();
+  void AfterSend(int status);
+  void Finish(int status);
+  void ClosePoll();
+  static void OnWritable(uv_poll_t* handle, int status, int events);
+
+  const int in_fd_;
+  const int sink_fd_;
+  // A duplicate of `sink_fd_` that is owned by this object, so that closing
+  // the stream does not pull the descriptor away from a running sendfile().
+  int out_fd_ = -1;
+  // -1 means that the file position of `in_fd_` is used and updated.
+  int64_t position_;
+  // -1 means that the file is sent up to its end.
+  int64_t remaining_;
+  uint64_t bytes_sent_ = 0;
+  uv_poll_t* poll_ = nullptr;
+  bool is_sending_ = false;
+  bool is_canceled_ = false;
+  bool is_closed_ = true;
+};
+#endif  // __linux__
+
 }  // namespace node
 
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
@@ -25,6 +25,7 @@
 #include "env-inl.h"
 #include "node_buffer.h"
 #include "node_errors.h"
+#include "utf8_utils.h"
 #include "util.h"
 
 #include <climits>
@@ -328,6 +329,25 @@ size_t StringBytes::Write(Isolate* isolate,
 
     case BUFFER:
     case UTF8:
+      // If the part of a one-byte string that fits is ASCII, its UTF-8
+      // encoding is the same as its Latin-1 encoding, which can be copied
+      // out without transcoding.
+      if (str->IsExternalOneByte()) {
+        auto ext = str->GetExternalOneByteStringResource();
+        nbytes = std::min(buflen, ext->length());
+        if (IsAscii(ext->data(), nbytes)) {
+          memcpy(buf, ext->data(), nbytes);
+          break;
+        }
+      } else if (str->IsOneByte() &&
+                 static_cast<size_t>(str->Length()) <= buflen &&
+                 str->Utf8Length(isolate) == str->Length()) {
+        // Every character outside of ASCII takes up more than one byte in
+        // UTF-8, so the string is ASCII if the lengths match.
+        uint8_t* const dst = reinterpret_cast<uint8_t*>(buf);
+        nbytes = str->WriteOneByte(isolate, dst, 0, buflen, flags);
+        break;
+      }
       nbytes = str->WriteUtf8(isolate, buf, buflen, nullptr, flags);
       break;
 
@@ -350,6 +370,26 @@ size_t StringBytes::Write(Isolate* isolate,
       if (str->IsExternalOneByte()) {
         auto ext = str->GetExternalOneByteStringResource();
         nbytes = base64_decode(buf, buflen, ext->data(), ext->length());
+      } else if (str->IsOneByte()) {
+        // Copying one-byte strings out as-is lets base64_decode() use the
+        // SIMD codecs, which only handle the standard alphabet. The decoder
+        // accepts both alphabets, so translating our private copy is safe.
+        MaybeStackBuffer<char> value(str->Length());
+        str->WriteOneByte(isolate,
+                          reinterpret_cast<uint8_t*>(value.out()),
+                          0,
+                          -1,
+                          String::NO_NULL_TERMINATION);
+        if (encoding == BASE64URL) {
+          char* data = value.out();
+          for (size_t i = 0; i < value.length(); i++) {
+            if (data[i] == '-')
+              data[i] = '+';
+            else if (data[i] == '_')
+              data[i] = '/';
+          }
+        }
+        nbytes = base64_decode(buf, buflen, value.out(), value.length());
       } else {
         String::Value value(isolate, str);
         nbytes = base64_decode(buf, buflen, *value, value.length());
@@ -468,59 +508,6 @@ Maybe<size_t> StringBytes::Size(Isolate* isolate,
 }
 
 
-
-
-static bool contains_non_ascii_slow(const char* buf, size_t len) {
-  for (size_t i = 0; i < len; ++i) {
-    if (buf[i] & 0x80)
-      return true;
-  }
-  return false;
-}
-
-
-static bool contains_non_ascii(const char* src, size_t len) {
-  if (len < 16) {
-    return contains_non_ascii_slow(src, len);
-  }
-
-  const unsigned bytes_per_word = sizeof(uintptr_t);
-  const unsigned align_mask = bytes_per_word - 1;
-  const unsigned unaligned = reinterpret_cast<uintptr_t>(src) & align_mask;
-
-  if (unaligned > 0) {
-    const unsigned n = bytes_per_word - unaligned;
-    if (contains_non_ascii_slow(src, n))
-      return true;
-    src += n;
-    len -= n;
-  }
-
-
-#if defined(_WIN64) || defined(_LP64)
-  const uintptr_t mask = 0x8080808080808080ll;
-#else
-  const uintptr_t mask = 0x80808080l;
-#endif
-
-  const uintptr_t* srcw = reinterpret_cast<const uintptr_t*>(src);
-
-  for (size_t i = 0, n = len / bytes_per_word; i < n; ++i) {
-    if (srcw[i] & mask)
-      return true;
-  }
-
-  const unsigned remainder = len & align_mask;
-  if (remainder > 0) {
-    const size_t offset = len - remainder;
-    if (contains_non_ascii_slow(src + offset, remainder))
-      return true;
-  }
-
-  return false;
-}
-
-
 static void force_ascii_slow(const char* src, char* dst, size_t len) {
   for (size_t i = 0; i < len; ++i) {
     dst[i] = src[i] & 0x7f;
@@ -609,6 +596,43 @@ std::string StringBytes::hex_encode(const char* src, size_t slen) {
   } while (0)
 
 
+// Decodes well-formed UTF-8 that starts with `ascii_length` bytes of ASCII
+// into a one-byte string if all of it fits into Latin-1, and into a two-byte
+// string otherwise.
+static MaybeLocal<Value> DecodeValidUtf8(Isolate* isolate,
+                                         const char* buf,
+                                         size_t buflen,
+                                         size_t ascii_length,
+                                         Local<Value>* error) {
+  bool is_latin1;
+  const size_t length =
+      ascii_length +
+      Utf16Length(buf + ascii_length, buflen - ascii_length, &is_latin1);
+
+  if (is_latin1) {
+    char* dst = node::UncheckedMalloc(length);
+    if (dst == nullptr) {
+      *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
+      return MaybeLocal<Value>();
+    }
+    memcpy(dst, buf, ascii_length);
+    size_t written = Utf8ToLatin1(
+        buf + ascii_length, buflen - ascii_length, dst + ascii_length);
+    CHECK_EQ(ascii_length + written, length);
+    return ExternOneByteString::New(isolate, dst, length, error);
+  }
+
+  uint16_t* dst = node::UncheckedMalloc<uint16_t>(length);
+  if (dst == nullptr) {
+    *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
+    return MaybeLocal<Value>();
+  }
+  size_t written = Utf8ToUtf16(buf, buflen, dst);
+  CHECK_EQ(written, length);
+  return ExternTwoByteString::New(isolate, dst, length, error);
+}
+
+
 MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
                                       const char* buf,
                                       size_t buflen,
@@ -634,7 +658,7 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
       }
 
     case ASCII:
-      if (contains_non_ascii(buf, buflen)) {
+      if (!IsAscii(buf, buflen)) {
         char* out = node::UncheckedMalloc(buflen);
         if (out == nullptr) {
           *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
@@ -648,6 +672,14 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
 
     case UTF8:
       {
+        // ASCII is a subset of both UTF-8 and Latin-1, and V8 can create
+        // one-byte strings from Latin-1 without decoding it.
+        const size_t ascii_length = FindNonAscii(buf, buflen);
+        if (ascii_length == buflen)
+          return ExternOneByteString::NewFromCopy(isolate, buf, buflen, error);
+        // Malformed input is left to V8, which replaces invalid sequences.
+        if (IsValidUtf8(buf + ascii_length, buflen - ascii_length))
+          return DecodeValidUtf8(isolate, buf, buflen, ascii_length, error);
         val = String::NewFromUtf8(isolate,
                                   buf,
                                   v8::NewStringType::kNormal,
@@ -0,0 +1,719 @@
+#include "utf8_utils.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__) ||                                 \
+    (defined(__i386__) && defined(__SSE2__)) ||                                \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NODE_UTF8_SSE2 1
+#include <emmintrin.h>
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+// SSSE3 and AVX2 code is compiled with function-level target attributes and
+// only called after checking that the CPU supports it.
+#define NODE_UTF8_X86_DISPATCH 1
+#include <immintrin.h>
+#define NODE_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define NODE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+// NEON is always available on arm64.
+#define NODE_UTF8_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace node {
+
+namespace {
+
+using FindNonAsciiFn = size_t (*)(const uint8_t*, size_t);
+using IsValidUtf8Fn = bool (*)(const uint8_t*, size_t);
+
+inline unsigned CountTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;  // NOLINT(runtime/int)
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+inline unsigned CountOnes(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  // __popcnt() requires the POPCNT instruction, which SSE2 does not imply.
+  mask = mask - ((mask >> 1) & 0x55555555);
+  mask = (mask & 0x33333333) + ((mask >> 2) & 0x33333333);
+  return (((mask + (mask >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+#else
+  return __builtin_popcount(mask);
+#endif
+}
+
+size_t FindNonAsciiScalar(const uint8_t* data, size_t length) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    if (word & 0x8080808080808080ULL)
+      break;
+  }
+  for (; i < length; i++) {
+    if (data[i] & 0x80)
+      return i;
+  }
+  return length;
+}
+
+// Validates the multi-byte sequence starting at data[0], which must be a
+// non-ASCII byte, against Table 3-7 of the Unicode Standard. Returns the
+// length of the sequence, or 0 if it is malformed or truncated.
+size_t ValidateSequence(const uint8_t* data, size_t length) {
+  const uint8_t lead = data[0];
+  uint8_t lower = 0x80;
+  uint8_t upper = 0xBF;
+  size_t size;
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    size = 2;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    size = 3;
+    if (lead == 0xE0) lower = 0xA0;  // Overlong.
+    if (lead == 0xED) upper = 0x9F;  // Surrogates.
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    size = 4;
+    if (lead == 0xF0) lower = 0x90;  // Overlong.
+    if (lead == 0xF4) upper = 0x8F;  // Above U+10FFFF.
+  } else {
+    return 0;
+  }
+  if (length < size || data[1] < lower || data[1] > upper)
+    return 0;
+  for (size_t i = 2; i < size; i++) {
+    if ((data[i] & 0xC0) != 0x80)
+      return 0;
+  }
+  return size;
+}
+
+// Skips runs of ASCII with `find_non_ascii` and checks the other sequences
+// one at a time. This is what the vectorized validators fall back to for
+// short inputs, and what is used when no vector unit is available.
+template <FindNonAsciiFn find_non_ascii>
+bool IsValidUtf8Scalar(const uint8_t* data, size_t length) {
+  size_t i = 0;
+  while (i < length) {
+    if (data[i] < 0x80) {
+      i += find_non_ascii(data + i, length - i);
+      continue;
+    }
+    size_t size = ValidateSequence(data + i, length - i);
+    if (size == 0)
+      return false;
+    i += size;
+  }
+  return true;
+}
+
+size_t Utf16LengthScalar(const uint8_t* data, size_t length, bool* is_latin1) {
+  size_t count = 0;
+  uint8_t max = 0;
+  for (size_t i = 0; i < length; i++) {
+    // Every byte but a continuation byte starts a code point, and code points
+    // of four bytes take up a surrogate pair.
+    count += (data[i] & 0xC0) != 0x80;
+    count += data[i] >= 0xF0;
+    max = std::max(max, data[i]);
+  }
+  // Lead bytes from 0xC4 up start code points from U+0100 up.
+  *is_latin1 = max < 0xC4;
+  return count;
+}
+
+// Decodes the well-formed sequence starting at data[0] and returns its
+// length.
+inline size_t DecodeSequence(const uint8_t* data, uint32_t* code_point) {
+  const uint32_t lead = data[0];
+  if (lead < 0x80) {
+    *code_point = lead;
+    return 1;
+  }
+  if (lead < 0xE0) {
+    *code_point = (lead & 0x1F) << 6 | (data[1] & 0x3F);
+    return 2;
+  }
+  if (lead < 0xF0) {
+    *code_point =
+        (lead & 0x0F) << 12 | (data[1] & 0x3F) << 6 | (data[2] & 0x3F);
+    return 3;
+  }
+  *code_point = (lead & 0x07) << 18 | (data[1] & 0x3F) << 12 |
+                (data[2] & 0x3F) << 6 | (data[3] & 0x3F);
+  return 4;
+}
+
+inline uint8_t* AppendCodePoint(uint32_t code_point, uint8_t* out) {
+  *out = static_cast<uint8_t>(code_point);
+  return out + 1;
+}
+
+inline uint16_t* AppendCodePoint(uint32_t code_point, uint16_t* out) {
+  if (code_point < 0x10000) {
+    *out = static_cast<uint16_t>(code_point);
+    return out + 1;
+  }
+  code_point -= 0x10000;
+  out[0] = static_cast<uint16_t>(0xD800 | (code_point >> 10));
+  out[1] = static_cast<uint16_t>(0xDC00 | (code_point & 0x3FF));
+  return out + 2;
+}
+
+// Converts blocks of kBlockSize bytes at once when `convert_ascii_block`
+// finds them to be ASCII, and decodes everything else one code point at a
+// time. After a block that is not ASCII, the next one starts right after the
+// last sequence that began in it.
+template <typename Char,
+          size_t kBlockSize,
+          bool (*convert_ascii_block)(const uint8_t*, Char*)>
+size_t Transcode(const uint8_t* data, size_t length, Char* out) {
+  Char* const start = out;
+  size_t i = 0;
+  while (i < length) {
+    if (i + kBlockSize <= length && convert_ascii_block(data + i, out)) {
+      i += kBlockSize;
+      out += kBlockSize;
+      continue;
+    }
+    const size_t end = std::min(length, i + kBlockSize);
+    while (i < end) {
+      uint32_t code_point;
+      i += DecodeSequence(data + i, &code_point);
+      out = AppendCodePoint(code_point, out);
+    }
+  }
+  return out - start;
+}
+
+inline bool ConvertAsciiBlockScalar(const uint8_t* data, uint8_t* out) {
+  uint64_t word;
+  memcpy(&word, data, sizeof(word));
+  if (word & 0x8080808080808080ULL)
+    return false;
+  memcpy(out, &word, sizeof(word));
+  return true;
+}
+
+inline bool ConvertAsciiBlockScalar(const uint8_t* data, uint16_t* out) {
+  uint64_t word;
+  memcpy(&word, data, sizeof(word));
+  if (word & 0x8080808080808080ULL)
+    return false;
+  for (size_t i = 0; i < sizeof(word); i++)
+    out[i] = data[i];
+  return true;
+}
+
+#if defined(NODE_UTF8_X86_DISPATCH) || defined(NODE_UTF8_NEON)
+// Lookup tables for the vectorized validation algorithm from
+// John Keiser and Daniel Lemire, "Validating UTF-8 In Less Than One
+// Instruction Per Byte", Software: Practice and Experience 51 (5), 2021.
+// Every byte is classified by the high and low nibbles of the byte before it
+// and the high nibble of the byte itself. The three table entries are ANDed,
+// so any bit that survives identifies an error, with the exception of
+// kTwoConts, which is expected exactly where a third or fourth byte of a
+// sequence is.
+constexpr uint8_t kTooShort = 1 << 0;    // 11______ 0_______
+                                         // 11______ 11______
+constexpr uint8_t kTooLong = 1 << 1;     // 0_______ 10______
+constexpr uint8_t kOverlong3 = 1 << 2;   // 11100000 100_____
+constexpr uint8_t kSurrogate = 1 << 4;   // 11101101 101_____
+constexpr uint8_t kOverlong2 = 1 << 5;   // 1100000_ 10______
+constexpr uint8_t kTwoConts = 1 << 7;    // 10______ 10______
+constexpr uint8_t kTooLarge = 1 << 3;    // 11110100 1001____
+                                         // 11110100 101_____
+                                         // 11110101 1001____
+                                         // 11110101 101_____
+                                         // 1111011_ 1001____
+                                         // 1111011_ 101_____
+                                         // 11111___ 1001____
+                                         // 11111___ 101_____
+constexpr uint8_t kTooLarge1000 = 1 << 6;
+                                         // 11110101 1000____
+                                         // 1111011_ 1000____
+                                         // 11111___ 1000____
+constexpr uint8_t kOverlong4 = 1 << 6;   // 11110000 1000____
+constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+alignas(16) constexpr uint8_t kByte1High[16] = {
+    // 0_______ ________ <ASCII in byte 1>
+    kTooLong, kTooLong, kTooLong, kTooLong,
+    kTooLong, kTooLong, kTooLong, kTooLong,
+    // 10______ ________ <continuation in byte 1>
+    kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+    // 1100____ ________ <two byte lead in byte 1>
+    kTooShort | kOverlong2,
+    // 1101____ ________ <two byte lead in byte 1>
+    kTooShort,
+    // 1110____ ________ <three byte lead in byte 1>
+    kTooShort | kOverlong3 | kSurrogate,
+    // 1111____ ________ <four+ byte lead in byte 1>
+    kTooShort | kTooLarge | kTooLarge1000 | kOverlong4,
+};
+
+alignas(16) constexpr uint8_t kByte1Low[16] = {
+    // ____0000 ________
+    kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+    // ____0001 ________
+    kCarry | kOverlong2,
+    // ____001_ ________
+    kCarry,
+    kCarry,
+    // ____0100 ________
+    kCarry | kTooLarge,
+    // ____0101 ________
+    kCarry | kTooLarge | kTooLarge1000,
+    // ____011_ ________
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    // ____1___ ________
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    // ____1101 ________
+    kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+};
+
+alignas(16) constexpr uint8_t kByte2High[16] = {
+    // ________ 0_______ <ASCII in byte 2>
+    kTooShort, kTooShort, kTooShort, kTooShort,
+    kTooShort, kTooShort, kTooShort, kTooShort,
+    // ________ 1000____
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 |
+        kOverlong4,
+    // ________ 1001____
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+    // ________ 101_____
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    // ________ 11______ <lead byte in byte 2>
+    kTooShort, kTooShort, kTooShort, kTooShort,
+};
+
+// A block ending in any of these needs bytes from the next block: the last
+// byte is a lead byte, or the second or third to last is a lead byte of a
+// three or four byte sequence.
+alignas(32) constexpr uint8_t kIncompleteMax[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+};
+#endif  // NODE_UTF8_X86_DISPATCH || NODE_UTF8_NEON
+
+#ifdef NODE_UTF8_SSE2
+size_t FindNonAsciiSSE2(const uint8_t* data, size_t length) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    uint32_t mask = _mm_movemask_epi8(v);
+    if (mask != 0)
+      return i + CountTrailingZeros(mask);
+  }
+  return i + FindNonAsciiScalar(data + i, length - i);
+}
+
+size_t Utf16LengthSSE2(const uint8_t* data, size_t length, bool* is_latin1) {
+  const __m128i last_continuation = _mm_set1_epi8(static_cast<char>(0xBF));
+  const __m128i four_byte_lead = _mm_set1_epi8(static_cast<char>(0xF0));
+  __m128i max = _mm_setzero_si128();
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    max = _mm_max_epu8(max, v);
+    // Continuation bytes are the only ones from -128 to -65 when read as
+    // signed integers.
+    const uint32_t starts =
+        _mm_movemask_epi8(_mm_cmpgt_epi8(v, last_continuation));
+    const uint32_t four_byte_leads = _mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_max_epu8(v, four_byte_lead), v));
+    count += CountOnes(starts) + CountOnes(four_byte_leads);
+  }
+  count += Utf16LengthScalar(data + i, length - i, is_latin1);
+  const __m128i latin1_max = _mm_set1_epi8(static_cast<char>(0xC3));
+  *is_latin1 = *is_latin1 &&
+               _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(max, latin1_max),
+                                                max)) == 0xFFFF;
+  return count;
+}
+
+inline bool ConvertAsciiBlockSSE2(const uint8_t* data, uint8_t* out) {
+  const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  if (_mm_movemask_epi8(v) != 0)
+    return false;
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+  return true;
+}
+
+inline bool ConvertAsciiBlockSSE2(const uint8_t* data, uint16_t* out) {
+  const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  if (_mm_movemask_epi8(v) != 0)
+    return false;
+  const __m128i zero = _mm_setzero_si128();
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                   _mm_unpacklo_epi8(v, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8),
+                   _mm_unpackhi_epi8(v, zero));
+  return true;
+}
+#endif  // NODE_UTF8_SSE2
+
+#ifdef NODE_UTF8_X86_DISPATCH
+NODE_TARGET_SSSE3
+inline __m128i CheckBlockSSSE3(__m128i input, __m128i prev_input) {
+  const __m128i mask_0f = _mm_set1_epi8(0x0F);
+  const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 16 - 1);
+  const __m128i byte_1_high = _mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1High)),
+      _mm_and_si128(_mm_srli_epi16(prev1, 4), mask_0f));
+  const __m128i byte_1_low = _mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1Low)),
+      _mm_and_si128(prev1, mask_0f));
+  const __m128i byte_2_high = _mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kByte2High)),
+      _mm_and_si128(_mm_srli_epi16(input, 4), mask_0f));
+  const __m128i special_cases =
+      _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+  // Third and fourth bytes of a sequence must be continuations (kTwoConts).
+  const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 16 - 2);
+  const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 16 - 3);
+  const __m128i is_third_byte =
+      _mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80));
+  const __m128i is_fourth_byte =
+      _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80));
+  const __m128i must_be_2_3_continuation =
+      _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte),
+                    _mm_set1_epi8(static_cast<char>(0x80)));
+  return _mm_xor_si128(must_be_2_3_continuation, special_cases);
+}
+
+NODE_TARGET_SSSE3
+bool IsValidUtf8SSSE3(const uint8_t* data, size_t length) {
+  if (length < 16)
+    return IsValidUtf8Scalar<FindNonAsciiSSE2>(data, length);
+
+  const __m128i incomplete_max =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kIncompleteMax + 16));
+  __m128i error = _mm_setzero_si128();
+  __m128i prev_input = _mm_setzero_si128();
+  __m128i prev_incomplete = _mm_setzero_si128();
+
+  size_t i = 0;
+  uint8_t tail[16];
+  while (i < length) {
+    __m128i input;
+    if (i + 16 <= length) {
+      input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    } else {
+      // Pad the last block with ASCII zeros.
+      memset(tail, 0, sizeof(tail));
+      memcpy(tail, data + i, length - i);
+      input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tail));
+    }
+    if (_mm_movemask_epi8(input) == 0) {
+      error = _mm_or_si128(error, prev_incomplete);
+      prev_incomplete = _mm_setzero_si128();
+    } else {
+      error = _mm_or_si128(error, CheckBlockSSSE3(input, prev_input));
+      prev_incomplete = _mm_subs_epu8(input, incomplete_max);
+    }
+    prev_input = input;
+    i += 16;
+  }
+  error = _mm_or_si128(error, prev_incomplete);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) ==
+         0xFFFF;
+}
+
+NODE_TARGET_AVX2
+size_t FindNonAsciiAVX2(const uint8_t* data, size_t length) {
+  size_t i = 0;
+  for (; i + 128 <= length; i += 128) {
+    const __m256i* p = reinterpret_cast<const __m256i*>(data + i);
+    __m256i any = _mm256_or_si256(
+        _mm256_or_si256(_mm256_loadu_si256(p), _mm256_loadu_si256(p + 1)),
+        _mm256_or_si256(_mm256_loadu_si256(p + 2), _mm256_loadu_si256(p + 3)));
+    if (_mm256_movemask_epi8(any) != 0)
+      break;
+  }
+  for (; i + 32 <= length; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    uint32_t mask = _mm256_movemask_epi8(v);
+    if (mask != 0)
+      return i + CountTrailingZeros(mask);
+  }
+  return i + FindNonAsciiSSE2(data + i, length - i);
+}
+
+NODE_TARGET_AVX2
+inline __m256i CheckBlockAVX2(__m256i input, __m256i prev_input) {
+  const __m256i mask_0f = _mm256_set1_epi8(0x0F);
+  // The upper lane of `prev_input` followed by the lower lane of `input`.
+  const __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+  const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 16 - 1);
+  const __m256i byte_1_high = _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1High))),
+      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), mask_0f));
+  const __m256i byte_1_low = _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1Low))),
+      _mm256_and_si256(prev1, mask_0f));
+  const __m256i byte_2_high = _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(kByte2High))),
+      _mm256_and_si256(_mm256_srli_epi16(input, 4), mask_0f));
+  const __m256i special_cases = _mm256_and_si256(
+      _mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+  const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 16 - 2);
+  const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 16 - 3);
+  const __m256i is_third_byte =
+      _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+  const __m256i is_fourth_byte =
+      _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80));
+  const __m256i must_be_2_3_continuation =
+      _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte),
+                       _mm256_set1_epi8(static_cast<char>(0x80)));
+  return _mm256_xor_si256(must_be_2_3_continuation, special_cases);
+}
+
+NODE_TARGET_AVX2
+bool IsValidUtf8AVX2(const uint8_t* data, size_t length) {
+  if (length < 32)
+    return IsValidUtf8Scalar<FindNonAsciiSSE2>(data, length);
+
+  const __m256i incomplete_max =
+      _mm256_load_si256(reinterpret_cast<const __m256i*>(kIncompleteMax));
+  __m256i error = _mm256_setzero_si256();
+  __m256i prev_input = _mm256_setzero_si256();
+  __m256i prev_incomplete = _mm256_setzero_si256();
+
+  size_t i = 0;
+  uint8_t tail[32];
+  while (i < length) {
+    __m256i input;
+    if (i + 32 <= length) {
+      input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    } else {
+      // Pad the last block with ASCII zeros.
+      memset(tail, 0, sizeof(tail));
+      memcpy(tail, data + i, length - i);
+      input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail));
+    }
+    if (_mm256_movemask_epi8(input) == 0) {
+      error = _mm256_or_si256(error, prev_incomplete);
+      prev_incomplete = _mm256_setzero_si256();
+    } else {
+      error = _mm256_or_si256(error, CheckBlockAVX2(input, prev_input));
+      prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+    }
+    prev_input = input;
+    i += 32;
+  }
+  error = _mm256_or_si256(error, prev_incomplete);
+  return _mm256_testz_si256(error, error) != 0;
+}
+#endif  // NODE_UTF8_X86_DISPATCH
+
+#ifdef NODE_UTF8_NEON
+size_t FindNonAsciiNEON(const uint8_t* data, size_t length) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    if (vmaxvq_u8(vld1q_u8(data + i)) >= 0x80)
+      break;
+  }
+  return i + FindNonAsciiScalar(data + i, length - i);
+}
+
+inline uint8x16_t CheckBlockNEON(uint8x16_t input, uint8x16_t prev_input) {
+  const uint8x16_t mask_0f = vdupq_n_u8(0x0F);
+  const uint8x16_t prev1 = vextq_u8(prev_input, input, 16 - 1);
+  const uint8x16_t byte_1_high =
+      vqtbl1q_u8(vld1q_u8(kByte1High), vshrq_n_u8(prev1, 4));
+  const uint8x16_t byte_1_low =
+      vqtbl1q_u8(vld1q_u8(kByte1Low), vandq_u8(prev1, mask_0f));
+  const uint8x16_t byte_2_high =
+      vqtbl1q_u8(vld1q_u8(kByte2High), vshrq_n_u8(input, 4));
+  const uint8x16_t special_cases =
+      vandq_u8(vandq_u8(byte_1_high, byte_1_low), byte_2_high);
+
+  const uint8x16_t prev2 = vextq_u8(prev_input, input, 16 - 2);
+  const uint8x16_t prev3 = vextq_u8(prev_input, input, 16 - 3);
+  const uint8x16_t is_third_byte = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+  const uint8x16_t is_fourth_byte = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+  const uint8x16_t must_be_2_3_continuation =
+      vandq_u8(vorrq_u8(is_third_byte, is_fourth_byte), vdupq_n_u8(0x80));
+  return veorq_u8(must_be_2_3_continuation, special_cases);
+}
+
+bool IsValidUtf8NEON(const uint8_t* data, size_t length) {
+  if (length < 16)
+    return IsValidUtf8Scalar<FindNonAsciiNEON>(data, length);
+
+  const uint8x16_t incomplete_max = vld1q_u8(kIncompleteMax + 16);
+  uint8x16_t error = vdupq_n_u8(0);
+  uint8x16_t prev_input = vdupq_n_u8(0);
+  uint8x16_t prev_incomplete = vdupq_n_u8(0);
+
+  size_t i = 0;
+  uint8_t tail[16];
+  while (i < length) {
+    uint8x16_t input;
+    if (i + 16 <= length) {
+      input = vld1q_u8(data + i);
+    } else {
+      // Pad the last block with ASCII zeros.
+      memset(tail, 0, sizeof(tail));
+      memcpy(tail, data + i, length - i);
+      input = vld1q_u8(tail);
+    }
+    if (vmaxvq_u8(input) < 0x80) {
+      error = vorrq_u8(error, prev_incomplete);
+      prev_incomplete = vdupq_n_u8(0);
+    } else {
+      error = vorrq_u8(error, CheckBlockNEON(input, prev_input));
+      prev_incomplete = vqsubq_u8(input, incomplete_max);
+    }
+    prev_input = input;
+    i += 16;
+  }
+  error = vorrq_u8(error, prev_incomplete);
+  return vmaxvq_u8(error) == 0;
+}
+
+size_t Utf16LengthNEON(const uint8_t* data, size_t length, bool* is_latin1) {
+  uint8x16_t max = vdupq_n_u8(0);
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t v = vld1q_u8(data + i);
+    max = vmaxq_u8(max, v);
+    // Continuation bytes are the only ones from -128 to -65 when read as
+    // signed integers. Both masks are 0xFF where they match.
+    const uint8x16_t starts =
+        vcgtq_s8(vreinterpretq_s8_u8(v), vdupq_n_s8(-65));
+    const uint8x16_t four_byte_leads = vcgeq_u8(v, vdupq_n_u8(0xF0));
+    count += vaddvq_u8(
+        vaddq_u8(vshrq_n_u8(starts, 7), vshrq_n_u8(four_byte_leads, 7)));
+  }
+  count += Utf16LengthScalar(data + i, length - i, is_latin1);
+  *is_latin1 = *is_latin1 && vmaxvq_u8(max) < 0xC4;
+  return count;
+}
+
+inline bool ConvertAsciiBlockNEON(const uint8_t* data, uint8_t* out) {
+  const uint8x16_t v = vld1q_u8(data);
+  if (vmaxvq_u8(v) >= 0x80)
+    return false;
+  vst1q_u8(out, v);
+  return true;
+}
+
+inline bool ConvertAsciiBlockNEON(const uint8_t* data, uint16_t* out) {
+  const uint8x16_t v = vld1q_u8(data);
+  if (vmaxvq_u8(v) >= 0x80)
+    return false;
+  vst1q_u16(out, vmovl_u8(vget_low_u8(v)));
+  vst1q_u16(out + 8, vmovl_high_u8(v));
+  return true;
+}
+#endif  // NODE_UTF8_NEON
+
+struct Implementation {
+  FindNonAsciiFn find_non_ascii;
+  IsValidUtf8Fn is_valid_utf8;
+};
+
+Implementation ChooseImplementation() {
+#if defined(NODE_UTF8_X86_DISPATCH)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return {FindNonAsciiAVX2, IsValidUtf8AVX2};
+  if (__builtin_cpu_supports("ssse3"))
+    return {FindNonAsciiSSE2, IsValidUtf8SSSE3};
+  return {FindNonAsciiSSE2, IsValidUtf8Scalar<FindNonAsciiSSE2>};
+#elif defined(NODE_UTF8_SSE2)
+  return {FindNonAsciiSSE2, IsValidUtf8Scalar<FindNonAsciiSSE2>};
+#elif defined(NODE_UTF8_NEON)
+  return {FindNonAsciiNEON, IsValidUtf8NEON};
+#else
+  return {FindNonAsciiScalar, IsValidUtf8Scalar<FindNonAsciiScalar>};
+#endif
+}
+
+const Implementation& GetImplementation() {
+  static const Implementation implementation = ChooseImplementation();
+  return implementation;
+}
+
+}  // anonymous namespace
+
+size_t FindNonAscii(const char* data, size_t length) {
+  return GetImplementation().find_non_ascii(
+      reinterpret_cast<const uint8_t*>(data), length);
+}
+
+bool IsValidUtf8(const char* data, size_t length) {
+  return GetImplementation().is_valid_utf8(
+      reinterpret_cast<const uint8_t*>(data), length);
+}
+
+// SSE2 and NEON are always available where they are used, so transcoding
+// needs no runtime dispatch.
+
+size_t Utf16Length(const char* data, size_t length, bool* is_latin1) {
+  const uint8_t* const bytes = reinterpret_cast<const uint8_t*>(data);
+#if defined(NODE_UTF8_SSE2)
+  return Utf16LengthSSE2(bytes, length, is_latin1);
+#elif defined(NODE_UTF8_NEON)
+  return Utf16LengthNEON(bytes, length, is_latin1);
+#else
+  return Utf16LengthScalar(bytes, length, is_latin1);
+#endif
+}
+
+size_t Utf8ToLatin1(const char* data, size_t length, char* out) {
+  const uint8_t* const bytes = reinterpret_cast<const uint8_t*>(data);
+  uint8_t* const dst = reinterpret_cast<uint8_t*>(out);
+#if defined(NODE_UTF8_SSE2)
+  return Transcode<uint8_t, 16, ConvertAsciiBlockSSE2>(bytes, length, dst);
+#elif defined(NODE_UTF8_NEON)
+  return Transcode<uint8_t, 16, ConvertAsciiBlockNEON>(bytes, length, dst);
+#else
+  return Transcode<uint8_t, 8, ConvertAsciiBlockScalar>(bytes, length, dst);
+#endif
+}
+
+size_t Utf8ToUtf16(const char* data, size_t length, uint16_t* out) {
+  const uint8_t* const bytes = reinterpret_cast<const uint8_t*>(data);
+#if defined(NODE_UTF8_SSE2)
+  return Transcode<uint16_t, 16, ConvertAsciiBlockSSE2>(bytes, length, out);
+#elif defined(NODE_UTF8_NEON)
+  return Transcode<uint16_t, 16, ConvertAsciiBlockNEON>(bytes, length, out);
+#else
+  return Transcode<uint16_t, 8, ConvertAsciiBlockScalar>(bytes, length, out);
+#endif
+}
+
+}  // namespace node
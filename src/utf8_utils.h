@@ -0,0 +1,46 @@
+#ifndef SRC_UTF8_UTILS_H_
+#define SRC_UTF8_UTILS_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstddef>
+#include <cstdint>
+
+namespace node {
+
+// Vectorized helpers for inspecting UTF-8 and Latin-1 data. The fastest
+// implementation available on the host CPU (AVX2, SSSE3, NEON, or portable
+// scalar code) is selected once at runtime.
+
+// Returns the index of the first byte >= 0x80 in `data`, or `length` if all
+// of the bytes are ASCII.
+size_t FindNonAscii(const char* data, size_t length);
+
+inline bool IsAscii(const char* data, size_t length) {
+  return FindNonAscii(data, length) == length;
+}
+
+// Returns true if `data` is well-formed UTF-8 as defined by the Unicode
+// Standard, i.e. it contains no overlong encodings, surrogates, code points
+// above U+10FFFF or truncated sequences.
+bool IsValidUtf8(const char* data, size_t length);
+
+// The following functions expect well-formed UTF-8, as checked by
+// IsValidUtf8().
+
+// Returns the number of UTF-16 code units that `data` decodes to. Sets
+// `*is_latin1` to whether all of the code points are below U+0100, in which
+// case this is also the number of Latin-1 characters it decodes to.
+size_t Utf16Length(const char* data, size_t length, bool* is_latin1);
+
+// Decodes `data` into `out`, which must have room for Utf16Length() code
+// units, and returns the number of code units written. Utf8ToLatin1() may
+// only be used if Utf16Length() reported the data to be Latin-1.
+size_t Utf8ToLatin1(const char* data, size_t length, char* out);
+size_t Utf8ToUtf16(const char* data, size_t length, uint16_t* out);
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_UTF8_UTILS_H_
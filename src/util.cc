@@ -223,6 +223,37 @@ int WriteFileSync(v8::Isolate* isolate,
   return WriteFileSync(path, buf);
 }
 
+int WriteFileAtomically(const char* path,
+                        const char* temp_path,
+                        const uv_buf_t* bufs,
+                        size_t count) {
+  uv_fs_t req;
+  int err = uv_fs_open(nullptr,
+                       &req,
+                       temp_path,
+                       O_WRONLY | O_CREAT | O_TRUNC,
+                       S_IWUSR | S_IRUSR,
+                       nullptr);
+  uv_fs_req_cleanup(&req);
+  if (err < 0) return err;
+
+  const uv_file fd = err;
+  err = uv_fs_write(nullptr, &req, fd, bufs, count, 0, nullptr);
+  uv_fs_req_cleanup(&req);
+  const int close_err = uv_fs_close(nullptr, &req, fd, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (err >= 0) err = close_err;
+  if (err >= 0) {
+    err = uv_fs_rename(nullptr, &req, temp_path, path, nullptr);
+    uv_fs_req_cleanup(&req);
+  }
+  if (err < 0) {
+    uv_fs_unlink(nullptr, &req, temp_path, nullptr);
+    uv_fs_req_cleanup(&req);
+  }
+  return err;
+}
+
 int ReadFileSync(std::string* result, const char* path) {
   uv_fs_t req;
   auto defer_req_cleanup = OnScopeLeave([&req]() {
@@ -361,6 +392,27 @@ void SetFastMethod(Local<v8::Context> context,
                    v8::FunctionCallback slow_callback,
                    const v8::CFunction* c_function) {
   Isolate* isolate = context->GetIsolate();
+  Local<v8::Function> function =
+      NewFunctionTemplate(isolate,
+                          slow_callback,
+                          Local<v8::Signature>(),
+                          v8::ConstructorBehavior::kThrow,
+                          v8::SideEffectType::kHasSideEffect,
+                          c_function)
+          ->GetFunction(context)
+          .ToLocalChecked();
+  const v8::NewStringType type = v8::NewStringType::kInternalized;
+  Local<v8::String> name_string =
+      v8::String::NewFromUtf8(isolate, name, type).ToLocalChecked();
+  that->Set(context, name_string, function).Check();
+}
+
+void SetFastMethodNoSideEffect(Local<v8::Context> context,
+                               Local<v8::Object> that,
+                               const char* name,
+                               v8::FunctionCallback slow_callback,
+                               const v8::CFunction* c_function) {
+  Isolate* isolate = context->GetIsolate();
   Local<v8::Function> function =
       NewFunctionTemplate(isolate,
                           slow_callback,
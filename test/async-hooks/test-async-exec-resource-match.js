@@ -12,7 +12,8 @@ const {
 // Ignore any asyncIds created before our hook is active.
 let firstSeenAsyncId = -1;
 const idResMap = new Map();
-const numExpectedCalls = 5;
+// One for TheResource and one for the readFile() request.
+const numExpectedCalls = 2;
 
 createHook({
   init: common.mustCallAtLeast(
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstring>
+#include <string>
 
 #include "gtest/gtest.h"
 
@@ -140,3 +141,54 @@ TEST(Base64Test, Decode) {
        "dCBjdXBpZGF0YXQgbm9uIHByb2lkZW50LCBzdW50IGluIGN1bHBhIHF1aSBvZmZpY2lh\n"
        "IGRlc2VydW50IG1vbGxpdCBhbmltIGlkIGVzdCBsYWJvcnVtLg", text);
 }
+
+TEST(Base64Test, DecodeLongInput) {
+  // Long enough for the SIMD codecs to process whole blocks.
+  std::string raw;
+  for (int i = 0; i < 1000; i++) raw += static_cast<char>(i * 7 + 3);
+  std::string encoded(node::base64_encoded_size(raw.size()), '\0');
+  base64_encode(raw.data(), raw.size(), &encoded[0], encoded.size());
+
+  auto test = [&raw](const std::string& input, size_t expected_length) {
+    const size_t len = node::base64_decoded_size_fast(input.size()) + 16;
+    std::string buffer(len, 'x');
+    const size_t written =
+        base64_decode(&buffer[0], len, input.data(), input.size());
+    EXPECT_EQ(written, expected_length);
+    EXPECT_EQ(buffer.substr(0, written), raw.substr(0, expected_length));
+    // Bytes past the decoded output must not be modified.
+    EXPECT_EQ(buffer.substr(written), std::string(len - written, 'x'));
+  };
+
+  test(encoded, raw.size());
+  test(encoded + "\n", raw.size());
+  test(encoded.substr(0, 600) + "\r\n" + encoded.substr(600), raw.size());
+  test(encoded.substr(0, 600) + "=" + encoded.substr(600), 450);
+  test(encoded.substr(0, 600) + "!", 450);
+
+  std::string url = encoded;
+  for (char& c : url) {
+    if (c == '+') c = '-';
+    if (c == '/') c = '_';
+  }
+  test(url, raw.size());
+}
+
+TEST(Base64Test, EncodeURLLongInput) {
+  std::string raw;
+  for (int i = 0; i < 1000; i++) raw += static_cast<char>(i * 7 + 3);
+  for (size_t len = 995; len <= raw.size(); len++) {
+    std::string url(node::base64_encoded_size(len, node::Base64Mode::URL),
+                    '\0');
+    base64_encode(raw.data(), len, &url[0], url.size(),
+                  node::Base64Mode::URL);
+    std::string expected(node::base64_encoded_size(len), '\0');
+    base64_encode(raw.data(), len, &expected[0], expected.size());
+    while (!expected.empty() && expected.back() == '=') expected.pop_back();
+    for (char& c : expected) {
+      if (c == '+') c = '-';
+      if (c == '/') c = '_';
+    }
+    EXPECT_EQ(url, expected);
+  }
+}
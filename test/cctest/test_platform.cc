@@ -1,7 +1,10 @@
 #include "node_internals.h"
 #include "libplatform/libplatform.h"
 
+#include <atomic>
+#include <functional>
 #include <string>
+#include <vector>
 #include "gtest/gtest.h"
 #include "node_test_fixture.h"
 
@@ -123,3 +126,304 @@ TEST_F(PlatformTest, TracingControllerNullptr) {
   node::SetTracingController(orig_controller);
   EXPECT_EQ(node::GetTracingController(), orig_controller);
 }
+
+// Runs a function, used to post arbitrary work to a WorkerThreadsTaskRunner.
+class LambdaTask : public v8::Task {
+ public:
+  explicit LambdaTask(std::function<void()> fn) : fn_(std::move(fn)) {}
+  void Run() final { fn_(); }
+
+ private:
+  std::function<void()> fn_;
+};
+
+static void PostLambda(node::WorkerThreadsTaskRunner* runner,
+                       std::function<void()> fn,
+                       v8::TaskPriority priority =
+                           v8::TaskPriority::kUserVisible) {
+  runner->PostTask(std::make_unique<LambdaTask>(std::move(fn)), priority);
+}
+
+TEST_F(PlatformTest, WorkerThreadsTaskRunnerStress) {
+  constexpr int kPosters = 4;
+  constexpr int kTasksPerPoster = 10000;
+  node::WorkerThreadsTaskRunner runner(4);
+  EXPECT_EQ(runner.NumberOfWorkerThreads(), 4);
+
+  struct PosterData {
+    node::WorkerThreadsTaskRunner* runner;
+    std::atomic<int>* run_count;
+    int id;
+  };
+  std::atomic<int> run_count {0};
+  std::vector<PosterData> posters;
+  for (int i = 0; i < kPosters; i++)
+    posters.push_back(PosterData { &runner, &run_count, i });
+
+  // Several threads post tasks of all priorities at the same time, and some
+  // of the tasks post more tasks from the worker threads.
+  std::vector<uv_thread_t> threads(kPosters);
+  for (int i = 0; i < kPosters; i++) {
+    CHECK_EQ(0, uv_thread_create(&threads[i], [](void* arg) {
+      PosterData* data = static_cast<PosterData*>(arg);
+      for (int j = 0; j < kTasksPerPoster; j++) {
+        auto priority = static_cast<v8::TaskPriority>((data->id + j) % 3);
+        std::atomic<int>* run_count = data->run_count;
+        node::WorkerThreadsTaskRunner* runner = data->runner;
+        PostLambda(runner, [=]() {
+          ++*run_count;
+          if (j % 10 == 0) {
+            PostLambda(runner, [=]() { ++*run_count; }, priority);
+          }
+        }, priority);
+      }
+    }, &posters[i]));
+  }
+  for (uv_thread_t& thread : threads)
+    CHECK_EQ(0, uv_thread_join(&thread));
+
+  runner.BlockingDrain();
+  constexpr int kExpected = kPosters * kTasksPerPoster * 11 / 10;
+  EXPECT_EQ(run_count.load(), kExpected);
+
+  node::PlatformWorkerPoolStats stats = runner.GetStats();
+  EXPECT_EQ(stats.workers.size(), 4u);
+  EXPECT_EQ(stats.pending_user_blocking_tasks, 0u);
+  EXPECT_EQ(stats.pending_user_visible_tasks, 0u);
+  EXPECT_EQ(stats.pending_best_effort_tasks, 0u);
+  uint64_t tasks_run = 0;
+  for (const node::PlatformWorkerStats& worker : stats.workers) {
+    EXPECT_LE(worker.tasks_stolen, worker.steal_attempts);
+    tasks_run += worker.tasks_run;
+  }
+  EXPECT_EQ(tasks_run, static_cast<uint64_t>(kExpected));
+
+  runner.Shutdown();
+}
+
+TEST_F(PlatformTest, WorkerThreadsTaskRunnerPriorities) {
+  node::WorkerThreadsTaskRunner runner(1);
+  node::Mutex mutex;
+  std::vector<v8::TaskPriority> order;
+  uv_sem_t started, release;
+  CHECK_EQ(0, uv_sem_init(&started, 0));
+  CHECK_EQ(0, uv_sem_init(&release, 0));
+
+  // Keep the only worker busy until all other tasks have been posted.
+  PostLambda(&runner, [&]() {
+    uv_sem_post(&started);
+    uv_sem_wait(&release);
+  });
+  uv_sem_wait(&started);
+  for (auto priority : { v8::TaskPriority::kBestEffort,
+                         v8::TaskPriority::kUserVisible,
+                         v8::TaskPriority::kUserBlocking }) {
+    PostLambda(&runner, [&, priority]() {
+      node::Mutex::ScopedLock lock(mutex);
+      order.push_back(priority);
+    }, priority);
+  }
+  node::PlatformWorkerPoolStats stats = runner.GetStats();
+  EXPECT_EQ(stats.pending_user_blocking_tasks, 1u);
+  EXPECT_EQ(stats.pending_user_visible_tasks, 1u);
+  EXPECT_EQ(stats.pending_best_effort_tasks, 1u);
+  uv_sem_post(&release);
+  runner.BlockingDrain();
+
+  std::vector<v8::TaskPriority> expected = {
+    v8::TaskPriority::kUserBlocking,
+    v8::TaskPriority::kUserVisible,
+    v8::TaskPriority::kBestEffort,
+  };
+  EXPECT_EQ(order, expected);
+
+  runner.Shutdown();
+  uv_sem_destroy(&started);
+  uv_sem_destroy(&release);
+}
+
+TEST_F(PlatformTest, WorkerThreadsTaskRunnerStealing) {
+  constexpr int kChildren = 100;
+  node::WorkerThreadsTaskRunner runner(2);
+  std::atomic<int> children_run {0};
+
+  // Tasks posted by a worker go into its own queue. The worker waits for
+  // them to finish, so the other worker has to steal all of them. The first
+  // task may have been stolen as well.
+  PostLambda(&runner, [&]() {
+    for (int i = 0; i < kChildren; i++) {
+      PostLambda(&runner, [&]() { children_run++; });
+    }
+    while (children_run < kChildren)
+      uv_sleep(1);
+  });
+  runner.BlockingDrain();
+  EXPECT_EQ(children_run.load(), kChildren);
+
+  uint64_t tasks_stolen = 0;
+  for (const node::PlatformWorkerStats& worker : runner.GetStats().workers)
+    tasks_stolen += worker.tasks_stolen;
+  EXPECT_GE(tasks_stolen, static_cast<uint64_t>(kChildren));
+
+  runner.Shutdown();
+}
+
+// Keeps every worker that joins it busy until it is released.
+class BlockingJobTask : public v8::JobTask {
+ public:
+  explicit BlockingJobTask(uv_sem_t* arrived) : arrived_(arrived) {}
+
+  void Run(v8::JobDelegate* delegate) final {
+    if (delegate->IsJoiningThread())
+      return;
+    uv_sem_post(arrived_);
+    while (!released_)
+      uv_sleep(1);
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const final {
+    return released_ ? 0 : 100;
+  }
+
+  std::atomic<bool> released_ {false};
+
+ private:
+  uv_sem_t* arrived_;
+};
+
+TEST_F(PlatformTest, JobsAreSizedToTheWorkerThreads) {
+  constexpr int kThreads = 2;
+  node::NodePlatform platform(kThreads, nullptr);
+  // The delayed task scheduler thread does not run job workers.
+  EXPECT_EQ(platform.NumberOfWorkerThreads(), kThreads);
+
+  uv_sem_t arrived;
+  CHECK_EQ(0, uv_sem_init(&arrived, 0));
+  auto task = std::make_unique<BlockingJobTask>(&arrived);
+  BlockingJobTask* job_task = task.get();
+  std::unique_ptr<v8::JobHandle> handle =
+      platform.PostJob(v8::TaskPriority::kUserVisible, std::move(task));
+  for (int i = 0; i < kThreads; i++)
+    uv_sem_wait(&arrived);
+
+  // All workers run the job, and no worker task is left waiting for one.
+  node::PlatformWorkerPoolStats stats = platform.GetWorkerPoolStats();
+  EXPECT_EQ(stats.pending_user_blocking_tasks, 0u);
+  EXPECT_EQ(stats.pending_user_visible_tasks, 0u);
+  EXPECT_EQ(stats.pending_best_effort_tasks, 0u);
+
+  job_task->released_ = true;
+  handle->Join();
+  platform.Shutdown();
+  uv_sem_destroy(&arrived);
+}
+
+class LambdaIdleTask : public v8::IdleTask {
+ public:
+  explicit LambdaIdleTask(std::function<void(double)> fn)
+      : fn_(std::move(fn)) {}
+  void Run(double deadline_in_seconds) final { fn_(deadline_in_seconds); }
+
+ private:
+  std::function<void(double)> fn_;
+};
+
+TEST_F(NodeZeroIsolateTestFixture, IdleTasksRunWhileLoopIsIdle) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = allocator.get();
+  auto isolate = v8::Isolate::Allocate();
+  CHECK_NOT_NULL(isolate);
+
+  auto delegate = std::make_shared<node::PerIsolatePlatformData>(
+    isolate,
+    &current_loop,
+    true);
+  platform->RegisterIsolate(isolate, delegate.get());
+  v8::Isolate::Initialize(isolate, create_params);
+  EXPECT_TRUE(platform->IdleTasksEnabled(isolate));
+
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    const double posted = platform->MonotonicallyIncreasingTime();
+    std::vector<double> deadlines;
+    delegate->PostIdleTask(std::make_unique<LambdaIdleTask>(
+        [&](double deadline) {
+          deadlines.push_back(deadline);
+          // Tasks posted by idle tasks wait for the next idle period.
+          delegate->PostIdleTask(std::make_unique<LambdaIdleTask>(
+              [&](double deadline) { deadlines.push_back(deadline); }));
+        }));
+
+    // Keeps the loop idle for two periods of 100 ms.
+    uv_timer_t timer;
+    int timer_runs = 0;
+    uv_timer_init(&current_loop, &timer);
+    timer.data = &timer_runs;
+    uv_timer_start(&timer, [](uv_timer_t* timer) {
+      if (++*static_cast<int*>(timer->data) == 2)
+        uv_timer_stop(timer);
+    }, 100, 100);
+    uv_run(&current_loop, UV_RUN_DEFAULT);
+    uv_close(reinterpret_cast<uv_handle_t*>(&timer), nullptr);
+    uv_run(&current_loop, UV_RUN_DEFAULT);
+
+    ASSERT_EQ(deadlines.size(), 2u);
+    // Idle periods end before the next timer is due, and are capped at 50 ms.
+    EXPECT_GT(deadlines[0], posted);
+    EXPECT_LE(deadlines[0], posted + 0.05 + 0.01);
+    EXPECT_GE(deadlines[1], posted + 0.1);
+  }
+
+  delegate->Shutdown();
+  platform->UnregisterIsolate(isolate);
+  isolate->Dispose();
+}
+
+TEST_F(NodeZeroIsolateTestFixture, IdleTasksWaitWhileLoopIsBusy) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = allocator.get();
+  auto isolate = v8::Isolate::Allocate();
+  CHECK_NOT_NULL(isolate);
+
+  auto delegate = std::make_shared<node::PerIsolatePlatformData>(
+    isolate,
+    &current_loop,
+    true);
+  platform->RegisterIsolate(isolate, delegate.get());
+  v8::Isolate::Initialize(isolate, create_params);
+
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    // The loop never blocks while the idle handle is active.
+    struct Busy {
+      uv_idle_t handle;
+      int iterations = 0;
+    } busy;
+    uv_idle_init(&current_loop, &busy.handle);
+    busy.handle.data = &busy;
+    uv_idle_start(&busy.handle, [](uv_idle_t* handle) {
+      Busy* busy = static_cast<Busy*>(handle->data);
+      if (++busy->iterations == 100)
+        uv_idle_stop(handle);
+    });
+
+    int iterations_before_task = -1;
+    delegate->PostIdleTask(std::make_unique<LambdaIdleTask>(
+        [&](double deadline) { iterations_before_task = busy.iterations; }));
+
+    // Once the loop is done with the idle handle, it only waits for the timer.
+    uv_timer_t timer;
+    uv_timer_init(&current_loop, &timer);
+    uv_timer_start(&timer, [](uv_timer_t* timer) {}, 20, 0);
+    uv_run(&current_loop, UV_RUN_DEFAULT);
+    uv_close(reinterpret_cast<uv_handle_t*>(&timer), nullptr);
+    uv_close(reinterpret_cast<uv_handle_t*>(&busy.handle), nullptr);
+    uv_run(&current_loop, UV_RUN_DEFAULT);
+
+    EXPECT_EQ(iterations_before_task, 100);
+  }
+
+  delegate->Shutdown();
+  platform->UnregisterIsolate(isolate);
+  isolate->Dispose();
+}
@@ -0,0 +1,168 @@
+#include "utf8_utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using node::FindNonAscii;
+using node::IsAscii;
+using node::IsValidUtf8;
+using node::Utf16Length;
+using node::Utf8ToLatin1;
+using node::Utf8ToUtf16;
+
+namespace {
+
+bool IsValid(const std::string& s) {
+  return IsValidUtf8(s.data(), s.size());
+}
+
+std::u16string ToUtf16(const std::string& s) {
+  bool is_latin1;
+  std::vector<uint16_t> out(Utf16Length(s.data(), s.size(), &is_latin1));
+  EXPECT_EQ(Utf8ToUtf16(s.data(), s.size(), out.data()), out.size());
+  return std::u16string(out.begin(), out.end());
+}
+
+std::string ToLatin1(const std::string& s) {
+  bool is_latin1;
+  std::string out(Utf16Length(s.data(), s.size(), &is_latin1), '\0');
+  EXPECT_TRUE(is_latin1);
+  EXPECT_EQ(Utf8ToLatin1(s.data(), s.size(), &out[0]), out.size());
+  return out;
+}
+
+bool IsLatin1(const std::string& s) {
+  bool is_latin1;
+  Utf16Length(s.data(), s.size(), &is_latin1);
+  return is_latin1;
+}
+
+}  // anonymous namespace
+
+TEST(Utf8UtilsTest, FindNonAscii) {
+  EXPECT_EQ(FindNonAscii("", 0), 0u);
+  EXPECT_TRUE(IsAscii("hello", 5));
+
+  // Exercise every position of every block size the implementations use.
+  for (size_t length = 1; length < 300; length++) {
+    std::string s(length, 'a');
+    EXPECT_EQ(FindNonAscii(s.data(), s.size()), length);
+    for (size_t pos = 0; pos < length; pos++) {
+      s[pos] = '\x80';
+      EXPECT_EQ(FindNonAscii(s.data(), s.size()), pos);
+      s[pos] = 'a';
+    }
+  }
+}
+
+TEST(Utf8UtilsTest, ValidSequences) {
+  EXPECT_TRUE(IsValid(""));
+  EXPECT_TRUE(IsValid("abc"));
+  EXPECT_TRUE(IsValid("\xC2\x80"));              // U+0080
+  EXPECT_TRUE(IsValid("\xDF\xBF"));              // U+07FF
+  EXPECT_TRUE(IsValid("\xE0\xA0\x80"));          // U+0800
+  EXPECT_TRUE(IsValid("\xED\x9F\xBF"));          // U+D7FF
+  EXPECT_TRUE(IsValid("\xEE\x80\x80"));          // U+E000
+  EXPECT_TRUE(IsValid("\xEF\xBF\xBF"));          // U+FFFF
+  EXPECT_TRUE(IsValid("\xF0\x90\x80\x80"));      // U+10000
+  EXPECT_TRUE(IsValid("\xF4\x8F\xBF\xBF"));      // U+10FFFF
+}
+
+TEST(Utf8UtilsTest, InvalidSequences) {
+  EXPECT_FALSE(IsValid("\x80"));                 // Lone continuation
+  EXPECT_FALSE(IsValid("\xC0\x80"));             // Overlong 2 bytes
+  EXPECT_FALSE(IsValid("\xC1\xBF"));
+  EXPECT_FALSE(IsValid("\xE0\x9F\xBF"));         // Overlong 3 bytes
+  EXPECT_FALSE(IsValid("\xED\xA0\x80"));         // Surrogate
+  EXPECT_FALSE(IsValid("\xED\xBF\xBF"));
+  EXPECT_FALSE(IsValid("\xF0\x8F\xBF\xBF"));     // Overlong 4 bytes
+  EXPECT_FALSE(IsValid("\xF4\x90\x80\x80"));     // Above U+10FFFF
+  EXPECT_FALSE(IsValid("\xF5\x80\x80\x80"));
+  EXPECT_FALSE(IsValid("\xFF"));
+  EXPECT_FALSE(IsValid("\xC3"));                 // Truncated
+  EXPECT_FALSE(IsValid("\xE2\x82"));
+  EXPECT_FALSE(IsValid("\xF0\x9F\x98"));
+  EXPECT_FALSE(IsValid("\xC3\xA9\xA9"));         // Too many continuations
+}
+
+TEST(Utf8UtilsTest, BlockBoundaries) {
+  // Place valid and invalid sequences at every offset of a long ASCII
+  // string so that they straddle the boundaries of vector blocks and the
+  // end of the input.
+  const std::string valid[] = {
+      "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"};
+  const std::string invalid[] = {
+      "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xED\xA0\x80", "\xC0\x80", "\xBF"};
+  for (size_t offset = 0; offset < 130; offset++) {
+    for (const std::string& seq : valid) {
+      std::string s = std::string(offset, 'x') + seq;
+      EXPECT_TRUE(IsValid(s)) << offset;
+      EXPECT_TRUE(IsValid(s + std::string(70, 'y'))) << offset;
+    }
+    for (const std::string& seq : invalid) {
+      std::string s = std::string(offset, 'x') + seq;
+      EXPECT_FALSE(IsValid(s)) << offset;
+      EXPECT_FALSE(IsValid(s + std::string(70, 'y'))) << offset;
+    }
+  }
+}
+
+TEST(Utf8UtilsTest, LongInput) {
+  std::string s;
+  for (int i = 0; i < 1000; i++) s += "abc\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+  EXPECT_TRUE(IsValid(s));
+  s[s.size() / 2] = '\xFF';
+  EXPECT_FALSE(IsValid(s));
+}
+
+TEST(Utf8UtilsTest, Transcode) {
+  EXPECT_EQ(ToUtf16(""), u"");
+  EXPECT_EQ(ToUtf16("abc"), u"abc");
+  EXPECT_EQ(ToUtf16("\xC2\x80\xDF\xBF"), u"\u0080\u07FF");
+  EXPECT_EQ(ToUtf16("\xE0\xA0\x80\xEF\xBF\xBF"), u"\u0800\uFFFF");
+  EXPECT_EQ(ToUtf16("\xF0\x90\x80\x80"), u"\xD800\xDC00");
+  EXPECT_EQ(ToUtf16("\xF4\x8F\xBF\xBF"), u"\xDBFF\xDFFF");
+
+  EXPECT_TRUE(IsLatin1(""));
+  EXPECT_TRUE(IsLatin1("\xC3\xBF"));                // U+00FF
+  EXPECT_FALSE(IsLatin1("\xC4\x80"));               // U+0100
+  EXPECT_FALSE(IsLatin1("\xE2\x82\xAC"));
+  EXPECT_FALSE(IsLatin1("\xF0\x9F\x98\x80"));
+  EXPECT_EQ(ToLatin1("a\xC2\x80\xC3\xA9\xC3\xBF"), "a\x80\xE9\xFF");
+}
+
+TEST(Utf8UtilsTest, TranscodeBlockBoundaries) {
+  // Same as above, with the sequences straddling the boundaries of vector
+  // blocks and the end of the input.
+  for (size_t offset = 0; offset < 70; offset++) {
+    const std::string ascii(offset, 'x');
+    const std::u16string ascii16(offset, u'x');
+    const std::string tail(40, 'y');
+    const std::u16string tail16(40, u'y');
+
+    EXPECT_EQ(ToUtf16(ascii + "\xC3\xA9" + tail),
+              ascii16 + u"\u00E9" + tail16) << offset;
+    EXPECT_EQ(ToUtf16(ascii + "\xE2\x82\xAC" + tail),
+              ascii16 + u"\u20AC" + tail16) << offset;
+    EXPECT_EQ(ToUtf16(ascii + "\xF0\x9F\x98\x80" + tail),
+              ascii16 + u"\U0001F600" + tail16) << offset;
+    EXPECT_EQ(ToLatin1(ascii + "\xC3\xA9" + tail),
+              ascii + "\xE9" + tail) << offset;
+    EXPECT_FALSE(IsLatin1(ascii + "\xC4\x80" + tail)) << offset;
+    EXPECT_FALSE(IsLatin1(tail + ascii + "\xF0\x9F\x98\x80")) << offset;
+  }
+}
+
+TEST(Utf8UtilsTest, TranscodeLongInput) {
+  std::string s;
+  std::u16string expected;
+  for (int i = 0; i < 1000; i++) {
+    s += "abc\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+    expected += u"abc\u00E9\u20AC\U0001F600";
+  }
+  EXPECT_EQ(ToUtf16(s), expected);
+}
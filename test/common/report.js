@@ -59,7 +59,8 @@ function _validateContent(report, fields = []) {
 
   // Verify that all sections are present as own properties of the report.
   const sections = ['header', 'nativeStack', 'libuv', 'environmentVariables',
-                    'sharedObjects', 'resourceUsage', 'workers'];
+                    'sharedObjects', 'resourceUsage', 'platformWorkers',
+                    'workers'];
   if (!isWindows)
     sections.push('userLimits');
 
@@ -265,6 +266,27 @@ function _validateContent(report, fields = []) {
     assert(Number.isSafeInteger(usage.fsActivity.writes));
   }
 
+  // Verify the format of the platformWorkers section.
+  const platformWorkers = report.platformWorkers;
+  checkForUnknownFields(platformWorkers,
+                        ['threads', 'pendingTasks', 'threadStats']);
+  assert(Number.isSafeInteger(platformWorkers.threads));
+  checkForUnknownFields(platformWorkers.pendingTasks,
+                        ['userBlocking', 'userVisible', 'bestEffort']);
+  Object.values(platformWorkers.pendingTasks).forEach((pending) => {
+    assert(Number.isSafeInteger(pending));
+  });
+  assert(Array.isArray(platformWorkers.threadStats));
+  assert.strictEqual(platformWorkers.threadStats.length,
+                     platformWorkers.threads);
+  platformWorkers.threadStats.forEach((thread) => {
+    checkForUnknownFields(thread, ['tasksRun', 'tasksStolen', 'stealAttempts']);
+    assert(Number.isSafeInteger(thread.tasksRun));
+    assert(Number.isSafeInteger(thread.tasksStolen));
+    assert(Number.isSafeInteger(thread.stealAttempts));
+    assert(thread.tasksStolen <= thread.stealAttempts);
+  });
+
   // Verify the format of the libuv section.
   assert(Array.isArray(report.libuv));
   report.libuv.forEach((resource) => {
@@ -0,0 +1,124 @@
+// Tests that large module graphs, whose sources are read in batches, are
+// loaded and linked correctly.
+import { spawnPromisified } from '../common/index.mjs';
+import tmpdir from '../common/tmpdir.js';
+import assert from 'assert';
+import fs from 'fs';
+import path from 'path';
+import { pathToFileURL } from 'url';
+
+tmpdir.refresh();
+
+// A tree in which every module imports `width` children, and all leaves
+// import a shared module which in turn imports the root, creating cycles.
+function writeTree(dir, depth, width) {
+  fs.mkdirSync(dir);
+  fs.writeFileSync(path.join(dir, 'shared.mjs'), `
+    import { count } from './m.mjs';
+    export const shared = () => count;
+  `);
+  let files = 0;
+  function write(name, level) {
+    files++;
+    let source = '';
+    let sum = '1';
+    if (level < depth) {
+      for (let i = 0; i < width; i++) {
+        source += `import { count as c${i} } from './${name}_${i}.mjs';\n`;
+        sum += ` + c${i}`;
+        write(`${name}_${i}`, level + 1);
+      }
+    } else {
+      source += 'import { shared } from \'./shared.mjs\';\n';
+      source += 'export const check = () => typeof shared();\n';
+    }
+    source += `export const count = ${sum};\n`;
+    fs.writeFileSync(path.join(dir, `${name}.mjs`), source);
+  }
+  write('m', 0);
+  return files;
+}
+
+{
+  const dir = path.join(tmpdir.path, 'wide');
+  const files = writeTree(dir, 1, 200);
+  const { count } = await import(pathToFileURL(path.join(dir, 'm.mjs')));
+  assert.strictEqual(count, files);
+}
+
+{
+  const dir = path.join(tmpdir.path, 'deep');
+  const files = writeTree(dir, 4, 5);
+  const { count } = await import(pathToFileURL(path.join(dir, 'm.mjs')));
+  assert.strictEqual(count, files);
+  const leaf = await import(pathToFileURL(path.join(dir, 'm_0_0_0_0.mjs')));
+  assert.strictEqual(leaf.check(), 'number');
+}
+
+// Several graphs that are imported at the same time share their reads.
+{
+  const dirs = [];
+  for (let i = 0; i < 4; i++) {
+    const dir = path.join(tmpdir.path, `concurrent${i}`);
+    dirs.push({ dir, files: writeTree(dir, 2, 8) });
+  }
+  const results = await Promise.all(dirs.map(({ dir }) => {
+    return import(pathToFileURL(path.join(dir, 'm.mjs')));
+  }));
+  for (let i = 0; i < dirs.length; i++)
+    assert.strictEqual(results[i].count, dirs[i].files);
+}
+
+// A module that cannot be loaded only fails the graphs it belongs to.
+{
+  const dir = path.join(tmpdir.path, 'broken');
+  const files = writeTree(dir, 1, 40);
+  fs.writeFileSync(path.join(dir, 'broken.mjs'), `
+    import './m.mjs';
+    import './folder.mjs';
+  `);
+  fs.mkdirSync(path.join(dir, 'folder.mjs'));
+  const [broken, ok] = await Promise.allSettled([
+    import(pathToFileURL(path.join(dir, 'broken.mjs'))),
+    import(pathToFileURL(path.join(dir, 'm.mjs'))),
+  ]);
+  assert.strictEqual(broken.status, 'rejected');
+  assert.strictEqual(ok.status, 'fulfilled', ok.reason);
+  assert.strictEqual(ok.value.count, files);
+}
+
+// The graph is loaded breadth-first: the modules imported by one level are
+// only loaded once every module of that level has been loaded.
+{
+  const dir = path.join(tmpdir.path, 'levels');
+  fs.mkdirSync(dir);
+  fs.writeFileSync(path.join(dir, 'main.mjs'), `
+    import './slow.mjs';
+    import './fast.mjs';
+  `);
+  fs.writeFileSync(path.join(dir, 'slow.mjs'), '');
+  fs.writeFileSync(path.join(dir, 'fast.mjs'), 'import \'./child.mjs\';');
+  fs.writeFileSync(path.join(dir, 'child.mjs'), '');
+  fs.writeFileSync(path.join(dir, 'loader.mjs'), `
+    import { basename } from 'path';
+    export async function load(url, context, next) {
+      console.log('load ' + basename(url));
+      if (url.endsWith('slow.mjs'))
+        await new Promise((resolve) => setTimeout(resolve, 100));
+      const result = await next(url, context);
+      console.log('loaded ' + basename(url));
+      return result;
+    }
+  `);
+  const { code, stdout, stderr } = await spawnPromisified(process.execPath, [
+    '--no-warnings',
+    '--experimental-loader',
+    pathToFileURL(path.join(dir, 'loader.mjs')).href,
+    path.join(dir, 'main.mjs'),
+  ]);
+  assert.strictEqual(code, 0, stderr);
+  const events = stdout.trim().split('\n');
+  assert.ok(
+    events.indexOf('loaded slow.mjs') < events.indexOf('load child.mjs'),
+    events.join(', '));
+}
@@ -0,0 +1,43 @@
+'use strict';
+
+// Workers of an application that was started from this snapshot report what
+// they see, and the main thread prints all reports once they are done.
+
+const { setDeserializeMainFunction } = require('v8').startupSnapshot;
+
+globalThis.fromSnapshot = 'main thread only';
+
+function report() {
+  const { parentPort, isMainThread, workerData } = require('worker_threads');
+  parentPort.postMessage({
+    name: workerData,
+    isMainThread,
+    fromSnapshot: typeof globalThis.fromSnapshot,
+    env: process.env.SNAPSHOT_WORKER_TEST,
+    readFileSync: typeof require('fs').readFileSync,
+  });
+}
+
+setDeserializeMainFunction(() => {
+  const { Worker } = require('worker_threads');
+  const workers = {
+    'default': {},
+    // Workers with options of their own are bootstrapped from scratch.
+    'execArgv': { execArgv: ['--no-warnings'] },
+    'env': { env: { SNAPSHOT_WORKER_TEST: 'own env' } },
+  };
+  const reports = [];
+  for (const [name, options] of Object.entries(workers)) {
+    const worker = new Worker(`(${report})()`, {
+      ...options,
+      eval: true,
+      workerData: name,
+    });
+    worker.on('message', (report) => reports.push(report));
+    worker.on('exit', (code) => {
+      reports.push({ name, code });
+      if (reports.length === 2 * Object.keys(workers).length)
+        console.log(JSON.stringify(reports));
+    });
+  }
+});
@@ -0,0 +1,73 @@
+'use strict';
+
+// Calls the Buffer methods backed by V8 fast API calls often enough for them
+// to be optimized, and checks that both the fast and the slow paths agree.
+
+require('../common');
+const assert = require('assert');
+
+const kIterations = 1e4;
+
+const a = Buffer.from('abcdefgh');
+const b = Buffer.from('abcdefgz');
+
+for (let i = 0; i < kIterations; i++) {
+  assert.strictEqual(Buffer.compare(a, b), -1);
+  assert.strictEqual(Buffer.compare(b, a), 1);
+  assert.strictEqual(Buffer.compare(a, a), 0);
+  assert.strictEqual(a.compare(b, 0, 7, 0, 7), 0);
+  assert.strictEqual(a.compare(b, 1, 8, 1, 8), -1);
+  assert.strictEqual(a.compare(b, 0, 4, 0, 8), 1);
+
+  assert.strictEqual(a.indexOf(0x64), 3);
+  assert.strictEqual(a.lastIndexOf(0x61), 0);
+  assert.strictEqual(a.indexOf(0x7a), -1);
+  assert.strictEqual(a.indexOf(0x66, -3), 5);
+  assert.strictEqual(a.indexOf(Buffer.from('cd')), 2);
+  assert.strictEqual(a.lastIndexOf(Buffer.from('h')), 7);
+  assert.strictEqual(a.indexOf(Buffer.from('zz')), -1);
+  assert.strictEqual(a.indexOf(Buffer.alloc(0), 3), 3);
+
+  assert.strictEqual(Buffer.byteLength('hello'), 5);
+  assert.strictEqual(Buffer.byteLength('héllo'), 6);
+  assert.strictEqual(Buffer.byteLength('€'), 3);
+
+  const target = Buffer.alloc(6);
+  assert.strictEqual(a.copy(target, 1, 2, 6), 4);
+  assert.deepStrictEqual(target, Buffer.from('\0cdef\0'));
+  assert.strictEqual(a.copy(target, 4), 2);
+  assert.deepStrictEqual(target, Buffer.from('\0cdeab'));
+  assert.deepStrictEqual(Buffer.concat([a, b], 10), Buffer.from('abcdefghab'));
+
+  const filled = Buffer.alloc(7);
+  filled.fill(Buffer.from('xyz'), 1);
+  assert.deepStrictEqual(filled, Buffer.from('\0xyzxyz'));
+  assert.throws(() => filled.fill(Buffer.alloc(0)), {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+
+  const swapped = Buffer.from([1, 2, 3, 4, 5, 6, 7, 8]);
+  assert.strictEqual(swapped.swap16(), swapped);
+  assert.deepStrictEqual(swapped, Buffer.from([2, 1, 4, 3, 6, 5, 8, 7]));
+  assert.strictEqual(swapped.swap32(), swapped);
+  assert.deepStrictEqual(swapped, Buffer.from([3, 4, 1, 2, 7, 8, 5, 6]));
+  assert.strictEqual(swapped.swap64(), swapped);
+  assert.deepStrictEqual(swapped, Buffer.from([6, 5, 8, 7, 2, 1, 4, 3]));
+}
+
+// Out-of-range arguments still throw once the callers are optimized.
+assert.throws(() => a.compare(b, 0, 8, 9, 10), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => a.copy(b, 0, 9, 10), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+
+// The native swap paths are only taken for larger buffers.
+const large = Buffer.alloc(256);
+for (let i = 0; i < large.length; i++) large[i] = i;
+for (let i = 0; i < kIterations; i++) {
+  assert.strictEqual(large.swap16(), large);
+  assert.strictEqual(large.swap16(), large);
+}
+for (let i = 0; i < large.length; i++) assert.strictEqual(large[i], i);
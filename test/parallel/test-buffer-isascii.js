@@ -0,0 +1,55 @@
+'use strict';
+
+require('../common');
+const assert = require('assert');
+const { isAscii, Buffer } = require('buffer');
+const { TextEncoder } = require('util');
+
+const encoder = new TextEncoder();
+
+assert.strictEqual(isAscii(encoder.encode('hello')), true);
+assert.strictEqual(isAscii(encoder.encode('ğ')), false);
+assert.strictEqual(isAscii(Buffer.from([])), true);
+
+// Check every position across the block sizes of the vectorized code.
+for (let length = 1; length < 300; length++) {
+  const buf = Buffer.alloc(length, 'a');
+  assert.strictEqual(isAscii(buf), true);
+  for (const pos of [0, length >> 1, length - 1]) {
+    buf[pos] = 0x80;
+    assert.strictEqual(isAscii(buf), false);
+    buf[pos] = 0x7f;
+  }
+}
+
+[
+  null,
+  undefined,
+  'hello',
+  true,
+  false,
+].forEach((input) => {
+  assert.throws(
+    () => { isAscii(input); },
+    {
+      code: 'ERR_INVALID_ARG_TYPE',
+    },
+  );
+});
+
+{
+  // Test with ArrayBuffer and other TypedArrays.
+  const { buffer } = encoder.encode('hello');
+  assert.strictEqual(isAscii(buffer), true);
+  assert.strictEqual(isAscii(new Uint16Array(buffer, 0, 2)), true);
+  assert.strictEqual(isAscii(new Uint8Array([0xff]).buffer), false);
+}
+
+{
+  // Detached buffers are rejected instead of being treated as empty.
+  const view = encoder.encode('hello');
+  const { buffer } = view;
+  structuredClone(buffer, { transfer: [buffer] });
+  assert.throws(() => isAscii(buffer), { code: 'ERR_INVALID_STATE' });
+  assert.throws(() => isAscii(view), { code: 'ERR_INVALID_STATE' });
+}
@@ -0,0 +1,52 @@
+'use strict';
+
+// Well-formed UTF-8 is decoded to Latin-1 or UTF-16 by Node.js itself,
+// malformed UTF-8 is left to V8. Check both, with the non-ASCII characters at
+// every offset of the vector blocks that are used for decoding.
+
+require('../common');
+const assert = require('assert');
+
+const chars = [
+  'é',  // Latin-1
+  'ÿ',
+  'Ā',  // Two-byte
+  '€',
+  '😀',  // Surrogate pair
+];
+
+for (let offset = 0; offset < 40; offset++) {
+  const ascii = 'x'.repeat(offset);
+  for (const char of chars) {
+    for (const str of [
+      ascii + char,
+      ascii + char + 'y'.repeat(40),
+      ascii + char + 'é'.repeat(20) + ascii,
+      char.repeat(offset + 1),
+    ]) {
+      assert.strictEqual(Buffer.from(str).toString(), str);
+      assert.strictEqual(new TextDecoder().decode(Buffer.from(str)), str);
+      assert.strictEqual(
+        new TextDecoder('utf-8', { fatal: true }).decode(Buffer.from(str)),
+        str);
+    }
+  }
+
+  // Truncated sequences and lone continuation bytes are replaced.
+  const prefix = Buffer.from(ascii + 'é');
+  for (const [bytes, expected] of [
+    [[0xc3], '�'],
+    [[0xe2, 0x82], '�'],
+    [[0x80, 0x61], '�a'],
+    [[0xed, 0xa0, 0x80], '���'],
+  ]) {
+    const buf = Buffer.concat([prefix, Buffer.from(bytes)]);
+    assert.strictEqual(buf.toString(), ascii + 'é' + expected);
+  }
+}
+
+// Long strings are created as external strings.
+for (const char of chars) {
+  const str = 'abc' + char.repeat(600000);
+  assert.strictEqual(Buffer.from(str).toString(), str);
+}
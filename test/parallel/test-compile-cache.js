@@ -0,0 +1,91 @@
+'use strict';
+
+// Tests that --experimental-compile-cache stores the code compiled for
+// CommonJS and ES modules in a file, and uses it on the next run.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const { pathToFileURL } = require('url');
+
+tmpdir.refresh();
+const cacheFile = path.join(tmpdir.path, 'compile-cache');
+const cjsFile = path.join(tmpdir.path, 'dep.js');
+const esmFile = path.join(tmpdir.path, 'main.mjs');
+
+fs.writeFileSync(cjsFile, 'module.exports = (a, b) => a + b;\n');
+fs.writeFileSync(esmFile, `
+  import { createRequire } from 'module';
+  const add = createRequire(import.meta.url)('./dep.js');
+  console.log(add(1, 2));
+`);
+
+function run(...execArgv) {
+  const child = spawnSync(process.execPath, [
+    `--experimental-compile-cache=${cacheFile}`,
+    ...execArgv,
+    esmFile,
+  ], {
+    cwd: tmpdir.path,
+    env: { ...process.env, NODE_DEBUG_NATIVE: 'COMPILE_CACHE' },
+  });
+  const stderr = child.stderr.toString();
+  assert.strictEqual(child.status, 0, stderr);
+  assert.strictEqual(child.stdout.toString().trim(), '3');
+  return stderr;
+}
+
+const esmURL = pathToFileURL(esmFile).href;
+
+// Nothing is cached yet, the compiled code is written to the cache file.
+{
+  const stderr = run();
+  assert.match(stderr, /Could not read compile cache/);
+  assert(stderr.includes(`Caching code for ${cjsFile}`), stderr);
+  assert(stderr.includes(`Caching code for ${esmURL}`), stderr);
+  assert.match(stderr, /Wrote 2 entries to compile cache/);
+  assert(fs.statSync(cacheFile).size > 0);
+}
+
+// The next run uses the cached code for both modules.
+{
+  const stderr = run();
+  assert.match(stderr, /Loaded 2 entries from compile cache/);
+  assert(stderr.includes(`Found cached code for ${cjsFile}`), stderr);
+  assert(stderr.includes(`Found cached code for ${esmURL}`), stderr);
+  assert.doesNotMatch(stderr, /Caching code/);
+  assert.doesNotMatch(stderr, /Wrote \d+ entries/);
+}
+
+// Modified files are compiled again, and the cache is updated.
+{
+  fs.writeFileSync(cjsFile, 'module.exports = (a, b) => b + a;\n');
+  let stderr = run();
+  assert(stderr.includes(`Cached code for ${cjsFile} is outdated`), stderr);
+  assert(stderr.includes(`Caching code for ${cjsFile}`), stderr);
+  assert(stderr.includes(`Found cached code for ${esmURL}`), stderr);
+
+  stderr = run();
+  assert(stderr.includes(`Found cached code for ${cjsFile}`), stderr);
+}
+
+// The cache is discarded when it was produced with different V8 flags.
+{
+  const stderr = run('--no-lazy');
+  assert.match(stderr, /invalid or was written by another version of V8/);
+  assert.match(stderr, /Wrote 2 entries to compile cache/);
+}
+
+// A corrupted cache file is ignored.
+{
+  fs.writeFileSync(cacheFile, 'garbage');
+  const stderr = run();
+  assert.match(stderr, /Compile cache .* is truncated/);
+  assert.match(stderr, /Wrote 2 entries to compile cache/);
+}
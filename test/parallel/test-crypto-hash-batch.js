@@ -0,0 +1,102 @@
+'use strict';
+// This tests crypto.hashBatch() and crypto.hashBatchSync().
+const common = require('../common');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+function expected(algorithm, inputs) {
+  return Buffer.concat(inputs.map((input) => {
+    if (input instanceof ArrayBuffer) input = new Uint8Array(input);
+    return crypto.createHash(algorithm).update(input).digest();
+  }));
+}
+
+const inputs = [
+  'Test123',
+  '',
+  'ü€😀',
+  Buffer.alloc(1000, 'a'),
+  new Uint16Array([1, 2, 3]),
+  new DataView(new ArrayBuffer(16)),
+  new ArrayBuffer(7),
+];
+
+for (const algorithm of ['sha1', 'sha256', 'sha512', 'md5', 'sha3-256']) {
+  const result = crypto.hashBatchSync(algorithm, inputs);
+  assert(Buffer.isBuffer(result));
+  assert.deepStrictEqual(result, expected(algorithm, inputs));
+
+  crypto.hashBatch(algorithm, inputs, common.mustSucceed((digests) => {
+    assert.deepStrictEqual(digests, result);
+  }));
+}
+
+// A single buffer with offsets.
+{
+  const data = Buffer.from('abcdefghij');
+  const chunks = ['abc', '', 'defg', 'hij'];
+  const offsets = [0, 3, 3, 7];
+  const digests = expected('sha256', chunks);
+  assert.deepStrictEqual(crypto.hashBatchSync('sha256', data, offsets),
+                         digests);
+  assert.deepStrictEqual(
+    crypto.hashBatchSync('sha256', data, new Uint32Array(offsets)), digests);
+  // Leading bytes that are not part of any input are ignored.
+  assert.deepStrictEqual(crypto.hashBatchSync('sha256', data, [3, 3, 7]),
+                         digests.subarray(32));
+  crypto.hashBatch('sha256', data, offsets, common.mustSucceed((result) => {
+    assert.deepStrictEqual(result, digests);
+  }));
+
+  // Without offsets, data is a single input.
+  assert.deepStrictEqual(crypto.hashBatchSync('sha256', data),
+                         expected('sha256', [data]));
+  crypto.hashBatch('sha256', 'abcdefghij', common.mustSucceed((result) => {
+    assert.deepStrictEqual(result, expected('sha256', [data]));
+  }));
+}
+
+// Modifying the inputs after starting the job does not affect the result.
+{
+  const data = Buffer.from('abcdef');
+  const chunks = [Buffer.from('abc'), Buffer.from('def')];
+  const fromOffsets = expected('sha1', [data.subarray(0, 3), data.subarray(3)]);
+  const fromArray = expected('sha1', chunks);
+  crypto.hashBatch('sha1', data, [0, 3], common.mustSucceed((result) => {
+    assert.deepStrictEqual(result, fromOffsets);
+  }));
+  crypto.hashBatch('sha1', chunks, common.mustSucceed((result) => {
+    assert.deepStrictEqual(result, fromArray);
+  }));
+  data.fill(0);
+  chunks[0].fill(0);
+}
+
+// No inputs.
+assert.deepStrictEqual(crypto.hashBatchSync('sha256', []), Buffer.alloc(0));
+assert.deepStrictEqual(crypto.hashBatchSync('sha256', Buffer.alloc(4), []),
+                       Buffer.alloc(0));
+
+// Invalid arguments.
+assert.throws(() => crypto.hashBatchSync(1, []),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => crypto.hashBatchSync('sha256', [1]),
+              { code: 'ERR_INVALID_ARG_TYPE', message: /"data\[0\]"/ });
+assert.throws(() => crypto.hashBatchSync('sha256', [], [0]),
+              { code: 'ERR_INVALID_ARG_VALUE' });
+assert.throws(() => crypto.hashBatchSync('sha256', Buffer.alloc(4), {}),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => crypto.hashBatchSync('sha256', Buffer.alloc(4), [2, 1]),
+              { code: 'ERR_OUT_OF_RANGE', message: /"offsets\[1\]"/ });
+assert.throws(() => crypto.hashBatchSync('sha256', Buffer.alloc(4), [5]),
+              { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => crypto.hashBatchSync('sha256', Buffer.alloc(4), [0.5]),
+              { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => crypto.hashBatchSync('not a hash', []),
+              { code: 'ERR_CRYPTO_INVALID_DIGEST' });
+assert.throws(() => crypto.hashBatch('sha256', []),
+              { code: 'ERR_INVALID_ARG_TYPE' });
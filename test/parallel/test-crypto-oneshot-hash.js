@@ -0,0 +1,65 @@
+'use strict';
+// This tests crypto.hash() works.
+const common = require('../common');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fixtures = require('../common/fixtures');
+const fs = require('fs');
+
+// Test errors for invalid arguments.
+[undefined, null, true, 1, () => {}, {}].forEach((invalid) => {
+  assert.throws(() => { crypto.hash(invalid, 'test'); },
+                { code: 'ERR_INVALID_ARG_TYPE' });
+});
+
+[undefined, null, true, 1, () => {}, {}].forEach((invalid) => {
+  assert.throws(() => { crypto.hash('sha1', invalid); },
+                { code: 'ERR_INVALID_ARG_TYPE' });
+});
+
+[null, true, 1, () => {}, {}].forEach((invalid) => {
+  assert.throws(() => { crypto.hash('sha1', 'test', invalid); },
+                { code: 'ERR_INVALID_ARG_TYPE' });
+});
+
+assert.throws(() => { crypto.hash('sha1', 'test', 'not an encoding'); },
+              { code: 'ERR_INVALID_ARG_VALUE' });
+
+assert.throws(() => { crypto.hash('not a hash', 'test'); },
+              /Digest method not supported/);
+
+// The results match those of the stateful API, for all algorithms and
+// encodings.
+const input = fs.readFileSync(fixtures.path('sample.png'));
+const inputs = [
+  '',
+  'Test123',
+  'ü€😀\ud800',
+  input.toString('latin1'),
+  input,
+  new Uint16Array(input.buffer, input.byteOffset, input.length >>> 1),
+  new DataView(input.buffer, input.byteOffset, input.length),
+];
+const encodings = [undefined, 'hex', 'base64', 'base64url', 'latin1',
+                   'buffer', 'Buffer', 'HEX'];
+
+for (const algorithm of crypto.getHashes()) {
+  for (const data of inputs) {
+    for (const encoding of encodings) {
+      const oldDigest = crypto.createHash(algorithm).update(data)
+        .digest(encoding === undefined ? 'hex' : encoding);
+      const digest = crypto.hash(algorithm, data, encoding);
+      assert.deepStrictEqual(digest, oldDigest);
+    }
+  }
+}
+
+// Aliases of algorithms resolve to the same implementations.
+assert.strictEqual(crypto.hash('RSA-SHA256', 'abc'),
+                   crypto.hash('sha256', 'abc'));
+assert.strictEqual(crypto.hash('SHA256', 'abc'),
+                   crypto.hash('sha256', 'abc'));
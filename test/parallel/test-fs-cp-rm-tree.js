@@ -0,0 +1,320 @@
+'use strict';
+
+// On POSIX systems fs.cp() copies new directories and fs.rm() removes
+// directories with a single binding call each. Check that the result is the
+// same as the entry-by-entry implementation that is used with a filter.
+
+const common = require('../common');
+if (common.isWindows)
+  common.skip('the native tree functions are not used on Windows');
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+let dirc = 0;
+function nextdir() {
+  return path.join(tmpdir.path, `tree_${++dirc}`);
+}
+
+const src = nextdir();
+fs.mkdirSync(path.join(src, 'a', 'b', 'c'), { recursive: true });
+fs.writeFileSync(path.join(src, 'file'), 'hello');
+fs.writeFileSync(path.join(src, 'a', 'large'), Buffer.alloc(300 * 1024, 'x'));
+fs.writeFileSync(path.join(src, 'a', 'b', 'c', 'deep'), 'deep');
+fs.writeFileSync(path.join(src, 'a', 'empty'), '');
+fs.symlinkSync('../file', path.join(src, 'a', 'relative-link'));
+fs.symlinkSync(path.join(src, 'file'), path.join(src, 'absolute-link'));
+fs.symlinkSync('missing', path.join(src, 'dangling-link'));
+fs.chmodSync(path.join(src, 'file'), 0o640);
+fs.chmodSync(path.join(src, 'a', 'b'), 0o750);
+fs.utimesSync(path.join(src, 'file'), 1000, 2000);
+fs.mkdirSync(path.join(src, 'readonly'));
+fs.writeFileSync(path.join(src, 'readonly', 'file'), 'readonly');
+fs.chmodSync(path.join(src, 'readonly', 'file'), 0o444);
+
+function describeTree(root, { followLinks = false } = {}) {
+  const tree = {};
+  (function walk(dir) {
+    for (const name of fs.readdirSync(dir).sort()) {
+      const p = path.join(dir, name);
+      const stats = followLinks ? fs.statSync(p) : fs.lstatSync(p);
+      const entry = { mode: stats.mode };
+      if (stats.isSymbolicLink()) {
+        entry.target = fs.readlinkSync(p);
+      } else if (stats.isFile()) {
+        entry.content = fs.readFileSync(p).toString('base64', 0, 64);
+        entry.size = stats.size;
+      }
+      tree[path.relative(root, p)] = entry;
+      if (stats.isDirectory())
+        walk(p);
+    }
+  })(root);
+  return tree;
+}
+
+// Copy with and without the native tree copy, which is skipped when a filter
+// is given, and compare the results.
+function checkCopy(options, copy) {
+  const native = nextdir();
+  const fallback = nextdir();
+  copy(native, options);
+  copy(fallback, { ...options, filter: () => true });
+  const describeOptions = { followLinks: options.dereference };
+  const expected = describeTree(fallback, describeOptions);
+  assert.deepStrictEqual(describeTree(native, describeOptions), expected);
+  assert.strictEqual(fs.statSync(native).mode, fs.statSync(src).mode);
+  if (options.preserveTimestamps) {
+    assert.strictEqual(fs.statSync(path.join(native, 'file')).mtimeMs,
+                       2000 * 1000);
+  }
+  return native;
+}
+
+const optionsList = [
+  { recursive: true },
+  { recursive: true, dereference: true },
+  { recursive: true, verbatimSymlinks: true },
+];
+
+for (const options of optionsList) {
+  // Dangling links cannot be dereferenced.
+  if (options.dereference)
+    fs.unlinkSync(path.join(src, 'dangling-link'));
+
+  const dest = checkCopy(options, (dest, options) => {
+    fs.cpSync(src, dest, options);
+  });
+  if (!options.dereference && !options.verbatimSymlinks) {
+    assert.strictEqual(
+      fs.readlinkSync(path.join(dest, 'a', 'relative-link')),
+      path.join(src, 'file'));
+  } else if (options.verbatimSymlinks) {
+    assert.strictEqual(
+      fs.readlinkSync(path.join(dest, 'a', 'relative-link')), '../file');
+  }
+
+  if (options.dereference)
+    fs.symlinkSync('missing', path.join(src, 'dangling-link'));
+}
+
+{
+  const options = { recursive: true, preserveTimestamps: true };
+  const expected = describeTree(
+    checkCopy(options, (dest, options) => fs.cpSync(src, dest, options)));
+  const dest = nextdir();
+  fs.cp(src, dest, options, common.mustSucceed(() => {
+    assert.deepStrictEqual(describeTree(dest), expected);
+    assert.strictEqual(fs.statSync(path.join(dest, 'file')).mtimeMs,
+                       2000 * 1000);
+  }));
+}
+
+// Copies into an existing directory only create the missing subdirectories
+// natively.
+{
+  const dest = nextdir();
+  fs.mkdirSync(dest);
+  fs.writeFileSync(path.join(dest, 'file'), 'old');
+  fs.cpSync(src, dest, { recursive: true, force: false });
+  assert.strictEqual(fs.readFileSync(path.join(dest, 'file'), 'utf8'), 'old');
+  assert.strictEqual(
+    fs.readFileSync(path.join(dest, 'a', 'b', 'c', 'deep'), 'utf8'), 'deep');
+}
+
+// Files in sysfs report a size, but copy_file_range() does not copy their
+// contents. They are read and written normally instead.
+{
+  const sysfsFile = '/sys/class/net/lo/address';
+  if (common.isLinux && fs.existsSync(sysfsFile)) {
+    const withSysfs = nextdir();
+    fs.mkdirSync(withSysfs);
+    fs.symlinkSync(sysfsFile, path.join(withSysfs, 'address'));
+    const expected = fs.readFileSync(sysfsFile, 'utf8');
+    assert.notStrictEqual(expected, '');
+
+    const dest = nextdir();
+    fs.cpSync(withSysfs, dest, { recursive: true, dereference: true });
+    assert.strictEqual(fs.readFileSync(path.join(dest, 'address'), 'utf8'),
+                       expected);
+
+    const dest2 = nextdir();
+    fs.cp(withSysfs, dest2, { recursive: true, dereference: true },
+          common.mustSucceed(() => {
+            assert.strictEqual(
+              fs.readFileSync(path.join(dest2, 'address'), 'utf8'), expected);
+          }));
+  }
+}
+
+// Errors report the entry that could not be copied, like the fallback does.
+// Running as root ignores the permissions.
+if (process.getuid() !== 0) {
+  const unreadable = nextdir();
+  fs.mkdirSync(path.join(unreadable, 'sub'), { recursive: true });
+  fs.writeFileSync(path.join(unreadable, 'sub', 'secret'), '');
+  fs.chmodSync(path.join(unreadable, 'sub', 'secret'), 0o000);
+
+  for (const filter of [undefined, () => true]) {
+    const dest = nextdir();
+    assert.throws(() => fs.cpSync(unreadable, dest, { recursive: true, filter }), {
+      code: 'EACCES',
+      syscall: 'copyfile',
+      path: path.join(unreadable, 'sub', 'secret'),
+      dest: path.join(dest, 'sub', 'secret'),
+    });
+  }
+
+  const dest = nextdir();
+  fs.cp(unreadable, dest, { recursive: true }, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'EACCES');
+    assert.strictEqual(err.path, path.join(unreadable, 'sub', 'secret'));
+  }));
+}
+
+// Special files below the copied directory are rejected like at the top.
+{
+  const withFifo = nextdir();
+  fs.mkdirSync(path.join(withFifo, 'sub'), { recursive: true });
+  const { status } = spawnSync('mkfifo', [path.join(withFifo, 'sub', 'fifo')]);
+  if (status === 0) {
+    const dest = nextdir();
+    assert.throws(() => fs.cpSync(withFifo, dest, { recursive: true }), {
+      code: 'ERR_FS_CP_FIFO_PIPE',
+      path: path.join(dest, 'sub', 'fifo'),
+    });
+
+    const dest2 = nextdir();
+    fs.cp(withFifo, dest2, { recursive: true }, common.mustCall((err) => {
+      assert.strictEqual(err.code, 'ERR_FS_CP_FIFO_PIPE');
+      assert.strictEqual(err.path, path.join(dest2, 'sub', 'fifo'));
+    }));
+
+    const dest3 = nextdir();
+    assert.rejects(fs.promises.cp(withFifo, dest3, { recursive: true }), {
+      code: 'ERR_FS_CP_FIFO_PIPE',
+      path: path.join(dest3, 'sub', 'fifo'),
+    }).then(common.mustCall());
+  }
+}
+
+// Removing a tree, including read-only files and dangling links.
+{
+  function makeTree() {
+    const dir = nextdir();
+    fs.cpSync(src, dir, { recursive: true });
+    for (let i = 0; i < 100; i++)
+      fs.writeFileSync(path.join(dir, 'a', `${i}`), `${i}`);
+    return dir;
+  }
+
+  const sync = makeTree();
+  fs.rmSync(sync, { recursive: true });
+  assert(!fs.existsSync(sync));
+
+  const callback = makeTree();
+  fs.rm(callback, { recursive: true }, common.mustSucceed(() => {
+    assert(!fs.existsSync(callback));
+  }));
+
+  const promise = makeTree();
+  fs.promises.rm(promise, { recursive: true }).then(common.mustCall(() => {
+    assert(!fs.existsSync(promise));
+  }));
+
+  // Links are removed, not their targets.
+  const linked = nextdir();
+  fs.mkdirSync(linked);
+  fs.symlinkSync(src, path.join(linked, 'link'));
+  fs.rmSync(linked, { recursive: true });
+  assert(fs.existsSync(path.join(src, 'file')));
+
+  // Files are removed too.
+  const file = path.join(tmpdir.path, 'rm-file');
+  fs.writeFileSync(file, '');
+  fs.rmSync(file, { recursive: true });
+  assert(!fs.existsSync(file));
+}
+
+// Entries that cannot be removed are reported.
+if (process.getuid() !== 0) {
+  const dir = nextdir();
+  fs.mkdirSync(path.join(dir, 'locked'), { recursive: true });
+  fs.writeFileSync(path.join(dir, 'locked', 'file'), '');
+  fs.chmodSync(path.join(dir, 'locked'), 0o555);
+
+  const expected = {
+    code: 'EACCES',
+    path: path.join(dir, 'locked', 'file'),
+  };
+  assert.throws(() => fs.rmSync(dir, { recursive: true }), expected);
+  fs.rm(dir, { recursive: true }, common.mustCall((err) => {
+    assert.strictEqual(err.code, expected.code);
+    assert.strictEqual(err.path, expected.path);
+    fs.chmodSync(path.join(dir, 'locked'), 0o755);
+  }));
+}
+
+// All the entries that cannot be removed are reported.
+if (process.getuid() !== 0) {
+  const dir = nextdir();
+  for (const name of ['locked1', 'locked2']) {
+    fs.mkdirSync(path.join(dir, name), { recursive: true });
+    fs.writeFileSync(path.join(dir, name, 'file'), '');
+    fs.chmodSync(path.join(dir, name), 0o555);
+  }
+
+  assert.throws(() => fs.rmSync(dir, { recursive: true }), (err) => {
+    assert(err instanceof AggregateError);
+    assert.strictEqual(err.code, 'EACCES');
+    assert.deepStrictEqual(err.errors.map((e) => e.path).sort(), [
+      path.join(dir, 'locked1', 'file'),
+      path.join(dir, 'locked2', 'file'),
+    ]);
+    return true;
+  });
+  fs.chmodSync(path.join(dir, 'locked1'), 0o755);
+  fs.chmodSync(path.join(dir, 'locked2'), 0o755);
+}
+
+// Devices are copied like copyFile() copies them, as much as their size
+// says, instead of being read until the end, which /dev/zero does not have.
+if (fs.existsSync('/dev/zero')) {
+  const withDevice = nextdir();
+  fs.mkdirSync(withDevice);
+  fs.symlinkSync('/dev/zero', path.join(withDevice, 'zero'));
+  const dest = nextdir();
+  fs.cpSync(withDevice, dest, { recursive: true, dereference: true });
+  assert.strictEqual(fs.statSync(path.join(dest, 'zero')).size, 0);
+}
+
+// Trees deeper than the number of directories that are kept open at a time
+// are copied and removed too.
+{
+  const deep = nextdir();
+  let dir = deep;
+  for (let i = 0; i < 80; i++) {
+    dir = path.join(dir, `${i}`);
+    fs.mkdirSync(dir, { recursive: true });
+    fs.writeFileSync(path.join(dir, 'file'), `${i}`);
+  }
+
+  const dest = nextdir();
+  fs.cpSync(deep, dest, { recursive: true });
+  assert.deepStrictEqual(describeTree(dest), describeTree(deep));
+  fs.rmSync(dest, { recursive: true });
+  assert(!fs.existsSync(dest));
+
+  const dest2 = nextdir();
+  fs.cp(deep, dest2, { recursive: true }, common.mustSucceed(() => {
+    assert.deepStrictEqual(describeTree(dest2), describeTree(deep));
+    fs.rm(dest2, { recursive: true }, common.mustSucceed(() => {
+      assert(!fs.existsSync(dest2));
+    }));
+  }));
+}
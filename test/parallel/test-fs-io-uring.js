@@ -0,0 +1,141 @@
+// Flags: --experimental-fs-io-uring
+'use strict';
+
+// The operations that --experimental-fs-io-uring moves onto io_uring must
+// behave exactly like their threadpool counterparts. When io_uring is not
+// available the threadpool is used, so this test passes everywhere.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const fsPromises = require('fs/promises');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'io-uring.txt');
+const link = path.join(tmpdir.path, 'io-uring-link');
+const data = Buffer.from('hello io_uring\n'.repeat(100));
+
+function compareStats(actual, expected) {
+  for (const key of ['dev', 'ino', 'mode', 'nlink', 'uid', 'gid', 'rdev',
+                     'size', 'blksize', 'blocks', 'mtimeMs', 'ctimeMs',
+                     'birthtimeMs']) {
+    assert.strictEqual(actual[key], expected[key], key);
+  }
+}
+
+fs.open(file, 'w+', common.mustSucceed((fd) => {
+  fs.write(fd, data, 0, data.length, null, common.mustSucceed((written) => {
+    assert.strictEqual(written, data.length);
+    fs.writev(fd, [data, data], data.length, common.mustSucceed((written) => {
+      assert.strictEqual(written, 2 * data.length);
+      fs.fsync(fd, common.mustSucceed(() => {
+        fs.fdatasync(fd, common.mustSucceed(() => {
+          fs.fstat(fd, common.mustSucceed((stats) => {
+            assert.strictEqual(stats.size, 3 * data.length);
+            compareStats(stats, fs.fstatSync(fd));
+            readBack(fd);
+          }));
+        }));
+      }));
+    }));
+  }));
+}));
+
+function readBack(fd) {
+  const buf = Buffer.alloc(data.length);
+  fs.read(fd, buf, 0, buf.length, data.length, common.mustSucceed((read) => {
+    assert.strictEqual(read, data.length);
+    assert.deepStrictEqual(buf, data);
+
+    const bufs = [Buffer.alloc(10), Buffer.alloc(data.length * 3)];
+    fs.readv(fd, bufs, 0, common.mustSucceed((read, buffers) => {
+      assert.strictEqual(read, 3 * data.length);
+      assert.deepStrictEqual(Buffer.concat(buffers),
+                             Buffer.concat([data, data, data, Buffer.alloc(10)]));
+      fs.close(fd, common.mustSucceed(() => {
+        afterClose(fd);
+      }));
+    }));
+  }));
+}
+
+function afterClose(fd) {
+  fs.fstat(fd, common.expectsError({ code: 'EBADF', syscall: 'fstat' }));
+
+  fs.stat(file, common.mustSucceed((stats) => {
+    compareStats(stats, fs.statSync(file));
+  }));
+
+  fs.symlinkSync(file, link);
+  fs.lstat(link, common.mustSucceed((stats) => {
+    assert(stats.isSymbolicLink());
+    compareStats(stats, fs.lstatSync(link));
+  }));
+  fs.stat(link, { bigint: true }, common.mustSucceed((stats) => {
+    assert.strictEqual(stats.size, BigInt(3 * data.length));
+    assert.strictEqual(stats.mtimeNs, fs.statSync(file, { bigint: true }).mtimeNs);
+  }));
+
+  const missing = path.join(tmpdir.path, 'missing');
+  fs.open(missing, 'r', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+    assert.strictEqual(err.syscall, 'open');
+    assert.strictEqual(err.path, missing);
+  }));
+  fs.stat(missing, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+    assert.strictEqual(err.syscall, 'stat');
+    assert.strictEqual(err.path, missing);
+  }));
+
+  // Reading from the current file position advances it.
+  const fd2 = fs.openSync(file, 'r');
+  const first = Buffer.alloc(data.length);
+  fs.read(fd2, first, 0, first.length, -1, common.mustSucceed((read) => {
+    assert.strictEqual(read, data.length);
+    assert.deepStrictEqual(first, data);
+    const second = Buffer.alloc(data.length);
+    fs.read(fd2, second, 0, second.length, null, common.mustSucceed((read) => {
+      assert.strictEqual(read, data.length);
+      assert.deepStrictEqual(second, data);
+      fs.closeSync(fd2);
+    }));
+  }));
+
+  // More concurrent requests than fit into the ring fall back to the
+  // threadpool.
+  const fd3 = fs.openSync(file, 'r');
+  let pending = 1000;
+  for (let i = 0; i < 1000; i++) {
+    const buf = Buffer.alloc(10);
+    fs.read(fd3, buf, 0, 10, i, common.mustSucceed((read) => {
+      assert.strictEqual(read, 10);
+      assert.deepStrictEqual(buf, Buffer.concat([data, data]).subarray(i, i + 10));
+      if (--pending === 0) fs.closeSync(fd3);
+    }));
+  }
+
+  promises().then(common.mustCall());
+}
+
+async function promises() {
+  const filehandle = await fsPromises.open(file, 'r+');
+  const { bytesWritten } = await filehandle.write(data, 0, data.length, 0);
+  assert.strictEqual(bytesWritten, data.length);
+  await filehandle.sync();
+  await filehandle.datasync();
+  const buf = Buffer.alloc(data.length);
+  const { bytesRead } = await filehandle.read(buf, 0, buf.length, 0);
+  assert.strictEqual(bytesRead, data.length);
+  assert.deepStrictEqual(buf, data);
+  compareStats(await filehandle.stat(), fs.fstatSync(filehandle.fd));
+  await filehandle.close();
+
+  compareStats(await fsPromises.stat(file), fs.statSync(file));
+  compareStats(await fsPromises.lstat(link), fs.lstatSync(link));
+  await assert.rejects(fsPromises.open(path.join(tmpdir.path, 'missing')),
+                       { code: 'ENOENT', syscall: 'open' });
+}
@@ -0,0 +1,151 @@
+'use strict';
+
+// fs.opendir() with the `recursive` and `withStats` options reads entries in
+// batches together with their lstat() information.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const root = path.join(tmpdir.path, 'tree');
+const expected = new Map();
+
+function add(relative, create) {
+  create(path.join(root, relative));
+  expected.set(relative, null);
+}
+
+fs.mkdirSync(root);
+add('a', (p) => fs.mkdirSync(p));
+add(path.join('a', 'b'), (p) => fs.mkdirSync(p));
+add(path.join('a', 'b', 'c'), (p) => fs.mkdirSync(p));
+add(path.join('a', 'b', 'c', 'deep'), (p) => fs.writeFileSync(p, 'deep'));
+add('empty', (p) => fs.mkdirSync(p));
+add('file', (p) => fs.writeFileSync(p, 'x'.repeat(1234)));
+for (let i = 0; i < 50; i++)
+  add(path.join('a', `file${i}`), (p) => fs.writeFileSync(p, `${i}`));
+if (!common.isWindows) {
+  add('link', (p) => fs.symlinkSync('a', p));
+}
+
+for (const relative of expected.keys())
+  expected.set(relative, fs.lstatSync(path.join(root, relative)));
+
+function checkDirent(dirent, { recursive, withStats }) {
+  assert(dirent instanceof fs.Dirent);
+  const relative = path.relative(root, path.join(dirent.path, dirent.name));
+  assert(expected.has(relative), `unexpected entry ${relative}`);
+  const stats = expected.get(relative);
+  if (!recursive)
+    assert.strictEqual(dirent.path, root);
+
+  assert.strictEqual(dirent.isFile(), stats.isFile());
+  assert.strictEqual(dirent.isDirectory(), stats.isDirectory());
+  assert.strictEqual(dirent.isSymbolicLink(), stats.isSymbolicLink());
+
+  if (withStats) {
+    assert(dirent.stats instanceof fs.Stats);
+    assert.strictEqual(dirent.stats, dirent.stats);
+    for (const key of ['dev', 'ino', 'mode', 'nlink', 'size', 'mtimeMs']) {
+      assert.strictEqual(dirent.stats[key], stats[key], key);
+    }
+  } else {
+    assert.strictEqual(dirent.stats, undefined);
+  }
+  return relative;
+}
+
+function expectedNames(recursive) {
+  return [...expected.keys()]
+    .filter((name) => recursive || !name.includes(path.sep))
+    .sort();
+}
+
+const optionsList = [
+  { recursive: true, withStats: true },
+  { recursive: true },
+  { withStats: true },
+  { recursive: true, withStats: true, bufferSize: 1 },
+  { recursive: true, withStats: true, bufferSize: 7 },
+];
+
+for (const options of optionsList) {
+  // Synchronous reads.
+  {
+    const dir = fs.opendirSync(root, options);
+    const names = [];
+    let dirent;
+    while ((dirent = dir.readSync()) !== null)
+      names.push(checkDirent(dirent, options));
+    dir.closeSync();
+    assert.deepStrictEqual(names.sort(), expectedNames(options.recursive));
+  }
+
+  // Callbacks.
+  fs.opendir(root, options, common.mustSucceed((dir) => {
+    const names = [];
+    dir.read(function next(err, dirent) {
+      assert.ifError(err);
+      if (dirent === null) {
+        assert.deepStrictEqual(names.sort(),
+                               expectedNames(options.recursive));
+        return dir.close(common.mustSucceed());
+      }
+      names.push(checkDirent(dirent, options));
+      dir.read(next);
+    });
+  }));
+
+  // Async iteration.
+  (async () => {
+    const names = [];
+    for await (const dirent of await fs.promises.opendir(root, options))
+      names.push(checkDirent(dirent, options));
+    assert.deepStrictEqual(names.sort(), expectedNames(options.recursive));
+  })().then(common.mustCall());
+}
+
+// Parents are listed before the entries of their subdirectories.
+{
+  const dir = fs.opendirSync(root, { recursive: true, bufferSize: 3 });
+  const seen = new Set([root]);
+  let dirent;
+  while ((dirent = dir.readSync()) !== null) {
+    assert(seen.has(dirent.path), dirent.path);
+    if (dirent.isDirectory())
+      seen.add(path.join(dirent.path, dirent.name));
+  }
+  dir.closeSync();
+}
+
+// Buffer names.
+{
+  const dir = fs.opendirSync(root, { withStats: true, encoding: 'buffer' });
+  const names = [];
+  let dirent;
+  while ((dirent = dir.readSync()) !== null) {
+    assert(Buffer.isBuffer(dirent.name));
+    names.push(dirent.name.toString());
+  }
+  dir.closeSync();
+  assert.deepStrictEqual(names.sort(), expectedNames(false));
+}
+
+// Closing a directory in the middle of a recursive walk.
+{
+  const dir = fs.opendirSync(root, { recursive: true, bufferSize: 1 });
+  for (let i = 0; i < 10; i++)
+    assert.notStrictEqual(dir.readSync(), null);
+  dir.closeSync();
+}
+
+// Invalid options.
+for (const key of ['recursive', 'withStats']) {
+  assert.throws(() => fs.opendirSync(root, { [key]: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
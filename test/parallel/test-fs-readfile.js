@@ -93,3 +93,40 @@ for (const e of fileInfo) {
     fs.readFile(fileInfo[0].name, { signal: 'hello' }, callback);
   }, { code: 'ERR_INVALID_ARG_TYPE', name: 'TypeError' });
 }
+{
+  // Paths are read and decoded in a single request. Check that the result
+  // matches decoding the Buffer in JS for every API flavor.
+  const { contents, name } = fileInfo[4];
+  for (const encoding of ['utf8', 'latin1', 'base64', 'hex', 'ucs2']) {
+    const expected = contents.toString(encoding);
+    assert.strictEqual(fs.readFileSync(name, encoding), expected);
+    fs.readFile(name, { encoding }, common.mustSucceed((data) => {
+      assert.strictEqual(data, expected);
+    }));
+    fs.promises.readFile(name, { encoding }).then(common.mustCall((data) => {
+      assert.strictEqual(data, expected);
+    }));
+  }
+  fs.promises.readFile(name).then(common.mustCall((data) => {
+    assert.deepStrictEqual(data, contents);
+  }));
+
+  const nonexistent = path.join(tmpdir.path, `${prefix}-nonexistent.txt`);
+  const expectedError = {
+    code: 'ENOENT',
+    syscall: 'open',
+    path: nonexistent,
+  };
+  fs.readFile(nonexistent, common.expectsError(expectedError));
+  assert.rejects(fs.promises.readFile(nonexistent), expectedError)
+    .then(common.mustCall());
+}
+
+if (common.isLinux) {
+  // Files in /proc report a size of 0 and are read until EOF.
+  const status = fs.readFileSync('/proc/self/status', 'latin1');
+  assert.match(status, /^Name:/);
+  fs.readFile('/proc/self/status', common.mustSucceed((data) => {
+    assert.match(data.toString(), /^Name:/);
+  }));
+}
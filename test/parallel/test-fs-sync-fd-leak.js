@@ -1,4 +1,3 @@
-// Flags: --expose-internals
 // Copyright Joyent, Inc. and other Node contributors.
 //
 // Permission is hereby granted, free of charge, to any person obtaining a
@@ -21,13 +20,27 @@
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 'use strict';
-require('../common');
+const common = require('../common');
 const assert = require('assert');
 const fs = require('fs');
-const { internalBinding } = require('internal/test/binding');
-const { UV_EBADF } = internalBinding('uv');
 
-// Ensure that (read|write|append)FileSync() closes the file descriptor
+// readFileSync() of a path opens and closes the file in a single binding
+// call, without going through fs.openSync() and fs.closeSync(). Ensure that
+// it closes the file descriptor when reading fails, by checking that the
+// descriptor it used is the lowest one available again afterwards.
+if (!common.isWindows) {
+  const fd = fs.openSync(__filename);
+  fs.closeSync(fd);
+  assert.throws(() => fs.readFileSync(__dirname), {
+    code: 'EISDIR',
+    syscall: 'read',
+  });
+  const next = fs.openSync(__filename);
+  fs.closeSync(next);
+  assert.strictEqual(next, fd);
+}
+
+// Ensure that (write|append)FileSync() closes the file descriptor.
 fs.openSync = function() {
   return 42;
 };
@@ -35,22 +48,11 @@ fs.closeSync = function(fd) {
   assert.strictEqual(fd, 42);
   close_called++;
 };
-fs.readSync = function() {
-  throw new Error('BAM');
-};
 fs.writeSync = function() {
   throw new Error('BAM');
 };
 
-internalBinding('fs').fstat = function(fd, bigint, _, ctx) {
-  ctx.errno = UV_EBADF;
-  ctx.syscall = 'fstat';
-};
-
 let close_called = 0;
-ensureThrows(function() {
-  fs.readFileSync('dummy');
-}, 'EBADF: bad file descriptor, fstat');
 ensureThrows(function() {
   fs.writeFileSync('dummy', 'xxx');
 }, 'BAM');
@@ -0,0 +1,101 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+
+const frozen = new http.FrozenHeaders({
+  'Content-Type': 'text/plain',
+  'X-Multi': ['a', 'b'],
+  'Cookie': ['c=1', 'd=2'],
+});
+assert(Object.isFrozen(frozen));
+
+// Invalid headers are rejected when freezing them.
+assert.throws(() => new http.FrozenHeaders({ 'bad name': 'x' }), {
+  code: 'ERR_INVALID_HTTP_TOKEN',
+});
+assert.throws(() => new http.FrozenHeaders({ 'x-bad': 'a\nb' }), {
+  code: 'ERR_INVALID_CHAR',
+});
+assert.throws(() => new http.FrozenHeaders({ 'x-undefined': undefined }), {
+  code: 'ERR_HTTP_INVALID_HEADER_VALUE',
+});
+assert.throws(() => new http.FrozenHeaders(['x-odd']), {
+  code: 'ERR_INVALID_ARG_VALUE',
+});
+for (const value of [null, 'x-foo: bar', 42]) {
+  assert.throws(() => new http.FrozenHeaders(value), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+// The same frozen headers can be written over and over again, and are
+// serialized exactly like their plain object counterpart.
+{
+  const res = new http.ServerResponse({ method: 'GET' });
+  res.writeHead(200, {
+    'Content-Type': 'text/plain',
+    'X-Multi': ['a', 'b'],
+    'Cookie': ['c=1', 'd=2'],
+  });
+  const expected = res._header;
+  for (let i = 0; i < 3; i++) {
+    const res = new http.ServerResponse({ method: 'GET' });
+    res.writeHead(200, frozen);
+    assert.strictEqual(res._header, expected);
+  }
+}
+
+// Special headers still affect the response.
+{
+  const res = new http.ServerResponse({ method: 'GET' });
+  res.shouldKeepAlive = true;
+  res.writeHead(200, new http.FrozenHeaders({
+    'Connection': 'close',
+    'Content-Length': '2',
+    'Date': 'Thu, 01 Jan 1970 00:00:00 GMT',
+  }));
+  assert.strictEqual(res._last, true);
+  assert.strictEqual(res.chunkedEncoding, false);
+  assert.doesNotMatch(res._header, /Transfer-Encoding/);
+  assert.strictEqual(res._header.match(/Date:/g).length, 1);
+}
+
+// Frozen headers are merged with headers set through setHeader(), and take
+// precedence over them.
+{
+  const res = new http.ServerResponse({ method: 'GET' });
+  res.setHeader('Content-Type', 'text/html');
+  res.setHeader('X-Other', 'yes');
+  res.writeHead(200, frozen);
+  assert.strictEqual(res.getHeader('content-type'), 'text/plain');
+  assert.deepStrictEqual(res.getHeader('x-multi'), ['a', 'b']);
+  assert.strictEqual(res.getHeader('x-other'), 'yes');
+  assert.match(res._header, /\r\nContent-Type: text\/plain\r\n/);
+  assert.doesNotMatch(res._header, /text\/html/);
+}
+
+// End to end.
+{
+  const server = http.createServer(common.mustCall((req, res) => {
+    res.writeHead(200, frozen);
+    res.end('ok');
+  }, 2));
+
+  server.listen(0, common.mustCall(() => {
+    let pending = 2;
+    for (let i = 0; i < 2; i++) {
+      http.get({ port: server.address().port }, common.mustCall((res) => {
+        assert.strictEqual(res.headers['content-type'], 'text/plain');
+        assert.strictEqual(res.headers['x-multi'], 'a, b');
+        assert.strictEqual(res.headers.cookie, 'c=1; d=2');
+        res.resume();
+        res.on('end', common.mustCall(() => {
+          if (--pending === 0)
+            server.close();
+        }));
+      }));
+    }
+  }));
+}
@@ -0,0 +1,219 @@
+'use strict';
+
+// Request parsers that batch their events hand everything that happened
+// during one execute() call to JS land at once. The callbacks have to see
+// exactly the same events as with a regular parser.
+
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+const { parsers, HTTPParser } = require('_http_common');
+const { REQUEST } = HTTPParser;
+
+const kOnMessageBegin = HTTPParser.kOnMessageBegin | 0;
+const kOnHeaders = HTTPParser.kOnHeaders | 0;
+const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
+const kOnBody = HTTPParser.kOnBody | 0;
+const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
+
+function newParser(batched, events, onHeadersComplete = () => 0) {
+  // Pooled parsers come with the dispatcher for batched events.
+  const parser = parsers.alloc();
+  parser.initialize(REQUEST, {}, 0, 0, undefined, batched);
+  parser[kOnMessageBegin] = () => events.push(['begin']);
+  parser[kOnHeaders] = (headers, url) => events.push(['headers', headers, url]);
+  parser[kOnHeadersComplete] = (...args) => {
+    events.push(['headersComplete', ...args]);
+    return onHeadersComplete(...args);
+  };
+  parser[kOnBody] = (body) => {
+    assert(Buffer.isBuffer(body));
+    events.push(['body', body.toString()]);
+  };
+  parser[kOnMessageComplete] = () => events.push(['complete']);
+  return parser;
+}
+
+function parse(batched, ...chunks) {
+  const events = [];
+  const parser = newParser(batched, events);
+  for (const chunk of chunks)
+    assert.strictEqual(parser.execute(chunk), chunk.length);
+  parser.close();
+  return events;
+}
+
+let manyHeaders = '';
+for (let i = 0; i < 40; i++)
+  manyHeaders += `X-Header-${i}: ${i}\r\n`;
+
+const pipelined = Buffer.from(
+  'GET /plain HTTP/1.1\r\nHost: a\r\n\r\n' +
+  'POST /length HTTP/1.1\r\nHost: a\r\nContent-Length: 5\r\n\r\nhello' +
+  'POST /chunked HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n' +
+  '3\r\nabc\r\n2\r\nde\r\n0\r\nX-Trailer: yes\r\n\r\n' +
+  `GET /many HTTP/1.1\r\nHost: a\r\n${manyHeaders}\r\n` +
+  'GET /close HTTP/1.0\r\n\r\n'
+);
+
+// All messages in one chunk, and split at every possible position.
+{
+  const expected = parse(false, pipelined);
+  assert.strictEqual(expected.filter(([name]) => name === 'complete').length,
+                     5);
+  assert.deepStrictEqual(parse(true, pipelined), expected);
+
+  for (let i = 1; i < pipelined.length; i++) {
+    const chunks = [pipelined.subarray(0, i), pipelined.subarray(i)];
+    assert.deepStrictEqual(parse(true, ...chunks), parse(false, ...chunks));
+  }
+}
+
+// Upgrade requests are handed over right away, after the events before them.
+{
+  const events = [];
+  const request = Buffer.from(
+    'POST / HTTP/1.1\r\nContent-Length: 3\r\n\r\nabc' +
+    'GET /chat HTTP/1.1\r\nConnection: Upgrade\r\nUpgrade: websocket\r\n\r\n' +
+    'after upgrade'
+  );
+  const parser = newParser(true, events, common.mustCall((...args) => {
+    if (args[4] !== '/chat')
+      return 0;
+    assert.deepStrictEqual(events.map(([name]) => name), [
+      'begin', 'headersComplete', 'body', 'complete', 'begin',
+      'headersComplete',
+    ]);
+    assert.strictEqual(args[7], true);
+    return 2;
+  }, 2));
+  assert.strictEqual(parser.execute(request),
+                     request.length - 'after upgrade'.length);
+  parser.close();
+}
+
+// Headers that were flushed early reach JS land before an upgrade request is
+// handed over.
+{
+  const events = [];
+  const request = Buffer.from(
+    'GET /chat HTTP/1.1\r\nConnection: Upgrade\r\nUpgrade: websocket\r\n' +
+    `${manyHeaders}\r\n`
+  );
+  const parser = newParser(true, events, common.mustCall((...args) => {
+    assert.deepStrictEqual(events.map(([name]) => name),
+                           ['begin', 'headers', 'headers', 'headersComplete']);
+    const headers = events.filter(([name]) => name === 'headers')
+      .flatMap(([, headers]) => headers);
+    assert.strictEqual(headers.length, 2 * 42);
+    assert.deepStrictEqual(headers.slice(-2), ['X-Header-39', '39']);
+    assert.strictEqual(args[7], true);
+    return 2;
+  }));
+  assert.strictEqual(parser.execute(request), request.length);
+  parser.close();
+}
+
+{
+  const server = http.createServer(common.mustNotCall());
+  server.on('upgrade', common.mustCall((req, socket) => {
+    assert.strictEqual(req.headers.upgrade, 'websocket');
+    for (let i = 0; i < 40; i++)
+      assert.strictEqual(req.headers[`x-header-${i}`], `${i}`);
+    socket.destroy();
+    server.close();
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    client.on('error', () => {});
+    client.write(
+      'GET /chat HTTP/1.1\r\nHost: a\r\nConnection: Upgrade\r\n' +
+      `Upgrade: websocket\r\n${manyHeaders}\r\n`
+    );
+  }));
+}
+
+// Exceptions thrown by the callbacks propagate out of execute().
+{
+  const parser = newParser(true, []);
+  parser[kOnMessageComplete] = () => { throw new Error('boom'); };
+  assert.throws(() => parser.execute(Buffer.from('GET / HTTP/1.1\r\n\r\n')),
+                { message: 'boom' });
+  parser.close();
+}
+
+// Pipelined requests on a server connection.
+{
+  const server = http.createServer(common.mustCall((req, res) => {
+    let body = '';
+    req.setEncoding('utf8');
+    req.on('data', (chunk) => body += chunk);
+    req.on('end', () => res.end(`${req.method} ${req.url} ${body}\n`));
+  }, 5));
+
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    // The last request closes the connection.
+    client.write(pipelined);
+    let response = '';
+    client.setEncoding('utf8');
+    client.on('data', (chunk) => response += chunk);
+    client.on('end', common.mustCall(() => {
+      const bodies = response.split('\r\n\r\n').slice(1)
+        .map((part) => part.split('\n')[0]);
+      assert.deepStrictEqual(bodies, [
+        'GET /plain ',
+        'POST /length hello',
+        'POST /chunked abcde',
+        'GET /many ',
+        'GET /close ',
+      ]);
+      server.close();
+    }));
+  }));
+}
+
+// Data read from the socket is handed to JS land in a single callback, which
+// passes the result of execute() on to kOnExecute after the events.
+{
+  const kOnEvents = HTTPParser.kOnEvents | 0;
+  const kOnExecute = HTTPParser.kOnExecute | 0;
+  let inEvents = false;
+  let eventCalls = 0;
+
+  const server = http.createServer(common.mustCall((req, res) => {
+    res.end('ok');
+  }));
+  server.on('connection', common.mustCall((socket) => {
+    const { parser } = socket;
+    const onEvents = parser[kOnEvents];
+    parser[kOnEvents] = function(events, values, body, ret) {
+      eventCalls++;
+      assert.strictEqual(typeof ret, 'number');
+      inEvents = true;
+      try {
+        return onEvents.call(this, events, values, body, ret);
+      } finally {
+        inEvents = false;
+      }
+    };
+    const onExecute = parser[kOnExecute];
+    parser[kOnExecute] = common.mustCallAtLeast((ret) => {
+      assert(inEvents);
+      return onExecute(ret);
+    });
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    client.end('GET / HTTP/1.0\r\n\r\n');
+    client.resume();
+    client.on('end', common.mustCall(() => {
+      assert(eventCalls > 0);
+      server.close();
+    }));
+  }));
+}
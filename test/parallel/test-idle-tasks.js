@@ -0,0 +1,37 @@
+// Flags: --experimental-idle-tasks
+'use strict';
+
+// V8 gets to do garbage collection work whenever the event loop of the main
+// thread or of a worker is idle. That must neither keep the loop alive nor
+// get in the way of tearing it down.
+
+const common = require('../common');
+const assert = require('assert');
+const { Worker } = require('worker_threads');
+
+function churn(rounds, callback) {
+  const retained = new Array(1e4);
+  let round = 0;
+  (function next() {
+    for (let i = 0; i < 1e4; i++)
+      retained[(i * 31 + round) % retained.length] = { i, round };
+    if (++round === rounds)
+      return callback(retained);
+    setTimeout(next, 2);
+  })();
+}
+
+churn(50, common.mustCall((retained) => {
+  assert.strictEqual(retained.length, 1e4);
+}));
+
+const worker = new Worker(`
+  const { parentPort } = require('worker_threads');
+  (${churn})(50, (retained) => parentPort.postMessage(retained.length));
+`, { eval: true });
+worker.on('message', common.mustCall((length) => {
+  assert.strictEqual(length, 1e4);
+}));
+worker.on('exit', common.mustCall((code) => {
+  assert.strictEqual(code, 0);
+}));
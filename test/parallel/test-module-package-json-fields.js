@@ -0,0 +1,112 @@
+'use strict';
+
+// Tests that package.json files are read the same way as with JSON.parse(),
+// now that the fields used by module resolution are extracted in C++.
+
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const { createRequire } = require('module');
+const path = require('path');
+const { pathToFileURL } = require('url');
+const { Worker } = require('worker_threads');
+
+tmpdir.refresh();
+
+function makePackage(name, json) {
+  const dir = path.join(tmpdir.path, 'node_modules', name);
+  fs.mkdirSync(dir, { recursive: true });
+  fs.writeFileSync(path.join(dir, 'package.json'), json);
+  fs.writeFileSync(path.join(dir, 'index.js'), 'module.exports = "index";');
+  fs.writeFileSync(path.join(dir, 'main.js'), 'module.exports = "main";');
+  fs.writeFileSync(path.join(dir, 'other.js'), 'module.exports = "other";');
+  fs.writeFileSync(path.join(dir, 'esm.mjs'), 'export default "esm";');
+  return dir;
+}
+
+const load = createRequire(path.join(tmpdir.path, 'parent.js'));
+
+// Plain fields.
+makePackage('plain', '{"name": "plain", "main": "main.js"}');
+assert.strictEqual(load('plain'), 'main');
+
+// Keys and values with escape sequences.
+makePackage('escaped-key', '{"m\\u0061in": "main.js"}');
+assert.strictEqual(load('escaped-key'), 'main');
+makePackage('escaped-value', '{"main": "m\\u0061in.js"}');
+assert.strictEqual(load('escaped-value'), 'main');
+
+// The last occurrence of a key wins.
+makePackage('duplicate', '{"main": "other.js", "main": "main.js"}');
+assert.strictEqual(load('duplicate'), 'main');
+
+// Fields that are nested in other values are ignored.
+makePackage('nested', `{
+  "config": { "main": "other.js", "list": [1, {"main": "other.js"}] },
+  "main": "main.js"
+}`);
+assert.strictEqual(load('nested'), 'main');
+
+// A byte order mark is skipped.
+makePackage('bom', '﻿{"main": "main.js"}');
+assert.strictEqual(load('bom'), 'main');
+
+// Values that are not strings are passed on as they are.
+makePackage('null', '{"main": null, "type": null}');
+assert.strictEqual(load('null'), 'index');
+makePackage('number', '{"main": 42}');
+assert.throws(() => load('number'), { code: 'ERR_INVALID_ARG_TYPE' });
+
+// Files without any of the fields are not parsed at all.
+makePackage('no-fields', 'not json');
+assert.strictEqual(load('no-fields'), 'index');
+
+// Other invalid files are reported as before.
+makePackage('invalid', '{"main": "main.js",}');
+assert.throws(() => load('invalid'), {
+  name: 'SyntaxError',
+  message: /^Error parsing .*invalid[/\\]package\.json: /,
+});
+
+// So are fields in files that do not contain an object.
+makePackage('array', '[{"main": "main.js"}]');
+assert.strictEqual(load('array'), 'index');
+
+// The exports field is parsed completely.
+makePackage('exports', `{
+  "exports": { ".": { "import": "./esm.mjs", "default": "./other.js" } }
+}`);
+assert.strictEqual(load('exports'), 'other');
+
+(async () => {
+  const parentPath = path.join(tmpdir.path, 'parent.mjs');
+  fs.writeFileSync(parentPath, 'export { default } from "exports";');
+  const parent = pathToFileURL(parentPath);
+  assert.strictEqual((await import(parent)).default, 'esm');
+
+  makePackage('esm-invalid', '{"type": "module",}');
+  await assert.rejects(
+    import(new URL('node_modules/esm-invalid/main.js', parent)),
+    { code: 'ERR_INVALID_PACKAGE_CONFIG' });
+})().then(common.mustCall());
+
+// Workers share the results of reading files, but see changes to them.
+{
+  const dir = makePackage('shared', '{"main": "main.js"}');
+  const code = `
+    const { parentPort } = require('worker_threads');
+    parentPort.postMessage(require(${JSON.stringify(dir)}));
+  `;
+  const worker = new Worker(code, { eval: true });
+  worker.once('message', common.mustCall((value) => {
+    assert.strictEqual(value, 'main');
+    fs.writeFileSync(path.join(dir, 'package.json'), '{"main": "other.js"}');
+    const future = new Date(Date.now() + 10000);
+    fs.utimesSync(path.join(dir, 'package.json'), future, future);
+    new Worker(code, { eval: true })
+      .once('message', common.mustCall((value) => {
+        assert.strictEqual(value, 'other');
+      }));
+  }));
+}
@@ -0,0 +1,130 @@
+'use strict';
+
+// Tests that --experimental-resolution-cache stores the files that require()
+// resolved to, and that results are not used anymore once the directories
+// and package.json files they depended on change.
+
+require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+
+tmpdir.refresh();
+const cacheFile = path.join(tmpdir.path, 'resolution-cache');
+const appDir = path.join(tmpdir.path, 'app');
+const pkgDir = path.join(appDir, 'node_modules', 'pkg');
+const main = path.join(appDir, 'main.js');
+
+fs.mkdirSync(path.join(appDir, 'util'));
+fs.mkdirSync(pkgDir, { recursive: true });
+fs.writeFileSync(main, `
+  const pkg = require('pkg');
+  const util = require('./util');
+  console.log(pkg + util);
+`);
+fs.writeFileSync(path.join(appDir, 'util', 'index.js'),
+                 'module.exports = "a";');
+fs.writeFileSync(path.join(pkgDir, 'package.json'), '{"main": "one.js"}');
+fs.writeFileSync(path.join(pkgDir, 'one.js'), 'module.exports = "1";');
+fs.writeFileSync(path.join(pkgDir, 'two.js'), 'module.exports = "2";');
+
+function run(expected, ...execArgv) {
+  const child = spawnSync(process.execPath, [
+    `--experimental-resolution-cache=${cacheFile}`,
+    ...execArgv,
+    main,
+  ], {
+    cwd: tmpdir.path,
+    env: { ...process.env, NODE_DEBUG_NATIVE: 'RESOLUTION_CACHE' },
+  });
+  const stderr = child.stderr.toString();
+  assert.strictEqual(child.status, 0, stderr);
+  assert.strictEqual(child.stdout.toString().trim(), expected);
+  return stderr;
+}
+
+// Nothing is cached yet, the results are written to the cache file.
+{
+  const stderr = run('1a');
+  assert.match(stderr, /Could not read resolution cache/);
+  assert.match(stderr, /Caching resolution of pkg to .*one\.js/);
+  assert.match(stderr, /Caching resolution of \.\/util to .*index\.js/);
+  assert.match(stderr, /Wrote 2 entries to resolution cache/);
+}
+
+// The next run uses the cached results.
+{
+  const stderr = run('1a');
+  assert.match(stderr, /Loaded 2 entries from resolution cache/);
+  assert.match(stderr, /Found cached resolution of pkg/);
+  assert.match(stderr, /Found cached resolution of \.\/util/);
+  assert.doesNotMatch(stderr, /Caching resolution/);
+  assert.doesNotMatch(stderr, /Wrote \d+ entries/);
+}
+
+// Changing a package.json invalidates the results that depend on it.
+{
+  fs.writeFileSync(path.join(pkgDir, 'package.json'), '{"main": "two.js"}');
+  // Make sure that the modification time changes on file systems with a
+  // coarse resolution.
+  const future = new Date(Date.now() + 10000);
+  fs.utimesSync(path.join(pkgDir, 'package.json'), future, future);
+  const stderr = run('2a');
+  assert.match(stderr, /Resolution of pkg is outdated/);
+  assert.match(stderr, /Caching resolution of pkg to .*two\.js/);
+  assert.match(stderr, /Found cached resolution of \.\/util/);
+}
+
+// So does adding a file that takes precedence in a directory that was
+// searched.
+{
+  fs.writeFileSync(path.join(appDir, 'util.js'), 'module.exports = "b";');
+  const future = new Date(Date.now() + 20000);
+  fs.utimesSync(appDir, future, future);
+  const stderr = run('2b');
+  assert.match(stderr, /Resolution of \.\/util is outdated/);
+  assert.match(stderr, /Caching resolution of \.\/util to .*util\.js/);
+}
+
+// The cache is discarded when it was written with options that affect the
+// resolution.
+{
+  const stderr = run('2b', '--preserve-symlinks');
+  assert.match(stderr, /written by another version of Node\.js or with other/);
+  assert.match(stderr, /Wrote 2 entries to resolution cache/);
+}
+
+// Results that come from the in-process path cache, here because a require
+// hook changed the context, are resolved again before they are cached.
+{
+  const hookCacheFile = path.join(tmpdir.path, 'resolution-cache-hook');
+  const hookMain = path.join(appDir, 'hook.js');
+  const depDir = path.join(appDir, 'node_modules', 'dep');
+  fs.mkdirSync(depDir);
+  fs.writeFileSync(path.join(depDir, 'index.js'), 'module.exports = "i";');
+  fs.writeFileSync(hookMain, `
+    const before = require('dep');
+    require.extensions['.txt'] = require.extensions['.js'];
+    console.log(before + require('dep'));
+  `);
+
+  function runHook(expected) {
+    const child = spawnSync(process.execPath, [
+      `--experimental-resolution-cache=${hookCacheFile}`,
+      hookMain,
+    ], { cwd: tmpdir.path });
+    assert.strictEqual(child.status, 0, child.stderr.toString());
+    assert.strictEqual(child.stdout.toString().trim(), expected);
+  }
+
+  runHook('ii');
+  runHook('ii');
+
+  fs.writeFileSync(path.join(appDir, 'node_modules', 'dep.js'),
+                   'module.exports = "f";');
+  const future = new Date(Date.now() + 30000);
+  fs.utimesSync(path.join(appDir, 'node_modules'), future, future);
+  runHook('ff');
+}
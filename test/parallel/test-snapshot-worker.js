@@ -0,0 +1,68 @@
+'use strict';
+
+// This tests that workers of an application that was started from a user-land
+// snapshot are started from the worker context of that snapshot.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../common/tmpdir');
+const fixtures = require('../common/fixtures');
+const path = require('path');
+
+tmpdir.refresh();
+const blobPath = path.join(tmpdir.path, 'snapshot.blob');
+const entry = fixtures.path('snapshot', 'worker.js');
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob',
+    blobPath,
+    '--build-snapshot',
+    entry,
+  ], {
+    cwd: tmpdir.path
+  });
+  if (child.status !== 0) {
+    console.log(child.stderr.toString());
+    console.log(child.stdout.toString());
+    assert.strictEqual(child.status, 0);
+  }
+}
+
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob',
+    blobPath,
+  ], {
+    cwd: tmpdir.path,
+    env: {
+      ...process.env,
+      SNAPSHOT_WORKER_TEST: 'parent env',
+    }
+  });
+  if (child.status !== 0) {
+    console.log(child.stderr.toString());
+    console.log(child.stdout.toString());
+    assert.strictEqual(child.status, 0);
+  }
+
+  const reports = JSON.parse(child.stdout.toString());
+  const byName = (a, b) => a.name.localeCompare(b.name) ||
+                           ('code' in a) - ('code' in b);
+  const expected = [];
+  for (const [name, env] of [
+    ['default', 'parent env'],
+    ['env', 'own env'],
+    ['execArgv', 'parent env'],
+  ]) {
+    expected.push({
+      name,
+      isMainThread: false,
+      // The state of the main context is not shared with workers.
+      fromSnapshot: 'undefined',
+      env,
+      readFileSync: 'function',
+    }, { name, code: 0 });
+  }
+  assert.deepStrictEqual(reports.sort(byName), expected);
+}
@@ -0,0 +1,114 @@
+'use strict';
+
+// Piping a file stream into a socket or an http.ServerResponse with
+// stream.pipeline() uses sendfile(2) where available. The result has to be
+// indistinguishable from the regular pipe() path.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const http = require('http');
+const net = require('net');
+const path = require('path');
+const { pipeline } = require('stream');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'sendfile.bin');
+const data = Buffer.alloc(4 * 1024 * 1024);
+for (let i = 0; i < data.length; i++)
+  data[i] = i % 251;
+fs.writeFileSync(file, data);
+
+function collect(stream, callback) {
+  const chunks = [];
+  stream.on('data', (chunk) => chunks.push(chunk));
+  stream.on('end', common.mustCall(() => callback(Buffer.concat(chunks))));
+}
+
+// http.ServerResponse with a Content-Length, a byte range, a chunked
+// response and several requests on one keep-alive connection.
+{
+  const ranges = {
+    '/': {},
+    '/range': { start: 1000, end: 200000 },
+    '/chunked': {},
+  };
+
+  const server = http.createServer(common.mustCall((req, res) => {
+    const options = ranges[req.url];
+    const { start = 0, end = data.length - 1 } = options;
+    if (req.url !== '/chunked')
+      res.setHeader('Content-Length', end - start + 1);
+    const src = fs.createReadStream(file, options);
+    pipeline(src, res, common.mustSucceed(() => {
+      assert.strictEqual(src.bytesRead, end - start + 1);
+    }));
+    // Responses that take the regular path do not commit their headers
+    // right away.
+    if (req.url === '/chunked')
+      res.setHeader('X-Set-After-Pipeline', 'yes');
+  }, 4));
+
+  server.listen(0, common.mustCall(() => {
+    const agent = new http.Agent({ keepAlive: true, maxSockets: 1 });
+    let pending = 0;
+    for (const url of ['/', '/range', '/chunked', '/']) {
+      pending++;
+      http.get({ port: server.address().port, path: url, agent },
+               common.mustCall((res) => {
+                 if (url === '/chunked') {
+                   assert.strictEqual(res.headers['x-set-after-pipeline'],
+                                      'yes');
+                 }
+                 collect(res, (body) => {
+                   const { start = 0, end = data.length - 1 } = ranges[url];
+                   assert(body.equals(data.subarray(start, end + 1)));
+                   if (--pending === 0) {
+                     agent.destroy();
+                     server.close();
+                   }
+                 });
+               }));
+    }
+  }));
+}
+
+// Data that was written to the socket before goes out first.
+{
+  const server = net.createServer(common.mustCall((socket) => {
+    socket.write('head');
+    pipeline(fs.createReadStream(file, { start: 7 }), socket,
+             common.mustSucceed());
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    collect(client, (body) => {
+      assert(body.equals(Buffer.concat([Buffer.from('head'),
+                                        data.subarray(7)])));
+      server.close();
+    });
+  }));
+}
+
+// The receiver goes away in the middle of the transfer.
+{
+  const large = path.join(tmpdir.path, 'sendfile-large.bin');
+  fs.writeFileSync(large, '');
+  fs.truncateSync(large, 256 * 1024 * 1024);
+
+  const server = net.createServer(common.mustCall((socket) => {
+    const src = fs.createReadStream(large);
+    src.on('close', common.mustCall(() => server.close()));
+    pipeline(src, socket, common.mustCall((err) => {
+      assert(err);
+    }));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    client.once('data', common.mustCall(() => client.destroy()));
+  }));
+}
@@ -0,0 +1,74 @@
+// Flags: --expose-internals
+'use strict';
+
+// Tests that with enableKTLS, the kernel encrypts the data that is sent, and
+// that connections work the same.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const { once } = require('events');
+const fs = require('fs');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+const { internalBinding } = require('internal/test/binding');
+
+for (const enableKTLS of [1, 'true', {}]) {
+  assert.throws(() => new tls.TLSSocket(null, { enableKTLS }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+}
+
+if (!internalBinding('tls_wrap').HAVE_KTLS)
+  common.skip('OpenSSL was built without kernel TLS support');
+if (!fs.existsSync('/sys/module/tls'))
+  common.skip('the tls kernel module is not loaded');
+
+const key = fixtures.readKey('agent2-key.pem');
+const cert = fixtures.readKey('agent2-cert.pem');
+
+// Larger than a TLS record, so that the data is sent in pieces.
+const payload = Buffer.alloc(256 * 1024, 'x');
+
+function collect(socket) {
+  const chunks = [];
+  socket.on('data', (chunk) => chunks.push(chunk));
+  return once(socket, 'end').then(() => Buffer.concat(chunks));
+}
+
+async function test(protocol) {
+  const server = tls.createServer({
+    key,
+    cert,
+    minVersion: protocol,
+    maxVersion: protocol,
+    enableKTLS: true,
+  }, common.mustCall((socket) => {
+    assert.strictEqual(socket._handle.isKTLSSending(), true);
+    collect(socket).then(common.mustCall((data) => {
+      assert.deepStrictEqual(data, payload);
+      socket.end(payload);
+    }));
+  }));
+  await once(server.listen(0), 'listening');
+
+  const client = tls.connect({
+    port: server.address().port,
+    rejectUnauthorized: false,
+    enableKTLS: true,
+  });
+  await once(client, 'secureConnect');
+  assert.strictEqual(client.getProtocol(), protocol);
+  assert.strictEqual(client._handle.isKTLSSending(), true);
+  const received = collect(client);
+  client.end(payload);
+  assert.deepStrictEqual(await received, payload);
+  server.close();
+}
+
+(async () => {
+  await test('TLSv1.2');
+  await test('TLSv1.3');
+})().then(common.mustCall());
@@ -0,0 +1,220 @@
+'use strict';
+
+// Tests that servers sharing a tls.SessionStore resume each other's sessions,
+// also across threads and, with a directory, across stores.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const { once } = require('events');
+const tls = require('tls');
+const { SSL_OP_NO_TICKET } = require('crypto').constants;
+const { Worker } = require('worker_threads');
+const fixtures = require('../common/fixtures');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+const key = fixtures.readKey('agent2-key.pem');
+const cert = fixtures.readKey('agent2-cert.pem');
+
+async function listen(options) {
+  const server = tls.createServer({
+    key,
+    cert,
+    maxVersion: 'TLSv1.2',
+    ...options,
+  }, (socket) => socket.end());
+  await once(server.listen(0), 'listening');
+  return server;
+}
+
+function connect(port, session) {
+  return new Promise((resolve, reject) => {
+    const socket = tls.connect({
+      port,
+      rejectUnauthorized: false,
+      session,
+    }, () => {
+      resolve({
+        reused: socket.isSessionReused(),
+        session: socket.getSession(),
+      });
+      socket.resume();
+      socket.end();
+    });
+    socket.on('error', reject);
+  });
+}
+
+for (const options of [null, 'x', { maxSessions: -1 }, { shards: 0 },
+                       { directory: 1 }]) {
+  assert.throws(() => new tls.SessionStore(options), {
+    code: /^ERR_INVALID_ARG_TYPE$|^ERR_OUT_OF_RANGE$/,
+  });
+}
+assert.throws(() => tls.createSecureContext({ sessionStore: {} }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+(async () => {
+  // Sessions stored by one server are resumed by another one.
+  {
+    const sessionStore = new tls.SessionStore();
+    const options = { sessionStore, secureOptions: SSL_OP_NO_TICKET };
+    const server1 = await listen(options);
+    const server2 = await listen(options);
+
+    const first = await connect(server1.address().port);
+    assert.strictEqual(first.reused, false);
+    const second = await connect(server2.address().port, first.session);
+    assert.strictEqual(second.reused, true);
+
+    const stats = sessionStore.getStats();
+    assert.strictEqual(stats.stores, 1);
+    assert.strictEqual(stats.hits, 1);
+    assert.strictEqual(stats.misses, 0);
+    assert.strictEqual(stats.size, 1);
+    server1.close();
+    server2.close();
+  }
+
+  // So are session tickets, because the servers use the ticket keys of the
+  // store.
+  {
+    const sessionStore = new tls.SessionStore();
+    const server1 = await listen({ sessionStore });
+    const server2 = await listen({ sessionStore });
+    assert.deepStrictEqual(server1.getTicketKeys(), server2.getTicketKeys());
+
+    const first = await connect(server1.address().port);
+    const second = await connect(server2.address().port, first.session);
+    assert.strictEqual(second.reused, true);
+    assert.strictEqual(sessionStore.getStats().ticketHits, 1);
+    server1.close();
+    server2.close();
+  }
+
+  // Stores that are passed to workers refer to the same sessions.
+  {
+    const sessionStore = new tls.SessionStore();
+    const server = await listen({
+      sessionStore,
+      secureOptions: SSL_OP_NO_TICKET,
+    });
+    const { session } = await connect(server.address().port);
+
+    const worker = new Worker(`
+      const { parentPort, workerData } = require('worker_threads');
+      const tls = require('tls');
+      const server = tls.createServer({
+        ...workerData,
+        maxVersion: 'TLSv1.2',
+      }, (socket) => socket.end());
+      server.listen(0, () => parentPort.postMessage(server.address().port));
+      parentPort.once('message', () => server.close());
+    `, {
+      eval: true,
+      workerData: {
+        key,
+        cert,
+        sessionStore,
+        secureOptions: SSL_OP_NO_TICKET,
+      },
+    });
+    const [port] = await once(worker, 'message');
+    const resumed = await connect(port, session);
+    assert.strictEqual(resumed.reused, true);
+    assert.strictEqual(sessionStore.getStats().hits, 1);
+    worker.postMessage('close');
+    server.close();
+  }
+
+  // Sessions are written to the directory, and are found there by other
+  // stores.
+  {
+    tmpdir.refresh();
+    const options = {
+      sessionIdContext: 'shared',
+      secureOptions: SSL_OP_NO_TICKET,
+    };
+    const sessionStore1 = new tls.SessionStore({ directory: tmpdir.path });
+    const sessionStore2 = new tls.SessionStore({ directory: tmpdir.path });
+    const server1 = await listen({ ...options, sessionStore: sessionStore1 });
+    const server2 = await listen({ ...options, sessionStore: sessionStore2 });
+
+    const { session } = await connect(server1.address().port);
+    const resumed = await connect(server2.address().port, session);
+    assert.strictEqual(resumed.reused, true);
+    const stats = sessionStore2.getStats();
+    assert.strictEqual(stats.hits, 1);
+    assert.strictEqual(stats.size, 1);
+    server1.close();
+    server2.close();
+  }
+
+  // Expired sessions are deleted from the directory, and it does not grow
+  // beyond maxSessions.
+  {
+    tmpdir.refresh();
+    const expired = path.join(tmpdir.path, '00.session');
+    fs.writeFileSync(expired, 'expired');
+    fs.utimesSync(expired, 1000, 1000);
+
+    const sessionStore = new tls.SessionStore({
+      maxSessions: 2,
+      shards: 1,
+      directory: tmpdir.path,
+    });
+    const server = await listen({
+      sessionStore,
+      secureOptions: SSL_OP_NO_TICKET,
+    });
+    for (let i = 0; i < 5; i++)
+      await connect(server.address().port);
+
+    const files = fs.readdirSync(tmpdir.path);
+    assert(!files.includes('00.session'));
+    assert.strictEqual(files.length, 2);
+    assert.strictEqual(sessionStore.getStats().stores, 5);
+    server.close();
+  }
+
+  // Full stores drop their least recently used sessions.
+  {
+    const sessionStore = new tls.SessionStore({ maxSessions: 1, shards: 1 });
+    const server = await listen({
+      sessionStore,
+      secureOptions: SSL_OP_NO_TICKET,
+    });
+
+    const first = await connect(server.address().port);
+    await connect(server.address().port);
+    const resumed = await connect(server.address().port, first.session);
+    assert.strictEqual(resumed.reused, false);
+
+    const stats = sessionStore.getStats();
+    assert.strictEqual(stats.misses, 1);
+    assert.strictEqual(stats.size, 1);
+    assert.strictEqual(stats.evictions, 2);
+    server.close();
+  }
+
+  // Stores with more shards than sessions keep no more than maxSessions.
+  {
+    const sessionStore = new tls.SessionStore({ maxSessions: 3, shards: 16 });
+    const server = await listen({
+      sessionStore,
+      secureOptions: SSL_OP_NO_TICKET,
+    });
+    for (let i = 0; i < 10; i++)
+      await connect(server.address().port);
+
+    const stats = sessionStore.getStats();
+    assert(stats.size <= 3, `${stats.size} sessions stored`);
+    assert.strictEqual(stats.size + stats.evictions, 10);
+    server.close();
+  }
+})().then(common.mustCall());
@@ -0,0 +1,69 @@
+'use strict';
+
+// Tests that data written as many buffers at once, which TLSWrap coalesces
+// into full records, arrives complete and in order, also when it is written
+// before the handshake finished.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const { once } = require('events');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+const key = fixtures.readKey('agent2-key.pem');
+const cert = fixtures.readKey('agent2-cert.pem');
+
+const chunks = [];
+for (const size of [1, 100, 16 * 1024 - 1, 3, 40 * 1024, 16 * 1024, 7, 0, 5])
+  chunks.push(Buffer.alloc(size, chunks.length));
+const expected = Buffer.concat(chunks);
+
+function writeCorked(socket) {
+  socket.cork();
+  for (const chunk of chunks)
+    socket.write(chunk);
+  socket.uncork();
+}
+
+function receive(socket) {
+  return new Promise((resolve) => {
+    const received = [];
+    let length = 0;
+    socket.on('data', function onData(chunk) {
+      received.push(chunk);
+      length += chunk.length;
+      if (length >= expected.length) {
+        socket.off('data', onData);
+        resolve(Buffer.concat(received));
+      }
+    });
+  });
+}
+
+(async () => {
+  const server = tls.createServer({ key, cert }, (socket) => {
+    receive(socket).then(common.mustCall((data) => {
+      assert.deepStrictEqual(data, expected);
+      writeCorked(socket);
+    }));
+  });
+  await once(server.listen(0), 'listening');
+
+  for (const beforeHandshake of [true, false]) {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+    });
+    if (beforeHandshake)
+      writeCorked(client);
+    else
+      client.once('secureConnect', () => writeCorked(client));
+
+    assert.deepStrictEqual(await receive(client), expected);
+    client.end();
+  }
+  server.close();
+})().then(common.mustCall());
@@ -78,7 +78,8 @@ bad.forEach((t) => {
         .decode(new Uint8Array(t.input));
     }, {
       code: 'ERR_ENCODING_INVALID_ENCODED_DATA',
-      name: 'TypeError'
+      name: 'TypeError',
+      errno: Number,
     }
   );
 });
@@ -206,3 +206,35 @@ if (common.hasIntl) {
   const str = decoder.decode(chunk);
   assert.strictEqual(str, '\ufffd');
 }
+
+// Test that whole UTF-8 inputs, and those after streaming, decode the same.
+{
+  const text = 'ascii é 日本 \u{1f600} '.repeat(50);
+  const bom = Buffer.from([0xEF, 0xBB, 0xBF]);
+  const input = Buffer.concat([bom, Buffer.from(text)]);
+
+  assert.strictEqual(new TextDecoder().decode(input), text);
+  assert.strictEqual(new TextDecoder('utf-8', { ignoreBOM: true })
+    .decode(input), `\ufeff${text}`);
+  assert.strictEqual(new TextDecoder().decode(input.buffer.slice(
+    input.byteOffset, input.byteOffset + input.length)), text);
+
+  if (common.hasIntl) {
+    assert.strictEqual(new TextDecoder('utf-8', { fatal: true })
+      .decode(input), text);
+    assert.throws(() => {
+      new TextDecoder('utf-8', { fatal: true })
+        .decode(Buffer.concat([input, Buffer.from([0xE6, 0x97])]));
+    }, {
+      code: 'ERR_ENCODING_INVALID_ENCODED_DATA',
+      name: 'TypeError'
+    });
+  }
+
+  const decoder = new TextDecoder();
+  const split = input.length - 3;
+  assert.strictEqual(
+    decoder.decode(input.subarray(0, split), { stream: true }) +
+    decoder.decode(input.subarray(split)), text);
+  assert.strictEqual(decoder.decode(input), text);
+}
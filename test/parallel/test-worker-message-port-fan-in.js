@@ -0,0 +1,35 @@
+'use strict';
+
+// Several threads post into the same BroadcastChannel at once, so that the
+// incoming queue of the receiving port is filled by all of them concurrently.
+// Messages from each of them have to arrive complete and in the order in
+// which they were sent.
+
+const common = require('../common');
+const assert = require('assert');
+const { BroadcastChannel, Worker } = require('worker_threads');
+
+const kProducers = 4;
+const kMessages = 10000;
+
+const channel = new BroadcastChannel('fan-in');
+const next = new Array(kProducers).fill(0);
+let received = 0;
+
+channel.onmessage = common.mustCall(({ data: { producer, seq } }) => {
+  assert.strictEqual(seq, next[producer]++);
+  if (++received === kProducers * kMessages)
+    channel.close();
+}, kProducers * kMessages);
+
+for (let producer = 0; producer < kProducers; producer++) {
+  const worker = new Worker(`
+    const { BroadcastChannel, workerData: { producer, count } } =
+      require('worker_threads');
+    const channel = new BroadcastChannel('fan-in');
+    for (let seq = 0; seq < count; seq++)
+      channel.postMessage({ producer, seq });
+    channel.close();
+  `, { eval: true, workerData: { producer, count: kMessages } });
+  worker.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+}
@@ -0,0 +1,173 @@
+'use strict';
+
+// Primitives, flat objects and arrays of primitives and typed arrays use a
+// compact encoding instead of v8::ValueSerializer. Receivers must not be able
+// to tell the difference.
+
+const common = require('../common');
+const assert = require('assert');
+const {
+  MessageChannel,
+  Worker,
+  receiveMessageOnPort,
+} = require('worker_threads');
+
+const { port1, port2 } = new MessageChannel();
+
+function roundTrip(value) {
+  port1.postMessage(value);
+  return receiveMessageOnPort(port2).message;
+}
+
+const twoByte = 'héllo \u{1F600} wörld 世界';
+const values = [
+  undefined,
+  null,
+  true,
+  false,
+  0,
+  -1,
+  2 ** 31 - 1,
+  -(2 ** 31),
+  2 ** 31,
+  1.5,
+  Infinity,
+  -Infinity,
+  '',
+  'hello',
+  'x'.repeat(1000),
+  twoByte,
+  twoByte.repeat(100),
+  {},
+  { id: 1, op: 'set', value: 'x', ok: true, none: null, u: undefined },
+  { [twoByte]: twoByte },
+  [],
+  [1, 'two', 3.5, null, undefined, false],
+  new Array(64).fill('x'),
+  // Too large for the compact encoding.
+  new Array(65).fill(1),
+  Object.fromEntries(new Array(65).fill().map((_, i) => [`k${i}`, i])),
+  // Not flat.
+  { nested: { a: 1 } },
+  [[1], [2]],
+  { 1: 'a', b: 'c' },
+  10n,
+];
+
+for (const value of values)
+  assert.deepStrictEqual(roundTrip(value), value);
+
+assert(Object.is(roundTrip(-0), -0));
+assert(Number.isNaN(roundTrip(NaN)));
+assert(Object.is(roundTrip([-0])[0], -0));
+
+// Objects arrive with own, enumerable properties in the same order.
+assert.deepStrictEqual(Object.keys(roundTrip({ b: 1, a: 2, c: 3 })),
+                       ['b', 'a', 'c']);
+{
+  const obj = { visible: 1 };
+  Object.defineProperty(obj, 'hidden', { value: 2, enumerable: false });
+  obj[Symbol('s')] = 3;
+  assert.deepStrictEqual(Reflect.ownKeys(roundTrip(obj)), ['visible']);
+}
+
+// Holes and named properties of arrays are preserved.
+{
+  // eslint-disable-next-line no-sparse-arrays
+  const sparse = roundTrip([1, , 3]);
+  assert.strictEqual(sparse.length, 3);
+  assert(!(1 in sparse));
+  const named = [1, 2];
+  named.extra = 'yes';
+  assert.strictEqual(roundTrip(named).extra, 'yes');
+}
+
+// Getters run exactly once.
+{
+  const getter = common.mustCall(() => 42);
+  const received = roundTrip({ get value() { return getter(); }, other: {} });
+  assert.deepStrictEqual(received, { value: 42, other: {} });
+
+  const elementGetter = common.mustCall(() => 1);
+  const array = [0, 0, {}];
+  Object.defineProperty(array, 1, { get: elementGetter, enumerable: true });
+  assert.deepStrictEqual(roundTrip(array), [0, 1, {}]);
+}
+
+// Class instances and other non-plain objects lose their prototype just like
+// before, and objects that cannot be cloned still throw.
+{
+  class Point { constructor() { this.x = 1; this.y = 2; } }
+  const received = roundTrip(new Point());
+  assert.strictEqual(Object.getPrototypeOf(received), Object.prototype);
+  assert.deepStrictEqual(received, { x: 1, y: 2 });
+  assert.deepStrictEqual(roundTrip(new Date(0)), new Date(0));
+  assert.deepStrictEqual(roundTrip(Object.assign(Object.create(null), {
+    a: 1,
+  })), { a: 1 });
+  assert.throws(() => port1.postMessage({ fn() {} }), {
+    name: 'DataCloneError',
+  });
+  assert.throws(() => port1.postMessage([() => {}]), {
+    name: 'DataCloneError',
+  });
+}
+
+// Typed arrays keep their type, offset and length, and the whole underlying
+// buffer is cloned.
+{
+  const buffer = new ArrayBuffer(64);
+  new Uint8Array(buffer).forEach((_, i, arr) => arr[i] = i);
+  for (const Type of [Uint8Array, Uint8ClampedArray, Int8Array, Uint16Array,
+                      Int16Array, Uint32Array, Int32Array, Float32Array,
+                      Float64Array, BigUint64Array, BigInt64Array]) {
+    const view = new Type(buffer, 8, 2);
+    const received = roundTrip(view);
+    assert(received instanceof Type);
+    assert.strictEqual(received.byteOffset, 8);
+    assert.strictEqual(received.length, 2);
+    assert.strictEqual(received.buffer.byteLength, 64);
+    assert.deepStrictEqual(received, view);
+    assert.deepStrictEqual(new Uint8Array(received.buffer),
+                           new Uint8Array(buffer));
+  }
+
+  // Buffers arrive as Uint8Arrays.
+  const received = roundTrip(Buffer.from('hello'));
+  assert.strictEqual(Object.getPrototypeOf(received), Uint8Array.prototype);
+  assert.strictEqual(Buffer.from(received).toString(), 'hello');
+
+  // Views on SharedArrayBuffers still share their memory.
+  const shared = new Int32Array(new SharedArrayBuffer(8));
+  const sharedCopy = roundTrip(shared);
+  sharedCopy[0] = 5;
+  assert.strictEqual(shared[0], 5);
+
+  // The received copy is independent of the sent typed array.
+  const sent = new Uint8Array(4);
+  const copy = roundTrip(sent);
+  sent[0] = 1;
+  assert.strictEqual(copy[0], 0);
+
+  assert.deepStrictEqual(roundTrip(new Uint8Array(0)), new Uint8Array(0));
+}
+
+port1.close();
+
+// Messages are the same when sent to and received from another thread.
+{
+  const worker = new Worker(`
+    const { parentPort } = require('worker_threads');
+    parentPort.on('message', (msg) => parentPort.postMessage(msg));
+  `, { eval: true });
+
+  const sent = [...values, new Float64Array([1.5, -0, NaN])];
+  let received = 0;
+  worker.on('message', common.mustCall((msg) => {
+    assert.deepStrictEqual(msg, sent[received]);
+    if (++received === sent.length)
+      worker.terminate();
+  }, sent.length));
+  for (const value of sent)
+    worker.postMessage(value);
+}
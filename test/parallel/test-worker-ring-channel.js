@@ -0,0 +1,168 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { MessageChannel, RingChannel, Worker } = require('worker_threads');
+
+// Records are read in the order in which they were written, and the reader
+// sees the end once all writers are closed.
+{
+  const { reader, writer } = new RingChannel({ capacity: 4096 });
+  assert.strictEqual(reader.maxRecordSize, 2040);
+  assert.strictEqual(writer.maxRecordSize, 2040);
+  assert.strictEqual(reader.read(), null);
+
+  assert.strictEqual(writer.write('hello'), true);
+  assert.strictEqual(writer.write(new Uint16Array([1, 2])), true);
+  assert.strictEqual(writer.write(new ArrayBuffer(3)), true);
+  assert.strictEqual(writer.write(['a', Buffer.from('b'), new Uint8Array([99])]),
+                     true);
+  assert.strictEqual(writer.write(''), true);
+
+  assert.deepStrictEqual(reader.read(), Buffer.from('hello'));
+  assert.deepStrictEqual(reader.read(),
+                         Buffer.from(new Uint16Array([1, 2]).buffer));
+  assert.deepStrictEqual(reader.read(), Buffer.alloc(3));
+  assert.deepStrictEqual(reader.read(), Buffer.from('abc'));
+  assert.deepStrictEqual(reader.read(), Buffer.alloc(0));
+  assert.strictEqual(reader.read(), null);
+  assert.strictEqual(reader.ended, false);
+
+  writer.write('last');
+  writer.close();
+  assert.throws(() => writer.write('x'), { code: 'ERR_INVALID_STATE' });
+  assert.deepStrictEqual(reader.read(), Buffer.from('last'));
+  assert.strictEqual(reader.read(), null);
+  assert.strictEqual(reader.ended, true);
+  reader.on('end', common.mustCall());
+  reader.close();
+}
+
+// Invalid arguments.
+{
+  for (const capacity of [0, 4095, 2 ** 31, 1.5]) {
+    assert.throws(() => new RingChannel({ capacity }), {
+      code: 'ERR_OUT_OF_RANGE',
+    });
+  }
+  assert.throws(() => new RingChannel({ capacity: '4096' }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+
+  // The capacity is rounded up to a power of two.
+  const { reader, writer } = new RingChannel({ capacity: 5000 });
+  assert.strictEqual(writer.maxRecordSize, 4088);
+  assert.throws(() => writer.write(Buffer.alloc(4089)), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => writer.write([Buffer.alloc(4000), Buffer.alloc(89)]), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  for (const data of [42, null, {}, [1]]) {
+    assert.throws(() => writer.write(data), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  }
+  assert.strictEqual(writer.write(Buffer.alloc(4088)), true);
+
+  // Readers can only be transferred, not cloned.
+  const { port1 } = new MessageChannel();
+  assert.throws(() => port1.postMessage(reader), { name: 'DataCloneError' });
+  port1.close();
+
+  writer.close();
+  reader.close();
+  assert.strictEqual(reader.read(), null);
+}
+
+// write() returns false when the ring is full, and 'drain' is emitted once
+// the reader has made room.
+{
+  const { reader, writer } = new RingChannel({ capacity: 4096 });
+  const record = Buffer.alloc(1000, 'x');
+  let written = 0;
+  while (writer.write(record))
+    written++;
+  assert.strictEqual(written, 4);
+
+  writer.once('drain', common.mustCall(() => {
+    // Records of all sizes wrap around the end of the buffer.
+    while (reader.read() !== null);
+    for (let i = 0; i < 1000; i++) {
+      const data = Buffer.alloc((i * 7) % writer.maxRecordSize, i);
+      assert.strictEqual(writer.write(data), true);
+      assert.deepStrictEqual(reader.read(), data);
+    }
+    writer.close();
+    reader.close();
+  }));
+  assert.deepStrictEqual(reader.read(), record);
+}
+
+// Writers are cloned into several workers at once.
+{
+  const kWorkers = 4;
+  const kRecords = 5000;
+  const { reader, writer } = new RingChannel({ capacity: 16 * 1024 });
+
+  for (let id = 0; id < kWorkers; id++) {
+    new Worker(`
+      const { workerData: { writer, id, count } } = require('worker_threads');
+      let i = 0;
+      (function writeMore() {
+        for (; i < count; i++) {
+          if (!writer.write(id + ':' + i))
+            return writer.once('drain', writeMore);
+        }
+        writer.close();
+      })();
+    `, { eval: true, workerData: { writer, id, count: kRecords } });
+  }
+  // Writers that are on their way to a worker keep the ring open.
+  writer.close();
+
+  const next = new Array(kWorkers).fill(0);
+  reader.on('readable', common.mustCallAtLeast(() => {
+    let record;
+    while ((record = reader.read()) !== null) {
+      const [id, i] = `${record}`.split(':').map(Number);
+      assert.strictEqual(i, next[id]++);
+    }
+  }));
+  reader.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(next, new Array(kWorkers).fill(kRecords));
+    reader.close();
+  }));
+}
+
+// The reader is transferred to a worker, including records that have not
+// been read yet.
+{
+  const { reader, writer } = new RingChannel();
+  writer.write('before');
+
+  const worker = new Worker(`
+    const { parentPort } = require('worker_threads');
+    parentPort.once('message', ({ reader }) => {
+      const records = [];
+      reader.on('readable', () => {
+        let record;
+        while ((record = reader.read()) !== null)
+          records.push(\`\${record}\`);
+      });
+      reader.on('end', () => parentPort.postMessage(records));
+    });
+  `, { eval: true });
+  worker.postMessage({ reader }, [reader]);
+  assert.strictEqual(reader.read(), null);
+  assert.throws(() => worker.postMessage(reader, [reader]), {
+    name: 'DataCloneError',
+  });
+
+  writer.write('after');
+  writer.close();
+  worker.on('message', common.mustCall((records) => {
+    assert.deepStrictEqual(records, ['before', 'after']);
+  }));
+  worker.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+}
@@ -0,0 +1,57 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { performance } = require('perf_hooks');
+const { Worker } = require('worker_threads');
+
+const kMilestones = [
+  'spawnStart',
+  'threadStart',
+  'isolateCreated',
+  'environmentCreated',
+  'bootstrapComplete',
+  'online',
+];
+
+const before = performance.now();
+const worker = new Worker('', { eval: true });
+
+{
+  const timing = worker.performance.startupTiming();
+  assert.deepStrictEqual(Object.keys(timing), kMilestones);
+  assert(timing.spawnStart >= before);
+  assert(timing.spawnStart <= performance.now());
+  assert.strictEqual(timing.online, -1);
+}
+
+worker.on('online', common.mustCall(() => {
+  const timing = worker.performance.startupTiming();
+  for (const name of kMilestones)
+    assert.notStrictEqual(timing[name], -1, name);
+
+  // The milestones are reached in order.
+  for (let i = 1; i < kMilestones.length; i++) {
+    assert(timing[kMilestones[i]] >= timing[kMilestones[i - 1]],
+           `${kMilestones[i]} < ${kMilestones[i - 1]}`);
+  }
+  assert(timing.online <= performance.now());
+}));
+
+worker.on('exit', common.mustCall(() => {
+  // The timing is still available once the worker is gone.
+  const timing = worker.performance.startupTiming();
+  for (const name of kMilestones)
+    assert.notStrictEqual(timing[name], -1, name);
+}));
+
+// Workers that are terminated early only report the stages that they reached.
+{
+  const worker = new Worker('', { eval: true });
+  worker.terminate();
+  worker.on('exit', common.mustCall(() => {
+    const timing = worker.performance.startupTiming();
+    assert.notStrictEqual(timing.spawnStart, -1);
+    assert.strictEqual(timing.online, -1);
+  }));
+}
@@ -0,0 +1,34 @@
+'use strict';
+
+// Matches past 2^31 - 1 bytes must be reported with their real index by
+// both the regular and the fast API implementations of indexOf().
+
+const common = require('../common');
+const assert = require('assert');
+
+if (common.isFreeBSD)
+  common.skip('Oversized buffer make the FreeBSD CI runner crash');
+
+const length = 2 ** 31 + 16;
+let buf;
+try {
+  buf = Buffer.alloc(length);
+} catch (e) {
+  if (e.code === 'ERR_OUT_OF_RANGE' ||
+      e.message === 'Array buffer allocation failed') {
+    common.skip('Insufficient memory on this platform for oversized buffers');
+  }
+  throw e;
+}
+
+const index = 2 ** 31 + 8;
+buf.write('needle', index);
+buf[index + 7] = 0x7f;
+
+// Enough calls for the fast API calls to be used.
+for (let i = 0; i < 1e4; i++) {
+  assert.strictEqual(buf.indexOf('needle', index - 8), index);
+  assert.strictEqual(buf.indexOf(Buffer.from('needle'), index - 8), index);
+  assert.strictEqual(buf.indexOf(0x7f, index - 8), index + 7);
+  assert.strictEqual(buf.lastIndexOf(0x7f), index + 7);
+}
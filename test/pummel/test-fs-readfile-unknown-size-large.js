@@ -0,0 +1,24 @@
+'use strict';
+
+// Files of unknown size are read until EOF, but not past 2 GiB, the same
+// limit that applies to files whose size fstat() reports.
+
+const common = require('../common');
+
+if (common.isWindows)
+  common.skip('/dev/zero is not available on Windows');
+
+if (!common.enoughTestMem)
+  common.skip('intensive readFile tests due to memory confinements');
+
+const assert = require('assert');
+const fs = require('fs');
+
+assert.throws(() => fs.readFileSync('/dev/zero'), {
+  code: 'ERR_FS_FILE_TOO_LARGE',
+  name: 'RangeError',
+});
+
+fs.readFile('/dev/zero', common.mustCall((err) => {
+  assert.strictEqual(err.code, 'ERR_FS_FILE_TOO_LARGE');
+}));
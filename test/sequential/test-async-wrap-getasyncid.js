@@ -328,3 +328,14 @@ if (process.features.inspector && common.isMainThread) {
   const handle = dirBinding.opendir('./', 'utf8', undefined, {});
   testInitialized(handle, 'DirHandle');
 }
+
+// RINGREADER, RINGWRITER
+{
+  const { RingReader } = internalBinding('ring_channel');
+  const reader = new RingReader(4096);
+  const writer = reader.createWriter();
+  testInitialized(reader, 'RingReader');
+  testInitialized(writer, 'RingWriter');
+  writer.close();
+  reader.close();
+}
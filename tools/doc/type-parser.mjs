@@ -131,6 +131,7 @@ const customTypesMap = {
 
   'http.Agent': 'http.html#class-httpagent',
   'http.ClientRequest': 'http.html#class-httpclientrequest',
+  'http.FrozenHeaders': 'http.html#class-httpfrozenheaders',
   'http.IncomingMessage': 'http.html#class-httpincomingmessage',
   'http.OutgoingMessage': 'http.html#class-httpoutgoingmessage',
   'http.Server': 'http.html#class-httpserver',